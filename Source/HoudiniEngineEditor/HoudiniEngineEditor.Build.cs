@@ -174,6 +174,7 @@ public class HoudiniEngineEditor : ModuleRules
                 "EditorStyle",
                 "EditorWidgets",
                 "Engine",
+                "ImageWrapper",
                 "InputCore",
                 "LevelEditor",
                 "MainFrame",
@@ -189,6 +190,9 @@ public class HoudiniEngineEditor : ModuleRules
             }
         );
 
+        // Icons stored in compressed HDA sections are inflated with zlib.
+        AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
         DynamicallyLoadedModuleNames.AddRange(
             new string[]
             {
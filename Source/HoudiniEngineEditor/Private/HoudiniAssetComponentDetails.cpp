@@ -37,6 +37,7 @@
 #include "HoudiniParameterDetails.h"
 
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/Texture2D.h"
 #include "ContentBrowserModule.h"
 #include "Editor/PropertyEditor/Public/PropertyCustomizationHelpers.h"
 #include "DetailWidgetRow.h"
@@ -229,6 +230,7 @@ FHoudiniAssetComponentDetails::CreateStaticMeshAndMaterialWidgets( IDetailCatego
 {
     StaticMeshThumbnailBorders.Empty();
     LandscapeThumbnailBorders.Empty();
+    VolumeTextureThumbnailBorders.Empty();
     MaterialInterfaceComboButtons.Empty();
     MaterialInterfaceThumbnailBorders.Empty();
 
@@ -752,6 +754,86 @@ FHoudiniAssetComponentDetails::CreateStaticMeshAndMaterialWidgets( IDetailCatego
 
             MeshIdx++;
         }
+
+        // And for the textures created from volumes
+        for ( TMap< FHoudiniGeoPartObject, UTexture2D * >::TIterator
+            IterVolumes( HoudiniAssetComponent->VolumeTextures ); IterVolumes; ++IterVolumes )
+        {
+            UTexture2D * VolumeTexture = IterVolumes.Value();
+            FHoudiniGeoPartObject & HoudiniGeoPartObject = IterVolumes.Key();
+
+            if ( !VolumeTexture )
+                continue;
+
+            NumberOfGeneratedMeshes++;
+
+            FString Label = TEXT( "" );
+            if ( HoudiniGeoPartObject.HasCustomName() )
+                Label = HoudiniGeoPartObject.PartName;
+            else
+                Label = VolumeTexture->GetName();
+
+            // Create thumbnail for this volume texture.
+            TSharedPtr< FAssetThumbnail > VolumeTextureThumbnail =
+                MakeShareable( new FAssetThumbnail( VolumeTexture, 64, 64, AssetThumbnailPool ) );
+
+            TSharedPtr< SBorder > VolumeTextureThumbnailBorder;
+
+            IDetailGroup& VolumeTextureGrp = DetailCategoryBuilder.AddGroup( FName( *Label ), FText::FromString( Label ) );
+            VolumeTextureGrp.AddWidgetRow()
+            .NameContent()
+            [
+                SNew( SSpacer )
+                .Size( FVector2D( 250, 64 ) )
+            ]
+            .ValueContent()
+            .MinDesiredWidth( HAPI_UNREAL_DESIRED_ROW_VALUE_WIDGET_WIDTH )
+            [
+                SNew( SHorizontalBox )
+                + SHorizontalBox::Slot()
+                .Padding( 0.0f, 0.0f, 2.0f, 0.0f )
+                .AutoWidth()
+                [
+                    SAssignNew( VolumeTextureThumbnailBorder, SBorder )
+                    .Padding( 5.0f )
+                    .BorderImage( this, &FHoudiniAssetComponentDetails::GetVolumeTextureThumbnailBorder, VolumeTexture )
+                    .OnMouseDoubleClick( this, &FHoudiniAssetComponentDetails::OnThumbnailDoubleClick, (UObject *) VolumeTexture )
+                    [
+                        SNew( SBox )
+                        .WidthOverride( 64 )
+                        .HeightOverride( 64 )
+                        .ToolTipText( FText::FromString( VolumeTexture->GetPathName() ) )
+                        [
+                            VolumeTextureThumbnail->MakeThumbnailWidget()
+                        ]
+                    ]
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth( 1.0f )
+                .Padding( 0.0f, 4.0f, 4.0f, 4.0f )
+                .VAlign( VAlign_Center )
+                [
+                    SNew( SVerticalBox )
+                    + SVerticalBox::Slot()
+                    [
+                        SNew( SHorizontalBox )
+                        + SHorizontalBox::Slot()
+                        .MaxWidth( 80.0f )
+                        [
+                            SNew( SButton )
+                            .VAlign( VAlign_Center )
+                            .HAlign( HAlign_Center )
+                            .Text( LOCTEXT( "Bake", "Bake" ) )
+                            .OnClicked( this, &FHoudiniAssetComponentDetails::OnBakeVolumeTexture, VolumeTexture, HoudiniAssetComponent )
+                            .ToolTipText( LOCTEXT( "HoudiniVolumeTextureBakeButton", "Bake this volume texture" ) )
+                        ]
+                    ]
+                ]
+            ];
+
+            // Store thumbnail for this volume texture.
+            VolumeTextureThumbnailBorders.Add( VolumeTexture, VolumeTextureThumbnailBorder );
+        }
     }
 
     if (NumberOfGeneratedMeshes > 1)
@@ -1123,6 +1205,16 @@ FHoudiniAssetComponentDetails::GetLandscapeThumbnailBorder( ALandscape * Landsca
         return FEditorStyle::GetBrush("PropertyEditor.AssetThumbnailShadow");
 }
 
+const FSlateBrush *
+FHoudiniAssetComponentDetails::GetVolumeTextureThumbnailBorder( UTexture2D * VolumeTexture ) const
+{
+    TSharedPtr< SBorder > ThumbnailBorder = VolumeTextureThumbnailBorders[ VolumeTexture ];
+    if ( ThumbnailBorder.IsValid() && ThumbnailBorder->IsHovered() )
+        return FEditorStyle::GetBrush( "PropertyEditor.AssetThumbnailLight" );
+    else
+        return FEditorStyle::GetBrush( "PropertyEditor.AssetThumbnailShadow" );
+}
+
 const FSlateBrush *
 FHoudiniAssetComponentDetails::GetMaterialInterfaceThumbnailBorder( UStaticMesh * StaticMesh, int32 MaterialIdx ) const
 {
@@ -1221,6 +1313,15 @@ FHoudiniAssetComponentDetails::OnBakeLandscape(ALandscape * Landscape, UHoudiniA
     return FReply::Handled();
 }
 
+FReply
+FHoudiniAssetComponentDetails::OnBakeVolumeTexture( UTexture2D * VolumeTexture, UHoudiniAssetComponent * HoudiniAssetComponent )
+{
+    if ( HoudiniAssetComponent && VolumeTexture )
+        (void) FHoudiniEngineBakeUtils::BakeVolumeTexture( HoudiniAssetComponent, VolumeTexture );
+
+    return FReply::Handled();
+}
+
 FReply
 FHoudiniAssetComponentDetails::OnBakeAllGeneratedMeshes()
 {
@@ -1244,6 +1345,15 @@ FHoudiniAssetComponentDetails::OnBakeAllGeneratedMeshes()
                 continue;
             (void) OnBakeLandscape(Landscape, HoudiniAssetComponent);
         }
+
+        for ( TMap< FHoudiniGeoPartObject, UTexture2D * >::TIterator
+            IterVolumes( HoudiniAssetComponent->VolumeTextures ); IterVolumes; ++IterVolumes )
+        {
+            UTexture2D * VolumeTexture = IterVolumes.Value();
+            if ( !VolumeTexture )
+                continue;
+            (void) OnBakeVolumeTexture( VolumeTexture, HoudiniAssetComponent );
+        }
     }
 
     return FReply::Handled();
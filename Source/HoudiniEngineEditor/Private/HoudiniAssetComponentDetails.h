@@ -50,6 +50,7 @@ class UStaticMesh;
 class IDetailLayoutBuilder;
 class UHoudiniAssetComponent;
 class ALandscape;
+class UTexture2D;
 
 
 /** Hashing function for our pair. **/
@@ -87,6 +88,7 @@ class FHoudiniAssetComponentDetails : public IDetailCustomization
         /** Gets the border brush to show around thumbnails, changes when the user hovers on it. **/
         const FSlateBrush * GetStaticMeshThumbnailBorder( UStaticMesh * StaticMesh ) const;
         const FSlateBrush * GetLandscapeThumbnailBorder( ALandscape * Landscape ) const; 
+        const FSlateBrush * GetVolumeTextureThumbnailBorder( UTexture2D * VolumeTexture ) const;
         const FSlateBrush * GetMaterialInterfaceThumbnailBorder( UStaticMesh * StaticMesh, int32 MaterialIdx ) const;
         const FSlateBrush * GetMaterialInterfaceThumbnailBorder( ALandscape * Landscape, int32 MaterialIdx ) const;
 
@@ -105,6 +107,9 @@ class FHoudiniAssetComponentDetails : public IDetailCustomization
         /** Handler for baking an individual Landscape. **/
         FReply OnBakeLandscape( ALandscape * Landscape, UHoudiniAssetComponent * HoudiniAssetComponent );
 
+        /** Handler for baking an individual volume texture. **/
+        FReply OnBakeVolumeTexture( UTexture2D * VolumeTexture, UHoudiniAssetComponent * HoudiniAssetComponent );
+
         /** Handler for bake all static meshes action. **/
         FReply OnBakeAllGeneratedMeshes();
 
@@ -260,6 +265,9 @@ class FHoudiniAssetComponentDetails : public IDetailCustomization
         /** Map of Landscapes and corresponding thumbnail borders. **/
         TMap< ALandscape *, TSharedPtr< SBorder > > LandscapeThumbnailBorders;
 
+        /** Map of volume textures and corresponding thumbnail borders. **/
+        TMap< UTexture2D *, TSharedPtr< SBorder > > VolumeTextureThumbnailBorders;
+
         /** Map of Landscapes / material indices to combo elements. **/
         TMap< TPair< ALandscape *, int32 >, TSharedPtr<SComboButton > > LandscapeMaterialInterfaceComboButtons;
 
@@ -29,10 +29,27 @@
 #include "RendererInterface.h"
 #include "SceneInterface.h"
 #include "SceneView.h"
+#include "CanvasTypes.h"
+#include "ObjectTools.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "ThumbnailRendering/SceneThumbnailInfo.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
 
 UHoudiniAssetThumbnailRenderer::UHoudiniAssetThumbnailRenderer( const FObjectInitializer & ObjectInitializer )
     : Super( ObjectInitializer )
     , ThumbnailScene( nullptr )
+    , SharedThumbnail( nullptr )
+    , bCanShareThumbnail( true )
 {}
 
 void
@@ -41,31 +58,310 @@ UHoudiniAssetThumbnailRenderer::Draw(
     FRenderTarget * RenderTarget, FCanvas * Canvas )
 {
     UHoudiniAsset * HoudiniAsset = Cast< UHoudiniAsset >( Object );
-    if ( HoudiniAsset && !HoudiniAsset->IsPendingKill() )
+    if ( !HoudiniAsset || HoudiniAsset->IsPendingKill() )
+        return;
+
+    // Assets whose thumbnail camera has been modified always render their scene.
+    if ( UsesDefaultThumbnailInfo( HoudiniAsset ) )
     {
-        if ( !ThumbnailScene || !ThumbnailScene->IsValid() )
-            ThumbnailScene = new FHoudiniAssetThumbnailScene();
+        // Assets with an icon display it instead of the scene.
+        RequestAssetIcon( HoudiniAsset );
+        UTexture2D * const * FoundIcon = AssetIcons.Find( FName( *HoudiniAsset->GetPathName() ) );
+        if ( FoundIcon && *FoundIcon && ( *FoundIcon )->Resource )
+        {
+            Canvas->DrawTile( X, Y, Width, Height, 0.0f, 0.0f, 1.0f, 1.0f, FLinearColor::White, ( *FoundIcon )->Resource, false );
+            return;
+        }
+
+        // The scene looks the same for every asset viewed from the default camera, so it is only rendered once.
+        UTextureRenderTarget2D * Thumbnail = GetSharedThumbnail( HoudiniAsset, FMath::Max( Width, Height ) );
+        if ( Thumbnail && Thumbnail->Resource )
+        {
+            Canvas->DrawTile( X, Y, Width, Height, 0.0f, 0.0f, 1.0f, 1.0f, FLinearColor::White, Thumbnail->Resource, false );
+            return;
+        }
+    }
+
+    RenderThumbnailScene( HoudiniAsset, X, Y, Width, Height, RenderTarget, Canvas );
+}
+
+void
+UHoudiniAssetThumbnailRenderer::RenderThumbnailScene(
+    UHoudiniAsset * HoudiniAsset, int32 X, int32 Y, uint32 Width, uint32 Height,
+    FRenderTarget * RenderTarget, FCanvas * Canvas )
+{
+    if ( !ThumbnailScene || !ThumbnailScene->IsValid() )
+        ThumbnailScene = new FHoudiniAssetThumbnailScene();
+
+    ThumbnailScene->SetHoudiniAsset( HoudiniAsset );
 
-        ThumbnailScene->SetHoudiniAsset( HoudiniAsset );
+    if ( ThumbnailScene->GetScene() )
+        ThumbnailScene->GetScene()->UpdateSpeedTreeWind( 0.0 );
 
-        if ( ThumbnailScene->GetScene() )
-            ThumbnailScene->GetScene()->UpdateSpeedTreeWind( 0.0 );
+    FSceneViewFamilyContext ViewFamily(
+        FSceneViewFamily::ConstructionValues(
+            RenderTarget,
+            ThumbnailScene->GetScene(), FEngineShowFlags( ESFIM_Game ) )
+        .SetWorldTimes( FApp::GetCurrentTime() - GStartTime, FApp::GetDeltaTime(), FApp::GetCurrentTime() - GStartTime ) );
+
+    ViewFamily.EngineShowFlags.DisableAdvancedFeatures();
+    ViewFamily.EngineShowFlags.MotionBlur = 0;
+    ViewFamily.EngineShowFlags.LOD = 0;
+
+    if ( ThumbnailScene )
+        ThumbnailScene->GetView( &ViewFamily, X, Y, Width, Height );
+
+    GetRendererModule().BeginRenderingViewFamily( Canvas, &ViewFamily );
+}
+
+bool
+UHoudiniAssetThumbnailRenderer::UsesDefaultThumbnailInfo( const UHoudiniAsset * HoudiniAsset ) const
+{
+    const USceneThumbnailInfo * ThumbnailInfo = Cast< USceneThumbnailInfo >( HoudiniAsset->ThumbnailInfo );
+    if ( !ThumbnailInfo )
+        return true;
+
+    const USceneThumbnailInfo * DefaultThumbnailInfo = GetDefault< USceneThumbnailInfo >();
+    return ThumbnailInfo->OrbitPitch == DefaultThumbnailInfo->OrbitPitch
+        && ThumbnailInfo->OrbitYaw == DefaultThumbnailInfo->OrbitYaw
+        && ThumbnailInfo->OrbitZoom == DefaultThumbnailInfo->OrbitZoom;
+}
+
+UTextureRenderTarget2D *
+UHoudiniAssetThumbnailRenderer::GetSharedThumbnail( UHoudiniAsset * HoudiniAsset, uint32 Size )
+{
+    if ( !bCanShareThumbnail )
+        return nullptr;
 
-        FSceneViewFamilyContext ViewFamily(
-            FSceneViewFamily::ConstructionValues(
-                RenderTarget,
-                ThumbnailScene->GetScene(), FEngineShowFlags( ESFIM_Game ) )
-            .SetWorldTimes( FApp::GetCurrentTime() - GStartTime, FApp::GetDeltaTime(), FApp::GetCurrentTime() - GStartTime ) );
+    Size = FMath::Max< uint32 >( Size, ThumbnailTools::DefaultThumbnailSize );
+    if ( SharedThumbnail && SharedThumbnail->SizeX >= (int32) Size )
+        return SharedThumbnail;
 
-        ViewFamily.EngineShowFlags.DisableAdvancedFeatures();
-        ViewFamily.EngineShowFlags.MotionBlur = 0;
-        ViewFamily.EngineShowFlags.LOD = 0;
+    UTextureRenderTarget2D * Thumbnail = NewObject< UTextureRenderTarget2D >( this, NAME_None, RF_Transient );
+    Thumbnail->ClearColor = FLinearColor::Black;
+    Thumbnail->InitAutoFormat( Size, Size );
+    Thumbnail->UpdateResourceImmediate( true );
 
-        if ( ThumbnailScene )
-            ThumbnailScene->GetView( &ViewFamily, X, Y, Width, Height );
+    FTextureRenderTargetResource * ThumbnailResource = Thumbnail->GameThread_GetRenderTargetResource();
+    if ( !ThumbnailResource )
+        return nullptr;
 
-        GetRendererModule().BeginRenderingViewFamily( Canvas, &ViewFamily );
+    FCanvas ThumbnailCanvas( ThumbnailResource, nullptr, nullptr, GMaxRHIFeatureLevel );
+    RenderThumbnailScene( HoudiniAsset, 0, 0, Size, Size, ThumbnailResource, &ThumbnailCanvas );
+    ThumbnailCanvas.Flush_GameThread();
+
+    // Only keep the render if it is indeed the shared logo, assets previewing their own geometry cannot share it.
+    if ( !ThumbnailScene || !ThumbnailScene->ShowsHoudiniLogo() )
+    {
+        bCanShareThumbnail = false;
+        return nullptr;
     }
+
+    SharedThumbnail = Thumbnail;
+    return SharedThumbnail;
+}
+
+/** Bytes identifying the icon section of an HDA, and the images it may contain. **/
+static const uint8 IconSectionName[ 9 ] = { 'I', 'c', 'o', 'n', 'I', 'm', 'a', 'g', 'e' };
+static const uint8 PNGSignature[ 8 ] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+static const uint8 PNGEnd[ 4 ] = { 'I', 'E', 'N', 'D' };
+static const uint8 GzipSignature[ 3 ] = { 0x1F, 0x8B, 0x08 };
+
+/** Icons larger than this, compressed or not, are ignored. **/
+static const int32 MaxAssetIconBytes = 4 * 1024 * 1024;
+
+/** Return the index of the given bytes in the buffer, from the given start, or INDEX_NONE. **/
+static int32
+FindBytes( const uint8 * Buffer, int32 BufferSize, int32 StartIdx, const uint8 * Bytes, int32 BytesSize )
+{
+    for ( int32 Idx = StartIdx; Idx + BytesSize <= BufferSize; ++Idx )
+    {
+        if ( Buffer[ Idx ] == Bytes[ 0 ] && FMemory::Memcmp( &Buffer[ Idx ], Bytes, BytesSize ) == 0 )
+            return Idx;
+    }
+
+    return INDEX_NONE;
+}
+
+/** Locate the data of the HDA's IconImage section, a PNG image which may be gzip compressed. **/
+static bool
+FindIconSection( const uint8 * AssetBytes, int32 AssetBytesCount, int32 & OutStart, int32 & OutSize )
+{
+    // Assets without an icon section have no icon, whatever images their other sections embed.
+    const int32 IconSectionIdx = FindBytes( AssetBytes, AssetBytesCount, 0, IconSectionName, 9 );
+    if ( IconSectionIdx == INDEX_NONE )
+        return false;
+
+    const int32 PNGIdx = FindBytes( AssetBytes, AssetBytesCount, IconSectionIdx + 9, PNGSignature, 8 );
+    const int32 GzipIdx = FindBytes(
+        AssetBytes, PNGIdx == INDEX_NONE ? AssetBytesCount : PNGIdx, IconSectionIdx + 9, GzipSignature, 3 );
+
+    if ( GzipIdx != INDEX_NONE )
+    {
+        // The compressed size is not known until the section is inflated, which stops at the end of its stream.
+        OutStart = GzipIdx;
+        OutSize = FMath::Min( AssetBytesCount - GzipIdx, MaxAssetIconBytes );
+        return true;
+    }
+
+    if ( PNGIdx == INDEX_NONE )
+        return false;
+
+    // The image ends after the IEND chunk's CRC.
+    const int32 EndIdx = FindBytes( AssetBytes, FMath::Min( AssetBytesCount, PNGIdx + MaxAssetIconBytes ), PNGIdx + 8, PNGEnd, 4 );
+    if ( EndIdx == INDEX_NONE || EndIdx + 8 > AssetBytesCount )
+        return false;
+
+    OutStart = PNGIdx;
+    OutSize = EndIdx + 8 - PNGIdx;
+    return true;
+}
+
+/** Return the PNG image of an icon section, inflating the section first if it is compressed. **/
+static bool
+ExtractIconPNG( const TArray< uint8 > & SectionBytes, TArray< uint8 > & OutPNG )
+{
+    if ( SectionBytes.Num() >= 8 && FMemory::Memcmp( SectionBytes.GetData(), PNGSignature, 8 ) == 0 )
+    {
+        OutPNG = SectionBytes;
+        return true;
+    }
+
+    z_stream Stream;
+    FMemory::Memzero( Stream );
+
+    // Adding 32 to the window bits lets zlib detect the gzip header.
+    if ( inflateInit2( &Stream, MAX_WBITS + 32 ) != Z_OK )
+        return false;
+
+    Stream.next_in = const_cast< Bytef * >( SectionBytes.GetData() );
+    Stream.avail_in = SectionBytes.Num();
+
+    static const int32 InflateChunkSize = 64 * 1024;
+    int Result = Z_OK;
+    while ( Result == Z_OK && OutPNG.Num() < MaxAssetIconBytes )
+    {
+        const int32 OutputStart = OutPNG.Num();
+        OutPNG.AddUninitialized( InflateChunkSize );
+        Stream.next_out = &OutPNG[ OutputStart ];
+        Stream.avail_out = InflateChunkSize;
+        Result = inflate( &Stream, Z_NO_FLUSH );
+        OutPNG.SetNum( OutputStart + InflateChunkSize - Stream.avail_out, false );
+    }
+
+    inflateEnd( &Stream );
+
+    return Result == Z_STREAM_END && OutPNG.Num() >= 8 && FMemory::Memcmp( OutPNG.GetData(), PNGSignature, 8 ) == 0;
+}
+
+/** Icons are cached in the project's saved folder under the hash of their HDA, so editing the HDA invalidates them. **/
+static FString
+GetAssetIconCachePath( uint32 AssetHash )
+{
+    return FPaths::ProjectSavedDir() / TEXT( "HoudiniEngine" ) / TEXT( "AssetIcons" ) / FString::Printf( TEXT( "%08x.png" ), AssetHash );
+}
+
+void
+UHoudiniAssetThumbnailRenderer::RequestAssetIcon( UHoudiniAsset * HoudiniAsset )
+{
+    const FName AssetPath( *HoudiniAsset->GetPathName() );
+    if ( RequestedAssetIcons.Contains( AssetPath ) )
+        return;
+
+    RequestedAssetIcons.Add( AssetPath );
+
+    const uint8 * AssetBytes = HoudiniAsset->GetAssetBytes();
+    const int32 AssetBytesCount = HoudiniAsset->GetAssetBytesCount();
+    if ( !AssetBytes || AssetBytesCount <= 0 )
+        return;
+
+    // An empty cache file records that the asset has no icon.
+    const FString CachePath = GetAssetIconCachePath( FCrc::MemCrc32( AssetBytes, AssetBytesCount ) );
+    const int64 CachedIconSize = IFileManager::Get().FileSize( *CachePath );
+    if ( CachedIconSize == 0 )
+        return;
+
+    // Only the icon section is copied for the background task, the asset's data is read in place.
+    const bool bIconCached = CachedIconSize > 0;
+    TSharedRef< TArray< uint8 >, ESPMode::ThreadSafe > SectionBytes = MakeShareable( new TArray< uint8 >() );
+    if ( !bIconCached )
+    {
+        int32 SectionStart = 0;
+        int32 SectionSize = 0;
+        if ( !FindIconSection( AssetBytes, AssetBytesCount, SectionStart, SectionSize ) )
+        {
+            FFileHelper::SaveArrayToFile( TArray< uint8 >(), *CachePath );
+            return;
+        }
+
+        SectionBytes->Append( &AssetBytes[ SectionStart ], SectionSize );
+    }
+
+    // The image wrapper module has to be loaded on the game thread.
+    IImageWrapperModule & ImageWrapperModule = FModuleManager::LoadModuleChecked< IImageWrapperModule >( FName( "ImageWrapper" ) );
+
+    TWeakObjectPtr< UHoudiniAssetThumbnailRenderer > WeakRenderer( this );
+    TWeakObjectPtr< UHoudiniAsset > WeakHoudiniAsset( HoudiniAsset );
+    FFunctionGraphTask::CreateAndDispatchWhenReady( [ = , &ImageWrapperModule ]()
+    {
+        TArray< uint8 > IconPNG;
+        if ( bIconCached )
+        {
+            if ( !FFileHelper::LoadFileToArray( IconPNG, *CachePath ) )
+                return;
+        }
+        else
+        {
+            if ( !ExtractIconPNG( SectionBytes.Get(), IconPNG ) )
+                IconPNG.Empty();
+
+            FFileHelper::SaveArrayToFile( IconPNG, *CachePath );
+            if ( IconPNG.Num() <= 0 )
+                return;
+        }
+
+        TSharedPtr< IImageWrapper > ImageWrapper = ImageWrapperModule.CreateImageWrapper( EImageFormat::PNG );
+        const TArray< uint8 > * RawData = nullptr;
+        if ( !ImageWrapper.IsValid() || !ImageWrapper->SetCompressed( IconPNG.GetData(), IconPNG.Num() )
+            || !ImageWrapper->GetRaw( ERGBFormat::BGRA, 8, RawData ) || !RawData )
+        {
+            // Do not keep an image which cannot be decoded, it would be read again every session.
+            IFileManager::Get().Delete( *CachePath );
+            return;
+        }
+
+        const int32 IconWidth = ImageWrapper->GetWidth();
+        const int32 IconHeight = ImageWrapper->GetHeight();
+        TSharedRef< TArray< uint8 >, ESPMode::ThreadSafe > IconData = MakeShareable( new TArray< uint8 >( *RawData ) );
+
+        FFunctionGraphTask::CreateAndDispatchWhenReady( [ = ]()
+        {
+            if ( WeakRenderer.IsValid() && WeakHoudiniAsset.IsValid() )
+                WeakRenderer->OnAssetIconDecoded( WeakHoudiniAsset.Get(), IconWidth, IconHeight, IconData.Get() );
+        }
+        , TStatId(), nullptr, ENamedThreads::GameThread );
+    }
+    , TStatId(), nullptr, ENamedThreads::AnyThread );
+}
+
+void
+UHoudiniAssetThumbnailRenderer::OnAssetIconDecoded(
+    UHoudiniAsset * HoudiniAsset, int32 IconWidth, int32 IconHeight,
+    const TArray< uint8 > & IconData )
+{
+    if ( IconWidth <= 0 || IconHeight <= 0 || IconData.Num() < IconWidth * IconHeight * 4 )
+        return;
+
+    UTexture2D * IconTexture = UTexture2D::CreateTransient( IconWidth, IconHeight, PF_B8G8R8A8 );
+    if ( !IconTexture )
+        return;
+
+    void * MipData = IconTexture->PlatformData->Mips[ 0 ].BulkData.Lock( LOCK_READ_WRITE );
+    FMemory::Memcpy( MipData, IconData.GetData(), IconWidth * IconHeight * 4 );
+    IconTexture->PlatformData->Mips[ 0 ].BulkData.Unlock();
+    IconTexture->UpdateResource();
+
+    AssetIcons.Add( FName( *HoudiniAsset->GetPathName() ), IconTexture );
 }
 
 void
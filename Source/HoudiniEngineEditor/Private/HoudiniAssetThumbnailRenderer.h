@@ -38,6 +38,8 @@ class UObject;
 class FCanvas;
 class FRenderTarget;
 class UHoudiniAsset;
+class UTexture2D;
+class UTextureRenderTarget2D;
 class FHoudiniAssetThumbnailScene;
 
 
@@ -59,8 +61,43 @@ class UHoudiniAssetThumbnailRenderer : public UDefaultSizedThumbnailRenderer
 
         virtual void BeginDestroy() override;
 
+    private:
+
+        /** Render the thumbnail scene for the given asset. **/
+        void RenderThumbnailScene(
+            UHoudiniAsset * HoudiniAsset, int32 X, int32 Y, uint32 Width, uint32 Height,
+            FRenderTarget * RenderTarget, FCanvas * Canvas );
+
+        /** Return true if the asset's thumbnail uses the default camera, and thus looks like every other one. **/
+        bool UsesDefaultThumbnailInfo( const UHoudiniAsset * HoudiniAsset ) const;
+
+        /** Render the shared thumbnail once, at least at the given size. **/
+        UTextureRenderTarget2D * GetSharedThumbnail( UHoudiniAsset * HoudiniAsset, uint32 Size );
+
+        /** Look for an icon embedded in the asset, decoding it on a background thread. The icon is cached on disk by asset hash. **/
+        void RequestAssetIcon( UHoudiniAsset * HoudiniAsset );
+
+        /** Create the texture used to draw an asset's icon. The texture is kept for this session only, not saved with the package. **/
+        void OnAssetIconDecoded(
+            UHoudiniAsset * HoudiniAsset, int32 IconWidth, int32 IconHeight,
+            const TArray< uint8 > & IconData );
+
     private:
 
         /** Used thumbnail scene. **/
         FHoudiniAssetThumbnailScene * ThumbnailScene;
+
+        /** Thumbnail shared by all the assets using the default camera, rendered once. **/
+        UPROPERTY( Transient )
+        UTextureRenderTarget2D * SharedThumbnail;
+
+        /** Icons of the assets which have one, indexed by asset path. **/
+        UPROPERTY( Transient )
+        TMap< FName, UTexture2D * > AssetIcons;
+
+        /** Assets whose icon has been looked for already, or is being decoded. **/
+        TSet< FName > RequestedAssetIcons;
+
+        /** Cleared if the preview scene does not show the same logo for every asset. **/
+        bool bCanShareThumbnail;
 };
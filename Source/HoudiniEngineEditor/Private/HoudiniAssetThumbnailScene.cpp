@@ -142,3 +142,12 @@ FHoudiniAssetThumbnailScene::IsValid() const
 
     return true;
 }
+
+bool
+FHoudiniAssetThumbnailScene::ShowsHoudiniLogo() const
+{
+    if ( !IsValid() )
+        return false;
+
+    return PreviewHoudiniAssetActor->GetHoudiniAssetComponent()->ContainsHoudiniLogoGeometry();
+}
@@ -49,6 +49,9 @@ class FHoudiniAssetThumbnailScene : public FThumbnailPreviewScene
 
 	bool IsValid() const;
 
+        /** Returns true if the preview actor displays the Houdini logo, as it does for any asset. **/
+        bool ShowsHoudiniLogo() const;
+
     /** FThumbnailPreviewScene methods. **/
     protected:
 
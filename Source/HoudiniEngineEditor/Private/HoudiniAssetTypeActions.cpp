@@ -186,6 +186,18 @@ FHoudiniAssetTypeActions::GetActions( const TArray< UObject * > & InObjects, cla
             FCanExecuteAction::CreateLambda( [=] { return (HoudiniAssets.Num() == 1); } )
         )
     );
+
+    MenuBuilder.AddMenuEntry(
+        NSLOCTEXT("HoudiniAssetTypeActions", "HoudiniAsset_ApplyBatchMerged", "Batch Apply to the current selection (merged)"),
+        NSLOCTEXT(
+            "HoudiniAssetTypeActions", "HoudiniAsset_ApplyBatchMergedTooltip",
+            "Batch apply the selected asset to the current world selection in a single cook. A single instance of the selected Houdini asset will be created, with each selected object packed in its first input."),
+        FSlateIcon(StyleSet->GetStyleSetName(), "HoudiniEngine.HoudiniEngineLogo"),
+        FUIAction(
+            FExecuteAction::CreateSP( this, &FHoudiniAssetTypeActions::ExecuteApplyBatchMerged, HoudiniAssets ),
+            FCanExecuteAction::CreateLambda( [=] { return (HoudiniAssets.Num() == 1); } )
+        )
+    );
 }
 
 void
@@ -300,6 +312,12 @@ FHoudiniAssetTypeActions::ExecuteApplyBatch( TArray< TWeakObjectPtr< UHoudiniAss
     return ExecuteApplyAssetToSelection( HoudiniAssets, EHoudiniToolType::HTOOLTYPE_OPERATOR_BATCH );
 }
 
+void
+FHoudiniAssetTypeActions::ExecuteApplyBatchMerged( TArray< TWeakObjectPtr< UHoudiniAsset > > HoudiniAssets )
+{
+    return ExecuteApplyAssetToSelection( HoudiniAssets, EHoudiniToolType::HTOOLTYPE_OPERATOR_BATCH_MERGED );
+}
+
 void
 FHoudiniAssetTypeActions::ExecuteApplyAssetToSelection( TArray< TWeakObjectPtr< UHoudiniAsset > > HoudiniAssets, EHoudiniToolType Type )
 {
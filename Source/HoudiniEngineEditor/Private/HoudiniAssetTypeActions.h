@@ -76,5 +76,8 @@ class FHoudiniAssetTypeActions : public FAssetTypeActions_Base
         /** Handler to batch apply the current hda to the current world selection */
         void ExecuteApplyBatch( TArray< TWeakObjectPtr< UHoudiniAsset > > HoudiniAssets );
 
+        /** Handler to batch apply the current hda to the current world selection, in a single instance */
+        void ExecuteApplyBatchMerged( TArray< TWeakObjectPtr< UHoudiniAsset > > HoudiniAssets );
+
         void ExecuteApplyAssetToSelection( TArray< TWeakObjectPtr< UHoudiniAsset > > HoudiniAssets, EHoudiniToolType Type );
 };
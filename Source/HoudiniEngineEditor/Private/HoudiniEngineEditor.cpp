@@ -45,6 +45,7 @@
 #include "UnrealEdGlobals.h"
 #include "Editor/UnrealEdEngine.h"
 #include "Engine/ObjectLibrary.h"
+#include "Misc/ScopedSlowTask.h"
 #include "EditorDirectories.h"
 #include "Styling/SlateStyleRegistry.h"
 #include "SHoudiniToolPalette.h"
@@ -874,109 +875,220 @@ FHoudiniEngineEditor::CleanUpTempFolder()
     // The Asset registry will help us finding if the content of the asset is referenced
     FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 
-    int32 DeletedCount = 0;
-    bool bDidDeleteAsset = true;
-    while ( bDidDeleteAsset )
-    {
-        // To correctly clean the temp folder, we need to iterate multiple times, because some of the temp assets
-        // might be referenced by other temp assets.. (ie Textures are referenced by Materials)
-        // We'll stop looking for assets to delete when no deletion occured.
-        bDidDeleteAsset = false;
+    // The Object library will list all UObjects found in the TempFolder
+    auto ObjectLibrary = UObjectLibrary::CreateLibrary( UObject::StaticClass(), false, true );
+    ObjectLibrary->LoadAssetDataFromPath( TempCookFolder );
 
-        // The Object library will list all UObjects found in the TempFolder
-        auto ObjectLibrary = UObjectLibrary::CreateLibrary( UObject::StaticClass(), false, true );
-        ObjectLibrary->LoadAssetDataFromPath( TempCookFolder );
+    // Getting all the found asset in the TEMPO folder
+    TArray<FAssetData> AssetDataList;
+    ObjectLibrary->GetAssetDataList( AssetDataList );
 
-        // Getting all the found asset in the TEMPO folder
-        TArray<FAssetData> AssetDataList;
-        ObjectLibrary->GetAssetDataList( AssetDataList );
+    // Group the assets by temporary package
+    TMap< FName, TArray< FAssetData > > TempPackageAssets;
+    for ( const FAssetData& Data : AssetDataList )
+        TempPackageAssets.FindOrAdd( Data.PackageName ).Add( Data );
 
-        // All the assets we're going to delete
-        TArray<FAssetData> AssetDataToDelete;
+    // The reference graph between the temporary packages is only computed once, instead of rescanning
+    // the folder after each deletion pass. Packages referenced from outside the temp folder are kept.
+    TMap< FName, TSet< FName > > TempReferencers;
+    TArray< FName > KeptPackages;
+
+    FScopedSlowTask DiscoveryTask( (float) TempPackageAssets.Num(), FText::FromString( TEXT( "Looking for unreferenced temporary files" ) ) );
+    DiscoveryTask.MakeDialog( true );
 
-        for ( FAssetData Data : AssetDataList )
+    for ( auto& PackageIter : TempPackageAssets )
+    {
+        DiscoveryTask.EnterProgressFrame();
+        if ( DiscoveryTask.ShouldCancel() )
+            return;
+
+        const FName& PackageName = PackageIter.Key;
+        TSet< FName >& Referencers = TempReferencers.FindOrAdd( PackageName );
+        bool bReferencedOutsideTempFolder = false;
+
+        // References stored in saved packages (levels, blueprints, other assets)
+        TArray< FName > RegistryReferencers;
+        AssetRegistryModule.Get().GetReferencers( PackageName, RegistryReferencers );
+        for ( const FName& ReferencerName : RegistryReferencers )
         {
-            UPackage* CurrentPackage = Data.GetPackage();
-            if ( !CurrentPackage )
+            if ( ReferencerName == PackageName )
                 continue;
 
-            TArray<FAssetData> AssetsInPackage;
-            bool bAssetDataSafeToDelete = true;
-            AssetRegistryModule.Get().GetAssetsByPackageName( CurrentPackage->GetFName(), AssetsInPackage );
+            if ( TempPackageAssets.Contains( ReferencerName ) )
+                Referencers.Add( ReferencerName );
+            else
+                bReferencedOutsideTempFolder = true;
+        }
 
-            for ( const auto& AssetInfo : AssetsInPackage )
-            {
-                if ( !AssetInfo.GetAsset() )
-                    continue;
+        // References held in memory, *including* the undo buffer
+        for ( const FAssetData& AssetInfo : PackageIter.Value )
+        {
+            if ( bReferencedOutsideTempFolder )
+                break;
 
-                // Check and see whether we are referenced by any objects that won't be garbage collected (*including* the undo buffer)
-                FReferencerInformationList ReferencesIncludingUndo;
-                UObject* AssetInPackage = AssetInfo.GetAsset();
-                bool bReferencedInMemoryOrUndoStack = IsReferenced( AssetInPackage, GARBAGE_COLLECTION_KEEPFLAGS, EInternalObjectFlags::GarbageCollectionKeepFlags, true, &ReferencesIncludingUndo );
-                if ( !bReferencedInMemoryOrUndoStack )
-                    continue;
+            UObject* AssetInPackage = AssetInfo.GetAsset();
+            if ( !AssetInPackage )
+                continue;
 
-                // We do have external references, check if the external references are in our ObjectToDelete list
-                // If they are, we can delete the asset cause its references are going to be deleted too.
-                for ( auto ExtRef : ReferencesIncludingUndo.ExternalReferences )
-                {
-                    UObject* Outer = ExtRef.Referencer->GetOuter();
+            FReferencerInformationList ReferencesIncludingUndo;
+            if ( !IsReferenced( AssetInPackage, GARBAGE_COLLECTION_KEEPFLAGS, EInternalObjectFlags::GarbageCollectionKeepFlags, true, &ReferencesIncludingUndo ) )
+                continue;
 
-                    bool bOuterFound = false;
-                    for ( auto DataToDelete : AssetDataToDelete )
-                    {
-                        if ( DataToDelete.GetPackage() == Outer )
-                        {
-                            bOuterFound = true;
-                            break;
-                        }
-                        else if ( DataToDelete.GetAsset() == Outer )
-                        {
-                            bOuterFound = true;
-                            break;
-                        }
-                    }
+            for ( const FReferencerInformation& ExtRef : ReferencesIncludingUndo.ExternalReferences )
+            {
+                UPackage* ReferencerPackage = ExtRef.Referencer ? ExtRef.Referencer->GetOutermost() : nullptr;
+                FName ReferencerName = ReferencerPackage ? ReferencerPackage->GetFName() : NAME_None;
+                if ( ReferencerName == PackageName )
+                    continue;
 
-                    // We have at least one reference that's not going to be deleted, we have to keep the asset
-                    if ( !bOuterFound )
-                    {
-                        bAssetDataSafeToDelete = false;
-                        break;
-                    }
+                if ( TempPackageAssets.Contains( ReferencerName ) )
+                {
+                    Referencers.Add( ReferencerName );
+                }
+                else
+                {
+                    bReferencedOutsideTempFolder = true;
+                    break;
                 }
             }
-            
-            if ( bAssetDataSafeToDelete )
-                AssetDataToDelete.Add( Data );
         }
 
-        // Nothing to delete
-        if ( AssetDataToDelete.Num() <= 0 )
-            break;
+        if ( bReferencedOutsideTempFolder )
+            KeptPackages.Add( PackageName );
+    }
+
+    // Everything referenced, directly or not, by a package we keep must be kept too.
+    TMap< FName, TArray< FName > > TempReferences;
+    for ( const auto& ReferencersIter : TempReferencers )
+    {
+        for ( const FName& ReferencerName : ReferencersIter.Value )
+            TempReferences.FindOrAdd( ReferencerName ).Add( ReferencersIter.Key );
+    }
+
+    TSet< FName > KeptPackageSet( KeptPackages );
+    for ( int32 KeptIdx = 0; KeptIdx < KeptPackages.Num(); KeptIdx++ )
+    {
+        const TArray< FName >* ReferencedPackages = TempReferences.Find( KeptPackages[ KeptIdx ] );
+        if ( !ReferencedPackages )
+            continue;
+
+        for ( const FName& ReferencedName : *ReferencedPackages )
+        {
+            bool bAlreadyKept = false;
+            KeptPackageSet.Add( ReferencedName, &bAlreadyKept );
+            if ( !bAlreadyKept )
+                KeptPackages.Add( ReferencedName );
+        }
+    }
+
+    // Count the referencers of each deletable package that are going to be deleted as well
+    TMap< FName, int32 > PendingReferencerCount;
+    for ( const auto& ReferencersIter : TempReferencers )
+    {
+        if ( !KeptPackageSet.Contains( ReferencersIter.Key ) )
+            PendingReferencerCount.Add( ReferencersIter.Key, ReferencersIter.Value.Num() );
+    }
+
+    // Delete the packages in reverse topological order, in batches of packages whose referencers are all deleted.
+    // (ie Materials are deleted before the Textures they reference)
+    int32 DeletedCount = 0;
+    while ( PendingReferencerCount.Num() > 0 )
+    {
+        TArray< FName > BatchPackages;
+        for ( const auto& PendingIter : PendingReferencerCount )
+        {
+            if ( PendingIter.Value <= 0 )
+                BatchPackages.Add( PendingIter.Key );
+        }
 
-        int32 CurrentDeleted = ObjectTools::DeleteAssets( AssetDataToDelete, false );
+        // Only reference cycles are left, delete them all together
+        bool bForceDelete = false;
+        if ( BatchPackages.Num() <= 0 )
+        {
+            PendingReferencerCount.GenerateKeyArray( BatchPackages );
+            bForceDelete = true;
+        }
+
+        TArray<FAssetData> AssetDataToDelete;
+        for ( const FName& PackageName : BatchPackages )
+        {
+            PendingReferencerCount.Remove( PackageName );
+            AssetDataToDelete.Append( TempPackageAssets[ PackageName ] );
+        }
+
+        int32 CurrentDeleted = bForceDelete ? 0 : ObjectTools::DeleteAssets( AssetDataToDelete, false );
         if ( CurrentDeleted <= 0 )
         {
             // Normal deletion failed...  Try to force delete the objects?
+            // Objects still referenced from outside the batch are left alone, they are in use.
+            TSet< FName > BatchPackageSet( BatchPackages );
             TArray<UObject*> ObjectsToDelete;
             for (int i = 0; i < AssetDataToDelete.Num(); i++)
             {
                 const FAssetData& AssetData = AssetDataToDelete[i];
                 UObject *ObjectToDelete = AssetData.GetAsset();
                 // Assets can be loaded even when their underlying type/class no longer exists...
-                if (ObjectToDelete != nullptr)
+                if (ObjectToDelete == nullptr)
+                    continue;
+
+                bool bReferencedOutsideBatch = false;
+                FReferencerInformationList ReferencesIncludingUndo;
+                if ( IsReferenced( ObjectToDelete, GARBAGE_COLLECTION_KEEPFLAGS, EInternalObjectFlags::GarbageCollectionKeepFlags, true, &ReferencesIncludingUndo ) )
                 {
-                    ObjectsToDelete.Add(ObjectToDelete);
+                    for ( const FReferencerInformation& ExtRef : ReferencesIncludingUndo.ExternalReferences )
+                    {
+                        UPackage* ReferencerPackage = ExtRef.Referencer ? ExtRef.Referencer->GetOutermost() : nullptr;
+                        if ( !ReferencerPackage || !BatchPackageSet.Contains( ReferencerPackage->GetFName() ) )
+                        {
+                            bReferencedOutsideBatch = true;
+                            break;
+                        }
+                    }
                 }
+
+                if ( !bReferencedOutsideBatch )
+                    ObjectsToDelete.Add(ObjectToDelete);
+            }
+
+            CurrentDeleted = ObjectsToDelete.Num() > 0 ? ObjectTools::ForceDeleteObjects(ObjectsToDelete, false) : 0;
+        }
+
+        DeletedCount += CurrentDeleted;
+
+        // Only the packages which are actually gone release the packages they reference. The packages which
+        // could not be deleted still reference theirs, which are then kept as well.
+        TArray< FName > RemainingPackages;
+        for ( const FName& PackageName : BatchPackages )
+        {
+            TArray< FAssetData > RemainingAssets;
+            AssetRegistryModule.Get().GetAssetsByPackageName( PackageName, RemainingAssets );
+            if ( RemainingAssets.Num() > 0 )
+            {
+                RemainingPackages.Add( PackageName );
+                continue;
             }
 
-            CurrentDeleted = ObjectTools::ForceDeleteObjects(ObjectsToDelete, false);
+            if ( const TArray< FName >* ReferencedPackages = TempReferences.Find( PackageName ) )
+            {
+                for ( const FName& ReferencedName : *ReferencedPackages )
+                {
+                    if ( int32* ReferencerCount = PendingReferencerCount.Find( ReferencedName ) )
+                        ( *ReferencerCount )--;
+                }
+            }
         }
 
-        if ( CurrentDeleted > 0 )
+        for ( int32 RemainingIdx = 0; RemainingIdx < RemainingPackages.Num(); RemainingIdx++ )
         {
-            DeletedCount += CurrentDeleted;
-            bDidDeleteAsset = true;
+            const TArray< FName >* ReferencedPackages = TempReferences.Find( RemainingPackages[ RemainingIdx ] );
+            if ( !ReferencedPackages )
+                continue;
+
+            for ( const FName& ReferencedName : *ReferencedPackages )
+            {
+                if ( PendingReferencerCount.Remove( ReferencedName ) > 0 )
+                    RemainingPackages.Add( ReferencedName );
+            }
         }
     }
 
@@ -1001,8 +1113,8 @@ FHoudiniEngineEditor::BakeAllAssets()
     FString Notification = TEXT("Baking all assets in the current level...");
     FHoudiniEngineUtils::CreateSlateNotification( Notification );
 
-    // Bakes and replaces with blueprints all Houdini Assets in the current level
-    int32 BakedCount = 0;
+    // Gather all the components to bake first
+    TArray< UHoudiniAssetComponent * > ComponentsToBake;
     for (TObjectIterator<UHoudiniAssetComponent> Itr; Itr; ++Itr)
     {
         UHoudiniAssetComponent * HoudiniAssetComponent = *Itr;
@@ -1022,11 +1134,32 @@ FHoudiniEngineEditor::BakeAllAssets()
 
         // If component is not cooking or instancing, we can bake blueprint.
         if ( !HoudiniAssetComponent->IsInstantiatingOrCooking() )
-        {
-            if ( FHoudiniEngineBakeUtils::ReplaceHoudiniActorWithBlueprint( HoudiniAssetComponent ) )
-                BakedCount++;
-        }
+            ComponentsToBake.Add( HoudiniAssetComponent );
+    }
+
+    // Bakes and replaces with blueprints all Houdini Assets in the current level.
+    // Meshes, materials and textures shared by several components are only baked once,
+    // and all the created packages are saved together at the end.
+    FScopedSlowTask BakeTask( (float) ComponentsToBake.Num(), FText::FromString( TEXT( "Baking all Houdini assets" ) ) );
+    BakeTask.MakeDialog();
+
+    int32 BakedCount = 0;
+    FHoudiniEngineBakeUtils::BeginBakeSession();
+    for ( UHoudiniAssetComponent * HoudiniAssetComponent : ComponentsToBake )
+    {
+        BakeTask.EnterProgressFrame();
+
+        // Replacing a previous component's actor may have destroyed this one
+        if ( !IsValid( HoudiniAssetComponent ) )
+            continue;
+
+        // Make sure the outputs are complete before baking them
+        HoudiniAssetComponent->FinishPostCookWorkItems();
+
+        if ( FHoudiniEngineBakeUtils::ReplaceHoudiniActorWithBlueprint( HoudiniAssetComponent ) )
+            BakedCount++;
     }
+    FHoudiniEngineBakeUtils::EndBakeSession();
 
     // Add a slate notification
     Notification = TEXT("Baked ") + FString::FromInt( BakedCount ) + TEXT(" Houdini assets.");
@@ -1124,6 +1257,7 @@ FHoudiniEngineEditor::RecookSelection()
         if ( !HoudiniAssetComponent || !HoudiniAssetComponent->IsComponentValid() )
             continue;
 
+        HoudiniAssetComponent->SetFinishPostCookImmediately( true );
         HoudiniAssetComponent->StartTaskAssetCookingManual();
         CookedCount++;
     }
@@ -1151,6 +1285,7 @@ FHoudiniEngineEditor::RecookAllAssets()
         if (!HoudiniAssetComponent || !HoudiniAssetComponent->IsComponentValid())
             continue;
 
+        HoudiniAssetComponent->SetFinishPostCookImmediately( true );
         HoudiniAssetComponent->StartTaskAssetCookingManual();
         CookedCount++;
     }
@@ -1178,6 +1313,7 @@ FHoudiniEngineEditor::RebuildAllAssets()
         if ( !HoudiniAssetComponent || !HoudiniAssetComponent->IsComponentValid() )
             continue;
 
+        HoudiniAssetComponent->SetFinishPostCookImmediately( true );
         HoudiniAssetComponent->StartTaskAssetRebuildManual();
         RebuiltCount++;
     }
@@ -1218,6 +1354,7 @@ FHoudiniEngineEditor::RebuildSelection()
         if ( !HoudiniAssetComponent || !HoudiniAssetComponent->IsComponentValid() )
             continue;
 
+        HoudiniAssetComponent->SetFinishPostCookImmediately( true );
         HoudiniAssetComponent->StartTaskAssetRebuildManual();
         RebuiltCount++;
     }
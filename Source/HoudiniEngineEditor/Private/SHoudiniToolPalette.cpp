@@ -129,6 +129,9 @@ TSharedRef< ITableRow > SHoudiniToolPalette::MakeListViewWidget( TSharedPtr< FHo
         case EHoudiniToolType::HTOOLTYPE_OPERATOR_BATCH:
             ToolTip += TEXT("Operator (Batch):\nDouble clicking on this tool will instantiate the asset in the world.\nAn instance of the asset will be created for each of the selected object, and the asset's first input will be set to that object.\nIf objects are selected in the world outliner, each created asset will use its object transform.\nIf objects are selected in the content browser, the world selection will be ignored.");
             break;
+        case EHoudiniToolType::HTOOLTYPE_OPERATOR_BATCH_MERGED:
+            ToolTip += TEXT("Operator (Batch, merged):\nDouble clicking on this tool will instantiate the asset in the world.\nA single instance of the asset will process all the selected objects in one cook: each selected object is packed before being merged in the asset's first input, and the geometry generated from it is output as its own mesh component.\nIf objects are selected in the world outliner, the asset's transform will default to the mean Transform of the select objects.\nIf objects are selected in the content browser, the world selection will be ignored.");
+            break;
         case EHoudiniToolType::HTOOLTYPE_GENERATOR:
         default:
             ToolTip += TEXT("Generator:\nDouble clicking on this tool will instantiate the asset in the world.\nIf objects are selected in the world outliner, the asset's transform will default to the mean Transform of the select objects.");
@@ -357,7 +360,9 @@ SHoudiniToolPalette::InstantiateHoudiniTool( FHoudiniTool* HoudiniTool )
     }
     else
     {
-        // We only need to create a single instance of the asset, regarding of the selection
+        // We only need to create a single instance of the asset, regarding of the selection.
+        // Merged batch tools process all the selected objects in that instance's first input, packing each
+        // object keeps them as separate pieces so the asset is only instantiated, fed and cooked once.
         AActor* CreatedActor = Factory->CreateActor( AssetObj, GEditor->GetEditorWorldContext().World()->GetCurrentLevel(), SpawnTransform );
         if ( !CreatedActor )
             return;
@@ -395,7 +400,10 @@ SHoudiniToolPalette::InstantiateHoudiniTool( FHoudiniTool* HoudiniTool )
 
                 // Set the input preset on the HoudiniAssetComponent
                 if ( InputPresets.Num() > 0 )
-                    HoudiniAssetComponent->SetHoudiniToolInputPresets( InputPresets );
+                {
+                    HoudiniAssetComponent->SetHoudiniToolInputPresets(
+                        InputPresets, HoudiniTool->Type == EHoudiniToolType::HTOOLTYPE_OPERATOR_BATCH_MERGED );
+                }
             }
         }
 
@@ -161,7 +161,8 @@ public class HoudiniEngineRuntime : ModuleRules
                 "InputCore",
                 "RHI",
                 "Foliage",
-                "Landscape"
+                "Landscape",
+                "ProceduralMeshComponent"
              }
         );
 
@@ -0,0 +1,1630 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+#include "HoudiniApi.h"
+#include "HoudiniApiRecorder.h"
+#include "HoudiniEngineRuntimePrivatePCH.h"
+#include "HoudiniEngine.h"
+
+#include "ScopeLock.h"
+#include "Misc/Crc.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "HAL/IConsoleManager.h"
+
+const uint32
+FHoudiniApiRecorder::FileMagic = 0x52504148u; // HAPR
+
+const uint32
+FHoudiniApiRecorder::FileVersion = 4u;
+
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 22
+#define HOUDINI_API_RECORDING_COMPRESSION NAME_Zlib
+#else
+#define HOUDINI_API_RECORDING_COMPRESSION COMPRESS_ZLIB
+#endif
+
+FCriticalSection
+FHoudiniApiRecorder::CriticalSection;
+
+EHoudiniApiRecorderMode::Type
+FHoudiniApiRecorder::Mode = EHoudiniApiRecorderMode::Disabled;
+
+FString
+FHoudiniApiRecorder::RecordingFilePath;
+
+TArray< FHoudiniApiCallRecord >
+FHoudiniApiRecorder::Records;
+
+TMap< uint64, TArray< int32 > >
+FHoudiniApiRecorder::ReplayIndices;
+
+TMap< uint64, int32 >
+FHoudiniApiRecorder::ReplayCursors;
+
+int32
+FHoudiniApiRecorder::ReplayMisses = 0;
+
+HAPI_Session
+FHoudiniApiRecorder::ReplaySession = { HAPI_SESSION_INPROCESS, 0 };
+
+bool
+FHoudiniApiRecorder::bReplaySessionOnly = false;
+
+int32
+FHoudiniApiRecorder::TableInstallCount = 0;
+
+bool
+FHoudiniApiRecorder::bSnapshotsEnabled = false;
+
+uint32
+FHoudiniApiRecorder::CaptureTlsSlot = 0xFFFFFFFF;
+
+uint32
+FHoudiniApiRecorder::ServeTlsSlot = 0xFFFFFFFF;
+
+/** FHoudiniApi entries which were active before the recorder was installed. **/
+struct FHoudiniApiRecordedTable
+{
+#define HOUDINI_API_RECORDED_FUNCTION_POINTER( FunctionName ) FHoudiniApi::FunctionName##FuncPtr FunctionName;
+    HOUDINI_API_RECORDED_FUNCTIONS( HOUDINI_API_RECORDED_FUNCTION_POINTER )
+#undef HOUDINI_API_RECORDED_FUNCTION_POINTER
+};
+
+static FHoudiniApiRecordedTable HoudiniApiRecordedTable;
+
+/** Version of HAPI the recordings are made with and can be replayed with. **/
+static uint32
+HoudiniApiRecordingHapiVersion()
+{
+    return HAPI_VERSION_HOUDINI_ENGINE_MAJOR * 10000 + HAPI_VERSION_HOUDINI_ENGINE_MINOR * 100 +
+        HAPI_VERSION_HOUDINI_ENGINE_API;
+}
+
+static uint64
+HoudiniApiRecordKey( uint16 Function, uint32 ArgumentHash )
+{
+    return ( static_cast< uint64 >( Function ) << 32 ) | static_cast< uint64 >( ArgumentHash );
+}
+
+FHoudiniApiCallRecord::FHoudiniApiCallRecord()
+    : Function( EHoudiniApiRecordedFunction::Count )
+    , ArgumentHash( 0u )
+    , Result( HAPI_RESULT_FAILURE )
+{}
+
+FHoudiniApiSnapshot::FHoudiniApiSnapshot()
+    : PayloadSize( 0 )
+{}
+
+const FHoudiniApiCallRecord *
+FHoudiniApiSnapshot::Find( uint16 Function, uint32 ArgumentHash ) const
+{
+    return Records.Find( HoudiniApiRecordKey( Function, ArgumentHash ) );
+}
+
+void
+FHoudiniApiSnapshot::Add( const FHoudiniApiCallRecord & Record )
+{
+    FHoudiniApiCallRecord & StoredRecord = Records.FindOrAdd( HoudiniApiRecordKey( Record.Function, Record.ArgumentHash ) );
+    PayloadSize += Record.Payload.Num() - StoredRecord.Payload.Num();
+    StoredRecord = Record;
+}
+
+int32
+FHoudiniApiSnapshot::Num() const
+{
+    return Records.Num();
+}
+
+int32
+FHoudiniApiSnapshot::GetPayloadSize() const
+{
+    return PayloadSize;
+}
+
+FHoudiniApiScopedSnapshot::FHoudiniApiScopedSnapshot(
+    const TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > & InSnapshot )
+    : PreviousSnapshot( nullptr )
+{
+    if ( !InSnapshot.IsValid() || !FHoudiniApiRecorder::AreSnapshotsEnabled() )
+        return;
+
+    Snapshot = InSnapshot;
+    PreviousSnapshot = FHoudiniApiRecorder::GetServedSnapshot();
+    FPlatformTLS::SetTlsValue( FHoudiniApiRecorder::ServeTlsSlot, (void *) Snapshot.Get() );
+}
+
+FHoudiniApiScopedSnapshot::~FHoudiniApiScopedSnapshot()
+{
+    if ( Snapshot.IsValid() )
+        FPlatformTLS::SetTlsValue( FHoudiniApiRecorder::ServeTlsSlot, (void *) PreviousSnapshot );
+}
+
+void
+FHoudiniApiCallRecord::AddArgument( const char * Value )
+{
+    if ( Value )
+        ArgumentHash = FCrc::MemCrc32( Value, FCStringAnsi::Strlen( Value ), ArgumentHash );
+}
+
+FArchive &
+operator<<( FArchive & Ar, FHoudiniApiCallRecord & Record )
+{
+    Ar << Record.Function;
+    Ar << Record.ArgumentHash;
+    Ar << Record.Result;
+    Ar << Record.Payload;
+    return Ar;
+}
+
+/** Helper used by the recorded entries, either forwards a call to HAPI and logs it, or serves it from a recording **/
+/** or from a snapshot captured by another thread.                                                                   **/
+class FHoudiniApiCall
+{
+    public:
+
+        FHoudiniApiCall( EHoudiniApiRecordedFunction::Type Function, const HAPI_Session * Session )
+            : bReplaying( FHoudiniApiRecorder::IsReplaying( Session ) )
+            , bLogging( false )
+            , bFound( false )
+            , ReadOffset( 0 )
+        {
+            Record.Function = Function;
+
+            // Calls are only hashed and their buffers copied when something will consume the record.
+            bLogging = bReplaying
+                || FHoudiniApiRecorder::GetMode() == EHoudiniApiRecorderMode::Recording
+                || FHoudiniApiRecorder::GetCaptureSnapshot()
+                || FHoudiniApiRecorder::GetServedSnapshot();
+        }
+
+        /** Hash an input argument. **/
+        template< typename TArgument >
+        FHoudiniApiCall & Argument( const TArgument & Value )
+        {
+            if ( bLogging )
+                Record.AddArgument( Value );
+
+            return *this;
+        }
+
+        /** Return true if call needs to be forwarded to HAPI, otherwise response is fetched from the recording. **/
+        bool Forward()
+        {
+            if ( !bLogging )
+                return true;
+
+            if ( !bReplaying )
+            {
+                // Calls which were not captured by the snapshot still go to HAPI.
+                const FHoudiniApiSnapshot * Snapshot = FHoudiniApiRecorder::GetServedSnapshot();
+                const FHoudiniApiCallRecord * SnapshotRecord =
+                    Snapshot ? Snapshot->Find( Record.Function, Record.ArgumentHash ) : nullptr;
+
+                if ( !SnapshotRecord )
+                    return true;
+
+                Record = *SnapshotRecord;
+                bReplaying = true;
+                bFound = true;
+                return false;
+            }
+
+            bFound = FHoudiniApiRecorder::FindRecord( Record.Function, Record.ArgumentHash, Record );
+            if ( !bFound )
+                Record.Result = HAPI_RESULT_FAILURE;
+
+            return false;
+        }
+
+        /** Store the result HAPI returned. **/
+        void SetResult( HAPI_Result Result )
+        {
+            Record.Result = Result;
+        }
+
+        /** Log or restore a buffer written by HAPI. **/
+        template< typename TOutput >
+        FHoudiniApiCall & Output( TOutput * Buffer, int32 Count )
+        {
+            int32 ByteCount = ( Buffer && Count > 0 ) ? Count * sizeof( TOutput ) : 0;
+
+            if ( bReplaying )
+            {
+                if ( !bFound || ReadOffset + (int32) sizeof( int32 ) > Record.Payload.Num() )
+                    return *this;
+
+                int32 RecordedByteCount = 0;
+                FMemory::Memcpy( &RecordedByteCount, Record.Payload.GetData() + ReadOffset, sizeof( int32 ) );
+                ReadOffset += sizeof( int32 );
+
+                int32 CopyByteCount = FMath::Min( ByteCount, RecordedByteCount );
+                if ( CopyByteCount > 0 && ReadOffset + CopyByteCount <= Record.Payload.Num() )
+                    FMemory::Memcpy( Buffer, Record.Payload.GetData() + ReadOffset, CopyByteCount );
+
+                ReadOffset += RecordedByteCount;
+            }
+            else if ( bLogging )
+            {
+                // Buffers are undefined if HAPI call has failed, there is no need to store them.
+                Record.AddOutput( Buffer, Record.Result == HAPI_RESULT_SUCCESS ? Count : 0 );
+            }
+
+            return *this;
+        }
+
+        /** Complete the call and return the result to the caller. **/
+        HAPI_Result Finish()
+        {
+            if ( bLogging && !bReplaying )
+            {
+                FHoudiniApiSnapshot * Snapshot = FHoudiniApiRecorder::GetCaptureSnapshot();
+                if ( Snapshot && Record.Result == HAPI_RESULT_SUCCESS )
+                    Snapshot->Add( Record );
+
+                // Only lock the recording when there is one, snapshots alone must not serialize all HAPI calls.
+                if ( FHoudiniApiRecorder::GetMode() == EHoudiniApiRecorderMode::Recording )
+                    FHoudiniApiRecorder::AddRecord( Record );
+            }
+
+            return static_cast< HAPI_Result >( Record.Result );
+        }
+
+    protected:
+
+        /** Record being built or replayed. **/
+        FHoudiniApiCallRecord Record;
+
+        /** Is set when serving the call from a recording. **/
+        bool bReplaying;
+
+        /** Is set when the call is recorded, captured or served, otherwise it is only forwarded to HAPI. **/
+        bool bLogging;
+
+        /** Is set when recorded response has been located. **/
+        bool bFound;
+
+        /** Read position within the replayed payload. **/
+        int32 ReadOffset;
+};
+
+/** FHoudiniApi entries installed while recording or replaying. **/
+struct FHoudiniApiRecordedCalls
+{
+    // Session entries are answered by the recorder while replaying, there is no libHAPI to create or initialize.
+
+    static HAPI_Result IsInitialized( const HAPI_Session * session )
+    {
+        if ( FHoudiniApiRecorder::IsReplaying( session ) )
+            return HAPI_RESULT_SUCCESS;
+
+        return HoudiniApiRecordedTable.IsInitialized( session );
+    }
+
+    static HAPI_Result IsSessionValid( const HAPI_Session * session )
+    {
+        if ( FHoudiniApiRecorder::IsReplaying( session ) )
+            return HAPI_RESULT_SUCCESS;
+
+        return HoudiniApiRecordedTable.IsSessionValid( session );
+    }
+
+    static HAPI_Result CreateInProcessSession( HAPI_Session * session )
+    {
+        if ( FHoudiniApiRecorder::IsReplaying( nullptr ) )
+        {
+            *session = FHoudiniApiRecorder::GetReplaySession();
+            return HAPI_RESULT_SUCCESS;
+        }
+
+        return HoudiniApiRecordedTable.CreateInProcessSession( session );
+    }
+
+    static HAPI_Result CreateThriftSocketSession( HAPI_Session * session, const char * host_name, int port )
+    {
+        if ( FHoudiniApiRecorder::IsReplaying( nullptr ) )
+        {
+            *session = FHoudiniApiRecorder::GetReplaySession();
+            return HAPI_RESULT_SUCCESS;
+        }
+
+        return HoudiniApiRecordedTable.CreateThriftSocketSession( session, host_name, port );
+    }
+
+    static HAPI_Result CreateThriftNamedPipeSession( HAPI_Session * session, const char * pipe_name )
+    {
+        if ( FHoudiniApiRecorder::IsReplaying( nullptr ) )
+        {
+            *session = FHoudiniApiRecorder::GetReplaySession();
+            return HAPI_RESULT_SUCCESS;
+        }
+
+        return HoudiniApiRecordedTable.CreateThriftNamedPipeSession( session, pipe_name );
+    }
+
+    static HAPI_Result Initialize(
+        const HAPI_Session * session, const HAPI_CookOptions * cook_options, HAPI_Bool use_cooking_thread,
+        int cooking_thread_stack_size, const char * houdini_environment_files, const char * otl_search_path,
+        const char * dso_search_path, const char * image_dso_search_path, const char * audio_dso_search_path )
+    {
+        if ( FHoudiniApiRecorder::IsReplaying( session ) )
+            return HAPI_RESULT_SUCCESS;
+
+        return HoudiniApiRecordedTable.Initialize(
+            session, cook_options, use_cooking_thread, cooking_thread_stack_size, houdini_environment_files,
+            otl_search_path, dso_search_path, image_dso_search_path, audio_dso_search_path );
+    }
+
+    static HAPI_Result Cleanup( const HAPI_Session * session )
+    {
+        if ( FHoudiniApiRecorder::IsReplaying( session ) )
+            return HAPI_RESULT_SUCCESS;
+
+        return HoudiniApiRecordedTable.Cleanup( session );
+    }
+
+    static HAPI_Result CloseSession( const HAPI_Session * session )
+    {
+        if ( FHoudiniApiRecorder::IsReplaying( session ) )
+            return HAPI_RESULT_SUCCESS;
+
+        return HoudiniApiRecordedTable.CloseSession( session );
+    }
+
+    static HAPI_Result GetSessionEnvInt( const HAPI_Session * session, HAPI_SessionEnvIntType int_type, int * value )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetSessionEnvInt, session );
+        Call.Argument( int_type );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetSessionEnvInt( session, int_type, value ) );
+
+        Call.Output( value, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result LoadAssetLibraryFromFile(
+        const HAPI_Session * session, const char * file_path, HAPI_Bool allow_overwrite, HAPI_AssetLibraryId * library_id )
+    {
+        // Library paths differ between machines, libraries are served in the order they were loaded.
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::LoadAssetLibraryFromFile, session );
+        Call.Argument( allow_overwrite );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.LoadAssetLibraryFromFile( session, file_path, allow_overwrite, library_id ) );
+
+        Call.Output( library_id, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result LoadAssetLibraryFromMemory(
+        const HAPI_Session * session, const char * library_buffer, int library_buffer_length,
+        HAPI_Bool allow_overwrite, HAPI_AssetLibraryId * library_id )
+    {
+        // Libraries are matched by size, hashing the whole library on every load is not worth it.
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::LoadAssetLibraryFromMemory, session );
+        Call.Argument( library_buffer_length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.LoadAssetLibraryFromMemory(
+                session, library_buffer, library_buffer_length, allow_overwrite, library_id ) );
+        }
+
+        Call.Output( library_id, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetAvailableAssetCount( const HAPI_Session * session, HAPI_AssetLibraryId library_id, int * asset_count )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetAvailableAssetCount, session );
+        Call.Argument( library_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetAvailableAssetCount( session, library_id, asset_count ) );
+
+        Call.Output( asset_count, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetAvailableAssets(
+        const HAPI_Session * session, HAPI_AssetLibraryId library_id, HAPI_StringHandle * asset_names_array, int asset_count )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetAvailableAssets, session );
+        Call.Argument( library_id ).Argument( asset_count );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetAvailableAssets( session, library_id, asset_names_array, asset_count ) );
+
+        Call.Output( asset_names_array, asset_count );
+        return Call.Finish();
+    }
+
+    static HAPI_Result CreateNode(
+        const HAPI_Session * session, HAPI_NodeId parent_node_id, const char * operator_name, const char * node_label,
+        HAPI_Bool cook_on_creation, HAPI_NodeId * new_node_id )
+    {
+        // Labels carry actor names, which differ between sessions.
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::CreateNode, session );
+        Call.Argument( parent_node_id ).Argument( operator_name ).Argument( cook_on_creation );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.CreateNode(
+                session, parent_node_id, operator_name, node_label, cook_on_creation, new_node_id ) );
+        }
+
+        Call.Output( new_node_id, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result DeleteNode( const HAPI_Session * session, HAPI_NodeId node_id )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::DeleteNode, session );
+        Call.Argument( node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.DeleteNode( session, node_id ) );
+
+        return Call.Finish();
+    }
+
+    static HAPI_Result IsNodeValid( const HAPI_Session * session, HAPI_NodeId node_id, int unique_node_id, HAPI_Bool * answer )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::IsNodeValid, session );
+        Call.Argument( node_id ).Argument( unique_node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.IsNodeValid( session, node_id, unique_node_id, answer ) );
+
+        Call.Output( answer, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetNodePath(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_NodeId relative_to_node_id, HAPI_StringHandle * path )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetNodePath, session );
+        Call.Argument( node_id ).Argument( relative_to_node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetNodePath( session, node_id, relative_to_node_id, path ) );
+
+        Call.Output( path, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetParameters(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_ParmInfo * parm_infos_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetParameters, session );
+        Call.Argument( node_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetParameters( session, node_id, parm_infos_array, start, length ) );
+
+        Call.Output( parm_infos_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetParmInfo(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_ParmId parm_id, HAPI_ParmInfo * parm_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetParmInfo, session );
+        Call.Argument( node_id ).Argument( parm_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetParmInfo( session, node_id, parm_id, parm_info ) );
+
+        Call.Output( parm_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetParmIdFromName(
+        const HAPI_Session * session, HAPI_NodeId node_id, const char * parm_name, HAPI_ParmId * parm_id )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetParmIdFromName, session );
+        Call.Argument( node_id ).Argument( parm_name );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetParmIdFromName( session, node_id, parm_name, parm_id ) );
+
+        Call.Output( parm_id, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetParmIntValues(
+        const HAPI_Session * session, HAPI_NodeId node_id, int * values_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetParmIntValues, session );
+        Call.Argument( node_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetParmIntValues( session, node_id, values_array, start, length ) );
+
+        Call.Output( values_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetParmFloatValues(
+        const HAPI_Session * session, HAPI_NodeId node_id, float * values_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetParmFloatValues, session );
+        Call.Argument( node_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetParmFloatValues( session, node_id, values_array, start, length ) );
+
+        Call.Output( values_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetParmStringValues(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_Bool evaluate,
+        HAPI_StringHandle * values_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetParmStringValues, session );
+        Call.Argument( node_id ).Argument( evaluate ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetParmStringValues(
+                session, node_id, evaluate, values_array, start, length ) );
+        }
+
+        Call.Output( values_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetParmChoiceLists(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_ParmChoiceInfo * parm_choices_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetParmChoiceLists, session );
+        Call.Argument( node_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetParmChoiceLists( session, node_id, parm_choices_array, start, length ) );
+
+        Call.Output( parm_choices_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetParmTagValue(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_ParmId parm_id, const char * tag_name,
+        HAPI_StringHandle * tag_value )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetParmTagValue, session );
+        Call.Argument( node_id ).Argument( parm_id ).Argument( tag_name );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetParmTagValue( session, node_id, parm_id, tag_name, tag_value ) );
+
+        Call.Output( tag_value, 1 );
+        return Call.Finish();
+    }
+
+    // Parameter values are not part of the argument hash, edits made while replaying are served the recorded results.
+
+    static HAPI_Result SetParmIntValue(
+        const HAPI_Session * session, HAPI_NodeId node_id, const char * parm_name, int index, int value )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::SetParmIntValue, session );
+        Call.Argument( node_id ).Argument( parm_name ).Argument( index );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.SetParmIntValue( session, node_id, parm_name, index, value ) );
+
+        return Call.Finish();
+    }
+
+    static HAPI_Result SetParmIntValues(
+        const HAPI_Session * session, HAPI_NodeId node_id, const int * values_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::SetParmIntValues, session );
+        Call.Argument( node_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.SetParmIntValues( session, node_id, values_array, start, length ) );
+
+        return Call.Finish();
+    }
+
+    static HAPI_Result SetParmFloatValues(
+        const HAPI_Session * session, HAPI_NodeId node_id, const float * values_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::SetParmFloatValues, session );
+        Call.Argument( node_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.SetParmFloatValues( session, node_id, values_array, start, length ) );
+
+        return Call.Finish();
+    }
+
+    static HAPI_Result SetParmStringValue(
+        const HAPI_Session * session, HAPI_NodeId node_id, const char * value, HAPI_ParmId parm_id, int index )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::SetParmStringValue, session );
+        Call.Argument( node_id ).Argument( parm_id ).Argument( index );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.SetParmStringValue( session, node_id, value, parm_id, index ) );
+
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetPresetBufLength(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PresetType preset_type, const char * preset_name,
+        int * buffer_length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetPresetBufLength, session );
+        Call.Argument( node_id ).Argument( preset_type ).Argument( preset_name );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetPresetBufLength( session, node_id, preset_type, preset_name, buffer_length ) );
+
+        Call.Output( buffer_length, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetPreset( const HAPI_Session * session, HAPI_NodeId node_id, char * buffer, int buffer_length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetPreset, session );
+        Call.Argument( node_id ).Argument( buffer_length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetPreset( session, node_id, buffer, buffer_length ) );
+
+        Call.Output( buffer, buffer_length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result SetPreset(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PresetType preset_type, const char * preset_name,
+        const char * buffer, int buffer_length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::SetPreset, session );
+        Call.Argument( node_id ).Argument( preset_type ).Argument( preset_name ).Argument( buffer_length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.SetPreset(
+                session, node_id, preset_type, preset_name, buffer, buffer_length ) );
+        }
+
+        return Call.Finish();
+    }
+
+    static HAPI_Result CookNode( const HAPI_Session * session, HAPI_NodeId node_id, const HAPI_CookOptions * cook_options )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::CookNode, session );
+        Call.Argument( node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.CookNode( session, node_id, cook_options ) );
+
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetStatus( const HAPI_Session * session, HAPI_StatusType status_type, int * status )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetStatus, session );
+        Call.Argument( status_type );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetStatus( session, status_type, status ) );
+
+        Call.Output( status, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetStatusStringBufLength(
+        const HAPI_Session * session, HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity, int * buffer_length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetStatusStringBufLength, session );
+        Call.Argument( status_type ).Argument( verbosity );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetStatusStringBufLength( session, status_type, verbosity, buffer_length ) );
+
+        Call.Output( buffer_length, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetStatusString(
+        const HAPI_Session * session, HAPI_StatusType status_type, char * string_value, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetStatusString, session );
+        Call.Argument( status_type ).Argument( length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetStatusString( session, status_type, string_value, length ) );
+
+        Call.Output( string_value, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetAssetInfo( const HAPI_Session * session, HAPI_NodeId node_id, HAPI_AssetInfo * asset_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetAssetInfo, session );
+        Call.Argument( node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetAssetInfo( session, node_id, asset_info ) );
+
+        Call.Output( asset_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetNodeInfo( const HAPI_Session * session, HAPI_NodeId node_id, HAPI_NodeInfo * node_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetNodeInfo, session );
+        Call.Argument( node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetNodeInfo( session, node_id, node_info ) );
+
+        Call.Output( node_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetObjectInfo( const HAPI_Session * session, HAPI_NodeId node_id, HAPI_ObjectInfo * object_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetObjectInfo, session );
+        Call.Argument( node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetObjectInfo( session, node_id, object_info ) );
+
+        Call.Output( object_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result ComposeObjectList(
+        const HAPI_Session * session, HAPI_NodeId parent_node_id, const char * categories, int * object_count )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::ComposeObjectList, session );
+        Call.Argument( parent_node_id ).Argument( categories );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.ComposeObjectList( session, parent_node_id, categories, object_count ) );
+
+        Call.Output( object_count, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetComposedObjectList(
+        const HAPI_Session * session, HAPI_NodeId parent_node_id, HAPI_ObjectInfo * object_infos_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetComposedObjectList, session );
+        Call.Argument( parent_node_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetComposedObjectList(
+                session, parent_node_id, object_infos_array, start, length ) );
+        }
+
+        Call.Output( object_infos_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetComposedObjectTransforms(
+        const HAPI_Session * session, HAPI_NodeId parent_node_id, HAPI_RSTOrder rst_order,
+        HAPI_Transform * transform_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetComposedObjectTransforms, session );
+        Call.Argument( parent_node_id ).Argument( rst_order ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetComposedObjectTransforms(
+                session, parent_node_id, rst_order, transform_array, start, length ) );
+        }
+
+        Call.Output( transform_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetObjectTransform(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_NodeId relative_to_node_id,
+        HAPI_RSTOrder rst_order, HAPI_Transform * transform )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetObjectTransform, session );
+        Call.Argument( node_id ).Argument( relative_to_node_id ).Argument( rst_order );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetObjectTransform(
+                session, node_id, relative_to_node_id, rst_order, transform ) );
+        }
+
+        Call.Output( transform, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetGeoInfo( const HAPI_Session * session, HAPI_NodeId node_id, HAPI_GeoInfo * geo_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetGeoInfo, session );
+        Call.Argument( node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetGeoInfo( session, node_id, geo_info ) );
+
+        Call.Output( geo_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetDisplayGeoInfo( const HAPI_Session * session, HAPI_NodeId object_node_id, HAPI_GeoInfo * geo_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetDisplayGeoInfo, session );
+        Call.Argument( object_node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetDisplayGeoInfo( session, object_node_id, geo_info ) );
+
+        Call.Output( geo_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetPartInfo(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, HAPI_PartInfo * part_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetPartInfo, session );
+        Call.Argument( node_id ).Argument( part_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetPartInfo( session, node_id, part_id, part_info ) );
+
+        Call.Output( part_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetVertexList(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id,
+        int * vertex_list_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetVertexList, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetVertexList(
+                session, node_id, part_id, vertex_list_array, start, length ) );
+        }
+
+        Call.Output( vertex_list_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetFaceCounts(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id,
+        int * face_counts_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetFaceCounts, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetFaceCounts(
+                session, node_id, part_id, face_counts_array, start, length ) );
+        }
+
+        Call.Output( face_counts_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetAttributeInfo(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, const char * name,
+        HAPI_AttributeOwner owner, HAPI_AttributeInfo * attr_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetAttributeInfo, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( name ).Argument( owner );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetAttributeInfo( session, node_id, part_id, name, owner, attr_info ) );
+
+        Call.Output( attr_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetAttributeNames(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, HAPI_AttributeOwner owner,
+        HAPI_StringHandle * attribute_names_array, int count )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetAttributeNames, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( owner ).Argument( count );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetAttributeNames(
+                session, node_id, part_id, owner, attribute_names_array, count ) );
+        }
+
+        Call.Output( attribute_names_array, count );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetAttributeFloatData(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, const char * name,
+        HAPI_AttributeInfo * attr_info, int stride, float * data_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetAttributeFloatData, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( name ).Argument( stride ).Argument( start ).Argument( length );
+        Call.Argument( attr_info ? attr_info->owner : HAPI_ATTROWNER_INVALID ).Argument( attr_info ? attr_info->tupleSize : 0 );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetAttributeFloatData(
+                session, node_id, part_id, name, attr_info, stride, data_array, start, length ) );
+        }
+
+        Call.Output( attr_info, 1 );
+        Call.Output( data_array, length * ( stride > 0 ? stride : ( attr_info ? attr_info->tupleSize : 0 ) ) );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetAttributeIntData(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, const char * name,
+        HAPI_AttributeInfo * attr_info, int stride, int * data_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetAttributeIntData, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( name ).Argument( stride ).Argument( start ).Argument( length );
+        Call.Argument( attr_info ? attr_info->owner : HAPI_ATTROWNER_INVALID ).Argument( attr_info ? attr_info->tupleSize : 0 );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetAttributeIntData(
+                session, node_id, part_id, name, attr_info, stride, data_array, start, length ) );
+        }
+
+        Call.Output( attr_info, 1 );
+        Call.Output( data_array, length * ( stride > 0 ? stride : ( attr_info ? attr_info->tupleSize : 0 ) ) );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetAttributeStringData(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, const char * name,
+        HAPI_AttributeInfo * attr_info, HAPI_StringHandle * data_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetAttributeStringData, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( name ).Argument( start ).Argument( length );
+        Call.Argument( attr_info ? attr_info->owner : HAPI_ATTROWNER_INVALID );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetAttributeStringData(
+                session, node_id, part_id, name, attr_info, data_array, start, length ) );
+        }
+
+        Call.Output( attr_info, 1 );
+        Call.Output( data_array, length * ( attr_info ? attr_info->tupleSize : 0 ) );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetStringBufLength( const HAPI_Session * session, HAPI_StringHandle string_handle, int * buffer_length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetStringBufLength, session );
+        Call.Argument( string_handle );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetStringBufLength( session, string_handle, buffer_length ) );
+
+        Call.Output( buffer_length, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetString( const HAPI_Session * session, HAPI_StringHandle string_handle, char * string_value, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetString, session );
+        Call.Argument( string_handle ).Argument( length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetString( session, string_handle, string_value, length ) );
+
+        Call.Output( string_value, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetGroupNames(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_GroupType group_type,
+        HAPI_StringHandle * group_names_array, int group_count )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetGroupNames, session );
+        Call.Argument( node_id ).Argument( group_type ).Argument( group_count );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetGroupNames(
+                session, node_id, group_type, group_names_array, group_count ) );
+        }
+
+        Call.Output( group_names_array, group_count );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetGroupMembership(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, HAPI_GroupType group_type,
+        const char * group_name, HAPI_Bool * membership_array_all_equal, int * membership_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetGroupMembership, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( group_type ).Argument( group_name );
+        Call.Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetGroupMembership(
+                session, node_id, part_id, group_type, group_name,
+                membership_array_all_equal, membership_array, start, length ) );
+        }
+
+        Call.Output( membership_array_all_equal, 1 );
+        Call.Output( membership_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetGroupNamesOnPackedInstancePart(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, HAPI_GroupType group_type,
+        HAPI_StringHandle * group_names_array, int group_count )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetGroupNamesOnPackedInstancePart, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( group_type ).Argument( group_count );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetGroupNamesOnPackedInstancePart(
+                session, node_id, part_id, group_type, group_names_array, group_count ) );
+        }
+
+        Call.Output( group_names_array, group_count );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetGroupMembershipOnPackedInstancePart(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, HAPI_GroupType group_type,
+        const char * group_name, HAPI_Bool * membership_array_all_equal, int * membership_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetGroupMembershipOnPackedInstancePart, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( group_type ).Argument( group_name );
+        Call.Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetGroupMembershipOnPackedInstancePart(
+                session, node_id, part_id, group_type, group_name,
+                membership_array_all_equal, membership_array, start, length ) );
+        }
+
+        Call.Output( membership_array_all_equal, 1 );
+        Call.Output( membership_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetMaterialNodeIdsOnFaces(
+        const HAPI_Session * session, HAPI_NodeId geometry_node_id, HAPI_PartId part_id,
+        HAPI_Bool * are_all_the_same, HAPI_NodeId * material_ids_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetMaterialNodeIdsOnFaces, session );
+        Call.Argument( geometry_node_id ).Argument( part_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetMaterialNodeIdsOnFaces(
+                session, geometry_node_id, part_id, are_all_the_same, material_ids_array, start, length ) );
+        }
+
+        Call.Output( are_all_the_same, 1 );
+        Call.Output( material_ids_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetMaterialInfo( const HAPI_Session * session, HAPI_NodeId material_node_id, HAPI_MaterialInfo * material_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetMaterialInfo, session );
+        Call.Argument( material_node_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetMaterialInfo( session, material_node_id, material_info ) );
+
+        Call.Output( material_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetInstancerPartTransforms(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, HAPI_RSTOrder rst_order,
+        HAPI_Transform * transforms_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetInstancerPartTransforms, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( rst_order ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetInstancerPartTransforms(
+                session, node_id, part_id, rst_order, transforms_array, start, length ) );
+        }
+
+        Call.Output( transforms_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetInstancedPartIds(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id,
+        HAPI_PartId * instanced_parts_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetInstancedPartIds, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetInstancedPartIds(
+                session, node_id, part_id, instanced_parts_array, start, length ) );
+        }
+
+        Call.Output( instanced_parts_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetInstanceTransforms(
+        const HAPI_Session * session, HAPI_NodeId object_node_id, HAPI_RSTOrder rst_order,
+        HAPI_Transform * transforms_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetInstanceTransforms, session );
+        Call.Argument( object_node_id ).Argument( rst_order ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetInstanceTransforms(
+                session, object_node_id, rst_order, transforms_array, start, length ) );
+        }
+
+        Call.Output( transforms_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetCurveInfo( const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, HAPI_CurveInfo * info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetCurveInfo, session );
+        Call.Argument( node_id ).Argument( part_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetCurveInfo( session, node_id, part_id, info ) );
+
+        Call.Output( info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetCurveCounts(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, int * counts_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetCurveCounts, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetCurveCounts( session, node_id, part_id, counts_array, start, length ) );
+
+        Call.Output( counts_array, length );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetVolumeInfo(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, HAPI_VolumeInfo * volume_info )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetVolumeInfo, session );
+        Call.Argument( node_id ).Argument( part_id );
+        if ( Call.Forward() )
+            Call.SetResult( HoudiniApiRecordedTable.GetVolumeInfo( session, node_id, part_id, volume_info ) );
+
+        Call.Output( volume_info, 1 );
+        return Call.Finish();
+    }
+
+    static HAPI_Result GetHeightFieldData(
+        const HAPI_Session * session, HAPI_NodeId node_id, HAPI_PartId part_id, float * values_array, int start, int length )
+    {
+        FHoudiniApiCall Call( EHoudiniApiRecordedFunction::GetHeightFieldData, session );
+        Call.Argument( node_id ).Argument( part_id ).Argument( start ).Argument( length );
+        if ( Call.Forward() )
+        {
+            Call.SetResult( HoudiniApiRecordedTable.GetHeightFieldData(
+                session, node_id, part_id, values_array, start, length ) );
+        }
+
+        Call.Output( values_array, length );
+        return Call.Finish();
+    }
+};
+
+void
+FHoudiniApiRecorder::InstallTable()
+{
+    // Recording, replaying and snapshots may be active at the same time, only the first one swaps the entries.
+    if ( TableInstallCount++ > 0 )
+        return;
+
+#define HOUDINI_API_RECORDED_FUNCTION_INSTALL( FunctionName ) \
+    HoudiniApiRecordedTable.FunctionName = FHoudiniApi::FunctionName; \
+    FHoudiniApi::FunctionName = &FHoudiniApiRecordedCalls::FunctionName;
+
+    HOUDINI_API_RECORDED_FUNCTIONS( HOUDINI_API_RECORDED_FUNCTION_INSTALL )
+
+#undef HOUDINI_API_RECORDED_FUNCTION_INSTALL
+}
+
+void
+FHoudiniApiRecorder::RestoreTable()
+{
+    if ( TableInstallCount == 0 || --TableInstallCount > 0 )
+        return;
+
+#define HOUDINI_API_RECORDED_FUNCTION_RESTORE( FunctionName ) \
+    FHoudiniApi::FunctionName = HoudiniApiRecordedTable.FunctionName;
+
+    HOUDINI_API_RECORDED_FUNCTIONS( HOUDINI_API_RECORDED_FUNCTION_RESTORE )
+
+#undef HOUDINI_API_RECORDED_FUNCTION_RESTORE
+}
+
+bool
+FHoudiniApiRecorder::StartRecording( const FString & FilePath )
+{
+    FScopeLock ScopeLock( &CriticalSection );
+
+    if ( Mode != EHoudiniApiRecorderMode::Disabled )
+    {
+        HOUDINI_LOG_WARNING( TEXT( "HAPI recorder is already active, unable to start recording to %s." ), *FilePath );
+        return false;
+    }
+
+    if ( !FHoudiniApi::IsHAPIInitialized() )
+    {
+        HOUDINI_LOG_WARNING( TEXT( "HAPI is not initialized, unable to start recording to %s." ), *FilePath );
+        return false;
+    }
+
+    Records.Empty();
+    RecordingFilePath = FilePath;
+
+    InstallTable();
+    Mode = EHoudiniApiRecorderMode::Recording;
+
+    HOUDINI_LOG_MESSAGE( TEXT( "Started recording HAPI calls to %s." ), *FilePath );
+    return true;
+}
+
+bool
+FHoudiniApiRecorder::StopRecording()
+{
+    FScopeLock ScopeLock( &CriticalSection );
+
+    if ( Mode != EHoudiniApiRecorderMode::Recording )
+        return false;
+
+    RestoreTable();
+    Mode = EHoudiniApiRecorderMode::Disabled;
+
+    bool bSaved = SaveRecording( RecordingFilePath, Records );
+    Records.Empty();
+    return bSaved;
+}
+
+bool
+FHoudiniApiRecorder::SaveRecording( const FString & FilePath, const TArray< FHoudiniApiCallRecord > & CallRecords )
+{
+    TArray< uint8 > RecordBuffer;
+    FMemoryWriter RecordWriter( RecordBuffer );
+    RecordWriter << const_cast< TArray< FHoudiniApiCallRecord > & >( CallRecords );
+
+    // Records are mostly geometry and attribute buffers, they compress well.
+    int32 UncompressedSize = RecordBuffer.Num();
+    int32 CompressedSize = FCompression::CompressMemoryBound( HOUDINI_API_RECORDING_COMPRESSION, UncompressedSize );
+
+    TArray< uint8 > CompressedBuffer;
+    CompressedBuffer.SetNumUninitialized( CompressedSize );
+    if ( !FCompression::CompressMemory(
+        HOUDINI_API_RECORDING_COMPRESSION, CompressedBuffer.GetData(), CompressedSize,
+        RecordBuffer.GetData(), UncompressedSize ) )
+    {
+        HOUDINI_LOG_ERROR( TEXT( "Failed compressing HAPI recording %s." ), *FilePath );
+        return false;
+    }
+
+    TArray< uint8 > Buffer;
+    FMemoryWriter Writer( Buffer );
+
+    uint32 Magic = FileMagic;
+    uint32 Version = FileVersion;
+    uint32 HapiVersion = HoudiniApiRecordingHapiVersion();
+
+    Writer << Magic;
+    Writer << Version;
+    Writer << HapiVersion;
+    Writer << UncompressedSize;
+    Writer.Serialize( CompressedBuffer.GetData(), CompressedSize );
+
+    bool bSaved = FFileHelper::SaveArrayToFile( Buffer, *FilePath );
+    if ( bSaved )
+    {
+        HOUDINI_LOG_MESSAGE(
+            TEXT( "Saved %d recorded HAPI calls (%d bytes) to %s." ),
+            CallRecords.Num(), Buffer.Num(), *FilePath );
+    }
+    else
+    {
+        HOUDINI_LOG_ERROR( TEXT( "Failed saving HAPI recording to %s." ), *FilePath );
+    }
+
+    return bSaved;
+}
+
+bool
+FHoudiniApiRecorder::StartReplay( const FString & FilePath, const HAPI_Session * Session )
+{
+    {
+        FScopeLock ScopeLock( &CriticalSection );
+
+        if ( !StartReplayInternal( FilePath, Session ) )
+            return false;
+    }
+
+    // Without libHAPI the engine has neither a session nor a scheduler, create them now that session calls are served.
+    if ( !Session && FHoudiniEngine::IsInitialized() )
+        FHoudiniEngine::Get().StartReplaySession();
+
+    return true;
+}
+
+bool
+FHoudiniApiRecorder::StartReplayInternal( const FString & FilePath, const HAPI_Session * Session )
+{
+    if ( Mode != EHoudiniApiRecorderMode::Disabled )
+    {
+        HOUDINI_LOG_WARNING( TEXT( "HAPI recorder is already active, unable to replay %s." ), *FilePath );
+        return false;
+    }
+
+    TArray< uint8 > Buffer;
+    if ( !FFileHelper::LoadFileToArray( Buffer, *FilePath ) )
+    {
+        HOUDINI_LOG_ERROR( TEXT( "Failed loading HAPI recording %s." ), *FilePath );
+        return false;
+    }
+
+    FMemoryReader Reader( Buffer );
+
+    uint32 Magic = 0u;
+    uint32 Version = 0u;
+    uint32 HapiVersion = 0u;
+    int32 UncompressedSize = 0;
+
+    Reader << Magic;
+    Reader << Version;
+    Reader << HapiVersion;
+    Reader << UncompressedSize;
+
+    if ( Reader.IsError() || Magic != FileMagic || Version != FileVersion )
+    {
+        HOUDINI_LOG_ERROR( TEXT( "%s is not a valid HAPI recording." ), *FilePath );
+        return false;
+    }
+
+    // Structures and enums written by HAPI differ between versions, responses cannot be served to another one.
+    if ( HapiVersion != HoudiniApiRecordingHapiVersion() )
+    {
+        HOUDINI_LOG_ERROR(
+            TEXT( "HAPI recording %s was made with HAPI %d, it cannot be replayed with HAPI %d." ),
+            *FilePath, HapiVersion, HoudiniApiRecordingHapiVersion() );
+        return false;
+    }
+
+    TArray< uint8 > RecordBuffer;
+    const int32 CompressedOffset = (int32) Reader.Tell();
+    bool bUncompressed = UncompressedSize >= 0;
+    if ( bUncompressed )
+    {
+        RecordBuffer.SetNumUninitialized( UncompressedSize );
+        bUncompressed = FCompression::UncompressMemory(
+            HOUDINI_API_RECORDING_COMPRESSION, RecordBuffer.GetData(), UncompressedSize,
+            Buffer.GetData() + CompressedOffset, Buffer.Num() - CompressedOffset );
+    }
+
+    Records.Empty();
+
+    FMemoryReader RecordReader( RecordBuffer );
+    if ( bUncompressed )
+        RecordReader << Records;
+
+    if ( !bUncompressed || RecordReader.IsError() )
+    {
+        HOUDINI_LOG_ERROR( TEXT( "HAPI recording %s is corrupted." ), *FilePath );
+        Records.Empty();
+        return false;
+    }
+
+    ReplayIndices.Empty();
+    ReplayCursors.Empty();
+    ReplayMisses = 0;
+
+    for ( int32 RecordIdx = 0; RecordIdx < Records.Num(); ++RecordIdx )
+    {
+        const FHoudiniApiCallRecord & Record = Records[ RecordIdx ];
+        ReplayIndices.FindOrAdd( HoudiniApiRecordKey( Record.Function, Record.ArgumentHash ) ).Add( RecordIdx );
+    }
+
+    bReplaySessionOnly = Session != nullptr;
+    if ( Session )
+    {
+        ReplaySession = *Session;
+    }
+    else
+    {
+        ReplaySession.type = HAPI_SESSION_INPROCESS;
+        ReplaySession.id = 0;
+    }
+
+    InstallTable();
+    Mode = EHoudiniApiRecorderMode::Replaying;
+
+    HOUDINI_LOG_MESSAGE(
+        TEXT( "Replaying %d recorded HAPI calls from %s (recorded with HAPI %d)." ),
+        Records.Num(), *FilePath, HapiVersion );
+
+    return true;
+}
+
+void
+FHoudiniApiRecorder::StopReplay()
+{
+    FScopeLock ScopeLock( &CriticalSection );
+
+    if ( Mode != EHoudiniApiRecorderMode::Replaying )
+        return;
+
+    RestoreTable();
+    Mode = EHoudiniApiRecorderMode::Disabled;
+
+    if ( ReplayMisses > 0 )
+        HOUDINI_LOG_WARNING( TEXT( "HAPI replay had %d calls without a recorded response." ), ReplayMisses );
+
+    Records.Empty();
+    ReplayIndices.Empty();
+    ReplayCursors.Empty();
+    bReplaySessionOnly = false;
+}
+
+EHoudiniApiRecorderMode::Type
+FHoudiniApiRecorder::GetMode()
+{
+    return Mode;
+}
+
+int32
+FHoudiniApiRecorder::GetRecordCount()
+{
+    FScopeLock ScopeLock( &CriticalSection );
+    return Records.Num();
+}
+
+int32
+FHoudiniApiRecorder::GetReplayMissCount()
+{
+    FScopeLock ScopeLock( &CriticalSection );
+    return ReplayMisses;
+}
+
+bool
+FHoudiniApiRecorder::IsReplaying( const HAPI_Session * Session )
+{
+    if ( Mode != EHoudiniApiRecorderMode::Replaying )
+        return false;
+
+    if ( !bReplaySessionOnly )
+        return true;
+
+    return Session && Session->type == ReplaySession.type && Session->id == ReplaySession.id;
+}
+
+const HAPI_Session &
+FHoudiniApiRecorder::GetReplaySession()
+{
+    return ReplaySession;
+}
+
+void
+FHoudiniApiRecorder::AddRecord( FHoudiniApiCallRecord & Record )
+{
+    FScopeLock ScopeLock( &CriticalSection );
+
+    if ( Mode == EHoudiniApiRecorderMode::Recording )
+        Records.Add( MoveTemp( Record ) );
+}
+
+bool
+FHoudiniApiRecorder::FindRecord( uint16 Function, uint32 ArgumentHash, FHoudiniApiCallRecord & Record )
+{
+    FScopeLock ScopeLock( &CriticalSection );
+
+    const uint64 Key = HoudiniApiRecordKey( Function, ArgumentHash );
+    const TArray< int32 > * Indices = ReplayIndices.Find( Key );
+    if ( !Indices || Indices->Num() == 0 )
+    {
+        ReplayMisses++;
+        return false;
+    }
+
+    // Identical calls are served in recorded order, so status polling progresses the same way it did when recording.
+    int32 & Cursor = ReplayCursors.FindOrAdd( Key );
+    Record = Records[ ( *Indices )[ FMath::Min( Cursor, Indices->Num() - 1 ) ] ];
+    Cursor++;
+
+    return true;
+}
+
+void
+FHoudiniApiRecorder::EnableSnapshots()
+{
+    FScopeLock ScopeLock( &CriticalSection );
+
+    if ( bSnapshotsEnabled || !FHoudiniApi::IsHAPIInitialized() )
+        return;
+
+    CaptureTlsSlot = FPlatformTLS::AllocTlsSlot();
+    ServeTlsSlot = FPlatformTLS::AllocTlsSlot();
+    if ( !FPlatformTLS::IsValidTlsSlot( CaptureTlsSlot ) || !FPlatformTLS::IsValidTlsSlot( ServeTlsSlot ) )
+    {
+        HOUDINI_LOG_WARNING( TEXT( "Unable to allocate thread local storage, HAPI snapshots are disabled." ) );
+        return;
+    }
+
+    InstallTable();
+    bSnapshotsEnabled = true;
+}
+
+void
+FHoudiniApiRecorder::DisableSnapshots()
+{
+    FScopeLock ScopeLock( &CriticalSection );
+
+    if ( !bSnapshotsEnabled )
+        return;
+
+    RestoreTable();
+    bSnapshotsEnabled = false;
+
+    FPlatformTLS::FreeTlsSlot( CaptureTlsSlot );
+    FPlatformTLS::FreeTlsSlot( ServeTlsSlot );
+    CaptureTlsSlot = 0xFFFFFFFF;
+    ServeTlsSlot = 0xFFFFFFFF;
+}
+
+bool
+FHoudiniApiRecorder::AreSnapshotsEnabled()
+{
+    return bSnapshotsEnabled;
+}
+
+bool
+FHoudiniApiRecorder::CaptureSnapshot( FHoudiniApiSnapshot & Snapshot, TFunctionRef< bool() > Function )
+{
+    if ( !bSnapshotsEnabled )
+        return false;
+
+    void * PreviousSnapshot = FPlatformTLS::GetTlsValue( CaptureTlsSlot );
+    FPlatformTLS::SetTlsValue( CaptureTlsSlot, &Snapshot );
+    bool bResult = Function();
+    FPlatformTLS::SetTlsValue( CaptureTlsSlot, PreviousSnapshot );
+
+    return bResult;
+}
+
+FHoudiniApiSnapshot *
+FHoudiniApiRecorder::GetCaptureSnapshot()
+{
+    if ( !bSnapshotsEnabled )
+        return nullptr;
+
+    return static_cast< FHoudiniApiSnapshot * >( FPlatformTLS::GetTlsValue( CaptureTlsSlot ) );
+}
+
+const FHoudiniApiSnapshot *
+FHoudiniApiRecorder::GetServedSnapshot()
+{
+    if ( !bSnapshotsEnabled )
+        return nullptr;
+
+    return static_cast< const FHoudiniApiSnapshot * >( FPlatformTLS::GetTlsValue( ServeTlsSlot ) );
+}
+
+static FAutoConsoleCommand HoudiniApiRecordCommand(
+    TEXT( "Houdini.Record" ),
+    TEXT( "Starts recording HAPI calls to the given file, or stops recording when no file is given." ),
+    FConsoleCommandWithArgsDelegate::CreateLambda( []( const TArray< FString > & Args )
+    {
+        if ( Args.Num() > 0 )
+            FHoudiniApiRecorder::StartRecording( Args[ 0 ] );
+        else
+            FHoudiniApiRecorder::StopRecording();
+    } ) );
+
+static FAutoConsoleCommand HoudiniApiReplayCommand(
+    TEXT( "Houdini.Replay" ),
+    TEXT( "Serves HAPI calls from the given recording, or stops replaying when no file is given." ),
+    FConsoleCommandWithArgsDelegate::CreateLambda( []( const TArray< FString > & Args )
+    {
+        if ( Args.Num() > 0 )
+            FHoudiniApiRecorder::StartReplay( Args[ 0 ] );
+        else
+            FHoudiniApiRecorder::StopReplay();
+    } ) );
@@ -0,0 +1,358 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+#pragma once
+
+#include "HoudiniApi.h"
+#include "Misc/Crc.h"
+
+
+/** List of FHoudiniApi entries which are intercepted by the recorder. These cover session management, asset     **/
+/** loading and instantiation, parameters, cooking, status polling and all the geometry, attribute, group,       **/
+/** material and instancer queries used when building the cook output. Session entries are not recorded, they   **/
+/** are answered by the recorder itself while replaying.                                                          **/
+#define HOUDINI_API_RECORDED_FUNCTIONS( HOUDINI_API_RECORDED_FUNCTION ) \
+    HOUDINI_API_RECORDED_FUNCTION( IsInitialized ) \
+    HOUDINI_API_RECORDED_FUNCTION( IsSessionValid ) \
+    HOUDINI_API_RECORDED_FUNCTION( CreateInProcessSession ) \
+    HOUDINI_API_RECORDED_FUNCTION( CreateThriftSocketSession ) \
+    HOUDINI_API_RECORDED_FUNCTION( CreateThriftNamedPipeSession ) \
+    HOUDINI_API_RECORDED_FUNCTION( Initialize ) \
+    HOUDINI_API_RECORDED_FUNCTION( Cleanup ) \
+    HOUDINI_API_RECORDED_FUNCTION( CloseSession ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetSessionEnvInt ) \
+    HOUDINI_API_RECORDED_FUNCTION( LoadAssetLibraryFromFile ) \
+    HOUDINI_API_RECORDED_FUNCTION( LoadAssetLibraryFromMemory ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetAvailableAssetCount ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetAvailableAssets ) \
+    HOUDINI_API_RECORDED_FUNCTION( CreateNode ) \
+    HOUDINI_API_RECORDED_FUNCTION( DeleteNode ) \
+    HOUDINI_API_RECORDED_FUNCTION( IsNodeValid ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetNodePath ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetParameters ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetParmInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetParmIdFromName ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetParmIntValues ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetParmFloatValues ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetParmStringValues ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetParmChoiceLists ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetParmTagValue ) \
+    HOUDINI_API_RECORDED_FUNCTION( SetParmIntValue ) \
+    HOUDINI_API_RECORDED_FUNCTION( SetParmIntValues ) \
+    HOUDINI_API_RECORDED_FUNCTION( SetParmFloatValues ) \
+    HOUDINI_API_RECORDED_FUNCTION( SetParmStringValue ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetPresetBufLength ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetPreset ) \
+    HOUDINI_API_RECORDED_FUNCTION( SetPreset ) \
+    HOUDINI_API_RECORDED_FUNCTION( CookNode ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetStatus ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetStatusStringBufLength ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetStatusString ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetAssetInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetNodeInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetObjectInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( ComposeObjectList ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetComposedObjectList ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetComposedObjectTransforms ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetObjectTransform ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetGeoInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetDisplayGeoInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetPartInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetVertexList ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetFaceCounts ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetAttributeInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetAttributeNames ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetAttributeFloatData ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetAttributeIntData ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetAttributeStringData ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetStringBufLength ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetString ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetGroupNames ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetGroupMembership ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetGroupNamesOnPackedInstancePart ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetGroupMembershipOnPackedInstancePart ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetMaterialNodeIdsOnFaces ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetMaterialInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetInstancerPartTransforms ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetInstancedPartIds ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetInstanceTransforms ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetCurveInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetCurveCounts ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetVolumeInfo ) \
+    HOUDINI_API_RECORDED_FUNCTION( GetHeightFieldData )
+
+namespace EHoudiniApiRecordedFunction
+{
+#define HOUDINI_API_RECORDED_FUNCTION_ENUM( FunctionName ) FunctionName,
+
+    enum Type : uint16
+    {
+        HOUDINI_API_RECORDED_FUNCTIONS( HOUDINI_API_RECORDED_FUNCTION_ENUM )
+        Count
+    };
+
+#undef HOUDINI_API_RECORDED_FUNCTION_ENUM
+}
+
+namespace EHoudiniApiRecorderMode
+{
+    enum Type
+    {
+        /** Calls go straight to libHAPI. **/
+        Disabled,
+
+        /** Calls go to libHAPI and are logged together with their returned buffers. **/
+        Recording,
+
+        /** Calls are served from a previously recorded file, libHAPI is not required. **/
+        Replaying
+    };
+}
+
+/** A single recorded HAPI call. **/
+struct HOUDINIENGINERUNTIME_API FHoudiniApiCallRecord
+{
+    FHoudiniApiCallRecord();
+
+    /** Serialization. **/
+    friend FArchive & operator<<( FArchive & Ar, FHoudiniApiCallRecord & Record );
+
+    /** Hash an input argument. **/
+    template< typename TArgument >
+    void AddArgument( const TArgument & Value );
+    void AddArgument( const char * Value );
+
+    /** Append a buffer written by HAPI, prefixed by its byte size. **/
+    template< typename TOutput >
+    void AddOutput( const TOutput * Buffer, int32 Count );
+
+    /** Which FHoudiniApi entry this call was made to. **/
+    uint16 Function;
+
+    /** Hash of all input arguments, used to match calls during replay. **/
+    uint32 ArgumentHash;
+
+    /** Result returned by HAPI. **/
+    int32 Result;
+
+    /** All buffers written by HAPI, in argument order, each prefixed by its byte size. **/
+    TArray< uint8 > Payload;
+};
+
+template< typename TArgument >
+void
+FHoudiniApiCallRecord::AddArgument( const TArgument & Value )
+{
+    ArgumentHash = FCrc::MemCrc32( &Value, sizeof( TArgument ), ArgumentHash );
+}
+
+template< typename TOutput >
+void
+FHoudiniApiCallRecord::AddOutput( const TOutput * Buffer, int32 Count )
+{
+    int32 ByteCount = ( Buffer && Count > 0 ) ? Count * sizeof( TOutput ) : 0;
+
+    int32 Offset = Payload.AddUninitialized( sizeof( int32 ) + ByteCount );
+    FMemory::Memcpy( Payload.GetData() + Offset, &ByteCount, sizeof( int32 ) );
+    if ( ByteCount > 0 )
+        FMemory::Memcpy( Payload.GetData() + Offset + sizeof( int32 ), Buffer, ByteCount );
+}
+
+/** Responses to recorded entries captured on one thread, for instance the scheduler thread right after a cook,  **/
+/** and served on another. Calls which were not captured are forwarded to HAPI. Immutable once capture has ended. **/
+struct HOUDINIENGINERUNTIME_API FHoudiniApiSnapshot
+{
+    public:
+
+        FHoudiniApiSnapshot();
+
+        /** Locate the captured response for a call with given function and argument hash. **/
+        const FHoudiniApiCallRecord * Find( uint16 Function, uint32 ArgumentHash ) const;
+
+        /** Store a response, replacing a previous response to the same call. **/
+        void Add( const FHoudiniApiCallRecord & Record );
+
+        /** Return number of captured calls. **/
+        int32 Num() const;
+
+        /** Return size in bytes of all captured buffers. **/
+        int32 GetPayloadSize() const;
+
+    protected:
+
+        /** Captured responses, indexed by function and argument hash. **/
+        TMap< uint64, FHoudiniApiCallRecord > Records;
+
+        /** Size in bytes of all captured buffers. **/
+        int32 PayloadSize;
+};
+
+/** Serves a snapshot to the calling thread for the lifetime of this object. Does nothing for an invalid snapshot  **/
+/** or when snapshots are not enabled.                                                                            **/
+struct HOUDINIENGINERUNTIME_API FHoudiniApiScopedSnapshot
+{
+    public:
+
+        FHoudiniApiScopedSnapshot( const TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > & InSnapshot );
+        ~FHoudiniApiScopedSnapshot();
+
+    protected:
+
+        /** Snapshot being served, kept alive while in scope. **/
+        TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > Snapshot;
+
+        /** Snapshot served by an enclosing scope, restored on destruction. **/
+        const FHoudiniApiSnapshot * PreviousSnapshot;
+};
+
+/** Records the FHoudiniApi table calls of a session to a compressed file, and serves them back without Houdini.  **/
+struct HOUDINIENGINERUNTIME_API FHoudiniApiRecorder
+{
+    public:
+
+        /** Start logging the recorded FHoudiniApi entries. Recording is written to disk when stopped. **/
+        static bool StartRecording( const FString & FilePath );
+
+        /** Stop logging and write the recording to disk. **/
+        static bool StopRecording();
+
+        /** Load a recording and route the recorded FHoudiniApi entries to it. When a session is given, only calls   **/
+        /** made on that session are replayed and all other calls still go to libHAPI.                              **/
+        static bool StartReplay( const FString & FilePath, const HAPI_Session * Session = nullptr );
+
+        /** Stop replaying and restore the FHoudiniApi table. **/
+        static void StopReplay();
+
+        /** Return current mode of the recorder. **/
+        static EHoudiniApiRecorderMode::Type GetMode();
+
+        /** Return number of calls recorded or loaded for replay. **/
+        static int32 GetRecordCount();
+
+        /** Return number of replayed calls which had no recorded response. **/
+        static int32 GetReplayMissCount();
+
+        /** Write calls to a recording file. **/
+        static bool SaveRecording( const FString & FilePath, const TArray< FHoudiniApiCallRecord > & CallRecords );
+
+    public:
+
+        /** Return true if calls made on given session are served from the recording. **/
+        static bool IsReplaying( const HAPI_Session * Session );
+
+        /** Return the session handed out by session creation entries while replaying. **/
+        static const HAPI_Session & GetReplaySession();
+
+    public:
+
+        /** Append a finished call to the recording. **/
+        static void AddRecord( FHoudiniApiCallRecord & Record );
+
+        /** Locate the recorded response for a call with given function and argument hash. Returns false on a miss. **/
+        static bool FindRecord( uint16 Function, uint32 ArgumentHash, FHoudiniApiCallRecord & Record );
+
+    public:
+
+        /** Install the recorder entries for as long as snapshots are needed, so capturing and serving only touch  **/
+        /** per-thread state and never swap the FHoudiniApi table. Must be called on the game thread before the     **/
+        /** scheduler thread is started.                                                                           **/
+        static void EnableSnapshots();
+
+        /** Remove the entries installed by EnableSnapshots. Must be called once the scheduler thread has stopped. **/
+        static void DisableSnapshots();
+
+        /** Return true if snapshots can be captured and served. **/
+        static bool AreSnapshotsEnabled();
+
+        /** Run given function, capturing responses to recorded entries it calls on the current thread into the   **/
+        /** given snapshot. Returns the result of the function, or false if snapshots are not enabled.            **/
+        static bool CaptureSnapshot( FHoudiniApiSnapshot & Snapshot, TFunctionRef< bool() > Function );
+
+        /** Return the snapshot captured by the current thread, if any. **/
+        static FHoudiniApiSnapshot * GetCaptureSnapshot();
+
+        /** Return the snapshot served to the current thread, if any. **/
+        static const FHoudiniApiSnapshot * GetServedSnapshot();
+
+    protected:
+
+        /** Swap recorded FHoudiniApi entries with the recorder ones, storing the current entries. **/
+        static void InstallTable();
+
+        /** Restore FHoudiniApi entries stored by InstallTable. **/
+        static void RestoreTable();
+
+        /** Load a recording and install the replay entries, called with the critical section held. **/
+        static bool StartReplayInternal( const FString & FilePath, const HAPI_Session * Session );
+
+    protected:
+
+        /** Recording file magic and version. **/
+        static const uint32 FileMagic;
+        static const uint32 FileVersion;
+
+        /** Synchronization primitive, scheduler thread polls HAPI concurrently with the game thread. **/
+        static FCriticalSection CriticalSection;
+
+        /** Current mode. **/
+        static EHoudiniApiRecorderMode::Type Mode;
+
+        /** Destination of the current recording. **/
+        static FString RecordingFilePath;
+
+        /** Recorded or loaded calls, in call order. **/
+        static TArray< FHoudiniApiCallRecord > Records;
+
+        /** Replay lookup, from function and argument hash to indices into Records. **/
+        static TMap< uint64, TArray< int32 > > ReplayIndices;
+
+        /** Replay cursors, indexed like ReplayIndices. Repeated calls past the end reuse the last response. **/
+        static TMap< uint64, int32 > ReplayCursors;
+
+        /** Number of replayed calls which had no recorded response. **/
+        static int32 ReplayMisses;
+
+        /** Session being replayed, and whether calls on other sessions still go to libHAPI. **/
+        static HAPI_Session ReplaySession;
+        static bool bReplaySessionOnly;
+
+        /** Number of active users of the recorder entries, recording, replay and snapshots count as one each. **/
+        static int32 TableInstallCount;
+
+        /** Is set while snapshots are enabled. **/
+        static bool bSnapshotsEnabled;
+
+        /** Thread local slots holding the snapshot captured by and served to each thread. **/
+        static uint32 CaptureTlsSlot;
+        static uint32 ServeTlsSlot;
+
+        friend struct FHoudiniApiScopedSnapshot;
+};
@@ -27,6 +27,7 @@
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngineBakeUtils.h"
 #include "HoudiniEngineMaterialUtils.h"
+#include "HoudiniObjectLoader.h"
 #include "HoudiniEngine.h"
 #include "HoudiniAsset.h"
 #include "HoudiniAssetActor.h"
@@ -58,6 +59,9 @@
 #include "HoudiniInstancedActorComponent.h"
 #include "HoudiniMeshSplitInstancerComponent.h"
 #include "HoudiniParamUtils.h"
+#include "HoudiniCookCache.h"
+#include "HoudiniPostCookExecutor.h"
+#include "HoudiniApiRecorder.h"
 #include "HoudiniLandscapeUtils.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Landscape.h"
@@ -66,7 +70,9 @@
 #include "LandscapeInfo.h"
 #include "LandscapeLayerInfoObject.h"
 #include "Materials/MaterialInstance.h"
+#include "Components/LineBatchComponent.h"
 #include "Engine/StaticMeshSocket.h"
+#include "Engine/Texture2D.h"
 #include "HoudiniCookHandler.h"
 #include "MetaData.h"
 #if WITH_EDITOR
@@ -307,6 +313,7 @@ UHoudiniAssetComponent::UHoudiniAssetComponent( const FObjectInitializer & Objec
     bManualRecookRequested = false;
     PreviousTransactionHoudiniAsset = nullptr;
     HoudiniAssetComponentMaterials = nullptr;
+    CurveLineBatchComponent = nullptr;
 #if WITH_EDITOR
     CopiedHoudiniComponent = nullptr;
 #endif
@@ -316,6 +323,7 @@ UHoudiniAssetComponent::UHoudiniAssetComponent( const FObjectInitializer & Objec
     ImportAxis = HRSAI_Unreal;
     HapiNotificationStarted = 0.0;
     AssetCookCount = 0;
+    bCookKeyPresetValid = false;
     HoudiniAssetComponentTransientFlagsPacked = 0u;
 
     /** Component flags. **/
@@ -367,6 +375,7 @@ UHoudiniAssetComponent::UHoudiniAssetComponent( const FObjectInitializer & Objec
     GeneratedDistanceFieldResolutionScale = 0.0f;
 
     bNeedToUpdateNavigationSystem = false;
+    bPackHoudiniToolInputPreset = false;
 
     // Make an invalid GUID, since we do not have any cooking requests.
     HapiGUID.Invalidate();
@@ -411,6 +420,12 @@ UHoudiniAssetComponent::AddReferencedObjects( UObject * InThis, FReferenceCollec
             Collector.AddReferencedObject( InstanceInput, InThis );
         }
 
+        // Add references to instance inputs which are still being created.
+        for ( auto& InstanceInput : HoudiniAssetComponent->PendingInstanceInputs )
+        {
+            Collector.AddReferencedObject( InstanceInput, InThis );
+        }
+
         // Add references to all handles.
         for ( TMap< FString, UHoudiniHandleComponent * >::TIterator
             IterHandles( HoudiniAssetComponent->HandleComponents ); IterHandles; ++IterHandles )
@@ -428,6 +443,15 @@ UHoudiniAssetComponent::AddReferencedObjects( UObject * InThis, FReferenceCollec
                 Collector.AddReferencedObject( StaticMesh, InThis );
         }
 
+        // Add references to static meshes which are still being built.
+        for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator
+            Iter( HoudiniAssetComponent->PendingStaticMeshes ); Iter; ++Iter )
+        {
+            UStaticMesh * StaticMesh = Iter.Value();
+            if ( StaticMesh )
+                Collector.AddReferencedObject( StaticMesh, InThis );
+        }
+
         // Add references to all static meshes and their static mesh components.
         for ( TMap< UStaticMesh *, UStaticMeshComponent * >::TIterator
             Iter( HoudiniAssetComponent->StaticMeshComponents ); Iter; ++Iter )
@@ -447,6 +471,10 @@ UHoudiniAssetComponent::AddReferencedObjects( UObject * InThis, FReferenceCollec
             Collector.AddReferencedObject( HoudiniSplineComponent, InThis );
         }
 
+        // Add reference to the output curves line batch.
+        if ( HoudiniAssetComponent->CurveLineBatchComponent )
+            Collector.AddReferencedObject( HoudiniAssetComponent->CurveLineBatchComponent, InThis );
+
         // Add references to all Landscape
         for ( TMap< FHoudiniGeoPartObject, ALandscape * >::TIterator
             Iter( HoudiniAssetComponent->LandscapeComponents ); Iter; ++Iter)
@@ -455,6 +483,14 @@ UHoudiniAssetComponent::AddReferencedObjects( UObject * InThis, FReferenceCollec
             Collector.AddReferencedObject( HoudiniLandscape, InThis );
         }
 
+        // Add references to all volume textures.
+        for ( TMap< FHoudiniGeoPartObject, UTexture2D * >::TIterator
+            Iter( HoudiniAssetComponent->VolumeTextures ); Iter; ++Iter )
+        {
+            UTexture2D * VolumeTexture = Iter.Value();
+            Collector.AddReferencedObject( VolumeTexture, InThis );
+        }
+
         // Add references to all generated Landscape layer objects
         for ( TMap< TWeakObjectPtr<class UPackage>, FHoudiniGeoPartObject > ::TIterator
             Iter( HoudiniAssetComponent->CookedTemporaryLandscapeLayers ); Iter; ++Iter )
@@ -497,6 +533,7 @@ void
 UHoudiniAssetComponent::SetAssetId( HAPI_NodeId InAssetId )
 {
     AssetId = InAssetId;
+    bCookKeyPresetValid = false;
 }
 
 bool
@@ -562,6 +599,9 @@ UHoudiniAssetComponent::SetHoudiniAsset( UHoudiniAsset * InHoudiniAsset )
 
 #endif
 
+    // Drop the output which has not been applied yet, its instance inputs are cleared with the others.
+    CancelPostCookWorkItems();
+
     // Clear all created parameters.
     ClearParameters();
 
@@ -580,6 +620,9 @@ UHoudiniAssetComponent::SetHoudiniAsset( UHoudiniAsset * InHoudiniAsset )
     // Clear all landscapes.
     ClearLandscapes();
 
+    // Release the volume textures.
+    VolumeTextures.Empty();
+
     // Set Houdini logo to be default geometry.
     ReleaseObjectGeoPartResources( StaticMeshes );
     StaticMeshes.Empty();
@@ -727,6 +770,7 @@ UHoudiniAssetComponent::CreateObjectGeoPartResources( TMap< FHoudiniGeoPartObjec
     TArray< FHoudiniGeoPartObject > FoundInstancers;
     TArray< FHoudiniGeoPartObject > FoundCurves;
     TArray< FHoudiniGeoPartObject > FoundVolumes;
+    TMap< FHoudiniGeoPartObject, UStaticMesh * > FoundMeshes;
     TMap< FHoudiniGeoPartObject, UStaticMesh* > StaleParts;
 
     for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator Iter( StaticMeshMap ); Iter; ++Iter )
@@ -762,76 +806,17 @@ UHoudiniAssetComponent::CreateObjectGeoPartResources( TMap< FHoudiniGeoPartObjec
                 continue;
             }
 
-            UStaticMeshComponent * StaticMeshComponent = nullptr;
-            UStaticMeshComponent * FoundStaticMeshComponent = LocateStaticMeshComponent( StaticMesh );
-
-            if ( FoundStaticMeshComponent )
+            if ( !HoudiniGeoPartObject.IsVisible() )
             {
-                StaticMeshComponent = FoundStaticMeshComponent;
-                if ( ! HoudiniGeoPartObject.IsVisible() )
-                {
-                    // We have a mesh and component for a part which is invisible.
-                    // Visibility may have changed since last cook
+                // We have a mesh and component for a part which is invisible.
+                // Visibility may have changed since last cook
+                if ( LocateStaticMeshComponent( StaticMesh ) )
                     StaleParts.Add( HoudiniGeoPartObject, StaticMesh );
-                    continue;
-                }
-            }
-            else if ( HoudiniGeoPartObject.IsVisible() )
-            {
-                // Create necessary component.
-                StaticMeshComponent = NewObject< UStaticMeshComponent >(
-                    GetOwner(), UStaticMeshComponent::StaticClass(),
-                    NAME_None, RF_Transactional );
-
-                // Attach created static mesh component to our Houdini component.
-                StaticMeshComponent->AttachToComponent( this, FAttachmentTransformRules::KeepRelativeTransform );
 
-                StaticMeshComponent->SetStaticMesh( StaticMesh );
-                StaticMeshComponent->SetVisibility( true );
-                StaticMeshComponent->SetMobility( Mobility );
-                StaticMeshComponent->RegisterComponent();
-
-                // Add to the map of components.
-                StaticMeshComponents.Add( StaticMesh, StaticMeshComponent );
+                continue;
             }
 
-            if ( StaticMeshComponent )
-            {
-                // If this is a collision geo, we need to make it invisible.
-                if (HoudiniGeoPartObject.IsCollidable())
-                {
-                    StaticMeshComponent->SetVisibility( false );
-                    StaticMeshComponent->SetHiddenInGame( true );                                                                     
-                    StaticMeshComponent->SetCollisionProfileName( FName( TEXT( "InvisibleWall" ) ) );
-                }
-                else
-                {
-                    // Visibility may have changed so we still need to update it
-                    StaticMeshComponent->SetVisibility( HoudiniGeoPartObject.IsVisible() );
-                    StaticMeshComponent->SetHiddenInGame( !HoudiniGeoPartObject.IsVisible() );
-                }
-
-                // And we will need to update the navmesh later
-                if( HoudiniGeoPartObject.IsCollidable() || HoudiniGeoPartObject.IsRenderCollidable() )
-                    bNeedToUpdateNavigationSystem = true;
-
-                // Transform the component by transformation provided by HAPI.
-                StaticMeshComponent->SetRelativeTransform( HoudiniGeoPartObject.TransformMatrix );
-
-                // If the static mesh had sockets, we can assign the desired actor to them now
-                int32 NumberOfSockets = StaticMesh == nullptr ? 0 : StaticMesh->Sockets.Num();
-                for( int32 nSocket = 0; nSocket < NumberOfSockets; nSocket++ )
-                {
-                    UStaticMeshSocket* MeshSocket = StaticMesh->Sockets[ nSocket ];
-                    if ( MeshSocket && ( MeshSocket->Tag.IsEmpty() ) )
-                        continue;
-
-                    FHoudiniEngineUtils::AddActorsToMeshSocket( StaticMesh->Sockets[ nSocket ], StaticMeshComponent );
-                }
-
-                // Try to update uproperty atributes
-                FHoudiniEngineUtils::UpdateUPropertyAttributesOnObject( StaticMeshComponent, HoudiniGeoPartObject );
-            }
+            FoundMeshes.Add( HoudiniGeoPartObject, StaticMesh );
         }
     }
 
@@ -848,6 +833,23 @@ UHoudiniAssetComponent::CreateObjectGeoPartResources( TMap< FHoudiniGeoPartObjec
     if ( &StaticMeshes != &StaticMeshMap )
         StaticMeshes = StaticMeshMap;
 
+    // The materials and textures generated by the cook are compiled in a single batch first,
+    // their shaders compile asynchronously while the rest of the output is applied.
+    AddPostCookWorkItem( []() { FHoudiniEngineMaterialUtils::FinalizePendingMaterialUpdates(); } );
+
+    // Each mesh component, instancer and material instance update is a separate work item,
+    // so the output of large cooks can be applied over several frames.
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator Iter( FoundMeshes ); Iter; ++Iter )
+    {
+        const FHoudiniGeoPartObject HoudiniGeoPartObject = Iter.Key();
+        UStaticMesh * StaticMesh = Iter.Value();
+
+        AddPostCookWorkItem( [ this, HoudiniGeoPartObject, StaticMesh ]()
+        {
+            CreateObjectGeoPartComponent( HoudiniGeoPartObject, StaticMesh );
+        } );
+    }
+
 #if WITH_EDITOR
     if ( FHoudiniEngineUtils::IsHoudiniAssetValid( AssetId ) )
     {
@@ -855,32 +857,260 @@ UHoudiniAssetComponent::CreateObjectGeoPartResources( TMap< FHoudiniGeoPartObjec
         CreateInstanceInputs( FoundInstancers );
 
         // Create necessary curves.
-        CreateCurves( FoundCurves );
+        AddPostCookWorkItem( [ this, FoundCurves ]() { CreateCurves( FoundCurves ); } );
 
         // Create necessary landscapes
-        CreateAllLandscapes( FoundVolumes );
+        AddPostCookWorkItem( [ this, FoundVolumes ]() { CreateAllLandscapes( FoundVolumes ); } );
+
+        // Create textures for the other volumes, before the material instances that may sample them.
+        AddPostCookWorkItem( [ this, FoundVolumes ]() { CreateVolumeTextures( FoundVolumes ); } );
     }
 #endif
 
-    CleanUpAttachedStaticMeshComponents();
+    AddPostCookWorkItem( [ this ]() { CleanUpAttachedStaticMeshComponents(); } );
 
     // Now that all the Meshes/Landscapes are created, see if we need to create material instances from attributes
-    CreateOrUpdateMaterialInstances();
+    TSharedRef< bool > bMaterialReplaced = MakeShared< bool >( false );
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator Iter( StaticMeshMap ); Iter; ++Iter )
+    {
+        const FHoudiniGeoPartObject HoudiniGeoPartObject = Iter.Key();
+        UStaticMesh * StaticMesh = Iter.Value();
+        if ( !StaticMesh )
+            continue;
 
-    // If one of the children we created is movable, we need to set ourselves to movable as well
-    const auto & LocalAttachChildren = GetAttachChildren();
-    for ( TArray< USceneComponent * >::TConstIterator Iter( LocalAttachChildren ); Iter; ++Iter )
+        AddPostCookWorkItem( [ this, HoudiniGeoPartObject, StaticMesh, bMaterialReplaced ]()
+        {
+            if ( CreateOrUpdateStaticMeshMaterialInstances( HoudiniGeoPartObject, StaticMesh ) )
+                *bMaterialReplaced = true;
+        } );
+    }
+
+    AddPostCookWorkItem( [ this, bMaterialReplaced ]()
     {
-        USceneComponent * SceneComponent = *Iter;
-        if ( SceneComponent->Mobility == EComponentMobility::Movable )
-            SetMobility( EComponentMobility::Movable );
+        if ( CreateOrUpdateLandscapeMaterialInstances() )
+            *bMaterialReplaced = true;
+
+#if WITH_EDITOR
+        if ( *bMaterialReplaced )
+            UpdateEditorProperties( false );
+#endif
+    } );
+
+    AddPostCookWorkItem( [ this ]()
+    {
+        // If one of the children we created is movable, we need to set ourselves to movable as well
+        const auto & LocalAttachChildren = GetAttachChildren();
+        for ( TArray< USceneComponent * >::TConstIterator Iter( LocalAttachChildren ); Iter; ++Iter )
+        {
+            USceneComponent * SceneComponent = *Iter;
+            if ( SceneComponent->Mobility == EComponentMobility::Movable )
+                SetMobility( EComponentMobility::Movable );
+        }
+    } );
+}
+
+void
+UHoudiniAssetComponent::CreateObjectGeoPartComponent( const FHoudiniGeoPartObject & HoudiniGeoPartObject, UStaticMesh * StaticMesh )
+{
+    // The part may have been released since this work was queued.
+    if ( StaticMeshes.FindRef( HoudiniGeoPartObject ) != StaticMesh )
+        return;
+
+    UStaticMeshComponent * StaticMeshComponent = LocateStaticMeshComponent( StaticMesh );
+    if ( !StaticMeshComponent )
+    {
+        // Create necessary component.
+        StaticMeshComponent = NewObject< UStaticMeshComponent >(
+            GetOwner(), UStaticMeshComponent::StaticClass(),
+            NAME_None, RF_Transactional );
+
+        // Attach created static mesh component to our Houdini component.
+        StaticMeshComponent->AttachToComponent( this, FAttachmentTransformRules::KeepRelativeTransform );
+
+        StaticMeshComponent->SetStaticMesh( StaticMesh );
+        StaticMeshComponent->SetVisibility( true );
+        StaticMeshComponent->SetMobility( Mobility );
+        StaticMeshComponent->RegisterComponent();
+
+        // Add to the map of components.
+        StaticMeshComponents.Add( StaticMesh, StaticMeshComponent );
+    }
+
+    // If this is a collision geo, we need to make it invisible.
+    if (HoudiniGeoPartObject.IsCollidable())
+    {
+        StaticMeshComponent->SetVisibility( false );
+        StaticMeshComponent->SetHiddenInGame( true );                                                                     
+        StaticMeshComponent->SetCollisionProfileName( FName( TEXT( "InvisibleWall" ) ) );
+    }
+    else
+    {
+        // Visibility may have changed so we still need to update it
+        StaticMeshComponent->SetVisibility( HoudiniGeoPartObject.IsVisible() );
+        StaticMeshComponent->SetHiddenInGame( !HoudiniGeoPartObject.IsVisible() );
+    }
+
+    // And we will need to update the navmesh later
+    if( HoudiniGeoPartObject.IsCollidable() || HoudiniGeoPartObject.IsRenderCollidable() )
+        bNeedToUpdateNavigationSystem = true;
+
+    // Transform the component by transformation provided by HAPI.
+    StaticMeshComponent->SetRelativeTransform( HoudiniGeoPartObject.TransformMatrix );
+
+    // If the static mesh had sockets, we can assign the desired actor to them now
+    int32 NumberOfSockets = StaticMesh == nullptr ? 0 : StaticMesh->Sockets.Num();
+    for( int32 nSocket = 0; nSocket < NumberOfSockets; nSocket++ )
+    {
+        UStaticMeshSocket* MeshSocket = StaticMesh->Sockets[ nSocket ];
+        if ( MeshSocket && ( MeshSocket->Tag.IsEmpty() ) )
+            continue;
+
+        FHoudiniEngineUtils::AddActorsToMeshSocket( StaticMesh->Sockets[ nSocket ], StaticMeshComponent );
+    }
+
+    // Try to update uproperty atributes
+    FHoudiniEngineUtils::UpdateUPropertyAttributesOnObject( StaticMeshComponent, HoudiniGeoPartObject );
+}
+
+void
+UHoudiniAssetComponent::AddPostCookWorkItem( TFunction< void() > WorkItem )
+{
+    FHoudiniPostCookExecutor * PostCookExecutor =
+        FHoudiniEngine::IsInitialized() ? FHoudiniEngine::Get().GetPostCookExecutor() : nullptr;
+
+    // Work queued by a deferred work item is deferred as well, it is executed right after it.
+    if ( PostCookExecutor && ( bDeferPostCookWorkItems || PostCookExecutor->IsExecutingWorkItem() ) )
+        PostCookExecutor->AddWorkItem( this, MoveTemp( WorkItem ) );
+    else
+        WorkItem();
+}
+
+bool
+UHoudiniAssetComponent::AreReferencedObjectsLoaded( const FHoudiniEngineTaskInfo & TaskInfo )
+{
+    if ( !bWaitingForReferencedObjects )
+    {
+        const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+        if ( !HoudiniRuntimeSettings || !HoudiniRuntimeSettings->bAsyncLoadReferencedObjects )
+            return true;
+
+        // Paths are gathered by the scheduler thread along with the prefetched output, without prefetching the
+        // referenced objects are loaded synchronously while the output is applied.
+        TSharedPtr< FStreamableHandle > LoadHandle = FHoudiniObjectLoader::RequestAsyncLoad( TaskInfo.ReferencedObjectPaths );
+        if ( !LoadHandle.IsValid() )
+            return true;
+
+        // Objects loaded for the previous cook are released once the new ones are requested.
+        ReferencedObjectsLoadHandle = LoadHandle;
+        bWaitingForReferencedObjects = true;
+    }
+
+    if ( ReferencedObjectsLoadHandle.IsValid() && ReferencedObjectsLoadHandle->IsLoadingInProgress() )
+    {
+        // Batch cooks need the output right away.
+        if ( !bFinishPostCookImmediately )
+            return false;
+
+        ReferencedObjectsLoadHandle->WaitUntilComplete();
+    }
+
+    bWaitingForReferencedObjects = false;
+    return true;
+}
+
+void
+UHoudiniAssetComponent::FinishPostCookWorkItems()
+{
+    if ( FHoudiniEngine::IsInitialized() && FHoudiniEngine::Get().GetPostCookExecutor() )
+        FHoudiniEngine::Get().GetPostCookExecutor()->FinishWorkItems( this );
+}
+
+void
+UHoudiniAssetComponent::CancelPostCookWorkItems()
+{
+    if ( HasPendingPostCookWorkItems() )
+    {
+        FHoudiniEngine::Get().GetPostCookExecutor()->CancelWorkItems( this );
+
+        // Generated materials are batched globally and may be used by other components, they still need to be compiled.
+        FHoudiniEngineMaterialUtils::FinalizePendingMaterialUpdates();
+    }
+
+    // Instance inputs which were not committed go back with the others, so they are released along with them.
+    for ( UHoudiniAssetInstanceInput * InstanceInput : PendingInstanceInputs )
+        InstanceInputs.AddUnique( InstanceInput );
+
+    PendingInstanceInputs.Empty();
+
+    // Meshes extracted for the dropped output have no component yet, only the ones not reused from the previous
+    // output need to be deleted.
+    TSet< UStaticMesh * > CurrentStaticMeshes;
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator Iter( StaticMeshes ); Iter; ++Iter )
+        CurrentStaticMeshes.Add( Iter.Value() );
+
+    TMap< FHoudiniGeoPartObject, UStaticMesh * > DroppedStaticMeshes;
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator Iter( PendingStaticMeshes ); Iter; ++Iter )
+    {
+        if ( Iter.Value() && !CurrentStaticMeshes.Contains( Iter.Value() ) )
+            DroppedStaticMeshes.Add( Iter.Key(), Iter.Value() );
     }
+
+    PendingStaticMeshes.Empty();
+
+    if ( DroppedStaticMeshes.Num() > 0 )
+        ReleaseObjectGeoPartResources( DroppedStaticMeshes, true );
+}
+
+bool
+UHoudiniAssetComponent::HasPendingPostCookWorkItems() const
+{
+    if ( FHoudiniEngine::IsInitialized() && FHoudiniEngine::Get().GetPostCookExecutor() )
+        return FHoudiniEngine::Get().GetPostCookExecutor()->HasWorkItems( this );
+
+    return false;
+}
+
+#if WITH_EDITOR
+
+void
+UHoudiniAssetComponent::CreateFullResolutionTextures()
+{
+    if ( !bHasDownsampledTextures || !FHoudiniEngineUtils::IsHoudiniAssetValid( AssetId ) )
+        return;
+
+    HAPI_AssetInfo AssetInfo;
+    if ( FHoudiniApi::GetAssetInfo( FHoudiniEngine::Get().GetSession(), AssetId, &AssetInfo ) != HAPI_RESULT_SUCCESS )
+        return;
+
+    TSet< HAPI_NodeId > UniqueMaterialIds;
+    TSet< HAPI_NodeId > UniqueInstancerMaterialIds;
+    TMap< FHoudiniGeoPartObject, HAPI_NodeId > InstancerMaterialMap;
+    FHoudiniEngineUtils::ExtractUniqueMaterialIds(
+        AssetInfo, UniqueMaterialIds, UniqueInstancerMaterialIds, InstancerMaterialMap );
+
+    // The cooked materials are regenerated in place, so the baked copies get the full resolution textures.
+    FHoudiniCookParams HoudiniCookParams( this );
+    HoudiniCookParams.StaticMeshBakeMode = FHoudiniCookParams::GetDefaultStaticMeshesCookMode();
+    HoudiniCookParams.MaterialAndTextureBakeMode = FHoudiniCookParams::GetDefaultMaterialAndTextureCookMode();
+
+    TMap< FString, UMaterialInterface * > Materials;
+    FHoudiniEngineMaterialUtils::HapiCreateMaterials(
+        AssetId, HoudiniCookParams, AssetInfo, UniqueMaterialIds,
+        UniqueInstancerMaterialIds, Materials, true );
+    FHoudiniEngineMaterialUtils::FinalizePendingMaterialUpdates();
+
+    bHasDownsampledTextures = false;
 }
 
+#endif
+
 
 void
 UHoudiniAssetComponent::ReleaseObjectGeoPartResources( bool bDeletePackages )
 {
+    // Pending work items would create components for the released meshes, drop them instead.
+    CancelPostCookWorkItems();
+
     ReleaseObjectGeoPartResources( StaticMeshes, bDeletePackages );
 }
 
@@ -1298,11 +1528,16 @@ UHoudiniAssetComponent::StopHoudiniTicking()
 }
 
 void
-UHoudiniAssetComponent::PostCook( bool bCookError )
+UHoudiniAssetComponent::PostCook(
+    bool bCookError, const TMap< FHoudiniGeoPartObject, UStaticMesh * > * SharedStaticMeshes,
+    const TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > & OutputSnapshot )
 {
     // Show busy cursor.
     FScopedBusyCursor ScopedBusyCursor;
 
+    // Output of the previous cook must be fully applied before it is replaced.
+    FinishPostCookWorkItems();
+
     // Create parameters and inputs.
     CreateParameters();
     CreateInputs();
@@ -1315,53 +1550,66 @@ UHoudiniAssetComponent::PostCook( bool bCookError )
         return;
     }
 
-    FTransform ComponentTransform;
-    TMap< FHoudiniGeoPartObject, UStaticMesh * > NewStaticMeshes;
-    
     FHoudiniCookParams HoudiniCookParams( this );
     HoudiniCookParams.StaticMeshBakeMode = FHoudiniCookParams::GetDefaultStaticMeshesCookMode();
     HoudiniCookParams.MaterialAndTextureBakeMode = FHoudiniCookParams::GetDefaultMaterialAndTextureCookMode();
 
-    if ( FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
-        GetAssetId(),
-        HoudiniCookParams,
-        !CheckGlobalSettingScaleFactors(),
-        bManualRecookRequested,
-        StaticMeshes, 
-        NewStaticMeshes, 
-        ComponentTransform ) )
-    {
-        // Remove all duplicates. After this operation, old map will have meshes which we need
-        // to deallocate.
-        for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator
-            Iter( NewStaticMeshes ); Iter; ++Iter )
-        {
-            const FHoudiniGeoPartObject HoudiniGeoPartObject = Iter.Key();
-            UStaticMesh * StaticMesh = Iter.Value();
+    // Cooked textures may be extracted at a lower resolution, they are extracted again at full resolution when baking.
+    const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+    if ( HoudiniRuntimeSettings && HoudiniRuntimeSettings->MaxCookedTextureResolution > 0 )
+    {
+        HoudiniCookParams.MaxTextureResolution = HoudiniRuntimeSettings->MaxCookedTextureResolution;
+        bHasDownsampledTextures = true;
+    }
 
-            // Removes the mesh from previous map of meshes
-            UStaticMesh * FoundOldStaticMesh = LocateStaticMesh( HoudiniGeoPartObject );
-            if ( ( FoundOldStaticMesh ) && ( FoundOldStaticMesh == StaticMesh ) )
+    if ( SharedStaticMeshes )
+    {
+        // Our node is shared, reuse the output extracted by the component which cooked it.
+        PendingStaticMeshes = *SharedStaticMeshes;
+        CommitStaticMeshes();
+    }
+    else
+    {
+        // Extracting the meshes walks the whole output and is a single work item, but each mesh is then built by
+        // its own work item: builds are the most expensive part of large outputs. The meshes are committed once
+        // they are all built, the work queued by these items is executed before the rest of the output.
+        const bool bForceRebuildStaticMesh = !CheckGlobalSettingScaleFactors();
+        const bool bForceRecookAll = bManualRecookRequested;
+        AddPostCookWorkItem( [ this, HoudiniCookParams, bForceRebuildStaticMesh, bForceRecookAll, OutputSnapshot ]() mutable
+        {
+            FHoudiniApiScopedSnapshot ScopedSnapshot( OutputSnapshot );
+
+            FTransform ComponentTransform;
+            TArray< UStaticMesh * > StaticMeshesToBuild;
+            PendingStaticMeshes.Empty();
+            if ( !FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
+                GetAssetId(), HoudiniCookParams, bForceRebuildStaticMesh, bForceRecookAll,
+                StaticMeshes, PendingStaticMeshes, ComponentTransform, &StaticMeshesToBuild ) )
             {
-                // Mesh has not changed, we need to remove it from the old map to avoid deallocation.
-                StaticMeshes.Remove( HoudiniGeoPartObject );
+                PendingStaticMeshes.Empty();
+                return;
             }
-        }
 
-        // Make sure rendering is done
-        FlushRenderingCommands();
-        
-        // Free meshes and components that are no longer used.
-        ReleaseObjectGeoPartResources(StaticMeshes, true);
+            for ( UStaticMesh * StaticMesh : StaticMeshesToBuild )
+            {
+                AddPostCookWorkItem( [ StaticMesh ]()
+                {
+                    TArray< FText > BuildErrors;
+                    FHoudiniEngineUtils::BuildStaticMesh( StaticMesh, BuildErrors );
+                    for ( int32 BuildErrorIdx = 0; BuildErrorIdx < BuildErrors.Num(); ++BuildErrorIdx )
+                    {
+                        HOUDINI_LOG_MESSAGE(
+                            TEXT( "Creating Static Meshes: Mesh [%s] build error - %s." ),
+                            *StaticMesh->GetName(), *( BuildErrors[ BuildErrorIdx ].ToString() ) );
+                    }
+                } );
+            }
 
-        // Set meshes and create new components for those meshes that do not have them.
-        if ( NewStaticMeshes.Num() > 0 )
-            CreateObjectGeoPartResources( NewStaticMeshes );
-        else
-            CreateStaticMeshHoudiniLogoResource( NewStaticMeshes );
+            AddPostCookWorkItem( [ this ]() { CommitStaticMeshes(); } );
+        } );
     }
 
-    // We can reset the manual recook flag now that the static meshes have been created
+    // We can reset the manual recook flag now that the static meshes extraction has been queued
     bManualRecookRequested = false;
 
     // Invoke cooks of downstream assets.
@@ -1378,6 +1626,46 @@ UHoudiniAssetComponent::PostCook( bool bCookError )
     }
 }
 
+void
+UHoudiniAssetComponent::CommitStaticMeshes()
+{
+    TMap< FHoudiniGeoPartObject, UStaticMesh * > NewStaticMeshes = MoveTemp( PendingStaticMeshes );
+    PendingStaticMeshes.Empty();
+
+    // Now that all the meshes are built, their navigation collision can be updated.
+    FHoudiniEngineUtils::UpdateStaticMeshNavigationCollision( NewStaticMeshes );
+
+    // Remove all duplicates. After this operation, old map will have meshes which we need
+    // to deallocate. Shared packed meshes may have moved to another geo part, so meshes are
+    // matched by value rather than by geo part.
+    TSet< UStaticMesh * > ReusedStaticMeshes;
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator
+        Iter( NewStaticMeshes ); Iter; ++Iter )
+    {
+        if ( Iter.Value() )
+            ReusedStaticMeshes.Add( Iter.Value() );
+    }
+
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator Iter( StaticMeshes ); Iter; ++Iter )
+    {
+        // Mesh has not changed, we need to remove it from the old map to avoid deallocation.
+        if ( Iter.Value() && ReusedStaticMeshes.Contains( Iter.Value() ) )
+            Iter.RemoveCurrent();
+    }
+
+    // Make sure rendering is done
+    FlushRenderingCommands();
+
+    // Free meshes and components that are no longer used.
+    ReleaseObjectGeoPartResources(StaticMeshes, true);
+
+    // Set meshes and create new components for those meshes that do not have them.
+    if ( NewStaticMeshes.Num() > 0 )
+        CreateObjectGeoPartResources( NewStaticMeshes );
+    else
+        CreateStaticMeshHoudiniLogoResource( NewStaticMeshes );
+}
+
 void
 UHoudiniAssetComponent::TickHoudiniComponent()
 {
@@ -1487,6 +1775,10 @@ UHoudiniAssetComponent::TickHoudiniComponent()
 
                 case EHoudiniEngineTaskState::FinishedCooking:
                 {
+                    // The task is processed again once the objects referenced by the output have been streamed in.
+                    if ( FHoudiniEngineUtils::IsValidAssetId( TaskInfo.AssetId ) && !AreReferencedObjectsLoaded( TaskInfo ) )
+                        break;
+
                     HOUDINI_LOG_MESSAGE( TEXT( "   %s FinishedCooking." ), *GetOwner()->GetName() );
 
                     if ( FHoudiniEngineUtils::IsValidAssetId( TaskInfo.AssetId ) )
@@ -1494,20 +1786,51 @@ UHoudiniAssetComponent::TickHoudiniComponent()
                         // Set new asset id.
                         SetAssetId( TaskInfo.AssetId );
 
-                        // Call post cook event.
-                        PostCook();
+                        // Apply the output over several frames, unless a batch cook needs it right away.
+                        const float PostCookFrameBudget = HoudiniRuntimeSettings ? HoudiniRuntimeSettings->PostCookFrameBudget : 0.0f;
+                        bDeferPostCookWorkItems = !bFinishPostCookImmediately && PostCookFrameBudget > 0.0f;
+                        bFinishPostCookImmediately = false;
+
+                        {
+                            // Serve output queries from the snapshot prefetched by the scheduler thread.
+                            FHoudiniApiScopedSnapshot ScopedSnapshot( TaskInfo.OutputSnapshot );
+
+                            // Call post cook event, the output is extracted within the snapshot as well.
+                            PostCook( false, nullptr, TaskInfo.OutputSnapshot );
+                        }
+
+                        const bool bDeferredPostCook = bDeferPostCookWorkItems;
+                        AddPostCookWorkItem( [ this, bDeferredPostCook ]()
+                        {
+                            // Make the output available to identical assets, only plain static mesh output can be shared.
+                            if ( InstanceInputs.Num() == 0 && SplineComponents.Num() == 0 && OutputCurveSegments.Num() == 0
+                                && LandscapeComponents.Num() == 0 && !bContainsHoudiniLogoGeometry )
+                            {
+                                FHoudiniCookCache::PublishCook( AssetId, StaticMeshes );
+                            }
+                            else
+                            {
+                                FHoudiniCookCache::InvalidateNode( AssetId );
+                            }
 
-                        // Need to update rendering information.
-                        UpdateRenderingInformation();
+                            // Need to update rendering information.
+                            UpdateRenderingInformation();
 
 #if WITH_EDITOR
-                        // Force editor to redraw viewports.
-                        if ( GEditor )
-                            GEditor->RedrawAllViewports();
+                            // Force editor to redraw viewports.
+                            if ( GEditor )
+                                GEditor->RedrawAllViewports();
 
-                        // Update properties panel after instantiation.
-                        UpdateEditorProperties( true );
+                            // Update properties panel after instantiation.
+                            UpdateEditorProperties( true );
 #endif
+
+                            // Ticking has stopped by now, the navigation system is updated when ticking.
+                            if ( bNeedToUpdateNavigationSystem && bDeferredPostCook )
+                                StartHoudiniTicking();
+                        } );
+
+                        bDeferPostCookWorkItems = false;
                     }
                     else
                     {
@@ -1541,6 +1864,9 @@ UHoudiniAssetComponent::TickHoudiniComponent()
 
                     if ( FHoudiniEngineUtils::IsValidAssetId( TaskInfo.AssetId ) )
                     {
+                        // Output of a failed cook cannot be shared.
+                        FHoudiniCookCache::InvalidateNode( TaskInfo.AssetId );
+
                         // Call post cook event with error parameter. This will create parameters, inputs and handles.
                         PostCook( true );
 
@@ -1681,7 +2007,8 @@ UHoudiniAssetComponent::TickHoudiniComponent()
     if (bFinishedLoadedInstantiation)
         bAssetIsBeingInstantiated = false;
 
-    if ( !IsInstantiatingOrCooking() )
+    // Changes are submitted once the output of the previous cook has been applied.
+    if ( !IsInstantiatingOrCooking() && !HasPendingPostCookWorkItems() )
     {
         if ( HasBeenInstantiatedButNotCooked() || bParametersChanged || bComponentNeedsCook || bManualRecookRequested )
         {
@@ -1691,6 +2018,10 @@ UHoudiniAssetComponent::TickHoudiniComponent()
             // We just submitted a task, we want to continue ticking.
             bStopTicking = false;
 
+            // Edits are never applied to a node shared with other assets, we request our own node instead.
+            if ( !bWaitingForUpstreamAssetsToInstantiate && !bLoadedComponentRequiresInstantiation && !bFinishedLoadedInstantiation )
+                ForkSharedNode();
+
             if ( bWaitingForUpstreamAssetsToInstantiate )
             {
                 // We are waiting for upstream assets to instantiate. Update the flag
@@ -1725,6 +2056,7 @@ UHoudiniAssetComponent::TickHoudiniComponent()
                 {
                     FHoudiniEngineUtils::SetAssetPreset( AssetId, PresetBuffer );
                     PresetBuffer.Empty();
+                    bCookKeyPresetValid = false;
                 }
 
                 // Upload changed parameters back to HAPI.
@@ -1733,8 +2065,9 @@ UHoudiniAssetComponent::TickHoudiniComponent()
                 // Reset tranform changed flag.
                 bComponentNeedsCook = false;
 
-                // Create asset cooking task object and submit it for processing.
-                StartTaskAssetCooking();
+                // Create asset cooking task object and submit it for processing, unless an identical asset has been cooked.
+                if ( !TryShareCookedNode() )
+                    StartTaskAssetCooking();
             }
             else
             {
@@ -1743,8 +2076,9 @@ UHoudiniAssetComponent::TickHoudiniComponent()
                     // Upload changed parameters back to HAPI.
                     UploadChangedParameters();
 
-                    // Create asset cooking task object and submit it for processing.
-                    StartTaskAssetCooking();
+                    // Create asset cooking task object and submit it for processing, unless an identical asset has been cooked.
+                    if ( bManualRecookRequested || !TryShareCookedNode() )
+                        StartTaskAssetCooking();
 
                     // Reset ComponentNeedsCook flag.
                     bComponentNeedsCook = false;
@@ -1788,7 +2122,7 @@ UHoudiniAssetComponent::TickHoudiniComponent()
         bNeedToUpdateNavigationSystem = false;
     }
 
-    if ( bStopTicking )
+    if ( bStopTicking || bWaitingForSharedCook )
         StopHoudiniTicking();
 }
 
@@ -1981,6 +2315,16 @@ UHoudiniAssetComponent::StartTaskAssetCookingManual()
     }
 }
 
+void
+UHoudiniAssetComponent::SetFinishPostCookImmediately( bool bInFinishPostCookImmediately )
+{
+    bFinishPostCookImmediately = bInFinishPostCookImmediately;
+
+    // Output of a previous cook which is still being applied is finished as well.
+    if ( bFinishPostCookImmediately )
+        FinishPostCookWorkItems();
+}
+
 void
 UHoudiniAssetComponent::StartTaskAssetResetManual()
 {
@@ -1990,6 +2334,7 @@ UHoudiniAssetComponent::StartTaskAssetResetManual()
         {
             if ( FHoudiniEngineUtils::SetAssetPreset( GetAssetId(), DefaultPresetBuffer ) )
             {
+                bCookKeyPresetValid = false;
                 UnmarkChangedParameters();
                 StartTaskAssetCookingManual();
             }
@@ -2056,6 +2401,10 @@ UHoudiniAssetComponent::StartTaskAssetDeletion()
 {
     if ( FHoudiniEngineUtils::IsValidAssetId( AssetId ) && bIsNativeComponent )
     {
+        // Shared nodes are only deleted by their last user.
+        if ( ReleaseSharedNode() )
+            return;
+
         // Generate GUID for our new task.
         FGuid HapiDeletionGUID = FGuid::NewGuid();
 
@@ -2084,6 +2433,10 @@ UHoudiniAssetComponent::StartTaskAssetCooking( bool bStartTicking )
         Task.AssetId = GetAssetId();
         FHoudiniEngine::Get().AddTask( Task );
 
+        // Identical assets can wait for this cook instead of submitting their own.
+        FHoudiniCookCache::RegisterCook( GetAssetId(), PendingCookKey, this );
+        PendingCookKey = FHoudiniCookKey();
+
         if ( bStartTicking )
             StartHoudiniTicking();
     }
@@ -2490,6 +2843,7 @@ UHoudiniAssetComponent::OnAssetPostImport( UFactory * Factory, UObject * Object
     RemoveAllAttachedComponents();
 
     // Release static mesh related resources.
+    CancelPostCookWorkItems();
     ReleaseObjectGeoPartResources( StaticMeshes );
     StaticMeshes.Empty();
     StaticMeshComponents.Empty();
@@ -2552,6 +2906,9 @@ UHoudiniAssetComponent::OnAssetPostImport( UFactory * Factory, UObject * Object
             SplineComponents.Add( HoudiniGeoPartObject, DuplicatedSplineComponent );
         }
     }
+
+    // Output curve lines are drawn once we are registered.
+    OutputCurveSegments = CopiedHoudiniComponent->OutputCurveSegments;
     
     /*
     // We need to duplicate landscapes.
@@ -2717,6 +3074,10 @@ UHoudiniAssetComponent::OnUpdateTransform( EUpdateTransformFlags UpdateTransform
 {
     Super::OnUpdateTransform( UpdateTransformFlags, Teleport );
 
+    // Batched lines are in world space, so they follow the component manually.
+    if ( OutputCurveSegments.Num() > 0 )
+        UpdateOutputCurveLines();
+
     CheckedUploadTransform();
 }
 
@@ -2726,8 +3087,8 @@ UHoudiniAssetComponent::CheckedUploadTransform()
     // Only if asset has been cooked.
     if ( AssetCookCount > 0 )
     {
-        // If we have to upload transforms.
-        if ( bUploadTransformsToHoudiniEngine )
+        // If we have to upload transforms. A shared node keeps the transform of the asset which cooked it.
+        if ( bUploadTransformsToHoudiniEngine && FHoudiniCookCache::GetNodeUserCount( AssetId ) < 2 )
         {
             // Retrieve the current component-to-world transform for this component.
             if ( !FHoudiniEngineUtils::HapiSetAssetTransform( AssetId, GetComponentTransform() ) )
@@ -2743,18 +3104,181 @@ UHoudiniAssetComponent::CheckedUploadTransform()
     }
 }
 
-void 
-UHoudiniAssetComponent::SetBakingBaseNameOverride( const FHoudiniGeoPartObject& GeoPartObject, const FString& BaseName )
+bool
+UHoudiniAssetComponent::ComputeCookKey( FHoudiniCookKey & CookKey )
 {
-    if( const FString* FoundOverride = BakeNameOverrides.Find( GeoPartObject ) )
+    CookKey = FHoudiniCookKey();
+
+    const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+    if ( !HoudiniRuntimeSettings || !HoudiniRuntimeSettings->bShareIdenticalCooks )
+        return false;
+
+    if ( !HoudiniAsset || !bIsNativeComponent || !FHoudiniEngineUtils::IsValidAssetId( AssetId ) )
+        return false;
+
+    // Handles, curves and downstream assets modify or reference our node directly, it cannot be shared.
+    if ( HandleComponents.Num() > 0 || SplineComponents.Num() > 0 || DownstreamAssetConnections.Num() > 0 )
+        return false;
+
+    CookKey.Inputs.SetNum( Inputs.Num() );
+    for ( int32 InputIdx = 0; InputIdx < Inputs.Num(); ++InputIdx )
     {
-        // forget the last baked package since we changed the name
-        if( *FoundOverride != BaseName )
+        if ( !Inputs[ InputIdx ] || !Inputs[ InputIdx ]->GetCookKey( CookKey.Inputs[ InputIdx ] ) )
+            return false;
+    }
+
+    // Preset only changes with our parameters, no need to fetch it again while waiting for a cook or on transform cooks.
+    if ( !bCookKeyPresetValid )
+    {
+        if ( !FHoudiniEngineUtils::GetHoudiniAssetName( AssetId, CookKeyAssetName )
+            || !FHoudiniEngineUtils::GetAssetPreset( AssetId, CookKeyPreset ) )
         {
-            BakedStaticMeshPackagesForParts.Remove( GeoPartObject );
+            return false;
         }
+
+        bCookKeyPresetValid = true;
     }
-    BakeNameOverrides.Add( GeoPartObject, BaseName );
+
+    CookKey.AssetPath = HoudiniAsset->GetPathName();
+    CookKey.AssetName = CookKeyAssetName;
+    CookKey.Preset = CookKeyPreset;
+
+    // Transform only affects the output if it triggers cooks.
+    if ( bTransformChangeTriggersCooks )
+        CookKey.Transform = GetComponentTransform().ToString();
+    else
+        CookKey.Transform.Empty();
+
+    CookKey.UpdateHash();
+    return CookKey.IsValid();
+}
+
+bool
+UHoudiniAssetComponent::TryShareCookedNode()
+{
+    bWaitingForSharedCook = false;
+
+    if ( !ComputeCookKey( PendingCookKey ) )
+        return false;
+
+    HAPI_NodeId SharedAssetId = -1;
+    TMap< FHoudiniGeoPartObject, UStaticMesh * > SharedStaticMeshes;
+    EHoudiniCookCacheResult::Type Result =
+        FHoudiniCookCache::FindNode( PendingCookKey, AssetId, SharedAssetId, SharedStaticMeshes );
+
+    if ( Result == EHoudiniCookCacheResult::Cooking )
+    {
+        // An identical asset is being cooked, wait for its output instead of cooking the same data twice.
+        // Only the first cook waits, edits are never delayed. We stop ticking until the cache notifies us.
+        if ( AssetCookCount != 0 || !FHoudiniCookCache::WaitForCook( PendingCookKey, this ) )
+            return false;
+
+        bWaitingForSharedCook = true;
+        return true;
+    }
+
+    if ( Result != EHoudiniCookCacheResult::Cooked )
+        return false;
+
+    HOUDINI_LOG_MESSAGE( TEXT( "%s sharing cook of asset id %d." ), *GetOwner()->GetName(), SharedAssetId );
+
+    // Our own node is no longer needed.
+    StartTaskAssetDeletion();
+
+    SetAssetId( SharedAssetId );
+    FHoudiniCookCache::AcquireNode( AssetId, this );
+    PendingCookKey = FHoudiniCookKey();
+
+    // Point our parameters and inputs at the shared node.
+    UpdateLoadedParameters();
+    for ( int32 InputIdx = 0; InputIdx < Inputs.Num(); ++InputIdx )
+    {
+        if ( Inputs[ InputIdx ] )
+            Inputs[ InputIdx ]->SetNodeId( AssetId );
+    }
+
+    // Call post cook event with the shared output.
+    PostCook( false, &SharedStaticMeshes );
+    AssetCookCount++;
+
+    // Need to update rendering information.
+    UpdateRenderingInformation();
+
+    // Force editor to redraw viewports.
+    if ( GEditor )
+        GEditor->RedrawAllViewports();
+
+    // Update properties panel.
+    UpdateEditorProperties( true );
+
+    return true;
+}
+
+bool
+UHoudiniAssetComponent::IsWaitingForSharedCook() const
+{
+    return bWaitingForSharedCook;
+}
+
+void
+UHoudiniAssetComponent::OnSharedCookFinished()
+{
+    if ( !bWaitingForSharedCook )
+        return;
+
+    // The next tick looks up the shared cook again, and cooks our own node if it can no longer be shared.
+    bWaitingForSharedCook = false;
+
+#if WITH_EDITOR
+    StartHoudiniTicking();
+#endif
+}
+
+bool
+UHoudiniAssetComponent::ForkSharedNode()
+{
+    if ( FHoudiniCookCache::GetNodeUserCount( AssetId ) < 2 )
+        return false;
+
+    HOUDINI_LOG_MESSAGE( TEXT( "%s no longer sharing cook of asset id %d." ), *GetOwner()->GetName(), AssetId );
+
+    // Keep the current state of the shared node, our own changes are uploaded once our node is instantiated.
+    if ( !FHoudiniEngineUtils::GetAssetPreset( AssetId, PresetBuffer ) )
+        PresetBuffer.Empty();
+
+    ReleaseSharedNode();
+
+    // Instantiate our own node the same way loaded components do.
+    bLoadedComponentRequiresInstantiation = true;
+    return true;
+}
+
+bool
+UHoudiniAssetComponent::ReleaseSharedNode()
+{
+    if ( !FHoudiniEngineUtils::IsValidAssetId( AssetId ) )
+        return false;
+
+    if ( FHoudiniCookCache::ReleaseNode( AssetId, this ) )
+        return false;
+
+    // Other assets still use the node, only forget about it.
+    AssetId = -1;
+    return true;
+}
+
+void 
+UHoudiniAssetComponent::SetBakingBaseNameOverride( const FHoudiniGeoPartObject& GeoPartObject, const FString& BaseName )
+{
+    if( const FString* FoundOverride = BakeNameOverrides.Find( GeoPartObject ) )
+    {
+        // forget the last baked package since we changed the name
+        if( *FoundOverride != BaseName )
+        {
+            BakedStaticMeshPackagesForParts.Remove( GeoPartObject );
+        }
+    }
+    BakeNameOverrides.Add( GeoPartObject, BaseName );
 }
 
 bool 
@@ -2929,6 +3453,12 @@ UHoudiniAssetComponent::OnComponentCreated()
 void
 UHoudiniAssetComponent::OnComponentDestroyed( bool bDestroyingHierarchy )
 {
+    // Leave a node shared with other assets untouched when our inputs are destroyed.
+    ReleaseSharedNode();
+
+    // Drop the output which has not been applied yet.
+    CancelPostCookWorkItems();
+
     // Release static mesh related resources.
     ReleaseObjectGeoPartResources( StaticMeshes );
     StaticMeshes.Empty();
@@ -2972,6 +3502,10 @@ UHoudiniAssetComponent::OnRegister()
 {
     Super::OnRegister();
 
+    // The line batch is not serialized, only the segments it draws.
+    if ( OutputCurveSegments.Num() > 0 )
+        UpdateOutputCurveLines();
+
     // We need to recreate render states for loaded components.
     if ( bLoadedComponent )
     {
@@ -3405,6 +3939,18 @@ UHoudiniAssetComponent::Serialize( FArchive & Ar )
         }
     }
 
+    // Serialize the volume textures, they are stored in the cook's temporary packages.
+    if ( HoudiniAssetComponentVersion >= VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_VOLUME_TEXTURES )
+    {
+        Ar << VolumeTextures;
+    }
+
+    // Serialize the output curve lines, the line batch drawing them is recreated when registered.
+    if ( HoudiniAssetComponentVersion >= VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_OUTPUT_CURVE_LINES )
+    {
+        Ar << OutputCurveSegments;
+    }
+
     if ( Ar.IsLoading() && bIsNativeComponent )
     {
         // This component has been loaded.
@@ -3483,6 +4029,9 @@ UHoudiniAssetComponent::CloneComponentsAndCreateActor()
     // Display busy cursor.
     FScopedBusyCursor ScopedBusyCursor;
 
+    // Bake the complete output of the last cook.
+    FinishPostCookWorkItems();
+
     ULevel * Level = GetHoudiniAssetActorOwner()->GetLevel();
     if ( !Level )
         Level = GWorld->GetCurrentLevel();
@@ -3836,67 +4385,28 @@ UHoudiniAssetComponent::CreateCurves( const TArray< FHoudiniGeoPartObject > & Fo
 {
     bool bCurveCreated = false;
 
-    TMap< FHoudiniGeoPartObject, UHoudiniSplineComponent * > NewSplineComponents;
-    for ( TArray< FHoudiniGeoPartObject >::TConstIterator Iter( FoundCurves ); Iter; ++Iter )
+    // Spline components of the curves which are not part of this cook are reused for the new curves,
+    // instead of being destroyed while new components are created.
+    TSet< FHoudiniGeoPartObject > FoundCurveParts( FoundCurves );
+    TArray< UHoudiniSplineComponent * > SplineComponentPool;
+    for ( TMap< FHoudiniGeoPartObject, UHoudiniSplineComponent * >::TIterator Iter( SplineComponents ); Iter; ++Iter )
     {
-        const FHoudiniGeoPartObject & HoudiniGeoPartObject = *Iter;
-
-        // Retrieve node id from geo part.
-        HAPI_NodeId NodeId = HoudiniGeoPartObject.HapiGeoGetNodeId( AssetId );
-        if ( NodeId == -1 )
-        {
-            // Invalid node id.
-            continue;
-        }
-
-        if ( !HoudiniGeoPartObject.HasParameters( AssetId ) )
-        {
-            // We have no parameters on this curve.
+        if ( FoundCurveParts.Contains( Iter.Key() ) )
             continue;
-        }
-
-        // We need to cook the spline node.
-        FHoudiniApi::CookNode(FHoudiniEngine::Get().GetSession(), NodeId, nullptr);
 
-        FString CurvePointsString;
-        EHoudiniSplineComponentType::Enum CurveTypeValue = EHoudiniSplineComponentType::Bezier;
-        EHoudiniSplineComponentMethod::Enum CurveMethodValue = EHoudiniSplineComponentMethod::CVs;
-        int32 CurveClosed = 1;
-
-        HAPI_AttributeInfo AttributeRefinedCurvePositions;
-        FMemory::Memzero< HAPI_AttributeInfo >( AttributeRefinedCurvePositions );
-
-        TArray< float > RefinedCurvePositions;
-        if ( !FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
-            HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_POSITION,
-            AttributeRefinedCurvePositions, RefinedCurvePositions ) )
-        {
-            continue;
-        }
-
-        if ( !AttributeRefinedCurvePositions.exists && RefinedCurvePositions.Num() > 0 )
-            continue;
-
-        // Transfer refined positions to position vector and perform necessary axis swap.
-        TArray< FVector > CurveDisplayPoints;
-        FHoudiniEngineUtils::ConvertScaleAndFlipVectorData( RefinedCurvePositions, CurveDisplayPoints );
-
-        if ( !FHoudiniEngineUtils::HapiGetParameterDataAsString(
-                NodeId, HAPI_UNREAL_PARAM_CURVE_COORDS, TEXT(""), CurvePointsString) ||
-           !FHoudiniEngineUtils::HapiGetParameterDataAsInteger(
-               NodeId, HAPI_UNREAL_PARAM_CURVE_TYPE, (int32) EHoudiniSplineComponentType::Bezier, (int32&) CurveTypeValue ) ||
-           !FHoudiniEngineUtils::HapiGetParameterDataAsInteger(
-               NodeId, HAPI_UNREAL_PARAM_CURVE_METHOD, (int32) EHoudiniSplineComponentMethod::CVs, (int32&) CurveMethodValue ) ||
-           !FHoudiniEngineUtils::HapiGetParameterDataAsInteger(
-               NodeId, HAPI_UNREAL_PARAM_CURVE_CLOSED, 1, CurveClosed ) )
+        UHoudiniSplineComponent * SplineComponent = Iter.Value();
+        if ( SplineComponent && !SplineComponent->IsPendingKill() && !SplineComponent->IsInputCurve() )
         {
-            continue;
+            SplineComponentPool.Add( SplineComponent );
+            Iter.RemoveCurrent();
         }
+    }
 
-        // Process coords string and extract positions.
-        TArray< FVector > CurvePositions;
-        FHoudiniEngineUtils::ExtractStringPositions( CurvePointsString, CurvePositions );
+    TMap< FHoudiniGeoPartObject, UHoudiniSplineComponent * > NewSplineComponents;
 
+    // Reuse the spline component of a curve, or of a curve which is gone, or create a new one.
+    auto AcquireSplineComponent = [ & ]( const FHoudiniGeoPartObject & HoudiniGeoPartObject )
+    {
         // Check if this curve already exists.
         UHoudiniSplineComponent * HoudiniSplineComponent = LocateSplineComponent( HoudiniGeoPartObject );
 
@@ -3906,6 +4416,11 @@ UHoudiniAssetComponent::CreateCurves( const TArray< FHoudiniGeoPartObject > & Fo
             // Remove it from old map.
             SplineComponents.Remove( HoudiniGeoPartObject );
         }
+        else if ( SplineComponentPool.Num() > 0 )
+        {
+            // Reuse the component of a curve which is gone, Construct will reset its state.
+            HoudiniSplineComponent = SplineComponentPool.Pop( false );
+        }
         else
         {
             // We need to create a new curve.
@@ -3935,6 +4450,72 @@ UHoudiniAssetComponent::CreateCurves( const TArray< FHoudiniGeoPartObject > & Fo
         // Transform the component by transformation provided by HAPI.
         HoudiniSplineComponent->SetRelativeTransform( HoudiniGeoPartObject.TransformMatrix );
 
+        return HoudiniSplineComponent;
+    };
+
+    // Curves without control point parameters are output curves, they cannot be edited.
+    TArray< FHoudiniGeoPartObject > OutputCurves;
+
+    for ( TArray< FHoudiniGeoPartObject >::TConstIterator Iter( FoundCurves ); Iter; ++Iter )
+    {
+        const FHoudiniGeoPartObject & HoudiniGeoPartObject = *Iter;
+
+        // Retrieve node id from geo part.
+        HAPI_NodeId NodeId = HoudiniGeoPartObject.HapiGeoGetNodeId( AssetId );
+        if ( NodeId == -1 )
+        {
+            // Invalid node id.
+            continue;
+        }
+
+        if ( !HoudiniGeoPartObject.HasParameters( AssetId )
+            || FHoudiniEngineUtils::HapiFindParameterByNameOrTag( NodeId, HAPI_UNREAL_PARAM_CURVE_COORDS ) < 0 )
+        {
+            // We have no curve parameters on this curve.
+            OutputCurves.Add( HoudiniGeoPartObject );
+            continue;
+        }
+
+        // A curve whose geometry has not changed keeps its spline component as it is, without cooking
+        // its node or reading its points and parameters back.
+        UHoudiniSplineComponent * UnchangedSplineComponent = LocateSplineComponent( HoudiniGeoPartObject );
+        if ( UnchangedSplineComponent && !HoudiniGeoPartObject.HasGeoChanged() && !UnchangedSplineComponent->IsPendingKill() )
+        {
+            SplineComponents.Remove( HoudiniGeoPartObject );
+            UnchangedSplineComponent->SetHoudiniGeoPartObject( HoudiniGeoPartObject );
+            UnchangedSplineComponent->SetRelativeTransform( HoudiniGeoPartObject.TransformMatrix );
+            NewSplineComponents.Add( HoudiniGeoPartObject, UnchangedSplineComponent );
+            continue;
+        }
+
+        // We need to cook the spline node.
+        FHoudiniApi::CookNode(FHoudiniEngine::Get().GetSession(), NodeId, nullptr);
+
+        // Refined positions of all the points, retrieved in one call, with the necessary axis swap.
+        TArray< FVector > CurveDisplayPoints;
+        TArray< int32 > CurveCounts;
+        bool bCurvePeriodic = false;
+        if ( !FHoudiniEngineUtils::HapiGetCurvePoints( HoudiniGeoPartObject, CurveDisplayPoints, CurveCounts, bCurvePeriodic ) )
+            continue;
+
+        // The coords, type, method and closed parameters are looked up by name or tag, and the integer values
+        // of the node are read in a single call.
+        FString CurvePointsString;
+        int32 CurveType = (int32) EHoudiniSplineComponentType::Bezier;
+        int32 CurveMethod = (int32) EHoudiniSplineComponentMethod::CVs;
+        int32 CurveClosed = 1;
+        if ( !FHoudiniEngineUtils::HapiGetCurveParameters( NodeId, CurvePointsString, CurveType, CurveMethod, CurveClosed ) )
+            continue;
+
+        EHoudiniSplineComponentType::Enum CurveTypeValue = (EHoudiniSplineComponentType::Enum) CurveType;
+        EHoudiniSplineComponentMethod::Enum CurveMethodValue = (EHoudiniSplineComponentMethod::Enum) CurveMethod;
+
+        // Process coords string and extract positions.
+        TArray< FVector > CurvePositions;
+        FHoudiniEngineUtils::ExtractStringPositions( CurvePointsString, CurvePositions );
+
+        UHoudiniSplineComponent * HoudiniSplineComponent = AcquireSplineComponent( HoudiniGeoPartObject );
+
         // Create Transform for the HoudiniSplineComponents
         TArray< FTransform > CurvePoints;
         CurvePoints.SetNumUninitialized(CurvePositions.Num());
@@ -3952,6 +4533,72 @@ UHoudiniAssetComponent::CreateCurves( const TArray< FHoudiniGeoPartObject > & Fo
             CurveMethodValue, ( CurveClosed == 1 ) );
     }
 
+    // The points of all the output curves of a part are read at once.
+    TArray< TArray< FVector > > OutputCurvePositions;
+    TArray< TArray< int32 > > OutputCurveCounts;
+    TArray< bool > OutputCurvePeriodic;
+    int32 OutputCurveCount = 0;
+    for ( int32 CurveIdx = 0; CurveIdx < OutputCurves.Num(); ++CurveIdx )
+    {
+        TArray< FVector > & CurvePositions = OutputCurvePositions[ OutputCurvePositions.AddDefaulted() ];
+        TArray< int32 > & CurveCounts = OutputCurveCounts[ OutputCurveCounts.AddDefaulted() ];
+        bool & bPeriodic = OutputCurvePeriodic[ OutputCurvePeriodic.Add( false ) ];
+
+        if ( OutputCurves[ CurveIdx ].IsVisible()
+            && FHoudiniEngineUtils::HapiGetCurvePoints( OutputCurves[ CurveIdx ], CurvePositions, CurveCounts, bPeriodic ) )
+        {
+            OutputCurveCount += CurveCounts.Num();
+        }
+        else
+        {
+            CurveCounts.Empty();
+        }
+    }
+
+    // Output curves get a spline component each, unless there are more of them than the threshold: road networks
+    // and similar outputs hold thousands of curves, they are all drawn by a single line batch instead. A spline
+    // component displays a single curve, so parts holding several curves always go to the line batch.
+    const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+    const int32 CurveLineBatchThreshold = HoudiniRuntimeSettings ? HoudiniRuntimeSettings->CurveLineBatchThreshold : 0;
+    const bool bBatchOutputCurves = CurveLineBatchThreshold > 0 && OutputCurveCount > CurveLineBatchThreshold;
+
+    TArray< FVector > CurveSegments;
+    for ( int32 CurveIdx = 0; CurveIdx < OutputCurves.Num(); ++CurveIdx )
+    {
+        const FHoudiniGeoPartObject & HoudiniGeoPartObject = OutputCurves[ CurveIdx ];
+        const TArray< FVector > & CurvePositions = OutputCurvePositions[ CurveIdx ];
+        const TArray< int32 > & CurveCounts = OutputCurveCounts[ CurveIdx ];
+        const bool bPeriodic = OutputCurvePeriodic[ CurveIdx ];
+        if ( CurveCounts.Num() <= 0 )
+            continue;
+
+        if ( !bBatchOutputCurves && CurveCounts.Num() == 1 )
+        {
+            UHoudiniSplineComponent * HoudiniSplineComponent = AcquireSplineComponent( HoudiniGeoPartObject );
+            HoudiniSplineComponent->Construct(
+                HoudiniGeoPartObject, CurvePositions, EHoudiniSplineComponentType::Polygon,
+                EHoudiniSplineComponentMethod::CVs, bPeriodic );
+
+            continue;
+        }
+
+        int32 CurveStart = 0;
+        for ( int32 CountIdx = 0; CountIdx < CurveCounts.Num(); ++CountIdx )
+        {
+            const int32 CurvePointCount = CurveCounts[ CountIdx ];
+            const int32 SegmentCount = bPeriodic && CurvePointCount > 2 ? CurvePointCount : CurvePointCount - 1;
+            for ( int32 SegmentIdx = 0; SegmentIdx < SegmentCount; ++SegmentIdx )
+            {
+                CurveSegments.Add( HoudiniGeoPartObject.TransformMatrix.TransformPosition(
+                    CurvePositions[ CurveStart + SegmentIdx ] ) );
+                CurveSegments.Add( HoudiniGeoPartObject.TransformMatrix.TransformPosition(
+                    CurvePositions[ CurveStart + ( SegmentIdx + 1 ) % CurvePointCount ] ) );
+            }
+
+            CurveStart += CurvePointCount;
+        }
+    }
+
 #if WITH_EDITOR
     // The editor caches the current selection visualizer, so we need to trick
     // and pretend the selection has changed so that the HSplineVisualizer can be drawn immediately
@@ -3959,8 +4606,20 @@ UHoudiniAssetComponent::CreateCurves( const TArray< FHoudiniGeoPartObject > & Fo
         GUnrealEd->NoteSelectionChange();
 #endif
 
+    // Release the pooled components which were not reused along with the remaining old curves.
+    for ( int32 PoolIdx = 0; PoolIdx < SplineComponentPool.Num(); ++PoolIdx )
+    {
+        UHoudiniSplineComponent * SplineComponent = SplineComponentPool[ PoolIdx ];
+        SplineComponent->DetachFromComponent( FDetachmentTransformRules::KeepRelativeTransform );
+        SplineComponent->UnregisterComponent();
+        SplineComponent->DestroyComponent();
+    }
+
     ClearCurves();
     SplineComponents = NewSplineComponents;
+
+    OutputCurveSegments = MoveTemp( CurveSegments );
+    UpdateOutputCurveLines();
 }
 
 void
@@ -4003,6 +4662,7 @@ UHoudiniAssetComponent::NotifyParameterChanged( UHoudiniAssetParameter * Houdini
     }
 
     bParametersChanged = true;
+    bCookKeyPresetValid = false;
     StartHoudiniTicking();
 }
 
@@ -4069,6 +4729,10 @@ UHoudiniAssetComponent::UploadChangedParameters()
         HOUDINI_LOG_ERROR(TEXT("%s UploadChangedParameters failed"), *GetOwner()->GetName());
     }
 
+    // Uploaded values are part of the preset used by the cook key.
+    if ( bParametersChanged )
+        bCookKeyPresetValid = false;
+
     // We no longer have changed parameters.
     bParametersChanged = false;
 }
@@ -4412,50 +5076,61 @@ UHoudiniAssetComponent::LocateInstanceInput( const FHoudiniGeoPartObject& GeoPar
 void
 UHoudiniAssetComponent::CreateInstanceInputs( const TArray< FHoudiniGeoPartObject > & Instancers )
 {
-    TArray< UHoudiniAssetInstanceInput * > NewInstanceInputs;
+    PendingInstanceInputs.Empty();
 
     for ( const FHoudiniGeoPartObject& GeoPart : Instancers )
     {
         if ( GeoPart.IsVisible() )
-        {
-            // Check if this instance input already exists.
-            UHoudiniAssetInstanceInput * HoudiniAssetInstanceInput = nullptr;
+            AddPostCookWorkItem( [ this, GeoPart ]() { CreateInstanceInput( GeoPart ); } );
+    }
 
-            if ( UHoudiniAssetInstanceInput * FoundHoudiniAssetInstanceInput = LocateInstanceInput( GeoPart ) )
-            {
-                // Input already exists, we can reuse it.
-                HoudiniAssetInstanceInput = FoundHoudiniAssetInstanceInput;
+    // Clear all the existing instance inputs and replace with the new
+    AddPostCookWorkItem( [ this ]() { CommitInstanceInputs(); } );
+}
 
-                // Since this is the corresponding part, we will refresh the InstanceInput's GeoPart
-                HoudiniAssetInstanceInput->SetGeoPartObject( GeoPart );
+void
+UHoudiniAssetComponent::CreateInstanceInput( const FHoudiniGeoPartObject & Instancer )
+{
+    // Check if this instance input already exists.
+    UHoudiniAssetInstanceInput * HoudiniAssetInstanceInput = nullptr;
 
-                // Remove it from old map.
-                InstanceInputs.Remove( FoundHoudiniAssetInstanceInput );
-            }
-            else
-            {
-                // Otherwise we need to create new instance input.
-                HoudiniAssetInstanceInput = UHoudiniAssetInstanceInput::Create( this, GeoPart );
-            }
+    if ( UHoudiniAssetInstanceInput * FoundHoudiniAssetInstanceInput = LocateInstanceInput( Instancer ) )
+    {
+        // Input already exists, we can reuse it.
+        HoudiniAssetInstanceInput = FoundHoudiniAssetInstanceInput;
 
-            if ( !HoudiniAssetInstanceInput )
-            {
-                // Invalid instance input.
-                HOUDINI_LOG_WARNING( TEXT( "%s: Failed to create Instancer from part %s" ), *GetOwner()->GetName(), *GeoPart.GetNodePath() );
-            }
-            else
-            {
-                // Add input to new map.
-                NewInstanceInputs.Add( HoudiniAssetInstanceInput );
-                // Create or re-create this input.
-                HoudiniAssetInstanceInput->CreateInstanceInput();
-            }
-        }
+        // Since this is the corresponding part, we will refresh the InstanceInput's GeoPart
+        HoudiniAssetInstanceInput->SetGeoPartObject( Instancer );
+
+        // Remove it from old map.
+        InstanceInputs.Remove( FoundHoudiniAssetInstanceInput );
+    }
+    else
+    {
+        // Otherwise we need to create new instance input.
+        HoudiniAssetInstanceInput = UHoudiniAssetInstanceInput::Create( this, Instancer );
     }
 
-    // Clear all the existing instance inputs and replace with the new
+    if ( !HoudiniAssetInstanceInput )
+    {
+        // Invalid instance input.
+        HOUDINI_LOG_WARNING( TEXT( "%s: Failed to create Instancer from part %s" ), *GetOwner()->GetName(), *Instancer.GetNodePath() );
+    }
+    else
+    {
+        // Add input to new map.
+        PendingInstanceInputs.Add( HoudiniAssetInstanceInput );
+        // Create or re-create this input.
+        HoudiniAssetInstanceInput->CreateInstanceInput();
+    }
+}
+
+void
+UHoudiniAssetComponent::CommitInstanceInputs()
+{
     ClearInstanceInputs();
-    InstanceInputs = NewInstanceInputs;
+    InstanceInputs = PendingInstanceInputs;
+    PendingInstanceInputs.Empty();
 }
 
 void
@@ -4615,6 +5290,41 @@ UHoudiniAssetComponent::CreateAllLandscapes( const TArray< FHoudiniGeoPartObject
     return true;
 }
 
+bool
+UHoudiniAssetComponent::CreateVolumeTextures( const TArray< FHoudiniGeoPartObject > & FoundVolumes )
+{
+    const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+    if ( !HoudiniRuntimeSettings || !HoudiniRuntimeSettings->MarshallingVolumesAsTextures )
+    {
+        VolumeTextures.Empty();
+        return false;
+    }
+
+    FHoudiniCookParams HoudiniCookParams( this );
+    HoudiniCookParams.StaticMeshBakeMode = FHoudiniCookParams::GetDefaultStaticMeshesCookMode();
+    HoudiniCookParams.MaterialAndTextureBakeMode = FHoudiniCookParams::GetDefaultMaterialAndTextureCookMode();
+
+    // Heightfields and their layers are skipped by the texture creation, they become landscapes.
+    TMap< FHoudiniGeoPartObject, UTexture2D * > NewVolumeTextures;
+    for ( const FHoudiniGeoPartObject & HoudiniGeoPartObject : FoundVolumes )
+    {
+        UTexture2D * VolumeTexture = FHoudiniEngineMaterialUtils::HapiCreateVolumeTexture(
+            HoudiniCookParams, HoudiniGeoPartObject,
+            HoudiniRuntimeSettings->MarshallingVolumeTexturesDownsampling,
+            HoudiniRuntimeSettings->MarshallingVolumeTexturesUseHalfFloat );
+
+        if ( VolumeTexture )
+            NewVolumeTextures.Add( HoudiniGeoPartObject, VolumeTexture );
+    }
+
+    VolumeTextures = NewVolumeTextures;
+
+    // The new textures have to be up to date before material instances reference them.
+    FHoudiniEngineMaterialUtils::FinalizePendingMaterialUpdates();
+
+    return VolumeTextures.Num() > 0;
+}
+
 void UHoudiniAssetComponent::UpdateLandscapeMaterialsAssignementsAndReplacements( ALandscape* Landscape, FHoudiniGeoPartObject Heightfield )
 {
     if ( !Landscape )
@@ -4756,6 +5466,56 @@ UHoudiniAssetComponent::ClearCurves()
     }
 
     SplineComponents.Empty();
+
+    OutputCurveSegments.Empty();
+    if ( CurveLineBatchComponent && !CurveLineBatchComponent->IsPendingKill() )
+    {
+        CurveLineBatchComponent->DetachFromComponent( FDetachmentTransformRules::KeepRelativeTransform );
+        CurveLineBatchComponent->UnregisterComponent();
+        CurveLineBatchComponent->DestroyComponent();
+    }
+
+    CurveLineBatchComponent = nullptr;
+}
+
+void
+UHoudiniAssetComponent::UpdateOutputCurveLines()
+{
+    if ( OutputCurveSegments.Num() <= 0 )
+    {
+        if ( CurveLineBatchComponent )
+            CurveLineBatchComponent->Flush();
+
+        return;
+    }
+
+    if ( !CurveLineBatchComponent || CurveLineBatchComponent->IsPendingKill() )
+    {
+        if ( !GetOwner() || !GetWorld() )
+            return;
+
+        // The line batch is drawn in game as well, it is rebuilt from the serialized segments.
+        CurveLineBatchComponent = NewObject< ULineBatchComponent >(
+            GetOwner(), ULineBatchComponent::StaticClass(), NAME_None, RF_Transient );
+
+        CurveLineBatchComponent->AttachToComponent( this, FAttachmentTransformRules::KeepRelativeTransform );
+        CurveLineBatchComponent->RegisterComponent();
+    }
+
+    // Batched lines are drawn in world space, lines without lifetime persist until flushed.
+    const FTransform & ComponentTransform = GetComponentTransform();
+    TArray< FBatchedLine > CurveLines;
+    CurveLines.Reserve( OutputCurveSegments.Num() / 2 );
+    for ( int32 PointIdx = 0; PointIdx + 1 < OutputCurveSegments.Num(); PointIdx += 2 )
+    {
+        CurveLines.Add( FBatchedLine(
+            ComponentTransform.TransformPosition( OutputCurveSegments[ PointIdx ] ),
+            ComponentTransform.TransformPosition( OutputCurveSegments[ PointIdx + 1 ] ),
+            FLinearColor::White, 0.0f, 0.0f, SDPG_World ) );
+    }
+
+    CurveLineBatchComponent->Flush();
+    CurveLineBatchComponent->DrawLines( CurveLines );
 }
 
 void
@@ -5364,88 +6124,118 @@ UHoudiniAssetComponent::RemoveReplacementMaterial(
 
 bool
 UHoudiniAssetComponent::CreateOrUpdateMaterialInstances()
+{
+    bool bMaterialReplaced = false;
+
+    // 1. FOR STATIC MESHES
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator Iter( StaticMeshes ); Iter; ++Iter )
+    {
+        if ( CreateOrUpdateStaticMeshMaterialInstances( Iter.Key(), Iter.Value() ) )
+            bMaterialReplaced = true;
+    }
+
+    // 2. FOR LANDSCAPES
+    if ( CreateOrUpdateLandscapeMaterialInstances() )
+        bMaterialReplaced = true;
+
+#if WITH_EDITOR
+    if ( bMaterialReplaced )
+        UpdateEditorProperties( false );
+#endif
+
+    return bMaterialReplaced;
+}
+
+bool
+UHoudiniAssetComponent::CreateOrUpdateStaticMeshMaterialInstances(
+    const FHoudiniGeoPartObject & HoudiniGeoPartObject, UStaticMesh * StaticMesh )
 {
 #if WITH_EDITOR
+    // Invisible meshes are used for instancers, so we will not skip them as the material instance/parameter attributes
+    // need to be set on the "source" mesh 
+    if ( !StaticMesh )
+        return false;
+
     FHoudiniCookParams HoudiniCookParams( this );
     HoudiniCookParams.PackageGUID = ComponentGUID;
     HoudiniCookParams.MaterialAndTextureBakeMode = FHoudiniCookParams::GetDefaultMaterialAndTextureCookMode();
 
     bool bMaterialReplaced = false;
 
-    // 1. FOR STATIC MESHES
     // Handling the creation of material instances from attributes    
-    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator Iter( StaticMeshes ); Iter; ++Iter )
+    // Replace the source material with the newly created/updated instance
+    for( int32 MatIdx = 0; MatIdx < StaticMesh->StaticMaterials.Num(); MatIdx++ )
     {
-        const FHoudiniGeoPartObject HoudiniGeoPartObject = Iter.Key();
-        UStaticMesh * StaticMesh = Iter.Value();
-
-        // Invisible meshes are used for instancers, so we will not skip them as the material instance/parameter attributes
-        // need to be set on the "source" mesh 
-        //if ( !HoudiniGeoPartObject.IsVisible() )
-        //    continue;
+        // The "source" material we want to create an instance of should have already been assigned to the mesh
+        UMaterialInstance* NewMaterialInstance = nullptr;
+        UMaterialInterface* SourceMaterialInterface = nullptr;
 
-        if ( !StaticMesh )
+        // Create a new material instance if needed and update its parameter if needed
+        if (!FHoudiniEngineMaterialUtils::CreateMaterialInstances(
+            HoudiniGeoPartObject, HoudiniCookParams, NewMaterialInstance, SourceMaterialInterface, 
+            HAPI_UNREAL_ATTRIB_MATERIAL_INSTANCE, MatIdx ) )
             continue;
 
-        // Replace the source material with the newly created/updated instance
-        for( int32 MatIdx = 0; MatIdx < StaticMesh->StaticMaterials.Num(); MatIdx++ )
-        {
-            // The "source" material we want to create an instance of should have already been assigned to the mesh
-            UMaterialInstance* NewMaterialInstance = nullptr;
-            UMaterialInterface* SourceMaterialInterface = nullptr;
-
-            // Create a new material instance if needed and update its parameter if needed
-            if (!FHoudiniEngineMaterialUtils::CreateMaterialInstances(
-                HoudiniGeoPartObject, HoudiniCookParams, NewMaterialInstance, SourceMaterialInterface, 
-                HAPI_UNREAL_ATTRIB_MATERIAL_INSTANCE, MatIdx ) )
-                continue;
-
-            if (!NewMaterialInstance || !SourceMaterialInterface)
-                continue;
+        if (!NewMaterialInstance || !SourceMaterialInterface)
+            continue;
 
-            UMaterialInterface * SMMatInterface = StaticMesh->StaticMaterials[ MatIdx ].MaterialInterface;
-            if ( SMMatInterface != SourceMaterialInterface && SMMatInterface->GetBaseMaterial() != SourceMaterialInterface )
-                continue;
+        UMaterialInterface * SMMatInterface = StaticMesh->StaticMaterials[ MatIdx ].MaterialInterface;
+        if ( SMMatInterface != SourceMaterialInterface && SMMatInterface->GetBaseMaterial() != SourceMaterialInterface )
+            continue;
 
-            // Replace the material assignment
-            if ( !ReplaceMaterial( HoudiniGeoPartObject, NewMaterialInstance, SourceMaterialInterface, MatIdx ) )
-                continue;
+        // Replace the material assignment
+        if ( !ReplaceMaterial( HoudiniGeoPartObject, NewMaterialInstance, SourceMaterialInterface, MatIdx ) )
+            continue;
 
-            // Update the StaticMesh, StaticMeshComponents and Instanced Static Mesh Components
-            StaticMesh->Modify(); 
-            StaticMesh->PreEditChange( nullptr );
-            StaticMesh->StaticMaterials[ MatIdx ].MaterialInterface = NewMaterialInstance;            
-            StaticMesh->PostEditChange();
-            StaticMesh->MarkPackageDirty();
+        // Update the StaticMesh, StaticMeshComponents and Instanced Static Mesh Components
+        StaticMesh->Modify(); 
+        StaticMesh->PreEditChange( nullptr );
+        StaticMesh->StaticMaterials[ MatIdx ].MaterialInterface = NewMaterialInstance;            
+        StaticMesh->PostEditChange();
+        StaticMesh->MarkPackageDirty();
 
-            UStaticMeshComponent * StaticMeshComponent = LocateStaticMeshComponent( StaticMesh );
-            if ( StaticMeshComponent )
-            {
-                StaticMeshComponent->Modify();
-                StaticMeshComponent->SetMaterial( MatIdx, NewMaterialInstance );
+        UStaticMeshComponent * StaticMeshComponent = LocateStaticMeshComponent( StaticMesh );
+        if ( StaticMeshComponent )
+        {
+            StaticMeshComponent->Modify();
+            StaticMeshComponent->SetMaterial( MatIdx, NewMaterialInstance );
 
-                bMaterialReplaced = true;
-            }
+            bMaterialReplaced = true;
+        }
 
-            TArray< UInstancedStaticMeshComponent * > InstancedStaticMeshComponents;
-            if ( LocateInstancedStaticMeshComponents( StaticMesh, InstancedStaticMeshComponents ) )
+        TArray< UInstancedStaticMeshComponent * > InstancedStaticMeshComponents;
+        if ( LocateInstancedStaticMeshComponents( StaticMesh, InstancedStaticMeshComponents ) )
+        {
+            for ( int32 Idx = 0; Idx < InstancedStaticMeshComponents.Num(); ++Idx )
             {
-                for ( int32 Idx = 0; Idx < InstancedStaticMeshComponents.Num(); ++Idx )
+                UInstancedStaticMeshComponent * InstancedStaticMeshComponent = InstancedStaticMeshComponents[ Idx ];
+                if ( InstancedStaticMeshComponent )
                 {
-                    UInstancedStaticMeshComponent * InstancedStaticMeshComponent = InstancedStaticMeshComponents[ Idx ];
-                    if ( InstancedStaticMeshComponent )
-                    {
-                        InstancedStaticMeshComponent->Modify();
-                        InstancedStaticMeshComponent->SetMaterial( MatIdx, NewMaterialInstance );
+                    InstancedStaticMeshComponent->Modify();
+                    InstancedStaticMeshComponent->SetMaterial( MatIdx, NewMaterialInstance );
 
-                        bMaterialReplaced = true;
-                    }
+                    bMaterialReplaced = true;
                 }
             }
         }
     }
 
-    // 2. FOR LANDSCAPES
+    return bMaterialReplaced;
+#else
+    return false;
+#endif
+}
+
+bool
+UHoudiniAssetComponent::CreateOrUpdateLandscapeMaterialInstances()
+{
+#if WITH_EDITOR
+    FHoudiniCookParams HoudiniCookParams( this );
+    HoudiniCookParams.PackageGUID = ComponentGUID;
+    HoudiniCookParams.MaterialAndTextureBakeMode = FHoudiniCookParams::GetDefaultMaterialAndTextureCookMode();
+
+    bool bMaterialReplaced = false;
+
     // Handling the creation of material instances from attributes
     for ( TMap< FHoudiniGeoPartObject, ALandscape * >::TIterator Iter( LandscapeComponents ); Iter; ++Iter )
     {
@@ -5529,9 +6319,6 @@ UHoudiniAssetComponent::CreateOrUpdateMaterialInstances()
         }
     }
 
-    if ( bMaterialReplaced )
-        UpdateEditorProperties( false );
-
     return bMaterialReplaced;
 #else
     return false;
@@ -5717,13 +6504,20 @@ UHoudiniAssetComponent::GetLandscapeComponents()
     return &LandscapeComponents;
 }
 
+TMap< FHoudiniGeoPartObject, UTexture2D * > *
+UHoudiniAssetComponent::GetVolumeTextures()
+{
+    return &VolumeTextures;
+}
+
 
 /** Set the preset Input for HoudiniTools **/
 void
-UHoudiniAssetComponent::SetHoudiniToolInputPresets( const TMap<UObject*, int32>& InPresets )
+UHoudiniAssetComponent::SetHoudiniToolInputPresets( const TMap<UObject*, int32>& InPresets, bool bInPackInputPresets )
 {
 #if WITH_EDITOR
     HoudiniToolInputPreset = InPresets;
+    bPackHoudiniToolInputPreset = bInPackInputPresets;
 #endif
 }
 
@@ -5807,6 +6601,13 @@ UHoudiniAssetComponent::ApplyHoudiniToolInputPreset()
 
             InputArray[ InputNumber ]->AddInputObject( Object );
 
+            if ( bPackHoudiniToolInputPreset )
+            {
+                // Each object is tagged with its source index so the output can be split back per object
+                InputArray[ InputNumber ]->SetPackBeforeMerge( true );
+                InputArray[ InputNumber ]->SetTagInputSources( true );
+            }
+
             if ( OnlyLandscapes && ( InputArray[ InputNumber ]->GetChoiceIndex() != EHoudiniAssetInputType::LandscapeInput ) )
                 InputArray[ InputNumber ]->ChangeInputType( EHoudiniAssetInputType::LandscapeInput );
 
@@ -5818,6 +6619,7 @@ UHoudiniAssetComponent::ApplyHoudiniToolInputPreset()
 
     // Discard the tool presets after their first setup
     HoudiniToolInputPreset.Empty();
+    bPackHoudiniToolInputPreset = false;
 }
 #endif
 
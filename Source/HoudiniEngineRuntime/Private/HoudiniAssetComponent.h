@@ -27,6 +27,7 @@
 #include "HoudiniGeoPartObject.h"
 #include "HoudiniRuntimeSettings.h"
 #include "HoudiniCookHandler.h"
+#include "HoudiniCookCache.h"
 
 #include "CoreMinimal.h"
 #include "Landscape.h"
@@ -45,6 +46,7 @@ class UObjectProperty;
 class USplineComponent;
 class UInstancedStaticMeshComponent;
 class UPhysicalMaterial;
+class UTexture2D;
 class UHoudiniAssetInput;
 class AHoudiniAssetActor;
 class UHoudiniAssetHandle;
@@ -57,6 +59,7 @@ class UHoudiniAssetComponentMaterials;
 class UFoliageType_InstancedStaticMesh;
 
 struct FTransform;
+struct FHoudiniApiSnapshot;
 struct FPropertyChangedEvent;
 struct FWalkableSlopeOverride;
 
@@ -248,6 +251,23 @@ public:
 
         /** Start manual asset rebuild task. **/
         void StartTaskAssetRebuildManual();
+
+        /** Apply the output of the next cook at once instead of over several frames, used by batch cooks. **/
+        void SetFinishPostCookImmediately( bool bInFinishPostCookImmediately );
+#endif
+
+        /** Apply the part of the last cook output which is still pending. **/
+        void FinishPostCookWorkItems();
+
+        /** Drop the part of the last cook output which is still pending, without applying it. **/
+        void CancelPostCookWorkItems();
+
+        /** Return true if part of the last cook output has not been applied yet. **/
+        bool HasPendingPostCookWorkItems() const;
+
+#if WITH_EDITOR
+        /** Extract the cooked textures again at full resolution if they were downsampled, used before baking. **/
+        void CreateFullResolutionTextures();
 #endif
 
         /** Used to differentiate native components from dynamic ones. **/
@@ -384,6 +404,12 @@ public:
         /** Is the asset still waiting for upstream asset to finish instantiating **/
         bool UpdateWaitingForUpstreamAssetsToInstantiate( bool bNotifyUpstreamAsset = false );
 
+        /** Return true if this asset waits for an identical asset to finish cooking, to share its output. **/
+        bool IsWaitingForSharedCook() const;
+
+        /** Called by the cook cache once the cook this asset waits for has finished, or can no longer be shared. **/
+        void OnSharedCookFinished();
+
     /** UObject methods. **/
     public:
 
@@ -422,8 +448,11 @@ public:
 
 #if WITH_EDITOR
 
-        /** Called after each cook. **/
-        void PostCook( bool bCookError = false );
+        /** Called after each cook. If SharedStaticMeshes is provided, it is used instead of extracting the output. **/
+        /** The output is extracted within OutputSnapshot, when given.                                              **/
+        void PostCook(
+            bool bCookError = false, const TMap< FHoudiniGeoPartObject, UStaticMesh * > * SharedStaticMeshes = nullptr,
+            const TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > & OutputSnapshot = nullptr );
 
         /** Check ourselves over and fix up any errors */
         void SanitizePostLoad();
@@ -488,6 +517,9 @@ public:
         /** Create all landscapes in the GeoPartObject array **/
         bool CreateAllLandscapes( const TArray< FHoudiniGeoPartObject > & FoundVolumes );
 
+        /** Create textures for the volumes of the GeoPartObject array that are not heightfields **/
+        bool CreateVolumeTextures( const TArray< FHoudiniGeoPartObject > & FoundVolumes );
+
         /** Updates the materials for a newly created landscape **/
         void UpdateLandscapeMaterialsAssignementsAndReplacements( ALandscape* Landscape, FHoudiniGeoPartObject Heightfield );
 
@@ -518,6 +550,15 @@ public:
         /** Create instance inputs. **/
         void CreateInstanceInputs( const TArray< FHoudiniGeoPartObject > & Instancers );
 
+        /** Create or reuse the instance input of an instancer and add it to the pending instance inputs. **/
+        void CreateInstanceInput( const FHoudiniGeoPartObject & Instancer );
+
+        /** Replace instance inputs by the pending ones. **/
+        void CommitInstanceInputs();
+
+        /** Replace static meshes by the pending ones and create their components. **/
+        void CommitStaticMeshes();
+
         /** Duplicate all parameters. Used during copying. **/
         void DuplicateParameters( UHoudiniAssetComponent * DuplicatedHoudiniComponent );
 
@@ -533,6 +574,18 @@ public:
         /** Helper called when world transform changes */
         void CheckedUploadTransform();
 
+        /** Compute the key identifying the result of the next cook. Returns false if this asset cannot share its cook. **/
+        bool ComputeCookKey( FHoudiniCookKey & CookKey );
+
+        /** Reuse the node and output of an identical asset instead of cooking. Returns true if no cook must be submitted. **/
+        bool TryShareCookedNode();
+
+        /** If our node is shared with other assets, request our own node so it can be edited. Returns true if forked. **/
+        bool ForkSharedNode();
+
+        /** Stop using our node if other assets still share it. Returns true if the node was shared. **/
+        bool ReleaseSharedNode();
+
         /** Per-part overrides for baking file name */
         void SetBakingBaseNameOverride( const FHoudiniGeoPartObject& GeoPartObject, const FString& BaseName );
         bool RemoveBakingBaseNameOverride( const FHoudiniGeoPartObject& GeoPartObject );
@@ -544,6 +597,9 @@ public:
         /** Clear all spline related resources. **/
         void ClearCurves();
 
+        /** Submit the output curve lines to the line batch component, using the current component transform. **/
+        void UpdateOutputCurveLines();
+
         /** Clear all parameters. **/
         void ClearParameters();
 
@@ -584,6 +640,21 @@ public:
         /** Create Static mesh resources. This will create necessary components for each mesh and update maps. **/
         void CreateObjectGeoPartResources( TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshMap );
 
+        /** Create or update the component of a static mesh part. **/
+        void CreateObjectGeoPartComponent( const FHoudiniGeoPartObject & HoudiniGeoPartObject, UStaticMesh * StaticMesh );
+
+        /** Execute output application work, or queue it on the post cook executor while a cook output is deferred. **/
+        void AddPostCookWorkItem( TFunction< void() > WorkItem );
+
+        /** Stream in the objects referenced by a finished cook. Returns false while they are still loading. **/
+        bool AreReferencedObjectsLoaded( const struct FHoudiniEngineTaskInfo & TaskInfo );
+
+        /** Handle the creation/update of material instances of a static mesh. **/
+        bool CreateOrUpdateStaticMeshMaterialInstances( const FHoudiniGeoPartObject & HoudiniGeoPartObject, UStaticMesh * StaticMesh );
+
+        /** Handle the creation/update of material instances of landscapes. **/
+        bool CreateOrUpdateLandscapeMaterialInstances();
+
         /** Delete Static mesh resources. This will free static meshes and corresponding components. **/
         void ReleaseObjectGeoPartResources( bool bDeletePackages = false );
 
@@ -623,8 +694,12 @@ public:
         /** Returns a pointer to the landscape component map **/
         TMap< FHoudiniGeoPartObject, ALandscape * > * GetLandscapeComponents();
 
-        /** Set the preset Input for HoudiniTools **/
-        void SetHoudiniToolInputPresets( const TMap< UObject*, int32 >& InPresets );
+        /** Returns a pointer to the volume texture map **/
+        TMap< FHoudiniGeoPartObject, UTexture2D * > * GetVolumeTextures();
+
+        /** Set the preset Input for HoudiniTools, packed inputs keep each preset object as a separate piece **/
+        /** and tag it with its source index, so the output is split back into a mesh component per object.   **/
+        void SetHoudiniToolInputPresets( const TMap< UObject*, int32 >& InPresets, bool bInPackInputPresets = false );
 
         /** Replaces references to a landscape actor by the newly generated one **/
         bool ReplaceLandscapeInInputs( ALandscape* Old, ALandscape* New );
@@ -679,6 +754,12 @@ public:
         /** Instance inputs for this component's asset **/
         TArray< UHoudiniAssetInstanceInput * > InstanceInputs;
 
+        /** Instance inputs created by the post cook work items which have not been committed yet. **/
+        TArray< UHoudiniAssetInstanceInput * > PendingInstanceInputs;
+
+        /** Keeps the objects referenced by the last cook output loaded. **/
+        TSharedPtr< struct FStreamableHandle > ReferencedObjectsLoadHandle;
+
         /** List of dependent downstream asset connections that have this asset as an asset input. **/
         TMap< UHoudiniAssetComponent * , TSet< int32 > > DownstreamAssetConnections;
 
@@ -686,6 +767,9 @@ public:
         TMap< FHoudiniGeoPartObject, UStaticMesh * > StaticMeshes;
         TMap< UStaticMesh *, UStaticMeshComponent * > StaticMeshComponents;
 
+        /** Static meshes extracted by the post cook work items which have not been committed yet. **/
+        TMap< FHoudiniGeoPartObject, UStaticMesh * > PendingStaticMeshes;
+
         /** Map of asset handle components. **/
         typedef TMap< FString, UHoudiniHandleComponent * > FHandleComponentMap;
         FHandleComponentMap HandleComponents;
@@ -693,9 +777,17 @@ public:
         /** Map of curve / spline components. **/
         TMap< FHoudiniGeoPartObject, UHoudiniSplineComponent * > SplineComponents;
 
+        /** Line batch drawing the output curves when there are too many for a spline component each, and their **/
+        /** segments in component space. The segments are serialized, the line batch is created when registered. **/
+        class ULineBatchComponent * CurveLineBatchComponent;
+        TArray< FVector > OutputCurveSegments;
+
         /** Map of Landscape / Heightfield components. **/
         TMap< FHoudiniGeoPartObject, ALandscape * > LandscapeComponents;
 
+        /** Map of textures created from non-heightfield volumes. **/
+        TMap< FHoudiniGeoPartObject, UTexture2D * > VolumeTextures;
+
         /** Material assignments. **/
         UHoudiniAssetComponentMaterials * HoudiniAssetComponentMaterials;
 
@@ -771,6 +863,14 @@ public:
         /** Number of times this asset has been cooked. **/
         int32 AssetCookCount;
 
+        /** Cook key of the cook which is about to be submitted, invalid if it cannot be shared. **/
+        FHoudiniCookKey PendingCookKey;
+
+        /** Preset and asset name of our node used by the cook key, fetched again once parameters change. **/
+        TArray< char > CookKeyPreset;
+        FString CookKeyAssetName;
+        bool bCookKeyPresetValid;
+
         /** Indicates the asset is being istantiated to avoid instantiating it twice on load **/
         bool bAssetIsBeingInstantiated;
 
@@ -780,6 +880,9 @@ public:
         /** Map used to preset the asset's inputs for Houdini Tools, maps a UObject to an Input number **/
         TMap<UObject*, int32> HoudiniToolInputPreset;
 
+        /** Whether the preset inputs must be packed before merging them. **/
+        bool bPackHoudiniToolInputPreset;
+
         /** Flags used by Houdini component. **/
         union
         {
@@ -844,6 +947,21 @@ public:
 
                 /** Is set to true when component is loaded and requires instantiation. **/
                 uint32 bLoadedComponentRequiresInstantiation : 1;
+
+                /** Is set to true while cook output application is queued on the post cook executor. **/
+                uint32 bDeferPostCookWorkItems : 1;
+
+                /** Is set to true when the next cook output must be applied at once. **/
+                uint32 bFinishPostCookImmediately : 1;
+
+                /** Is set to true while objects referenced by the finished cook are being streamed in. **/
+                uint32 bWaitingForReferencedObjects : 1;
+
+                /** Is set to true when the cooked textures may have been extracted below their full resolution. **/
+                uint32 bHasDownsampledTextures : 1;
+
+                /** Is set to true while ticking is stopped until an identical asset has finished cooking. **/
+                uint32 bWaitingForSharedCook : 1;
             };
 
             uint32 HoudiniAssetComponentTransientFlagsPacked;
@@ -39,6 +39,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "Engine/Selection.h"
 #include "Internationalization.h"
+#include "StaticMeshResources.h"
 #include "HoudiniEngineRuntimePrivatePCH.h"
 
 #if WITH_EDITOR
@@ -226,6 +227,7 @@ UHoudiniAssetInput::UHoudiniAssetInput( const FObjectInitializer & ObjectInitial
     bLandscapeAutoSelectComponent = true;
     bPackBeforeMerge = false;
     bExportAllLODs = false;
+    bTagInputSources = false;
 
     ChoiceStringValue = TEXT( "" );
 
@@ -650,7 +652,7 @@ UHoudiniAssetInput::UploadParameterValue()
                     // Connect input and create connected asset. Will return by reference.
                     if ( !FHoudiniEngineUtils::HapiCreateInputNodeForData( 
                         HostAssetId, InputObjects, InputTransforms,
-                        ConnectedAssetId, CreatedInputDataAssetIds, bExportAllLODs ) )
+                        ConnectedAssetId, CreatedInputDataAssetIds, bExportAllLODs, bTagInputSources ) )
 
                     {
                         bChanged = false;
@@ -839,7 +841,7 @@ UHoudiniAssetInput::UploadParameterValue()
                     // Connect input and create connected asset. Will return by reference.
                     if ( !FHoudiniEngineUtils::HapiCreateInputNodeForData(
                         HostAssetId, InputOutlinerMeshArray, ConnectedAssetId,
-                        UnrealSplineResolution, bExportAllLODs ) )
+                        UnrealSplineResolution, bExportAllLODs, bTagInputSources ) )
                     {
                         bChanged = false;
                         ConnectedAssetId = -1;
@@ -1513,7 +1515,7 @@ UHoudiniAssetInput::ChangeInputType(const EHoudiniAssetInputType::Enum& newType)
             HAPI_NodeId HostAssetId = GetAssetId();
             if (FHoudiniEngineUtils::HapiCreateInputNodeForData(
                 HostAssetId, InputOutlinerMeshArray,
-                ConnectedAssetId, UnrealSplineResolution))
+                ConnectedAssetId, UnrealSplineResolution, bExportAllLODs, bTagInputSources))
             {
                 ConnectInputNode();
             }
@@ -2998,6 +3000,53 @@ UHoudiniAssetInput::HasChanged() const
     return bChanged || bLoadedParameter || !bInputAssetConnectedInHoudini;
 }
 
+bool
+UHoudiniAssetInput::GetCookKey( FString & OutKey ) const
+{
+    OutKey.Empty();
+
+    if ( ChoiceIndex != EHoudiniAssetInputType::GeometryInput )
+        return false;
+
+    // Every setting changing the uploaded data is part of the key, tagging adds the source attributes.
+    OutKey = FString::Printf(
+        TEXT( "%d;%d;%d;%d;%d" ), InputIndex, (int32) bKeepWorldTransform, (int32) bPackBeforeMerge,
+        (int32) bExportAllLODs, (int32) bTagInputSources );
+
+    for ( int32 Idx = 0; Idx < InputObjects.Num(); ++Idx )
+    {
+        const UObject * InputObject = InputObjects[ Idx ];
+        if ( !InputObject )
+        {
+            OutKey += TEXT( ";None" );
+            continue;
+        }
+
+        // Only static meshes are uploaded from data we can identify, their derived data key changes with their content.
+        const UStaticMesh * StaticMesh = Cast< UStaticMesh >( InputObject );
+        if ( !StaticMesh || !StaticMesh->RenderData.IsValid() )
+            return false;
+
+        OutKey += TEXT( ";" ) + StaticMesh->GetPathName();
+#if WITH_EDITORONLY_DATA
+        OutKey += TEXT( ";" ) + StaticMesh->RenderData->DerivedDataKey;
+#endif
+
+        // Material assignments are sent with the mesh.
+        for ( const FStaticMaterial & StaticMaterial : StaticMesh->StaticMaterials )
+        {
+            OutKey += TEXT( ";" );
+            if ( StaticMaterial.MaterialInterface )
+                OutKey += StaticMaterial.MaterialInterface->GetPathName();
+        }
+
+        if ( InputTransforms.IsValidIndex( Idx ) )
+            OutKey += TEXT( ";" ) + InputTransforms[ Idx ].ToString();
+    }
+
+    return true;
+}
+
 #if WITH_EDITOR
 bool
 UHoudiniAssetInput::UpdateInputOulinerArray()
@@ -3478,6 +3527,28 @@ UHoudiniAssetInput::AddInputObject( UObject* ObjectToAdd )
     return false;
 }
 
+void
+UHoudiniAssetInput::SetPackBeforeMerge( bool bInPackBeforeMerge )
+{
+    if ( bPackBeforeMerge == bInPackBeforeMerge )
+        return;
+
+    bPackBeforeMerge = bInPackBeforeMerge;
+    MarkChanged( true );
+}
+
+void
+UHoudiniAssetInput::SetTagInputSources( bool bInTagInputSources )
+{
+    if ( bTagInputSources == bInTagInputSources )
+        return;
+
+    // The input nodes must be recreated to add or remove the source index attribute.
+    bTagInputSources = bInTagInputSources;
+    bStaticMeshChanged = true;
+    MarkChanged( true );
+}
+
 #endif
 
 const ALandscape*
@@ -147,6 +147,12 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInput : public UHoudiniAssetParamete
         void ClearInputs();
 
         bool AddInputObject( UObject* ObjectToAdd );
+
+        // Sets whether each input object is packed before being merged, used for presetting Houdini tools input
+        void SetPackBeforeMerge( bool bInPackBeforeMerge );
+
+        // Sets whether each input object is tagged with its source index, used for presetting merged batch tools input
+        void SetTagInputSources( bool bInTagInputSources );
 #endif
 
         /** Upload parameter value to HAPI. **/
@@ -224,6 +230,11 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInput : public UHoudiniAssetParamete
         /** Retruns true if at least one object in this input has more than 1 LOD **/
         bool HasLODs() const;
 
+        /** Describe the data this input sends to Houdini, including the content revision of its meshes. Returns   **/
+        /** false if the input cannot be described, which is the case for inputs referencing live scene data such **/
+        /** as curves, assets or landscapes, or for objects whose content cannot be identified.                    **/
+        bool GetCookKey( FString & OutKey ) const;
+
         /** Returns the input's transform scale values **/
         TOptional< float > GetPositionX( int32 AtIndex ) const;
         TOptional< float > GetPositionY( int32 AtIndex ) const;
@@ -582,6 +593,9 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInput : public UHoudiniAssetParamete
 
                 /** Indicates that all LODs in the input should be marshalled to Houdini **/
                 uint32 bExportAllLODs : 1;
+
+                /** Indicates that each input object is tagged with its index, so the output is split per source object **/
+                uint32 bTagInputSources : 1;
             };
 
             uint32 HoudiniAssetInputFlagsPacked;
@@ -29,6 +29,7 @@
 #include "HoudiniAssetInstanceInputField.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEngineString.h"
+#include "HoudiniObjectLoader.h"
 #include "HoudiniInstancedActorComponent.h"
 #include "HoudiniMeshSplitInstancerComponent.h"
 #include "Components/AudioComponent.h"
@@ -46,6 +47,7 @@
 UHoudiniAssetInstanceInput::UHoudiniAssetInstanceInput( const FObjectInitializer& ObjectInitializer )
     : Super( ObjectInitializer )
     , ObjectToInstanceId( -1 )
+    , NumInstanceCustomDataFloats( 0 )
 {
     Flags.HoudiniAssetInstanceInputFlagsPacked = 0;
     TupleSize = 0;
@@ -143,58 +145,30 @@ UHoudiniAssetInstanceInput::CreateInstanceInput()
     // List of new fields. Reused input fields will also be placed here.
     TArray< UHoudiniAssetInstanceInputField * > NewInstanceInputFields;
 
+    // Instance colors are only used by split mesh instancers, which paint each instance.
+    InstanceColors.Empty();
+    if ( Flags.bIsSplitMeshInstancer )
+        GetInstanceColors( AllTransforms.Num(), InstanceColors );
+
+    // Custom data is only read when the instancer explicitly requests it.
+    GetInstanceCustomData( AllTransforms.Num(), NumInstanceCustomDataFloats, InstanceCustomData );
+
     if ( Flags.bIsPackedPrimitiveInstancer )
     {
-        // This is using packed primitives
-        HAPI_PartInfo PartInfo;
-
-        HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetPartInfo(
-            FHoudiniEngine::Get().GetSession(), HoudiniGeoPartObject.GeoId, HoudiniGeoPartObject.PartId,
-            &PartInfo ), false );
-
-        // Retrieve part name.
-        FString PartName;
-        FHoudiniEngineString HoudiniEngineStringPartName( PartInfo.nameSH );
-        HoudiniEngineStringPartName.ToFString( PartName );
-
-        //HOUDINI_LOG_MESSAGE( TEXT( "Part Instancer (%s): IPC=%d, IC=%d" ), *PartName, PartInfo.instancedPartCount, PartInfo.instanceCount );
-
-        // Get transforms for each instance
-        TArray<HAPI_Transform> InstancerPartTransforms;
-        InstancerPartTransforms.SetNumZeroed( PartInfo.instanceCount );
-        HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetInstancerPartTransforms(
-            FHoudiniEngine::Get().GetSession(), HoudiniGeoPartObject.GeoId, PartInfo.id,
-            HAPI_RSTORDER_DEFAULT, InstancerPartTransforms.GetData(), 0, PartInfo.instanceCount ), false );
-
-        // Get the part ids for parts being instanced
-        TArray<HAPI_PartId> InstancedPartIds;
-        InstancedPartIds.SetNumZeroed( PartInfo.instancedPartCount );
-        HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetInstancedPartIds(
-            FHoudiniEngine::Get().GetSession(), HoudiniGeoPartObject.GeoId, PartInfo.id,
-            InstancedPartIds.GetData(), 0, PartInfo.instancedPartCount ), false );
-
-        for ( auto InstancedPartId : InstancedPartIds )
-        {
-            HAPI_PartInfo InstancedPartInfo;
-            HOUDINI_CHECK_ERROR_RETURN(
-                FHoudiniApi::GetPartInfo(
-                    FHoudiniEngine::Get().GetSession(), HoudiniGeoPartObject.GeoId, InstancedPartId,
-                    &InstancedPartInfo ), false );
-
-            TArray<FTransform> ObjectTransforms;
-            ObjectTransforms.SetNumUninitialized( InstancerPartTransforms.Num() );
-            for ( int32 InstanceIdx = 0; InstanceIdx < InstancerPartTransforms.Num(); ++InstanceIdx )
-            {
-                const auto& InstanceTransform = InstancerPartTransforms[InstanceIdx];
-                FHoudiniEngineUtils::TranslateHapiTransform( InstanceTransform, ObjectTransforms[InstanceIdx] );
-                //HOUDINI_LOG_MESSAGE( TEXT( "Instance %d:%d Transform: %s for Part Id %d" ), HoudiniGeoPartObject.PartId, InstanceIdx, *ObjectTransforms[ InstanceIdx ].ToString(), InstancedPartId );
-            }
+        // This is using packed primitives, all instanced parts share the same transforms.
+        TArray< HAPI_PartId > InstancedPartIds;
+        TArray< FTransform > ObjectTransforms;
+        if ( !GetPackedPrimitiveInstances( HoudiniGeoPartObject, InstancedPartIds, ObjectTransforms ) )
+            return false;
 
+        for ( HAPI_PartId InstancedPartId : InstancedPartIds )
+        {
             // Create this instanced input field for this instanced part
             //
             FHoudiniGeoPartObject InstancedPart( HoudiniGeoPartObject.AssetId, HoudiniGeoPartObject.ObjectId, HoudiniGeoPartObject.GeoId, InstancedPartId );
             InstancedPart.TransformMatrix = HoudiniGeoPartObject.TransformMatrix;
-            CreateInstanceInputField( InstancedPart, ObjectTransforms, InstanceInputFields, NewInstanceInputFields );
+            CreateInstanceInputField(
+                InstancedPart, ObjectTransforms, InstanceColors, InstanceCustomData, InstanceInputFields, NewInstanceInputFields );
         }
     }
     else if ( Flags.bIsAttributeInstancer )
@@ -207,32 +181,33 @@ UHoudiniAssetInstanceInput::CreateInstanceInput()
             InstancedObjectIds.GetData(), 
             0, NumPoints), false );
 
-        // Find the set of instanced object ids and locate the corresponding parts
-        TSet< int32 > UniqueInstancedObjectIds( InstancedObjectIds );
-        TArray< FTransform > InstanceTransforms;
-        for ( int32 InstancedObjectId : UniqueInstancedObjectIds )
+        // Bucket the transforms by instanced object id and locate the corresponding parts.
+        TArray< HAPI_NodeId > UniqueInstancedObjectIds;
+        TArray< TArray< FTransform > > InstanceTransforms;
+        TArray< TArray< int32 > > InstancePointIndices;
+        PartitionInstanceTransforms(
+            InstancedObjectIds, AllTransforms, UniqueInstancedObjectIds, InstanceTransforms, &InstancePointIndices );
+
+        if( UHoudiniAssetComponent* Comp = GetHoudiniAssetComponent() )
         {
-            if( UHoudiniAssetComponent* Comp = GetHoudiniAssetComponent() )
+            for ( int32 BucketIdx = 0; BucketIdx < UniqueInstancedObjectIds.Num(); ++BucketIdx )
             {
                 TArray< FHoudiniGeoPartObject > PartsToInstance;
-                if( Comp->LocateStaticMeshes( InstancedObjectId, PartsToInstance ) )
+                if( Comp->LocateStaticMeshes( UniqueInstancedObjectIds[ BucketIdx ], PartsToInstance ) )
                 {
-                    // copy out the transforms for this instance id
-                    InstanceTransforms.Empty();
-                    for( int32 Ix = 0; Ix < InstancedObjectIds.Num(); ++Ix )
-                    {
-                        if( ( InstancedObjectIds[ Ix ] == InstancedObjectId ) && ( AllTransforms.IsValidIndex( Ix ) ) )
-                        {
-                            InstanceTransforms.Add( AllTransforms[ Ix ] );
-                        }
-                    }
+                    TArray< FLinearColor > Colors;
+                    GatherInstanceColors( InstancePointIndices[ BucketIdx ], Colors );
+
+                    TArray< float > CustomData;
+                    GatherInstanceCustomData( InstancePointIndices[ BucketIdx ], CustomData );
 
                     // Locate or create an instance input field for each part for this instanced object id
                     for( FHoudiniGeoPartObject& Part : PartsToInstance )
                     {
                         // Change the transform of the part being instanced to match the instancer
                         Part.TransformMatrix = HoudiniGeoPartObject.TransformMatrix;
-                        CreateInstanceInputField( Part, InstanceTransforms, InstanceInputFields, NewInstanceInputFields );
+                        CreateInstanceInputField(
+                            Part, InstanceTransforms[ BucketIdx ], Colors, CustomData, InstanceInputFields, NewInstanceInputFields );
                     }
                 }
             }
@@ -287,13 +262,12 @@ UHoudiniAssetInstanceInput::CreateInstanceInput()
             // Attempt to load specified asset.
             const FString & AssetName = DetailInstanceValues[ 0 ];
             UObject * AttributeObject =
-                StaticLoadObject( 
-                    UObject::StaticClass(), nullptr, *AssetName, nullptr, LOAD_None, nullptr );
+                FHoudiniObjectLoader::LoadObject( AssetName, UObject::StaticClass() );
 
             if ( AttributeObject )
             {
                 CreateInstanceInputField(
-                    AttributeObject, AllTransforms, InstanceInputFields,
+                    AttributeObject, AllTransforms, InstanceColors, InstanceCustomData, InstanceInputFields,
                     NewInstanceInputFields );
             }
             else
@@ -320,34 +294,31 @@ UHoudiniAssetInstanceInput::CreateInstanceInput()
                 return false;
             }
 
-            // If instance attribute exists on points, we need to get all unique values.
-            TMap< FString, UObject * > ObjectsToInstance;
-
-            for ( auto Iter : PointInstanceValues )
-            {
-                const FString & UniqueName = *Iter;
-
-                if ( !ObjectsToInstance.Contains( UniqueName ) )
-                {
-                    UObject * AttributeObject = StaticLoadObject( 
-                        UObject::StaticClass(), nullptr, *UniqueName, nullptr, LOAD_None, nullptr );
-
-                    ObjectsToInstance.Add( UniqueName, AttributeObject );
-                }
-            }
+            // If instance attribute exists on points, we need to get all unique values and their transforms.
+            TArray< FString > InstancePaths;
+            TArray< TArray< FTransform > > InstanceTransforms;
+            TArray< TArray< int32 > > InstancePointIndices;
+            PartitionInstanceTransforms(
+                PointInstanceValues, AllTransforms, InstancePaths, InstanceTransforms, &InstancePointIndices );
 
             bool Success = false;
 
-            for( auto Iter : ObjectsToInstance )
+            for ( int32 BucketIdx = 0; BucketIdx < InstancePaths.Num(); ++BucketIdx )
             {
-                const FString & InstancePath = Iter.Key;
-                UObject * AttributeObject = Iter.Value;
+                UObject * AttributeObject =
+                    FHoudiniObjectLoader::LoadObject( InstancePaths[ BucketIdx ], UObject::StaticClass() );
 
                 if ( AttributeObject )
                 {
-                    TArray< FTransform > ObjectTransforms;
-                    GetPathInstaceTransforms( InstancePath, PointInstanceValues, AllTransforms, ObjectTransforms );
-                    CreateInstanceInputField( AttributeObject, ObjectTransforms, InstanceInputFields, NewInstanceInputFields );
+                    TArray< FLinearColor > Colors;
+                    GatherInstanceColors( InstancePointIndices[ BucketIdx ], Colors );
+
+                    TArray< float > CustomData;
+                    GatherInstanceCustomData( InstancePointIndices[ BucketIdx ], CustomData );
+
+                    CreateInstanceInputField(
+                        AttributeObject, InstanceTransforms[ BucketIdx ], Colors, CustomData,
+                        InstanceInputFields, NewInstanceInputFields );
                     Success = true;
                 }
             }
@@ -381,10 +352,16 @@ UHoudiniAssetInstanceInput::CreateInstanceInput()
 
             // Locate or create an input field.
             CreateInstanceInputField(
-                ItemHoudiniGeoPartObject, AllTransforms, InstanceInputFields, NewInstanceInputFields );
+                ItemHoudiniGeoPartObject, AllTransforms, InstanceColors, InstanceCustomData,
+                InstanceInputFields, NewInstanceInputFields );
         }
     }
 
+    // Colors and custom data have been handed over to the fields.
+    InstanceColors.Empty();
+    InstanceCustomData.Empty();
+    NumInstanceCustomDataFloats = 0;
+
     // Sort and store new fields.
     NewInstanceInputFields.Sort( FHoudiniAssetInstanceInputFieldSortPredicate() );
     CleanInstanceInputFields( InstanceInputFields );
@@ -450,6 +427,8 @@ void
 UHoudiniAssetInstanceInput::CreateInstanceInputField(
     const FHoudiniGeoPartObject & InHoudiniGeoPartObject,
     const TArray< FTransform > & ObjectTransforms,
+    const TArray< FLinearColor > & ObjectColors,
+    const TArray< float > & ObjectCustomData,
     const TArray< UHoudiniAssetInstanceInputField * > & OldInstanceInputFields,
     TArray<UHoudiniAssetInstanceInputField * > & NewInstanceInputFields)
 {
@@ -497,7 +476,8 @@ UHoudiniAssetInstanceInput::CreateInstanceInputField(
         }
 
         // Set transforms for this input.
-        HoudiniAssetInstanceInputField->SetInstanceTransforms( ObjectTransforms );
+        HoudiniAssetInstanceInputField->SetInstanceTransforms(
+            ObjectTransforms, ObjectColors, ObjectCustomData, NumInstanceCustomDataFloats );
         HoudiniAssetInstanceInputField->UpdateInstanceUPropertyAttributes();
 
         // Add field to list of fields.
@@ -505,62 +485,33 @@ UHoudiniAssetInstanceInput::CreateInstanceInputField(
     }
     else if ( InHoudiniGeoPartObject.IsPackedPrimitiveInstancer() )
     {
-        HAPI_Result Result = HAPI_RESULT_SUCCESS;
-        // We seem to be instancing a PP instancer, we need to get the transforms 
-
-        HAPI_PartInfo PartInfo;
-        HOUDINI_CHECK_ERROR( &Result, FHoudiniApi::GetPartInfo(
-            FHoudiniEngine::Get().GetSession(), InHoudiniGeoPartObject.GeoId, InHoudiniGeoPartObject.PartId,
-            &PartInfo ) );
-
-        // Get transforms for each instance
-        TArray<HAPI_Transform> InstancerPartTransforms;
-        InstancerPartTransforms.SetNumZeroed( PartInfo.instanceCount );
-        HOUDINI_CHECK_ERROR( &Result, FHoudiniApi::GetInstancerPartTransforms(
-            FHoudiniEngine::Get().GetSession(), InHoudiniGeoPartObject.GeoId, PartInfo.id,
-            HAPI_RSTORDER_DEFAULT, InstancerPartTransforms.GetData(), 0, PartInfo.instanceCount ) );
-
-        // Get the part ids for parts being instanced
-        TArray<HAPI_PartId> InstancedPartIds;
-        InstancedPartIds.SetNumZeroed( PartInfo.instancedPartCount );
-        HOUDINI_CHECK_ERROR( &Result, FHoudiniApi::GetInstancedPartIds(
-            FHoudiniEngine::Get().GetSession(), InHoudiniGeoPartObject.GeoId, PartInfo.id,
-            InstancedPartIds.GetData(), 0, PartInfo.instancedPartCount ) );
-
-        for ( auto InstancedPartId : InstancedPartIds )
+        // We seem to be instancing a PP instancer, we need to get the transforms
+        TArray< HAPI_PartId > InstancedPartIds;
+        TArray< FTransform > PPObjectTransforms;
+        GetPackedPrimitiveInstances( InHoudiniGeoPartObject, InstancedPartIds, PPObjectTransforms );
+
+        // Build the list of transforms for this instancer, it is the same for all instanced parts.
+        TArray< FTransform > AllTransforms;
+        AllTransforms.Empty( PPObjectTransforms.Num() * ObjectTransforms.Num() );
+        for ( const FTransform& ObjectTransform : ObjectTransforms )
         {
-            HAPI_PartInfo InstancedPartInfo;
-            HOUDINI_CHECK_ERROR( &Result,
-                FHoudiniApi::GetPartInfo(
-                    FHoudiniEngine::Get().GetSession(), InHoudiniGeoPartObject.GeoId, InstancedPartId,
-                    &InstancedPartInfo ) );
-
-            TArray<FTransform> PPObjectTransforms;
-            PPObjectTransforms.SetNumUninitialized( InstancerPartTransforms.Num() );
-            for ( int32 InstanceIdx = 0; InstanceIdx < InstancerPartTransforms.Num(); ++InstanceIdx )
+            for ( const FTransform& PPTransform : PPObjectTransforms )
             {
-                const auto& InstanceTransform = InstancerPartTransforms[InstanceIdx];
-                FHoudiniEngineUtils::TranslateHapiTransform( InstanceTransform, PPObjectTransforms[InstanceIdx] );
+                AllTransforms.Add( PPTransform * ObjectTransform );
             }
+        }
 
+        for ( HAPI_PartId InstancedPartId : InstancedPartIds )
+        {
             // Create this instanced input field for this instanced part
             
             // find static mesh for this instancer
             FHoudiniGeoPartObject TempInstancedPart( InHoudiniGeoPartObject.AssetId, InHoudiniGeoPartObject.ObjectId, InHoudiniGeoPartObject.GeoId, InstancedPartId );
             if ( UStaticMesh* FoundStaticMesh = Comp->LocateStaticMesh( TempInstancedPart, false ) )
             {
-                // Build the list of transforms for this instancer
-                TArray< FTransform > AllTransforms;
-                AllTransforms.Empty( PPObjectTransforms.Num() * ObjectTransforms.Num() );
-                for ( const FTransform& ObjectTransform : ObjectTransforms )
-                {
-                    for ( const FTransform& PPTransform : PPObjectTransforms )
-                    {
-                        AllTransforms.Add( PPTransform * ObjectTransform );
-                    }
-                }
-
-                CreateInstanceInputField( FoundStaticMesh, AllTransforms, InstanceInputFields, NewInstanceInputFields );
+                CreateInstanceInputField(
+                    FoundStaticMesh, AllTransforms, TArray< FLinearColor >(), TArray< float >(),
+                    InstanceInputFields, NewInstanceInputFields );
             }
             else
             {
@@ -580,6 +531,8 @@ void
 UHoudiniAssetInstanceInput::CreateInstanceInputField(
     UObject * InstancedObject,
     const TArray< FTransform > & ObjectTransforms,
+    const TArray< FLinearColor > & ObjectColors,
+    const TArray< float > & ObjectCustomData,
     const TArray< UHoudiniAssetInstanceInputField * > & OldInstanceInputFields,
     TArray< UHoudiniAssetInstanceInputField * > & NewInstanceInputFields )
 {
@@ -631,7 +584,8 @@ UHoudiniAssetInstanceInput::CreateInstanceInputField(
     }
 
     // Set transforms for this input.
-    HoudiniAssetInstanceInputField->SetInstanceTransforms( ObjectTransforms );
+    HoudiniAssetInstanceInputField->SetInstanceTransforms(
+        ObjectTransforms, ObjectColors, ObjectCustomData, NumInstanceCustomDataFloats );
 
     // Add field to list of fields.
     NewInstanceInputFields.Add( HoudiniAssetInstanceInputField );
@@ -920,6 +874,8 @@ UHoudiniAssetInstanceInput::CloneComponentsAndAttachToActor( AActor * Actor )
                     DuplicatedComponent,
                     HoudiniAssetInstanceInputField->GetInstancedTransforms( VariationIdx ),
                     HoudiniAssetInstanceInputField->GetInstancedColors( VariationIdx ),
+                    HoudiniAssetInstanceInputField->GetInstancedCustomData( VariationIdx ),
+                    HoudiniAssetInstanceInputField->GetNumCustomDataFloats(),
                     HoudiniAssetInstanceInputField->GetRotationOffset( VariationIdx ),
                     HoudiniAssetInstanceInputField->GetScaleOffset( VariationIdx ) );
 
@@ -952,19 +908,223 @@ UHoudiniAssetInstanceInput::CloneComponentsAndAttachToActor( AActor * Actor )
 
 #endif
 
+/** Counting sort of the transforms by key: one pass to intern the keys and count the bucket sizes, and one **/
+/** pass to write each transform into its preallocated bucket.                                              **/
+template< typename KeyType >
+static void
+PartitionInstanceTransformsByKey(
+    const TArray< KeyType > & PointKeys, const TArray< FTransform > & Transforms,
+    TArray< KeyType > & OutKeys, TArray< TArray< FTransform > > & OutTransforms,
+    TArray< TArray< int32 > > * OutPointIndices )
+{
+    OutKeys.Empty();
+    OutTransforms.Empty();
+    if ( OutPointIndices )
+        OutPointIndices->Empty();
+
+    // Points without a transform are skipped.
+    const int32 NumPoints = FMath::Min( PointKeys.Num(), Transforms.Num() );
+
+    TMap< KeyType, int32 > KeyToBucket;
+    TArray< int32 > PointBuckets;
+    TArray< int32 > BucketSizes;
+    PointBuckets.SetNumUninitialized( NumPoints );
+
+    for ( int32 PointIdx = 0; PointIdx < NumPoints; ++PointIdx )
+    {
+        const KeyType & Key = PointKeys[ PointIdx ];
+        int32 * FoundBucket = KeyToBucket.Find( Key );
+        int32 BucketIdx = FoundBucket ? *FoundBucket : INDEX_NONE;
+        if ( BucketIdx == INDEX_NONE )
+        {
+            BucketIdx = OutKeys.Add( Key );
+            BucketSizes.Add( 0 );
+            KeyToBucket.Add( Key, BucketIdx );
+        }
+
+        PointBuckets[ PointIdx ] = BucketIdx;
+        BucketSizes[ BucketIdx ]++;
+    }
+
+    OutTransforms.SetNum( OutKeys.Num() );
+    for ( int32 BucketIdx = 0; BucketIdx < OutTransforms.Num(); ++BucketIdx )
+        OutTransforms[ BucketIdx ].Reserve( BucketSizes[ BucketIdx ] );
+
+    for ( int32 PointIdx = 0; PointIdx < NumPoints; ++PointIdx )
+        OutTransforms[ PointBuckets[ PointIdx ] ].Add( Transforms[ PointIdx ] );
+
+    if ( OutPointIndices )
+    {
+        OutPointIndices->SetNum( OutKeys.Num() );
+        for ( int32 BucketIdx = 0; BucketIdx < OutKeys.Num(); ++BucketIdx )
+            ( *OutPointIndices )[ BucketIdx ].Reserve( BucketSizes[ BucketIdx ] );
+
+        for ( int32 PointIdx = 0; PointIdx < NumPoints; ++PointIdx )
+            ( *OutPointIndices )[ PointBuckets[ PointIdx ] ].Add( PointIdx );
+    }
+}
+
+void
+UHoudiniAssetInstanceInput::PartitionInstanceTransforms(
+    const TArray< HAPI_NodeId > & PointInstancedObjectIds, const TArray< FTransform > & Transforms,
+    TArray< HAPI_NodeId > & OutInstancedObjectIds, TArray< TArray< FTransform > > & OutTransforms,
+    TArray< TArray< int32 > > * OutPointIndices )
+{
+    PartitionInstanceTransformsByKey(
+        PointInstancedObjectIds, Transforms, OutInstancedObjectIds, OutTransforms, OutPointIndices );
+}
+
 void
-UHoudiniAssetInstanceInput::GetPathInstaceTransforms(
-    const FString & ObjectInstancePath,
+UHoudiniAssetInstanceInput::PartitionInstanceTransforms(
     const TArray< FString > & PointInstanceValues, const TArray< FTransform > & Transforms,
-    TArray< FTransform > & OutTransforms)
+    TArray< FString > & OutInstancePaths, TArray< TArray< FTransform > > & OutTransforms,
+    TArray< TArray< int32 > > * OutPointIndices )
 {
-    OutTransforms.Empty();
+    PartitionInstanceTransformsByKey( PointInstanceValues, Transforms, OutInstancePaths, OutTransforms, OutPointIndices );
+}
+
+bool
+UHoudiniAssetInstanceInput::GetInstanceColors( int32 NumInstances, TArray< FLinearColor > & OutColors ) const
+{
+    OutColors.Empty();
+    if ( NumInstances <= 0 )
+        return false;
+
+    // Only the explicit instance color is used, the point color is left to the instanced geometry.
+    HAPI_AttributeInfo AttributeInfo;
+    FMemory::Memzero< HAPI_AttributeInfo >( AttributeInfo );
 
-    for ( int32 Idx = 0; Idx < PointInstanceValues.Num(); ++Idx )
+    TArray< float > ColorData;
+    if ( !FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+        HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_INSTANCE_COLOR, AttributeInfo, ColorData, 4 ) )
+        return false;
+
+    // Detail colors apply to all instances, other owners need one color per instance.
+    const int32 TupleSize = AttributeInfo.tupleSize;
+    if ( TupleSize < 3 || ( AttributeInfo.count != 1 && AttributeInfo.count != NumInstances ) )
+        return false;
+
+    OutColors.SetNumUninitialized( NumInstances );
+    for ( int32 InstanceIdx = 0; InstanceIdx < NumInstances; ++InstanceIdx )
     {
-        if ( ObjectInstancePath.Equals( PointInstanceValues[ Idx ] ) )
-            OutTransforms.Add( Transforms[ Idx ] );
+        const float * Color = &ColorData[ ( AttributeInfo.count == 1 ? 0 : InstanceIdx ) * TupleSize ];
+        OutColors[ InstanceIdx ] = FLinearColor( Color[ 0 ], Color[ 1 ], Color[ 2 ], TupleSize > 3 ? Color[ 3 ] : 1.0f );
     }
+
+    return true;
+}
+
+void
+UHoudiniAssetInstanceInput::GatherInstanceColors( const TArray< int32 > & PointIndices, TArray< FLinearColor > & OutColors ) const
+{
+    OutColors.Empty();
+    if ( InstanceColors.Num() == 0 )
+        return;
+
+    OutColors.Reserve( PointIndices.Num() );
+    for ( int32 PointIdx : PointIndices )
+        OutColors.Add( InstanceColors[ PointIdx ] );
+}
+
+bool
+UHoudiniAssetInstanceInput::GetInstanceCustomData(
+    int32 NumInstances, int32 & OutNumCustomDataFloats, TArray< float > & OutCustomData ) const
+{
+    OutNumCustomDataFloats = 0;
+    OutCustomData.Empty();
+    if ( NumInstances <= 0 )
+        return false;
+
+    // The number of floats is requested explicitly, followed by one attribute per float.
+    HAPI_AttributeInfo AttributeInfo;
+    FMemory::Memzero< HAPI_AttributeInfo >( AttributeInfo );
+
+    TArray< int32 > NumCustomFloatsData;
+    if ( !FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
+        HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_INSTANCE_NUM_CUSTOM_FLOATS, AttributeInfo, NumCustomFloatsData, 1 ) )
+        return false;
+
+    if ( NumCustomFloatsData.Num() <= 0 || NumCustomFloatsData[ 0 ] <= 0 )
+        return false;
+
+    // Detail values apply to all instances, missing or mismatched attributes are left at zero.
+    const int32 NumCustomDataFloats = NumCustomFloatsData[ 0 ];
+    OutCustomData.SetNumZeroed( NumInstances * NumCustomDataFloats );
+    for ( int32 FloatIdx = 0; FloatIdx < NumCustomDataFloats; ++FloatIdx )
+    {
+        FString AttributeName = FString::Printf(
+            TEXT( "%s%d" ), TEXT( HAPI_UNREAL_ATTRIB_INSTANCE_CUSTOM_DATA_PREFIX ), FloatIdx );
+
+        TArray< float > FloatData;
+        FMemory::Memzero< HAPI_AttributeInfo >( AttributeInfo );
+        if ( !FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+            HoudiniGeoPartObject, TCHAR_TO_UTF8( *AttributeName ), AttributeInfo, FloatData, 1 ) )
+        {
+            HOUDINI_LOG_WARNING( TEXT( "Instancer is missing custom data attribute %s." ), *AttributeName );
+            continue;
+        }
+
+        if ( FloatData.Num() != 1 && FloatData.Num() != NumInstances )
+        {
+            HOUDINI_LOG_WARNING( TEXT( "Instancer custom data attribute %s has %d values for %d instances." ),
+                *AttributeName, FloatData.Num(), NumInstances );
+            continue;
+        }
+
+        for ( int32 InstanceIdx = 0; InstanceIdx < NumInstances; ++InstanceIdx )
+        {
+            OutCustomData[ InstanceIdx * NumCustomDataFloats + FloatIdx ] =
+                FloatData[ FloatData.Num() == 1 ? 0 : InstanceIdx ];
+        }
+    }
+
+    OutNumCustomDataFloats = NumCustomDataFloats;
+    return true;
+}
+
+void
+UHoudiniAssetInstanceInput::GatherInstanceCustomData( const TArray< int32 > & PointIndices, TArray< float > & OutCustomData ) const
+{
+    OutCustomData.Empty();
+    if ( NumInstanceCustomDataFloats <= 0 )
+        return;
+
+    OutCustomData.Reserve( PointIndices.Num() * NumInstanceCustomDataFloats );
+    for ( int32 PointIdx : PointIndices )
+        OutCustomData.Append( &InstanceCustomData[ PointIdx * NumInstanceCustomDataFloats ], NumInstanceCustomDataFloats );
+}
+
+bool
+UHoudiniAssetInstanceInput::GetPackedPrimitiveInstances(
+    const FHoudiniGeoPartObject & InstancerGeoPartObject, TArray< HAPI_PartId > & OutInstancedPartIds,
+    TArray< FTransform > & OutInstanceTransforms )
+{
+    OutInstancedPartIds.Empty();
+    OutInstanceTransforms.Empty();
+
+    HAPI_PartInfo PartInfo;
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetPartInfo(
+        FHoudiniEngine::Get().GetSession(), InstancerGeoPartObject.GeoId, InstancerGeoPartObject.PartId,
+        &PartInfo ), false );
+
+    // Get the part ids for parts being instanced.
+    OutInstancedPartIds.SetNumZeroed( PartInfo.instancedPartCount );
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetInstancedPartIds(
+        FHoudiniEngine::Get().GetSession(), InstancerGeoPartObject.GeoId, PartInfo.id,
+        OutInstancedPartIds.GetData(), 0, PartInfo.instancedPartCount ), false );
+
+    // Get transforms for each instance, and convert them once for all instanced parts.
+    TArray< HAPI_Transform > InstancerPartTransforms;
+    InstancerPartTransforms.SetNumZeroed( PartInfo.instanceCount );
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetInstancerPartTransforms(
+        FHoudiniEngine::Get().GetSession(), InstancerGeoPartObject.GeoId, PartInfo.id,
+        HAPI_RSTORDER_DEFAULT, InstancerPartTransforms.GetData(), 0, PartInfo.instanceCount ), false );
+
+    OutInstanceTransforms.SetNumUninitialized( InstancerPartTransforms.Num() );
+    for ( int32 InstanceIdx = 0; InstanceIdx < InstancerPartTransforms.Num(); ++InstanceIdx )
+        FHoudiniEngineUtils::TranslateHapiTransform( InstancerPartTransforms[ InstanceIdx ], OutInstanceTransforms[ InstanceIdx ] );
+
+    return true;
 }
 
 #if WITH_EDITOR
@@ -86,6 +86,19 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInstanceInput : public UHoudiniAsset
         /** Refresh state based on the given geo part object */
         void SetGeoPartObject( const FHoudiniGeoPartObject& InGeoPartObject );
 
+        /** Partition per point transforms by instanced object id in a single pass. Buckets are ordered by first **/
+        /** occurrence of their key, transforms within a bucket keep their point order.                        **/
+        static void PartitionInstanceTransforms(
+            const TArray< HAPI_NodeId > & PointInstancedObjectIds, const TArray< FTransform > & Transforms,
+            TArray< HAPI_NodeId > & OutInstancedObjectIds, TArray< TArray< FTransform > > & OutTransforms,
+            TArray< TArray< int32 > > * OutPointIndices = nullptr );
+
+        /** Partition per point transforms by instance path in a single pass. Used by attribute instancer. **/
+        static void PartitionInstanceTransforms(
+            const TArray< FString > & PointInstanceValues, const TArray< FTransform > & Transforms,
+            TArray< FString > & OutInstancePaths, TArray< TArray< FTransform > > & OutTransforms,
+            TArray< TArray< int32 > > * OutPointIndices = nullptr );
+
     /** UHoudiniAssetParameter methods. **/
     public:
 
@@ -113,12 +126,27 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInstanceInput : public UHoudiniAsset
 
 #endif
 
+
     protected:
 
-        /** Retrieve all transforms for a given path. Used by attribute instancer. **/
-        void GetPathInstaceTransforms(
-            const FString & ObjectInstancePath, const TArray< FString > & PointInstanceValues,
-            const TArray< FTransform > & Transforms, TArray< FTransform > & OutTransforms );
+        /** Retrieve the color of each instance from the instance color attribute. Returns false if there is none. **/
+        bool GetInstanceColors( int32 NumInstances, TArray< FLinearColor > & OutColors ) const;
+
+        /** Gather the colors of the given points. **/
+        void GatherInstanceColors( const TArray< int32 > & PointIndices, TArray< FLinearColor > & OutColors ) const;
+
+        /** Retrieve the custom data floats of each instance from the requested custom data attributes. **/
+        /** Returns false if the instancer does not request any.                                        **/
+        bool GetInstanceCustomData( int32 NumInstances, int32 & OutNumCustomDataFloats, TArray< float > & OutCustomData ) const;
+
+        /** Gather the custom data floats of the given points. **/
+        void GatherInstanceCustomData( const TArray< int32 > & PointIndices, TArray< float > & OutCustomData ) const;
+
+        /** Retrieve the parts instanced by a packed primitive instancer and its instance transforms. The transforms **/
+        /** are shared by all instanced parts, so they are only converted once.                                      **/
+        static bool GetPackedPrimitiveInstances(
+            const FHoudiniGeoPartObject & InstancerGeoPartObject, TArray< HAPI_PartId > & OutInstancedPartIds,
+            TArray< FTransform > & OutInstanceTransforms );
 
     protected:
 
@@ -129,13 +157,15 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInstanceInput : public UHoudiniAsset
         /** Locate or create (if it does not exist) an input field. **/
         void CreateInstanceInputField(
             const FHoudiniGeoPartObject & HoudiniGeoPartObject,
-            const TArray< FTransform > & ObjectTransforms, 
+            const TArray< FTransform > & ObjectTransforms, const TArray< FLinearColor > & ObjectColors,
+            const TArray< float > & ObjectCustomData,
             const TArray< UHoudiniAssetInstanceInputField * > & OldInstanceInputFields,
             TArray< UHoudiniAssetInstanceInputField * > & NewInstanceInputFields );
 
         /** Locate or create (if it does not exist) an input field. This version is used with override attribute. **/
         void CreateInstanceInputField(
-            UObject * InstancedObject, const TArray< FTransform > & ObjectTransforms,
+            UObject * InstancedObject, const TArray< FTransform > & ObjectTransforms, const TArray< FLinearColor > & ObjectColors,
+            const TArray< float > & ObjectCustomData,
             const TArray< UHoudiniAssetInstanceInputField * > & OldInstanceInputFields,
             TArray< UHoudiniAssetInstanceInputField * > & NewInstanceInputFields );
 
@@ -240,6 +270,15 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInstanceInput : public UHoudiniAsset
         /** Id of an object to instance. **/
         HAPI_NodeId ObjectToInstanceId;
 
+        /** Color of each instance, only valid while creating this input. **/
+        TArray< FLinearColor > InstanceColors;
+
+        /** Custom data floats of each instance, only valid while creating this input. **/
+        TArray< float > InstanceCustomData;
+
+        /** Number of custom data floats of each instance. **/
+        int32 NumInstanceCustomDataFloats;
+
 public:
         /** Flags used by this input. **/
         union FHoudiniAssetInstanceInputFlags
@@ -34,12 +34,16 @@
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
 
 
-// Fastrand is a faster alternative to std::rand()
-// and doesn't oscillate when looking for 2 values like Unreal's.
-inline int fastrand(int& nSeed)
+// Hash an instance index into a well distributed value, used to pick the variation of each instance.
+// The variation of an instance only depends on its index, not on the other instances.
+inline uint32 HashInstanceIndex( uint32 InstanceIndex )
 {
-    nSeed = (214013 * nSeed + 2531011);
-    return (nSeed >> 16) & 0x7FFF;
+    InstanceIndex ^= InstanceIndex >> 16;
+    InstanceIndex *= 0x85ebca6b;
+    InstanceIndex ^= InstanceIndex >> 13;
+    InstanceIndex *= 0xc2b2ae35;
+    InstanceIndex ^= InstanceIndex >> 16;
+    return InstanceIndex;
 }
 
 bool
@@ -56,6 +60,7 @@ UHoudiniAssetInstanceInputField::UHoudiniAssetInstanceInputField( const FObjectI
     , OriginalObject( nullptr )
     , HoudiniAssetComponent( nullptr )
     , HoudiniAssetInstanceInput( nullptr )
+    , NumCustomDataFloats( 0 )
     , HoudiniAssetInstanceInputFieldFlagsPacked( 0 )
 {}
 
@@ -132,6 +137,13 @@ UHoudiniAssetInstanceInputField::Serialize( FArchive & Ar )
         Ar << VariationInstanceColorOverrideArray;
     }
 
+    if ( Ar.IsSaving() || ( Ar.IsLoading() && LinkerVersion >= VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_INSTANCE_CUSTOM_DATA ) )
+    {
+        Ar << NumCustomDataFloats;
+        Ar << InstanceCustomData;
+        Ar << VariationInstanceCustomDataArray;
+    }
+
     Ar << InstancerComponents;
     Ar << InstancedObjects;
     Ar << OriginalObject;
@@ -252,32 +264,7 @@ UHoudiniAssetInstanceInputField::AddInstanceComponent( int32 VariationIdx )
             MSIC->SetStaticMesh(StaticMesh);
             MSIC->SetOverrideMaterial(InstancerMaterial);
 
-            // Check for instance colors
-            HAPI_AttributeInfo AttributeInfo = {};
-            if( HAPI_RESULT_SUCCESS == FHoudiniApi::GetAttributeInfo(
-                FHoudiniEngine::Get().GetSession(), InstancerHoudiniGeoPartObject.GeoId, InstancerHoudiniGeoPartObject.PartId,
-                HAPI_UNREAL_ATTRIB_INSTANCE_COLOR, HAPI_AttributeOwner::HAPI_ATTROWNER_PRIM, &AttributeInfo) )
-            {
-                if( AttributeInfo.exists )
-                {
-                    if( AttributeInfo.tupleSize == 4 )
-                    {
-                        // Allocate sufficient buffer for data.
-                        InstanceColorOverride.SetNumUninitialized(AttributeInfo.count);
-
-                        if( HAPI_RESULT_SUCCESS == FHoudiniApi::GetAttributeFloatData(
-                            FHoudiniEngine::Get().GetSession(), InstancerHoudiniGeoPartObject.GeoId, InstancerHoudiniGeoPartObject.PartId,
-                            HAPI_UNREAL_ATTRIB_INSTANCE_COLOR, &AttributeInfo, -1, (float*)InstanceColorOverride.GetData(), 0, AttributeInfo.count) )
-                        {
-                            // got some override colors
-                        }
-                    }
-                    else
-                    {
-                        HOUDINI_LOG_WARNING(TEXT(HAPI_UNREAL_ATTRIB_INSTANCE_COLOR " must be a float[4] prim attribute"));
-                    }
-                }
-            }
+            // Instance colors are handed over by the instance input along with the transforms.
             NewComp = MSIC;
         }
         else
@@ -336,9 +323,31 @@ UHoudiniAssetInstanceInputField::AddInstanceComponent( int32 VariationIdx )
 }
 
 void
-UHoudiniAssetInstanceInputField::SetInstanceTransforms( const TArray< FTransform > & ObjectTransforms )
+UHoudiniAssetInstanceInputField::SetInstanceTransforms(
+    const TArray< FTransform > & ObjectTransforms,
+    const TArray< FLinearColor > & ObjectColors,
+    const TArray< float > & ObjectCustomData, int32 InNumCustomDataFloats )
 {
     InstancedTransforms = ObjectTransforms;
+
+    // Colors are only kept if there is one for each instance.
+    if ( ObjectColors.Num() == ObjectTransforms.Num() )
+        InstanceColorOverride = ObjectColors;
+    else
+        InstanceColorOverride.Empty();
+
+    // Custom data is only kept if there is a full set for each instance.
+    if ( InNumCustomDataFloats > 0 && ObjectCustomData.Num() == ObjectTransforms.Num() * InNumCustomDataFloats )
+    {
+        InstanceCustomData = ObjectCustomData;
+        NumCustomDataFloats = InNumCustomDataFloats;
+    }
+    else
+    {
+        InstanceCustomData.Empty();
+        NumCustomDataFloats = 0;
+    }
+
     UpdateInstanceTransforms( true );
 }
 
@@ -349,30 +358,43 @@ UHoudiniAssetInstanceInputField::UpdateInstanceTransforms( bool RecomputeVariati
     int32 NumInstanceColors = InstanceColorOverride.Num();
     int32 VariationCount = InstanceVariationCount();
 
-    int nSeed = 1234;
+    // Each point keeps its variation between cooks, even when points are added or removed, so instancer
+    // components only receive the instances which actually changed.
     if ( RecomputeVariationAssignments )
     {
 	VariationTransformsArray.Empty();
 	VariationTransformsArray.SetNum(VariationCount);
 	VariationInstanceColorOverrideArray.Empty();
 	VariationInstanceColorOverrideArray.SetNum(VariationCount);
+        VariationInstanceCustomDataArray.Empty();
+        VariationInstanceCustomDataArray.SetNum( VariationCount );
 
         for ( int32 Idx = 0; Idx < NumInstanceTransforms; Idx++ )
         {
-            int32 VariationIndex = fastrand(nSeed) % VariationCount;
+            int32 VariationIndex = HashInstanceIndex( Idx ) % VariationCount;
             VariationTransformsArray[ VariationIndex ].Add(InstancedTransforms[Idx]);
 	    if( NumInstanceColors > Idx )
 	    {
 		VariationInstanceColorOverrideArray[VariationIndex].Add(InstanceColorOverride[Idx]);
 	    }
+
+            if ( NumCustomDataFloats > 0 )
+            {
+                VariationInstanceCustomDataArray[ VariationIndex ].Append(
+                    &InstanceCustomData[ Idx * NumCustomDataFloats ], NumCustomDataFloats );
+            }
         }
     }
 
+    // Fields loaded from older files have no custom data assignments.
+    VariationInstanceCustomDataArray.SetNum( VariationCount );
+
     for ( int32 Idx = 0; Idx < VariationCount; Idx++ )
     {
         UHoudiniInstancedActorComponent::UpdateInstancerComponentInstances(
             InstancerComponents[ Idx ],
             VariationTransformsArray[ Idx ], VariationInstanceColorOverrideArray[ Idx ],
+            VariationInstanceCustomDataArray[ Idx ], NumCustomDataFloats,
             RotationOffsets[ Idx ] ,
             ScaleOffsets[ Idx ] );
     }
@@ -611,6 +633,16 @@ UHoudiniAssetInstanceInputField::GetInstancedTransforms( int32 VariationIdx ) co
     return VariationTransformsArray[ VariationIdx ];
 }
 
+const TArray< float > &
+UHoudiniAssetInstanceInputField::GetInstancedCustomData( int32 VariationIdx ) const
+{
+    static const TArray< float > EmptyCustomData;
+    if ( !VariationInstanceCustomDataArray.IsValidIndex( VariationIdx ) )
+        return EmptyCustomData;
+
+    return VariationInstanceCustomDataArray[ VariationIdx ];
+}
+
 void
 UHoudiniAssetInstanceInputField::RecreateRenderState()
 {
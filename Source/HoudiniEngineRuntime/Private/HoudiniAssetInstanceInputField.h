@@ -136,6 +136,12 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInstanceInputField : public UObject
 	/** Return the array of transforms for all variations **/
 	FORCEINLINE const TArray< FLinearColor > & GetInstancedColors() { return InstanceColorOverride; }
 
+        /** Return the custom data floats of all instances used by the variation. **/
+        const TArray< float > & GetInstancedCustomData( int32 VariationIdx ) const;
+
+        /** Return the number of custom data floats of each instance. **/
+        FORCEINLINE int32 GetNumCustomDataFloats() const { return NumCustomDataFloats; }
+
         /** Recreates render states for instanced static mesh component. **/
         void RecreateRenderState();
 
@@ -150,8 +156,11 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInstanceInputField : public UObject
         /** Create instanced component for this field. **/
         void AddInstanceComponent( int32 VariationIdx );
 
-        /** Set transforms for this field. **/
-        void SetInstanceTransforms( const TArray< FTransform > & ObjectTransforms );
+        /** Set transforms, per-instance colors and per-instance custom data for this field. **/
+        void SetInstanceTransforms(
+            const TArray< FTransform > & ObjectTransforms,
+            const TArray< FLinearColor > & ObjectColors,
+            const TArray< float > & ObjectCustomData, int32 InNumCustomDataFloats );
 
         /** Update relative transform for this field. **/
         void UpdateRelativeTransform();
@@ -188,6 +197,15 @@ class HOUDINIENGINERUNTIME_API UHoudiniAssetInstanceInputField : public UObject
 	/** Per-variation color override assignments */
 	TArray< TArray< FLinearColor > > VariationInstanceColorOverrideArray;
 
+        /** Custom data floats, NumCustomDataFloats for each instance. **/
+        TArray< float > InstanceCustomData;
+
+        /** Per-variation custom data assignments. **/
+        TArray< TArray< float > > VariationInstanceCustomDataArray;
+
+        /** Number of custom data floats of each instance. **/
+        int32 NumCustomDataFloats;
+
         /** Corresponding geo part object. **/
         FHoudiniGeoPartObject HoudiniGeoPartObject;
 
@@ -0,0 +1,298 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+#include "HoudiniApi.h"
+#include "HoudiniCookCache.h"
+#include "HoudiniEngineRuntimePrivatePCH.h"
+#include "HoudiniAssetComponent.h"
+#include "Misc/Crc.h"
+
+TMap< HAPI_NodeId, FHoudiniCookCacheEntry >
+FHoudiniCookCache::Entries;
+
+TMap< FHoudiniCookKey, HAPI_NodeId >
+FHoudiniCookCache::CookKeys;
+
+FHoudiniCookKey::FHoudiniCookKey()
+    : Hash( 0u )
+{}
+
+bool
+FHoudiniCookKey::IsValid() const
+{
+    return !AssetPath.IsEmpty() && Preset.Num() > 0;
+}
+
+void
+FHoudiniCookKey::UpdateHash()
+{
+    Hash = GetTypeHash( AssetPath );
+    Hash = HashCombine( Hash, GetTypeHash( AssetName ) );
+    Hash = FCrc::MemCrc32( Preset.GetData(), Preset.Num(), Hash );
+
+    for ( const FString & Input : Inputs )
+        Hash = HashCombine( Hash, GetTypeHash( Input ) );
+
+    Hash = HashCombine( Hash, GetTypeHash( Transform ) );
+}
+
+bool
+FHoudiniCookKey::operator==( const FHoudiniCookKey & Other ) const
+{
+    return Hash == Other.Hash
+        && AssetPath == Other.AssetPath
+        && AssetName == Other.AssetName
+        && Preset == Other.Preset
+        && Inputs == Other.Inputs
+        && Transform == Other.Transform;
+}
+
+FHoudiniCookCacheEntry::FHoudiniCookCacheEntry()
+    : bCooked( false )
+{}
+
+void
+FHoudiniCookCache::RegisterCook( HAPI_NodeId NodeId, const FHoudiniCookKey & CookKey, UHoudiniAssetComponent * HoudiniAssetComponent )
+{
+    if ( NodeId < 0 )
+        return;
+
+    FHoudiniCookCacheEntry & Entry = Entries.FindOrAdd( NodeId );
+
+    // Output of a previous cook is no longer valid.
+    RemoveCookKey( NodeId, Entry );
+    Entry.bCooked = false;
+    Entry.StaticMeshes.Empty();
+
+    if ( HoudiniAssetComponent )
+        Entry.Users.AddUnique( HoudiniAssetComponent );
+
+    if ( CookKey.IsValid() )
+    {
+        // Only claim the key if no other node is already cooking or holding it.
+        if ( !CookKeys.Contains( CookKey ) )
+        {
+            Entry.CookKey = CookKey;
+            CookKeys.Add( CookKey, NodeId );
+        }
+    }
+}
+
+void
+FHoudiniCookCache::PublishCook( HAPI_NodeId NodeId, const TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshes )
+{
+    FHoudiniCookCacheEntry * Entry = FindValidEntry( NodeId );
+    if ( !Entry || !Entry->CookKey.IsValid() )
+        return;
+
+    Entry->StaticMeshes.Empty( StaticMeshes.Num() );
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TConstIterator Iter( StaticMeshes ); Iter; ++Iter )
+        Entry->StaticMeshes.Add( Iter.Key(), Iter.Value() );
+
+    Entry->bCooked = true;
+    NotifyWaiters( *Entry );
+}
+
+void
+FHoudiniCookCache::InvalidateNode( HAPI_NodeId NodeId )
+{
+    FHoudiniCookCacheEntry * Entry = Entries.Find( NodeId );
+    if ( !Entry )
+        return;
+
+    RemoveCookKey( NodeId, *Entry );
+    Entry->bCooked = false;
+    Entry->StaticMeshes.Empty();
+}
+
+EHoudiniCookCacheResult::Type
+FHoudiniCookCache::FindNode(
+    const FHoudiniCookKey & CookKey, HAPI_NodeId IgnoreNodeId, HAPI_NodeId & OutNodeId,
+    TMap< FHoudiniGeoPartObject, UStaticMesh * > & OutStaticMeshes )
+{
+    OutNodeId = -1;
+    OutStaticMeshes.Empty();
+
+    if ( !CookKey.IsValid() )
+        return EHoudiniCookCacheResult::NotFound;
+
+    const HAPI_NodeId * FoundNodeId = CookKeys.Find( CookKey );
+    if ( !FoundNodeId || *FoundNodeId == IgnoreNodeId )
+        return EHoudiniCookCacheResult::NotFound;
+
+    HAPI_NodeId NodeId = *FoundNodeId;
+    FHoudiniCookCacheEntry * Entry = FindValidEntry( NodeId );
+    if ( !Entry )
+        return EHoudiniCookCacheResult::NotFound;
+
+    if ( !Entry->bCooked )
+        return EHoudiniCookCacheResult::Cooking;
+
+    // If any of the published meshes has been destroyed, the output can no longer be shared.
+    for ( TMap< FHoudiniGeoPartObject, TWeakObjectPtr< UStaticMesh > >::TConstIterator Iter( Entry->StaticMeshes ); Iter; ++Iter )
+    {
+        UStaticMesh * StaticMesh = Iter.Value().Get();
+        if ( !StaticMesh )
+        {
+            InvalidateNode( NodeId );
+            OutStaticMeshes.Empty();
+            return EHoudiniCookCacheResult::NotFound;
+        }
+
+        OutStaticMeshes.Add( Iter.Key(), StaticMesh );
+    }
+
+    OutNodeId = NodeId;
+    return EHoudiniCookCacheResult::Cooked;
+}
+
+bool
+FHoudiniCookCache::WaitForCook( const FHoudiniCookKey & CookKey, UHoudiniAssetComponent * HoudiniAssetComponent )
+{
+    if ( !CookKey.IsValid() || !HoudiniAssetComponent )
+        return false;
+
+    const HAPI_NodeId * FoundNodeId = CookKeys.Find( CookKey );
+    if ( !FoundNodeId )
+        return false;
+
+    FHoudiniCookCacheEntry * Entry = FindValidEntry( *FoundNodeId );
+    if ( !Entry || Entry->bCooked )
+        return false;
+
+    Entry->Waiters.AddUnique( HoudiniAssetComponent );
+    return true;
+}
+
+void
+FHoudiniCookCache::AcquireNode( HAPI_NodeId NodeId, UHoudiniAssetComponent * HoudiniAssetComponent )
+{
+    if ( NodeId < 0 || !HoudiniAssetComponent )
+        return;
+
+    FHoudiniCookCacheEntry & Entry = Entries.FindOrAdd( NodeId );
+    Entry.Users.AddUnique( HoudiniAssetComponent );
+}
+
+bool
+FHoudiniCookCache::ReleaseNode( HAPI_NodeId NodeId, UHoudiniAssetComponent * HoudiniAssetComponent )
+{
+    FHoudiniCookCacheEntry * Entry = Entries.Find( NodeId );
+    if ( !Entry )
+        return true;
+
+    Entry->Users.Remove( HoudiniAssetComponent );
+
+    // Drop this node if it is no longer used.
+    if ( FindValidEntry( NodeId ) )
+        return false;
+
+    return true;
+}
+
+int32
+FHoudiniCookCache::GetNodeUserCount( HAPI_NodeId NodeId )
+{
+    FHoudiniCookCacheEntry * Entry = FindValidEntry( NodeId );
+    if ( !Entry )
+        return 0;
+
+    return Entry->Users.Num();
+}
+
+int32
+FHoudiniCookCache::GetNodeWaiterCount( HAPI_NodeId NodeId )
+{
+    FHoudiniCookCacheEntry * Entry = FindValidEntry( NodeId );
+    if ( !Entry )
+        return 0;
+
+    return Entry->Waiters.Num();
+}
+
+void
+FHoudiniCookCache::Reset()
+{
+    Entries.Empty();
+    CookKeys.Empty();
+}
+
+FHoudiniCookCacheEntry *
+FHoudiniCookCache::FindValidEntry( HAPI_NodeId NodeId )
+{
+    FHoudiniCookCacheEntry * Entry = Entries.Find( NodeId );
+    if ( !Entry )
+        return nullptr;
+
+    Entry->Users.RemoveAll( []( const TWeakObjectPtr< UHoudiniAssetComponent > & User )
+    {
+        return !User.IsValid();
+    } );
+
+    if ( Entry->Users.Num() == 0 )
+    {
+        RemoveCookKey( NodeId, *Entry );
+        Entries.Remove( NodeId );
+        return nullptr;
+    }
+
+    return Entry;
+}
+
+void
+FHoudiniCookCache::RemoveCookKey( HAPI_NodeId NodeId, FHoudiniCookCacheEntry & Entry )
+{
+    // Waiting components would never be notified once the key is gone, they cook on their own instead.
+    NotifyWaiters( Entry );
+
+    if ( !Entry.CookKey.IsValid() )
+        return;
+
+    const HAPI_NodeId * FoundNodeId = CookKeys.Find( Entry.CookKey );
+    if ( FoundNodeId && *FoundNodeId == NodeId )
+        CookKeys.Remove( Entry.CookKey );
+
+    Entry.CookKey = FHoudiniCookKey();
+}
+
+void
+FHoudiniCookCache::NotifyWaiters( FHoudiniCookCacheEntry & Entry )
+{
+    // Components only restart ticking when notified, so the cache is never modified while iterating.
+    TArray< TWeakObjectPtr< UHoudiniAssetComponent > > Waiters = MoveTemp( Entry.Waiters );
+    Entry.Waiters.Empty();
+
+    for ( const TWeakObjectPtr< UHoudiniAssetComponent > & Waiter : Waiters )
+    {
+        if ( Waiter.IsValid() )
+            Waiter->OnSharedCookFinished();
+    }
+}
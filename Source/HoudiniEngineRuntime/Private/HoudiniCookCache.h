@@ -0,0 +1,172 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+#pragma once
+
+#include "HoudiniApi.h"
+#include "HoudiniGeoPartObject.h"
+
+class UHoudiniAssetComponent;
+class UStaticMesh;
+
+namespace EHoudiniCookCacheResult
+{
+    enum Type
+    {
+        /** No node has been cooked with this key. **/
+        NotFound,
+
+        /** A node with this key is currently being cooked. **/
+        Cooking,
+
+        /** A node with this key has been cooked and its output can be shared. **/
+        Cooked
+    };
+}
+
+/** Everything which determines the result of a cook. Keys are always compared in full, the hash only selects **/
+/** the bucket, so two components never share a node because their keys happen to hash the same.              **/
+struct HOUDINIENGINERUNTIME_API FHoudiniCookKey
+{
+    FHoudiniCookKey();
+
+    /** Return true if this key identifies a cook which can be shared. **/
+    bool IsValid() const;
+
+    /** Compute the bucket hash, must be called once all fields are set. **/
+    void UpdateHash();
+
+    /** Comparison operator. **/
+    bool operator==( const FHoudiniCookKey & Other ) const;
+
+    /** Hashing function. **/
+    friend uint32 GetTypeHash( const FHoudiniCookKey & CookKey )
+    {
+        return CookKey.Hash;
+    }
+
+    /** Path of the Houdini asset and name of the instantiated operator. **/
+    FString AssetPath;
+    FString AssetName;
+
+    /** Preset of the node, holding all its parameter values. **/
+    TArray< char > Preset;
+
+    /** Description of the data each input sends to Houdini, including the content revision of its objects. **/
+    TArray< FString > Inputs;
+
+    /** Component transform, only set when transform changes trigger cooks. **/
+    FString Transform;
+
+    /** Hash of all the fields above. **/
+    uint32 Hash;
+};
+
+/** Book-keeping for a HAPI node that may be shared by several components. **/
+struct FHoudiniCookCacheEntry
+{
+    FHoudiniCookCacheEntry();
+
+    /** Key of the last cook submitted for this node, invalid if the node cannot be shared. **/
+    FHoudiniCookKey CookKey;
+
+    /** Is set to true once the cook for CookKey has finished and its output has been published. **/
+    bool bCooked;
+
+    /** Components currently using this node. **/
+    TArray< TWeakObjectPtr< UHoudiniAssetComponent > > Users;
+
+    /** Components waiting for the cook of this node to finish, so that they can share its output. **/
+    TArray< TWeakObjectPtr< UHoudiniAssetComponent > > Waiters;
+
+    /** Static meshes extracted from the last cook of this node. **/
+    TMap< FHoudiniGeoPartObject, TWeakObjectPtr< UStaticMesh > > StaticMeshes;
+};
+
+/** Session-wide memoization of cook results. Components whose cook key (asset library, asset name, preset and **/
+/** inputs) match can share a single HAPI node and its extracted output instead of instantiating and cooking  **/
+/** their own copy. All functions must be called from the game thread.                                        **/
+struct HOUDINIENGINERUNTIME_API FHoudiniCookCache
+{
+    public:
+
+        /** Record that a cook with the given key has been submitted for the node. **/
+        static void RegisterCook( HAPI_NodeId NodeId, const FHoudiniCookKey & CookKey, UHoudiniAssetComponent * HoudiniAssetComponent );
+
+        /** Publish the output of a finished cook, making the node available for sharing. **/
+        static void PublishCook( HAPI_NodeId NodeId, const TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshes );
+
+        /** Prevent a node from being shared, for instance when its cook failed. **/
+        static void InvalidateNode( HAPI_NodeId NodeId );
+
+        /** Look up a node, other than IgnoreNodeId, whose last cook used the given key. **/
+        static EHoudiniCookCacheResult::Type FindNode(
+            const FHoudiniCookKey & CookKey, HAPI_NodeId IgnoreNodeId, HAPI_NodeId & OutNodeId,
+            TMap< FHoudiniGeoPartObject, UStaticMesh * > & OutStaticMeshes );
+
+        /** Notify the component once the node cooking with the given key has finished, or can no longer be shared. **/
+        /** Returns false if no node is cooking with this key.                                                        **/
+        static bool WaitForCook( const FHoudiniCookKey & CookKey, UHoudiniAssetComponent * HoudiniAssetComponent );
+
+        /** Add a component to the users of a node. **/
+        static void AcquireNode( HAPI_NodeId NodeId, UHoudiniAssetComponent * HoudiniAssetComponent );
+
+        /** Remove a component from the users of a node. Returns true if nobody else uses the node and it can be deleted. **/
+        static bool ReleaseNode( HAPI_NodeId NodeId, UHoudiniAssetComponent * HoudiniAssetComponent );
+
+        /** Return the number of components using a node. **/
+        static int32 GetNodeUserCount( HAPI_NodeId NodeId );
+
+        /** Return the number of components waiting for the cook of a node. **/
+        static int32 GetNodeWaiterCount( HAPI_NodeId NodeId );
+
+        /** Forget all nodes, used when the session is restarted. **/
+        static void Reset();
+
+    protected:
+
+        /** Remove users which have been garbage collected, and the entry itself if it is no longer used. **/
+        static FHoudiniCookCacheEntry * FindValidEntry( HAPI_NodeId NodeId );
+
+        /** Remove the key mapping of an entry. **/
+        static void RemoveCookKey( HAPI_NodeId NodeId, FHoudiniCookCacheEntry & Entry );
+
+        /** Let the components waiting for an entry's cook know that they can look it up again. **/
+        static void NotifyWaiters( FHoudiniCookCacheEntry & Entry );
+
+    protected:
+
+        /** Cache entries indexed by node id. **/
+        static TMap< HAPI_NodeId, FHoudiniCookCacheEntry > Entries;
+
+        /** Cook keys and the node they were last submitted for. **/
+        static TMap< FHoudiniCookKey, HAPI_NodeId > CookKeys;
+};
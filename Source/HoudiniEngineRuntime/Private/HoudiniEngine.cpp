@@ -25,9 +25,14 @@
 #include "HoudiniEngine.h"
 #include "HoudiniEngineRuntimePrivatePCH.h"
 #include "HoudiniEngineScheduler.h"
+#include "HoudiniApiRecorder.h"
+#include "HoudiniPostCookExecutor.h"
+#include "HoudiniCookCache.h"
+#include "HoudiniObjectLoader.h"
 #include "HoudiniEngineTask.h"
 #include "HoudiniEngineTaskInfo.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniEngineMaterialUtils.h"
 #include "HoudiniLandscapeUtils.h"
 #include "HoudiniAsset.h"
 #include "HoudiniRuntimeSettings.h"
@@ -57,6 +62,7 @@ FHoudiniEngine::FHoudiniEngine()
     , HoudiniBgeoAsset( nullptr )
     , HoudiniEngineSchedulerThread( nullptr )
     , HoudiniEngineScheduler( nullptr )
+    , HoudiniPostCookExecutor( nullptr )
     , EnableCookingGlobal( true )
 {
     Session.type = HAPI_SESSION_MAX;
@@ -383,11 +389,18 @@ FHoudiniEngine::StartupModule()
                 RunningEngineMajor, RunningEngineMinor, RunningEngineApi );
         }
 
+        // Snapshots must be enabled before the scheduler thread calls HAPI, the table is not touched afterwards.
+        if ( HoudiniRuntimeSettings->bPrefetchCookOutput )
+            FHoudiniApiRecorder::EnableSnapshots();
+
         // Create HAPI scheduler and processing thread.
         HoudiniEngineScheduler = new FHoudiniEngineScheduler();
         HoudiniEngineSchedulerThread = FRunnableThread::Create(
             HoudiniEngineScheduler, TEXT( "HoudiniTaskCookAsset" ), 0, TPri_Normal );
 
+        // Create the executor applying cook output on the game thread.
+        HoudiniPostCookExecutor = new FHoudiniPostCookExecutor();
+
         // Set the default value for pausing houdini engine cooking
         EnableCookingGlobal = !HoudiniRuntimeSettings->bPauseCookingOnStart;
     }
@@ -450,6 +463,22 @@ FHoudiniEngine::ShutdownModule()
         HoudiniEngineScheduler = nullptr;
     }
 
+    // No other thread calls HAPI anymore.
+    FHoudiniApiRecorder::DisableSnapshots();
+
+    // Pending cook output can no longer be applied.
+    if ( HoudiniPostCookExecutor )
+    {
+        delete HoudiniPostCookExecutor;
+        HoudiniPostCookExecutor = nullptr;
+    }
+
+    // Shared nodes are no longer valid.
+    FHoudiniCookCache::Reset();
+
+    // Release objects streamed in for cook output.
+    FHoudiniObjectLoader::Reset();
+
     // Perform HAPI finalization.
     if ( FHoudiniApi::IsHAPIInitialized() )
         FHoudiniApi::Cleanup( GetSession() );
@@ -512,6 +541,9 @@ FHoudiniEngine::CookNode(
         AssetId, HoudiniCookParams, ForceRebuildStaticMesh, 
         ForceRecookAll, StaticMeshesIn, CookResultArray, ComponentTransform );
 
+    // Compile the materials generated by this cook in a single batch.
+    FHoudiniEngineMaterialUtils::FinalizePendingMaterialUpdates();
+
     if ( !bReturn )
         return false;
 
@@ -558,4 +590,58 @@ FHoudiniEngine::GetEnableCookingGlobal()
     return EnableCookingGlobal;
 }
 
+FHoudiniPostCookExecutor *
+FHoudiniEngine::GetPostCookExecutor() const
+{
+    return HoudiniPostCookExecutor;
+}
+
+void
+FHoudiniEngine::StartReplaySession()
+{
+    // Session entries are answered by the recorder, there is nothing to initialize.
+    if ( Session.type == HAPI_SESSION_MAX )
+        FHoudiniApi::CreateInProcessSession( &Session );
+
+    HAPIState = FHoudiniApi::IsInitialized( GetSession() );
+
+    if ( !HoudiniEngineScheduler )
+    {
+        const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+        if ( HoudiniRuntimeSettings && HoudiniRuntimeSettings->bPrefetchCookOutput )
+            FHoudiniApiRecorder::EnableSnapshots();
+
+        HoudiniEngineScheduler = new FHoudiniEngineScheduler();
+        HoudiniEngineSchedulerThread = FRunnableThread::Create(
+            HoudiniEngineScheduler, TEXT( "HoudiniTaskCookAsset" ), 0, TPri_Normal );
+    }
+
+    if ( !HoudiniPostCookExecutor )
+        HoudiniPostCookExecutor = new FHoudiniPostCookExecutor();
+}
+
+void
+FHoudiniEngine::SuspendScheduler()
+{
+    if ( !HoudiniEngineScheduler || !HoudiniEngineSchedulerThread )
+        return;
+
+    HoudiniEngineScheduler->Stop();
+    HoudiniEngineSchedulerThread->WaitForCompletion();
+
+    delete HoudiniEngineSchedulerThread;
+    HoudiniEngineSchedulerThread = nullptr;
+}
+
+void
+FHoudiniEngine::ResumeScheduler()
+{
+    if ( !HoudiniEngineScheduler || HoudiniEngineSchedulerThread )
+        return;
+
+    HoudiniEngineScheduler->Resume();
+    HoudiniEngineSchedulerThread = FRunnableThread::Create(
+        HoudiniEngineScheduler, TEXT( "HoudiniTaskCookAsset" ), 0, TPri_Normal );
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -30,6 +30,7 @@
 class UStaticMesh;
 class FRunnableThread;
 class FHoudiniEngineScheduler;
+class FHoudiniPostCookExecutor;
 
 class HOUDINIENGINERUNTIME_API FHoudiniEngine : public IHoudiniEngine
 {
@@ -76,6 +77,18 @@ class HOUDINIENGINERUNTIME_API FHoudiniEngine : public IHoudiniEngine
         void SetEnableCookingGlobal(const bool& enableCooking);
         bool GetEnableCookingGlobal();
 
+        /** Return the executor applying cook output over several frames, can be null. **/
+        FHoudiniPostCookExecutor * GetPostCookExecutor() const;
+
+        /** Create the session and the scheduler when HAPI calls are replayed from a recording without libHAPI. **/
+        void StartReplaySession();
+
+        /** Stop the scheduler thread, waiting for the task in progress. Queued tasks are kept until it is resumed. **/
+        void SuspendScheduler();
+
+        /** Restart the scheduler thread after it has been suspended. **/
+        void ResumeScheduler();
+
     public:
 
         /** App identifier string. **/
@@ -124,6 +137,9 @@ class HOUDINIENGINERUNTIME_API FHoudiniEngine : public IHoudiniEngine
         /** Scheduler used to schedule HAPI instantiation and cook tasks. **/
         FHoudiniEngineScheduler * HoudiniEngineScheduler;
 
+        /** Executor used to apply cook output on the game thread within a frame budget. **/
+        FHoudiniPostCookExecutor * HoudiniPostCookExecutor;
+
         /** Location of libHAPI binary. **/
         FString LibHAPILocation;
 
@@ -71,6 +71,15 @@
 
 #define LOCTEXT_NAMESPACE HOUDINI_LOCTEXT_NAMESPACE 
 
+bool
+FHoudiniEngineBakeUtils::bBakeSessionActive = false;
+
+TMap< TWeakObjectPtr< const UObject >, TWeakObjectPtr< UObject > >
+FHoudiniEngineBakeUtils::BakeSessionDuplicates;
+
+TArray< TWeakObjectPtr< UPackage > >
+FHoudiniEngineBakeUtils::BakeSessionPackages;
+
 UPackage *
 FHoudiniEngineBakeUtils::BakeCreateBlueprintPackageForComponent(
     UHoudiniAssetComponent * HoudiniAssetComponent,
@@ -363,6 +372,7 @@ FHoudiniEngineBakeUtils::ReplaceHoudiniActorWithBlueprint( UHoudiniAssetComponen
                 // Compile our blueprint and notify asset system about blueprint.
                 FKismetEditorUtilities::CompileBlueprint( Blueprint );
                 FAssetRegistryModule::AssetCreated( Blueprint );
+                AddBakeSessionPackages( { Package } );
 
                 // Retrieve actor transform.
                 FVector Location = ClonedActor->GetActorLocation();
@@ -425,6 +435,18 @@ FHoudiniEngineBakeUtils::DuplicateStaticMeshAndCreatePackage(
         else
             HoudiniCookParams.MaterialAndTextureBakeMode = BakeMode;
 
+        // Meshes shared by several baked components are only baked once per bake session.
+        const bool bShareBakedMesh = BakeMode == EBakeMode::CreateNewAssets && IsBakeSessionActive();
+        if( bShareBakedMesh )
+        {
+            if( UStaticMesh * SessionStaticMesh = Cast< UStaticMesh >( FindBakeSessionDuplicate( StaticMesh ) ) )
+                return SessionStaticMesh;
+        }
+
+        // Baked materials must use full resolution textures.
+        if( Component && BakeMode != FHoudiniCookParams::GetDefaultStaticMeshesCookMode() )
+            Component->CreateFullResolutionTextures();
+
         FString MeshName;
         FGuid MeshGuid;
 
@@ -495,6 +517,9 @@ FHoudiniEngineBakeUtils::DuplicateStaticMeshAndCreatePackage(
 
         // Dirty the static mesh package.
         DuplicatedStaticMesh->MarkPackageDirty();
+
+        if( bShareBakedMesh )
+            AddBakeSessionDuplicate( StaticMesh, DuplicatedStaticMesh );
     }
 #endif
     return DuplicatedStaticMesh;
@@ -506,6 +531,9 @@ FHoudiniEngineBakeUtils::BakeHoudiniActorToActors( UHoudiniAssetComponent * Houd
 #if WITH_EDITOR
     const FScopedTransaction Transaction( LOCTEXT( "BakeToActors", "Bake To Actors" ) );
 
+    // Bake the complete output of the last cook.
+    HoudiniAssetComponent->FinishPostCookWorkItems();
+
     auto SMComponentToPart = HoudiniAssetComponent->CollectAllStaticMeshComponents();
     TArray< AActor* > NewActors = BakeHoudiniActorToActors_StaticMeshes( HoudiniAssetComponent, SMComponentToPart );
 
@@ -534,6 +562,9 @@ FHoudiniEngineBakeUtils::BakeHoudiniActorToActors_InstancedActors(
 {
     TArray< AActor* > NewActors;
 #if WITH_EDITOR
+    // Instanced actors may still be spawning.
+    HoudiniAssetComponent->FinishPostCookWorkItems();
+
     ULevel* DesiredLevel = GWorld->GetCurrentLevel();
     FName BaseName( *( HoudiniAssetComponent->GetOwner()->GetName() + TEXT( "_Baked" ) ) );
 
@@ -870,6 +901,9 @@ void
 FHoudiniEngineBakeUtils::BakeHoudiniActorToOutlinerInput( UHoudiniAssetComponent * HoudiniAssetComponent )
 {
 #if WITH_EDITOR
+    // Bake the complete output of the last cook.
+    HoudiniAssetComponent->FinishPostCookWorkItems();
+
     TMap< const UStaticMesh*, UStaticMesh* > OriginalToBakedMesh;
     TMap< const UStaticMeshComponent*, FHoudiniGeoPartObject > SMComponentToPart = HoudiniAssetComponent->CollectAllStaticMeshComponents();
 
@@ -959,6 +993,14 @@ FHoudiniEngineBakeUtils::DuplicateMaterialAndCreatePackage(
 {
     UMaterial * DuplicatedMaterial = nullptr;
 #if WITH_EDITOR
+    // Materials shared by several baked meshes are only baked once per bake session.
+    const bool bShareBakedMaterial = HoudiniCookParams.MaterialAndTextureBakeMode == EBakeMode::CreateNewAssets && IsBakeSessionActive();
+    if( bShareBakedMaterial )
+    {
+        if( UMaterial * SessionMaterial = Cast< UMaterial >( FindBakeSessionDuplicate( Material ) ) )
+            return SessionMaterial;
+    }
+
     // Create material package.
     FString MaterialName;
     UPackage * MaterialPackage = FHoudiniEngineBakeUtils::BakeCreateTextureOrMaterialPackageForComponent(
@@ -997,6 +1039,9 @@ FHoudiniEngineBakeUtils::DuplicateMaterialAndCreatePackage(
 
     // Reset any derived state
     DuplicatedMaterial->ForceRecompileForRendering();
+
+    if( bShareBakedMaterial )
+        AddBakeSessionDuplicate( Material, DuplicatedMaterial );
 #endif
     return DuplicatedMaterial;
 }
@@ -1038,6 +1083,14 @@ FHoudiniEngineBakeUtils::DuplicateTextureAndCreatePackage(
 {
     UTexture2D* DuplicatedTexture = nullptr;
 #if WITH_EDITOR
+    // Textures shared by several baked materials are only baked once per bake session.
+    const bool bShareBakedTexture = HoudiniCookParams.MaterialAndTextureBakeMode == EBakeMode::CreateNewAssets && IsBakeSessionActive();
+    if( bShareBakedTexture )
+    {
+        if( UTexture2D * SessionTexture = Cast< UTexture2D >( FindBakeSessionDuplicate( Texture ) ) )
+            return SessionTexture;
+    }
+
     // Retrieve original package of this texture.
     UPackage * TexturePackage = Cast< UPackage >( Texture->GetOuter() );
     if( TexturePackage )
@@ -1082,6 +1135,9 @@ FHoudiniEngineBakeUtils::DuplicateTextureAndCreatePackage(
 
                 // Dirty the texture package.
                 DuplicatedTexture->MarkPackageDirty();
+
+                if( bShareBakedTexture )
+                    AddBakeSessionDuplicate( Texture, DuplicatedTexture );
             }
         }
     }
@@ -1159,8 +1215,11 @@ FHoudiniEngineBakeUtils::BakeLandscape( UHoudiniAssetComponent* HoudiniAssetComp
 
     if ( LayerPackages.Num() > 0 )
     {
-        // Save the layer info's package
-        FEditorFileUtils::PromptForCheckoutAndSave( LayerPackages, true, false );
+        // Save the layer info's package, at the end of the bake session if there is one
+        if ( IsBakeSessionActive() )
+            AddBakeSessionPackages( LayerPackages );
+        else
+            FEditorFileUtils::PromptForCheckoutAndSave( LayerPackages, true, false );
 
         // Remove the packages from the asset component, or the asset component might 
         // destroy them when it is being destroyed
@@ -1174,6 +1233,63 @@ FHoudiniEngineBakeUtils::BakeLandscape( UHoudiniAssetComponent* HoudiniAssetComp
 #endif
 }
 
+UTexture2D *
+FHoudiniEngineBakeUtils::BakeVolumeTexture( UHoudiniAssetComponent * HoudiniAssetComponent, UTexture2D * VolumeTexture )
+{
+#if WITH_EDITOR
+    if ( !HoudiniAssetComponent || !HoudiniAssetComponent->GetHoudiniAsset() || !VolumeTexture )
+        return nullptr;
+
+    UPackage * TexturePackage = Cast< UPackage >( VolumeTexture->GetOuter() );
+    UMetaData * MetaData = TexturePackage ? TexturePackage->GetMetaData() : nullptr;
+    if ( !MetaData )
+        return nullptr;
+
+    // Locate the volume this texture was created from.
+    const FHoudiniGeoPartObject * HoudiniGeoPartObject = HoudiniAssetComponent->GetVolumeTextures()->FindKey( VolumeTexture );
+    if ( !HoudiniGeoPartObject )
+        return nullptr;
+
+    FHoudiniCookParams HoudiniCookParams( HoudiniAssetComponent );
+    HoudiniCookParams.StaticMeshBakeMode = EBakeMode::ReplaceExisitingAssets;
+    HoudiniCookParams.MaterialAndTextureBakeMode = EBakeMode::ReplaceExisitingAssets;
+
+    // Baking the same volume again replaces the previously baked texture.
+    const FString VolumeName = MetaData->GetValue( VolumeTexture, HAPI_UNREAL_PACKAGE_META_NODE_PATH );
+    const FString VolumeDescriptor = HoudiniAssetComponent->GetHoudiniAsset()->GetName() + TEXT( "_volume_" ) +
+        FString::FromInt( HoudiniGeoPartObject->ObjectId ) + TEXT( "_" ) +
+        FString::FromInt( HoudiniGeoPartObject->GeoId ) + TEXT( "_" ) +
+        FString::FromInt( HoudiniGeoPartObject->PartId ) + TEXT( "_" ) + VolumeName + TEXT( "_" );
+
+    UTexture2D * BakedTexture = DuplicateTextureAndCreatePackage( VolumeTexture, HoudiniCookParams, VolumeDescriptor );
+    if ( !BakedTexture )
+        return nullptr;
+
+    // Materials sampling the baked texture still need the slice layout and the value range.
+    UPackage * BakedPackage = BakedTexture->GetOutermost();
+    AddHoudiniMetaInformationToPackage(
+        BakedPackage, BakedTexture, HAPI_UNREAL_PACKAGE_META_NODE_PATH, *VolumeName );
+
+    if ( MetaData->HasValue( VolumeTexture, HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_LAYOUT ) )
+    {
+        AddHoudiniMetaInformationToPackage(
+            BakedPackage, BakedTexture, HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_LAYOUT,
+            *MetaData->GetValue( VolumeTexture, HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_LAYOUT ) );
+    }
+
+    if ( MetaData->HasValue( VolumeTexture, HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_RANGE ) )
+    {
+        AddHoudiniMetaInformationToPackage(
+            BakedPackage, BakedTexture, HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_RANGE,
+            *MetaData->GetValue( VolumeTexture, HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_RANGE ) );
+    }
+
+    return BakedTexture;
+#else
+    return nullptr;
+#endif
+}
+
 UPackage *
 FHoudiniEngineBakeUtils::BakeCreateMaterialPackageForComponent(
     FHoudiniCookParams& HoudiniCookParams,
@@ -1633,4 +1749,73 @@ FHoudiniEngineBakeUtils::GetHoudiniGeneratedNameFromMetaInformation(
     }
 
     return false;
-}
\ No newline at end of file
+}
+
+void
+FHoudiniEngineBakeUtils::BeginBakeSession()
+{
+    bBakeSessionActive = true;
+    BakeSessionDuplicates.Empty();
+    BakeSessionPackages.Empty();
+}
+
+int32
+FHoudiniEngineBakeUtils::EndBakeSession()
+{
+    int32 SavedCount = 0;
+
+#if WITH_EDITOR
+    TArray< UPackage * > PackagesToSave;
+    for ( const TWeakObjectPtr< UPackage > & Package : BakeSessionPackages )
+    {
+        if ( Package.IsValid() )
+            PackagesToSave.AddUnique( Package.Get() );
+    }
+
+    // A single save for everything the session created
+    if ( PackagesToSave.Num() > 0 && FEditorFileUtils::PromptForCheckoutAndSave( PackagesToSave, true, false ) == FEditorFileUtils::PR_Success )
+        SavedCount = PackagesToSave.Num();
+#endif
+
+    bBakeSessionActive = false;
+    BakeSessionDuplicates.Empty();
+    BakeSessionPackages.Empty();
+
+    return SavedCount;
+}
+
+bool
+FHoudiniEngineBakeUtils::IsBakeSessionActive()
+{
+    return bBakeSessionActive;
+}
+
+UObject *
+FHoudiniEngineBakeUtils::FindBakeSessionDuplicate( const UObject * Object )
+{
+    if ( !bBakeSessionActive || !Object )
+        return nullptr;
+
+    TWeakObjectPtr< UObject > * FoundDuplicate = BakeSessionDuplicates.Find( Object );
+    return FoundDuplicate ? FoundDuplicate->Get() : nullptr;
+}
+
+void
+FHoudiniEngineBakeUtils::AddBakeSessionDuplicate( const UObject * Object, UObject * Duplicate )
+{
+    if ( !bBakeSessionActive || !Object || !Duplicate )
+        return;
+
+    BakeSessionDuplicates.Add( Object, Duplicate );
+    BakeSessionPackages.Add( Duplicate->GetOutermost() );
+}
+
+void
+FHoudiniEngineBakeUtils::AddBakeSessionPackages( const TArray< UPackage * > & Packages )
+{
+    if ( !bBakeSessionActive )
+        return;
+
+    for ( UPackage * Package : Packages )
+        BakeSessionPackages.Add( Package );
+}
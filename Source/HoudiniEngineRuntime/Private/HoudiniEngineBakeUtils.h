@@ -102,6 +102,9 @@ public:
     /** Bakes landscape (detach them from the asset), if OnlyBakeThisLandscape is null, all landscapes will be baked **/
     static bool BakeLandscape( UHoudiniAssetComponent* HoudiniAssetComponent, class ALandscape * OnlyBakeThisLandscape = nullptr );
 
+    /** Bakes a volume texture to a new package, keeping the volume layout and value range meta information. **/
+    static UTexture2D * BakeVolumeTexture( UHoudiniAssetComponent * HoudiniAssetComponent, UTexture2D * VolumeTexture );
+
     /** Create a package for a given component for material. **/
     static UPackage * BakeCreateMaterialPackageForComponent(
         FHoudiniCookParams& HoudiniCookParams,
@@ -134,4 +137,29 @@ public:
     /** Retrieve item name from Houdini meta information. **/
     static bool GetHoudiniGeneratedNameFromMetaInformation(
         UPackage * Package, UObject * Object, FString & HoudiniName );
+
+    /** Start a bake session, the meshes and materials baked until it ends are shared by all the baked components. **/
+    static void BeginBakeSession();
+
+    /** End the bake session and save all the packages it created at once. Returns the number of saved packages. **/
+    static int32 EndBakeSession();
+
+    /** Returns true if a bake session is in progress. **/
+    static bool IsBakeSessionActive();
+
+protected:
+
+    /** Returns the copy of an object already baked during the current session, if any. **/
+    static UObject * FindBakeSessionDuplicate( const UObject * Object );
+
+    /** Record the baked copy of an object, its package is saved when the session ends. **/
+    static void AddBakeSessionDuplicate( const UObject * Object, UObject * Duplicate );
+
+    /** Record packages to be saved when the session ends. **/
+    static void AddBakeSessionPackages( const TArray< UPackage * > & Packages );
+
+    /** State of the current bake session. **/
+    static bool bBakeSessionActive;
+    static TMap< TWeakObjectPtr< const UObject >, TWeakObjectPtr< UObject > > BakeSessionDuplicates;
+    static TArray< TWeakObjectPtr< UPackage > > BakeSessionPackages;
 };
\ No newline at end of file
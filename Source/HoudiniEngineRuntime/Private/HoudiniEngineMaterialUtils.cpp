@@ -28,6 +28,7 @@
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngineBakeUtils.h"
 #include "HoudiniEngineString.h"
+#include "HoudiniObjectLoader.h"
 
 #include "Materials/Material.h"
 #include "Materials/MaterialInstance.h"
@@ -62,6 +63,12 @@ FHoudiniEngineMaterialUtils::MaterialExpressionNodeStepX = 220;
 const int32
 FHoudiniEngineMaterialUtils::MaterialExpressionNodeStepY = 220;
 
+TArray< TWeakObjectPtr< UMaterial > >
+FHoudiniEngineMaterialUtils::PendingMaterialUpdates;
+
+TArray< TWeakObjectPtr< UTexture > >
+FHoudiniEngineMaterialUtils::PendingTextureUpdates;
+
 void
 FHoudiniEngineMaterialUtils::HapiCreateMaterials(
     HAPI_NodeId AssetId,
@@ -80,9 +87,6 @@ FHoudiniEngineMaterialUtils::HapiCreateMaterials(
     if ( UniqueMaterialIds.Num() == 0 )
         return;
 
-    // Update context for generated materials (will trigger when object goes out of scope).
-    FMaterialUpdateContext MaterialUpdateContext;
-
     // Default Houdini material.
     UMaterial * DefaultMaterial = FHoudiniEngine::Get().GetHoudiniDefaultMaterial().Get();
     Materials.Add( HAPI_UNREAL_DEFAULT_MATERIAL_NAME, DefaultMaterial );
@@ -205,18 +209,14 @@ FHoudiniEngineMaterialUtils::HapiCreateMaterials(
             Material->TwoSided = true;
             Material->SetShadingModel( MSM_DefaultLit );
 
-            // Schedule this material for update.
-            MaterialUpdateContext.AddMaterial( Material );
-
             // Cache material.
             Materials.Add( MaterialShopName, Material );
 
-            // Propagate and trigger material updates.
+            // Propagate and schedule material updates, the material is compiled with the rest of the cook's output.
             if ( bCreatedNewMaterial )
                 FAssetRegistryModule::AssetCreated( Material );
 
-            Material->PreEditChange( nullptr );
-            Material->PostEditChange();
+            FHoudiniEngineMaterialUtils::AddPendingMaterialUpdate( Material );
             Material->MarkPackageDirty();
         }
         else
@@ -230,12 +230,64 @@ FHoudiniEngineMaterialUtils::HapiCreateMaterials(
 #endif
 }
 
+void
+FHoudiniEngineMaterialUtils::AddPendingMaterialUpdate( UMaterial * Material )
+{
+    if ( Material )
+        PendingMaterialUpdates.AddUnique( Material );
+}
+
+void
+FHoudiniEngineMaterialUtils::AddPendingTextureUpdate( UTexture * Texture )
+{
+    if ( Texture )
+        PendingTextureUpdates.AddUnique( Texture );
+}
+
+void
+FHoudiniEngineMaterialUtils::FinalizePendingMaterialUpdates()
+{
+    // Updates may schedule further ones, so take ownership of the current batch first.
+    TArray< TWeakObjectPtr< UTexture > > Textures = MoveTemp( PendingTextureUpdates );
+    TArray< TWeakObjectPtr< UMaterial > > Materials = MoveTemp( PendingMaterialUpdates );
+    PendingTextureUpdates.Empty();
+    PendingMaterialUpdates.Empty();
+
+#if WITH_EDITOR
+    // Textures are updated first, so the materials sampling them are compiled against their final state.
+    for ( TWeakObjectPtr< UTexture > & Texture : Textures )
+    {
+        if ( !Texture.IsValid() )
+            continue;
+
+        Texture->PreEditChange( nullptr );
+        Texture->PostEditChange();
+    }
+
+    if ( Materials.Num() <= 0 )
+        return;
+
+    // Update context for all the materials (will trigger once, when it goes out of scope).
+    FMaterialUpdateContext MaterialUpdateContext;
+    for ( TWeakObjectPtr< UMaterial > & Material : Materials )
+    {
+        if ( !Material.IsValid() )
+            continue;
+
+        MaterialUpdateContext.AddMaterial( Material.Get() );
+
+        // Shader compilation is queued to the shader compiling manager and completes asynchronously.
+        Material->PreEditChange( nullptr );
+        Material->PostEditChange();
+    }
+#endif
+}
 
 bool
 FHoudiniEngineMaterialUtils::HapiExtractImage(
     HAPI_ParmId NodeParmId, const HAPI_MaterialInfo & MaterialInfo,
     TArray< char > & ImageBuffer, const char * PlaneType, HAPI_ImageDataFormat ImageDataFormat,
-    HAPI_ImagePacking ImagePacking, bool bRenderToImage )
+    HAPI_ImagePacking ImagePacking, bool bRenderToImage, int32 MaxResolution )
 {
     if ( bRenderToImage )
     {
@@ -260,6 +312,15 @@ FHoudiniEngineMaterialUtils::HapiExtractImage(
     ImageInfo.interleaved = true;
     ImageInfo.packing = ImagePacking;
 
+    // Let Houdini downsample large images, this reduces the amount of data transferred and compressed.
+    const int32 ImageResolution = FMath::Max( ImageInfo.xRes, ImageInfo.yRes );
+    if ( MaxResolution > 0 && ImageResolution > MaxResolution )
+    {
+        const float ResolutionScale = (float) MaxResolution / (float) ImageResolution;
+        ImageInfo.xRes = FMath::Max( 1, FMath::RoundToInt( ImageInfo.xRes * ResolutionScale ) );
+        ImageInfo.yRes = FMath::Max( 1, FMath::RoundToInt( ImageInfo.yRes * ResolutionScale ) );
+    }
+
     if ( FHoudiniApi::SetImageInfo(
         FHoudiniEngine::Get().GetSession(),
         MaterialInfo.nodeId, &ImageInfo) != HAPI_RESULT_SUCCESS )
@@ -500,7 +561,8 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentDiffuse(
         // Retrieve color plane.
         if ( bFoundImagePlanes && FHoudiniEngineMaterialUtils::HapiExtractImage(
             ParmDiffuseTextureId, MaterialInfo, ImageBuffer, PlaneType,
-            HAPI_IMAGE_DATA_INT8, ImagePacking, false ) )
+            HAPI_IMAGE_DATA_INT8, ImagePacking, false,
+            HoudiniCookParams.MaxTextureResolution ) )
         {
             UPackage * TextureDiffusePackage = nullptr;
             if ( TextureDiffuse )
@@ -565,8 +627,6 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentDiffuse(
                 if ( bCreatedNewTextureDiffuse )
                     FAssetRegistryModule::AssetCreated( TextureDiffuse );
 
-                TextureDiffuse->PreEditChange( nullptr );
-                TextureDiffuse->PostEditChange();
                 TextureDiffuse->MarkPackageDirty();
             }
         }
@@ -745,7 +805,8 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentOpacityMask(
 
         if ( bFoundImagePlanes && FHoudiniEngineMaterialUtils::HapiExtractImage(
             ParmOpacityTextureId, MaterialInfo, ImageBuffer, PlaneType,
-            HAPI_IMAGE_DATA_INT8, ImagePacking, false ) )
+            HAPI_IMAGE_DATA_INT8, ImagePacking, false,
+            HoudiniCookParams.MaxTextureResolution ) )
         {
             // Locate sampling expression.
             ExpressionTextureOpacitySample = Cast< UMaterialExpressionTextureSampleParameter2D >(
@@ -839,8 +900,6 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentOpacityMask(
                 if ( bCreatedNewTextureOpacity )
                     FAssetRegistryModule::AssetCreated( TextureOpacity );
 
-                TextureOpacity->PreEditChange( nullptr );
-                TextureOpacity->PostEditChange();
                 TextureOpacity->MarkPackageDirty();
 
                 bExpressionCreated = true;
@@ -1112,7 +1171,8 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentNormal(
         // Retrieve color plane.
         if (FHoudiniEngineMaterialUtils::HapiExtractImage(
             ParmNameNormalId, MaterialInfo, ImageBuffer,
-            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true ) )
+            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true,
+            HoudiniCookParams.MaxTextureResolution ) )
         {
             UMaterialExpressionTextureSampleParameter2D * ExpressionNormal =
                 Cast< UMaterialExpressionTextureSampleParameter2D >( Material->Normal.Expression );
@@ -1236,7 +1296,8 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentNormal(
             // Retrieve color plane - this will contain normal data.
             if ( FHoudiniEngineMaterialUtils::HapiExtractImage(
                 ParmNameBaseId, MaterialInfo, ImageBuffer,
-                HAPI_UNREAL_MATERIAL_TEXTURE_NORMAL, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGB, true ) )
+                HAPI_UNREAL_MATERIAL_TEXTURE_NORMAL, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGB, true,
+                HoudiniCookParams.MaxTextureResolution ) )
             {
                 UMaterialExpressionTextureSampleParameter2D * ExpressionNormal =
                     Cast< UMaterialExpressionTextureSampleParameter2D >( Material->Normal.Expression );
@@ -1327,8 +1388,6 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentNormal(
                     if ( bCreatedNewTextureNormal )
                         FAssetRegistryModule::AssetCreated( TextureNormal );
 
-                    TextureNormal->PreEditChange( nullptr );
-                    TextureNormal->PostEditChange();
                     TextureNormal->MarkPackageDirty();
 
                     bExpressionCreated = true;
@@ -1387,7 +1446,8 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentSpecular(
         // Retrieve color plane.
         if ( FHoudiniEngineMaterialUtils::HapiExtractImage(
             ParmNameSpecularId, MaterialInfo, ImageBuffer,
-            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true ) )
+            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true,
+            HoudiniCookParams.MaxTextureResolution ) )
         {
             UMaterialExpressionTextureSampleParameter2D * ExpressionSpecular =
                 Cast< UMaterialExpressionTextureSampleParameter2D >( Material->Specular.Expression );
@@ -1595,7 +1655,8 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentRoughness(
         // Retrieve color plane.
         if ( FHoudiniEngineMaterialUtils::HapiExtractImage(
             ParmNameRoughnessId, MaterialInfo, ImageBuffer,
-            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true ) )
+            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true,
+            HoudiniCookParams.MaxTextureResolution ) )
         {
             UMaterialExpressionTextureSampleParameter2D* ExpressionRoughness =
                 Cast< UMaterialExpressionTextureSampleParameter2D >( Material->Roughness.Expression );
@@ -1795,7 +1856,8 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentMetallic(
         // Retrieve color plane.
         if ( FHoudiniEngineMaterialUtils::HapiExtractImage(
             ParmNameMetallicId, MaterialInfo, ImageBuffer,
-            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true ) )
+            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true,
+            HoudiniCookParams.MaxTextureResolution ) )
         {
             UMaterialExpressionTextureSampleParameter2D * ExpressionMetallic =
                 Cast< UMaterialExpressionTextureSampleParameter2D >( Material->Metallic.Expression );
@@ -1986,7 +2048,8 @@ FHoudiniEngineMaterialUtils::CreateMaterialComponentEmissive(
         // Retrieve color plane.
         if ( FHoudiniEngineMaterialUtils::HapiExtractImage(
             ParmNameEmissiveId, MaterialInfo, ImageBuffer,
-            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true ) )
+            HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, HAPI_IMAGE_DATA_INT8, HAPI_IMAGE_PACKING_RGBA, true,
+            HoudiniCookParams.MaxTextureResolution ) )
         {
             UMaterialExpressionTextureSampleParameter2D * ExpressionEmissive =
                 Cast< UMaterialExpressionTextureSampleParameter2D >( Material->EmissiveColor.Expression );
@@ -2177,6 +2240,25 @@ FHoudiniEngineMaterialUtils::CreateUnrealTexture(
     FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
         Package, Texture, HAPI_UNREAL_PACKAGE_META_NODE_PATH, *NodePath );
 
+    // Hash the extracted image and the parameters used to build the texture from it.
+    uint32 ImageHash = FCrc::MemCrc32( ImageBuffer.GetData(), ImageBuffer.Num() );
+    ImageHash = HashCombine( ImageHash, GetTypeHash( TextureParameters.bUseAlpha ) );
+    ImageHash = HashCombine( ImageHash, GetTypeHash( TextureParameters.bSRGB ) );
+    ImageHash = HashCombine( ImageHash, GetTypeHash( (int32) TextureParameters.CompressionSettings ) );
+    ImageHash = HashCombine( ImageHash, GetTypeHash( TextureParameters.bDeferCompression ) );
+    const FString TextureHash = FString::Printf( TEXT( "%dx%d_%08x" ), ImageInfo.xRes, ImageInfo.yRes, ImageHash );
+
+    // If the existing texture was built from identical data, there is no need to rebuild and recompress its source.
+    UMetaData * MetaData = Package ? Package->GetMetaData() : nullptr;
+    if ( ExistingTexture && MetaData && Texture->Source.IsValid()
+        && MetaData->GetValue( Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_HASH ).Equals( TextureHash ) )
+    {
+        return Texture;
+    }
+
+    FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
+        Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_HASH, *TextureHash );
+
     // Initialize texture source.
     Texture->Source.Init( ImageInfo.xRes, ImageInfo.yRes, 1, 1, TSF_BGRA8 );
 
@@ -2246,7 +2328,275 @@ FHoudiniEngineMaterialUtils::CreateUnrealTexture(
     }
     */
 
-    Texture->PostEditChange();
+    // The texture is updated along with the rest of the cook's materials.
+    FHoudiniEngineMaterialUtils::AddPendingTextureUpdate( Texture );
+
+    return Texture;
+}
+
+UTexture2D *
+FHoudiniEngineMaterialUtils::HapiCreateVolumeTexture(
+    FHoudiniCookParams& HoudiniCookParams, const FHoudiniGeoPartObject & HoudiniGeoPartObject,
+    int32 Downsampling, bool bUseHalfFloat )
+{
+    if ( !HoudiniGeoPartObject.IsVolume() || !HoudiniCookParams.HoudiniAsset )
+        return nullptr;
+
+    HAPI_NodeId NodeId = HoudiniGeoPartObject.HapiGeoGetNodeId();
+    if ( NodeId == -1 )
+        return nullptr;
+
+    HAPI_VolumeInfo VolumeInfo;
+    FMemory::Memzero< HAPI_VolumeInfo >( VolumeInfo );
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetVolumeInfo(
+        FHoudiniEngine::Get().GetSession(), NodeId,
+        HoudiniGeoPartObject.PartId, &VolumeInfo ), nullptr );
+
+    // Heightfields and their layers are flat, they are converted to landscapes instead.
+    if ( VolumeInfo.zLength <= 1 )
+        return nullptr;
+
+    // Only float volumes with up to four values per voxel can be packed in a texture.
+    if ( VolumeInfo.storage != HAPI_STORAGETYPE_FLOAT || VolumeInfo.tupleSize < 1 || VolumeInfo.tupleSize > 4 || VolumeInfo.tileSize <= 0 )
+        return nullptr;
+
+    FString VolumeName;
+    FHoudiniEngineString( VolumeInfo.nameSH ).ToFString( VolumeName );
+
+    // Houdini is Y up: each slice of the texture is a Houdini XZ plane, the slices are stacked along Houdini's Y axis.
+    // Volume textures are not available before 4.21, so the slices are laid out in a grid inside a 2D texture.
+    const int32 MaxTextureSize = 8192;
+    const int32 TupleSize = VolumeInfo.tupleSize;
+    const int32 TileSize = VolumeInfo.tileSize;
+
+    int32 Stride = FMath::Max( Downsampling, 1 );
+    int32 SizeX = 0, SizeY = 0, SizeZ = 0, TilesX = 0, TilesY = 0;
+    while ( true )
+    {
+        SizeX = ( VolumeInfo.xLength + Stride - 1 ) / Stride;
+        SizeY = ( VolumeInfo.zLength + Stride - 1 ) / Stride;
+        SizeZ = ( VolumeInfo.yLength + Stride - 1 ) / Stride;
+        TilesX = FMath::CeilToInt( FMath::Sqrt( (float) SizeZ ) );
+        TilesY = ( SizeZ + TilesX - 1 ) / TilesX;
+
+        if ( SizeX * TilesX <= MaxTextureSize && SizeY * TilesY <= MaxTextureSize )
+            break;
+
+        Stride++;
+    }
+
+    if ( Stride > FMath::Max( Downsampling, 1 ) )
+    {
+        HOUDINI_LOG_WARNING(
+            TEXT( "Volume %s is too large for a %dx%d texture, it was downsampled by %d instead of %d." ),
+            *VolumeName, MaxTextureSize, MaxTextureSize, Stride, FMath::Max( Downsampling, 1 ) );
+    }
+
+    const int32 AtlasSizeX = SizeX * TilesX;
+    const int32 AtlasSizeY = SizeY * TilesY;
+
+    ETextureSourceFormat SourceFormat = TSF_RGBA16F;
+    if ( !bUseHalfFloat )
+        SourceFormat = ( TupleSize == 1 ) ? TSF_G8 : TSF_BGRA8;
+
+    // Create or reuse the package and texture of this part.
+    FString VolumeDescriptor = HoudiniCookParams.HoudiniAsset->GetName() + TEXT( "_volume_" ) +
+        FString::FromInt( HoudiniGeoPartObject.ObjectId ) + TEXT( "_" ) +
+        FString::FromInt( HoudiniGeoPartObject.GeoId ) + TEXT( "_" ) +
+        FString::FromInt( HoudiniGeoPartObject.PartId ) + TEXT( "_" ) + VolumeName + TEXT( "_" );
+
+    FString TextureName;
+    UPackage * Package = FHoudiniEngineBakeUtils::BakeCreateTextureOrMaterialPackageForComponent(
+        HoudiniCookParams, VolumeDescriptor, TextureName );
+    if ( !Package )
+        return nullptr;
+
+    UTexture2D * Texture = FindObject< UTexture2D >( Package, *TextureName );
+    if ( Texture && !HoudiniGeoPartObject.bHasGeoChanged && Texture->Source.IsValid()
+        && Texture->Source.GetSizeX() == AtlasSizeX && Texture->Source.GetSizeY() == AtlasSizeY
+        && Texture->Source.GetFormat() == SourceFormat )
+    {
+        return Texture;
+    }
+
+    if ( !Texture )
+    {
+        Texture = NewObject< UTexture2D >(
+            Package, UTexture2D::StaticClass(), *TextureName,
+            RF_Transactional );
+
+        Texture->LODGroup = TEXTUREGROUP_World;
+    }
+
+    // The texture type and the volume name let material parameters find the texture by "<volume name>/V".
+    FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
+        Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_OBJECT, TEXT( "true" ) );
+    FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
+        Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_NAME, *TextureName );
+    FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
+        Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_TYPE, HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_VOLUME );
+    FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
+        Package, Texture, HAPI_UNREAL_PACKAGE_META_NODE_PATH, *VolumeName );
+
+    // Slice size and grid size, needed by materials to sample the atlas as a volume.
+    FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
+        Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_LAYOUT,
+        *FString::Printf( TEXT( "%d %d %d %d %d" ), SizeX, SizeY, SizeZ, TilesX, TilesY ) );
+
+    // The volume is read one tile at a time, only a single tile buffer is held besides the texture source.
+    TArray< float > TileValues;
+    TileValues.SetNumUninitialized( TileSize * TileSize * TileSize * TupleSize );
+
+    auto StreamVolumeTiles = [ & ]( TFunctionRef< void( int32 SrcIndex, int32 DestIndex ) > ProcessVoxel )
+    {
+        HAPI_VolumeTileInfo Tile;
+        FMemory::Memzero< HAPI_VolumeTileInfo >( Tile );
+        if ( HAPI_RESULT_SUCCESS != FHoudiniApi::GetFirstVolumeTile(
+            FHoudiniEngine::Get().GetSession(), NodeId, HoudiniGeoPartObject.PartId, &Tile ) )
+            return false;
+
+        while ( Tile.isValid )
+        {
+            if ( HAPI_RESULT_SUCCESS != FHoudiniApi::GetVolumeTileFloatData(
+                FHoudiniEngine::Get().GetSession(), NodeId, HoudiniGeoPartObject.PartId,
+                0.0f, &Tile, TileValues.GetData(), TileValues.Num() ) )
+                return false;
+
+            for ( int32 tz = 0; tz < TileSize; tz++ )
+            {
+                const int32 hz = Tile.minZ - VolumeInfo.minZ + tz;
+                if ( hz < 0 || hz >= VolumeInfo.zLength || hz % Stride != 0 )
+                    continue;
+
+                for ( int32 ty = 0; ty < TileSize; ty++ )
+                {
+                    const int32 hy = Tile.minY - VolumeInfo.minY + ty;
+                    if ( hy < 0 || hy >= VolumeInfo.yLength || hy % Stride != 0 )
+                        continue;
+
+                    // Position of this slice in the atlas grid.
+                    const int32 Slice = hy / Stride;
+                    const int32 SliceOffsetX = ( Slice % TilesX ) * SizeX;
+                    const int32 SliceOffsetY = ( Slice / TilesX ) * SizeY;
+
+                    for ( int32 tx = 0; tx < TileSize; tx++ )
+                    {
+                        const int32 hx = Tile.minX - VolumeInfo.minX + tx;
+                        if ( hx < 0 || hx >= VolumeInfo.xLength || hx % Stride != 0 )
+                            continue;
+
+                        const int32 SrcIndex = ( ( tz * TileSize + ty ) * TileSize + tx ) * TupleSize;
+                        const int32 DestIndex = ( SliceOffsetY + hz / Stride ) * AtlasSizeX + SliceOffsetX + hx / Stride;
+                        ProcessVoxel( SrcIndex, DestIndex );
+                    }
+                }
+            }
+
+            if ( HAPI_RESULT_SUCCESS != FHoudiniApi::GetNextVolumeTile(
+                FHoudiniEngine::Get().GetSession(), NodeId, HoudiniGeoPartObject.PartId, &Tile ) )
+                return false;
+        }
+
+        return true;
+    };
+
+    // Eight bit textures need the value range of the volume, found with a first pass over the tiles.
+    float ValueMin = MAX_FLT;
+    float ValueMax = -MAX_FLT;
+    if ( !bUseHalfFloat )
+    {
+        StreamVolumeTiles( [ & ]( int32 SrcIndex, int32 DestIndex )
+        {
+            for ( int32 n = 0; n < TupleSize; n++ )
+            {
+                ValueMin = FMath::Min( ValueMin, TileValues[ SrcIndex + n ] );
+                ValueMax = FMath::Max( ValueMax, TileValues[ SrcIndex + n ] );
+            }
+        } );
+
+        if ( ValueMin > ValueMax )
+            ValueMin = ValueMax = 0.0f;
+
+        FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
+            Package, Texture, HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_RANGE,
+            *FString::Printf( TEXT( "%f %f" ), ValueMin, ValueMax ) );
+    }
+
+    const float ValueScale = ValueMax > ValueMin ? 255.0f / ( ValueMax - ValueMin ) : 0.0f;
+    auto QuantizeValue = [ & ]( float Value )
+    {
+        return (uint8) FMath::Clamp( FMath::RoundToInt( ( Value - ValueMin ) * ValueScale ), 0, 255 );
+    };
+
+    Texture->Source.Init( AtlasSizeX, AtlasSizeY, 1, 1, SourceFormat );
+    uint8 * MipData = Texture->Source.LockMip( 0 );
+
+    // Voxels missing from sparse volumes and the unused cells of the grid stay at zero.
+    FMemory::Memzero( MipData, Texture->Source.CalcMipSize( 0 ) );
+
+    bool bSuccess = false;
+    if ( SourceFormat == TSF_RGBA16F )
+    {
+        FFloat16Color * DestData = (FFloat16Color *) MipData;
+        bSuccess = StreamVolumeTiles( [ & ]( int32 SrcIndex, int32 DestIndex )
+        {
+            FLinearColor Voxel( 0.0f, 0.0f, 0.0f, 1.0f );
+            for ( int32 n = 0; n < TupleSize; n++ )
+                Voxel.Component( n ) = TileValues[ SrcIndex + n ];
+
+            DestData[ DestIndex ] = FFloat16Color( Voxel );
+        } );
+    }
+    else if ( SourceFormat == TSF_G8 )
+    {
+        bSuccess = StreamVolumeTiles( [ & ]( int32 SrcIndex, int32 DestIndex )
+        {
+            MipData[ DestIndex ] = QuantizeValue( TileValues[ SrcIndex ] );
+        } );
+    }
+    else
+    {
+        FColor * DestData = (FColor *) MipData;
+        bSuccess = StreamVolumeTiles( [ & ]( int32 SrcIndex, int32 DestIndex )
+        {
+            FColor Voxel( 0, 0, 0, 255 );
+            Voxel.R = QuantizeValue( TileValues[ SrcIndex ] );
+            if ( TupleSize > 1 )
+                Voxel.G = QuantizeValue( TileValues[ SrcIndex + 1 ] );
+            if ( TupleSize > 2 )
+                Voxel.B = QuantizeValue( TileValues[ SrcIndex + 2 ] );
+            if ( TupleSize > 3 )
+                Voxel.A = QuantizeValue( TileValues[ SrcIndex + 3 ] );
+
+            DestData[ DestIndex ] = Voxel;
+        } );
+    }
+
+    Texture->Source.UnlockMip( 0 );
+
+    if ( !bSuccess )
+        HOUDINI_LOG_WARNING( TEXT( "Failed to read all the tiles of volume %s, missing voxels were left empty." ), *VolumeName );
+
+    // Slices are not filtered across the grid: no compression, no mips, clamped and point sampled.
+    Texture->SRGB = false;
+    Texture->CompressionNone = true;
+    Texture->MipGenSettings = TMGS_NoMipmaps;
+    Texture->AddressX = TA_Clamp;
+    Texture->AddressY = TA_Clamp;
+    Texture->Filter = TF_Nearest;
+    if ( SourceFormat == TSF_RGBA16F )
+        Texture->CompressionSettings = TC_HDR;
+    else if ( SourceFormat == TSF_G8 )
+        Texture->CompressionSettings = TC_Grayscale;
+    else
+        Texture->CompressionSettings = TC_VectorDisplacementmap;
+
+    if ( HoudiniCookParams.MaterialAndTextureBakeMode == EBakeMode::CookToTemp )
+        Texture->SetFlags( RF_Public | RF_Standalone );
+
+    // The texture is updated along with the rest of the cook's materials.
+    FHoudiniEngineMaterialUtils::AddPendingTextureUpdate( Texture );
+    Texture->MarkPackageDirty();
 
     return Texture;
 }
@@ -2419,7 +2769,7 @@ FHoudiniEngineMaterialUtils::CreateMaterialInstances(
 
     // Trying to find the material we want to create an instance of
     OriginalMaterialInterface = Cast< UMaterialInterface >(
-        StaticLoadObject( UMaterialInterface::StaticClass(), nullptr, *MaterialName, nullptr, LOAD_NoWarn, nullptr ) );
+        FHoudiniObjectLoader::LoadObject( MaterialName, UMaterialInterface::StaticClass(), LOAD_NoWarn ) );
 
     // The source material wasn't found
     if ( !OriginalMaterialInterface )
@@ -2429,35 +2779,65 @@ FHoudiniEngineMaterialUtils::CreateMaterialInstances(
     if ( !ParentMaterial )
         return false;
 
-    // Create/Retrieve the package for the MI
+    // See if we need to override some of the material instance's parameters
+    TArray< UGenericAttribute > AllMatParams;
+    // Get the detail material parameters
+    int ParamCount = FHoudiniEngineUtils::GetGenericAttributeList( HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_GENERIC_MAT_PARAM_PREFIX, AllMatParams, HAPI_ATTROWNER_DETAIL );
+    // Then the primitive material parameters
+    ParamCount += FHoudiniEngineUtils::GetGenericAttributeList( HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_GENERIC_MAT_PARAM_PREFIX, AllMatParams, HAPI_ATTROWNER_PRIM, MaterialIndexToAttributeIndex );
+
+    // Material instances are identified by their parent and parameter values, so all the parts and slots
+    // using the same parent with identical parameters share a single instance.
+    const FString MaterialInstanceKey = GetMaterialInstanceKey( ParentMaterial, AllMatParams );
+    const uint32 MaterialInstanceHash = GetTypeHash( MaterialInstanceKey );
+
+    // The full key is stored with each instance. On a hash collision, the instance found under that name
+    // holds other parameters and the next name is tried instead.
     FString MaterialInstanceName;
-    FString MaterialInstanceNamePrefix = PackageTools::SanitizePackageName( ParentMaterial->GetName() + TEXT("_instance_") + FString::FromInt(MaterialIndex) );
-    
-    // See if we can find the package in the cooked temp package cache
     UPackage * MaterialInstancePackage = nullptr;
-    TWeakObjectPtr< UPackage > * FoundPointer = CookParams.CookedTemporaryPackages->Find( MaterialInstanceNamePrefix );
-    if ( FoundPointer && (*FoundPointer).IsValid() )
+    UMaterialInstanceConstant* NewMaterialInstance = nullptr;
+    for ( int32 CollisionIdx = 0; ; ++CollisionIdx )
     {
-        // We found an already existing package for the M_I
-        MaterialInstancePackage = (*FoundPointer).Get();
-        MaterialInstanceName = MaterialInstancePackage->GetName();
-    }
-    else 
-    {
-        // We Couldnt find the corresponding M_I package, so create a new one
-        MaterialInstancePackage = FHoudiniEngineBakeUtils::BakeCreateTextureOrMaterialPackageForComponent(
-            CookParams, MaterialInstanceNamePrefix, MaterialInstanceName );
-    }
+        FString MaterialInstanceNamePrefix = PackageTools::SanitizePackageName(
+            ParentMaterial->GetName() + TEXT( "_instance_" ) + FString::Printf( TEXT( "%08x" ), MaterialInstanceHash ) );
+        if ( CollisionIdx > 0 )
+            MaterialInstanceNamePrefix += FString::Printf( TEXT( "_%d" ), CollisionIdx );
 
-    // Couldn't create a package for the Material Instance
-    if ( !MaterialInstancePackage )
-        return false;
+        // See if we can find the package in the cooked temp package cache
+        TWeakObjectPtr< UPackage > * FoundPointer = CookParams.CookedTemporaryPackages->Find( MaterialInstanceNamePrefix );
+        if ( FoundPointer && (*FoundPointer).IsValid() )
+        {
+            // We found an already existing package for the M_I
+            MaterialInstancePackage = (*FoundPointer).Get();
+            MaterialInstanceName = MaterialInstancePackage->GetName();
+        }
+        else
+        {
+            // We Couldnt find the corresponding M_I package, so create a new one
+            MaterialInstancePackage = FHoudiniEngineBakeUtils::BakeCreateTextureOrMaterialPackageForComponent(
+                CookParams, MaterialInstanceNamePrefix, MaterialInstanceName );
+        }
+
+        // Couldn't create a package for the Material Instance
+        if ( !MaterialInstancePackage )
+            return false;
+
+        // Trying to find the material instance in the package, it has already been created if another part shares it.
+        NewMaterialInstance = FindObject< UMaterialInstanceConstant >( MaterialInstancePackage, *MaterialInstanceName );
+        if ( !NewMaterialInstance )
+            NewMaterialInstance = LoadObject<UMaterialInstanceConstant>( MaterialInstancePackage, *MaterialInstanceName, nullptr, LOAD_None, nullptr );
+
+        if ( !NewMaterialInstance )
+            break;
+
+        UMetaData * MetaData = MaterialInstancePackage->GetMetaData();
+        if ( MetaData && MetaData->GetValue( NewMaterialInstance, HAPI_UNREAL_PACKAGE_META_GENERATED_MATERIAL_INSTANCE_KEY ).Equals( MaterialInstanceKey ) )
+            break;
+
+        NewMaterialInstance = nullptr;
+    }
 
-    //UMaterialInterface * MaterialInstanceInterface = Cast< UMaterialInterface >(
-    //    StaticLoadObject(UMaterialInterface::StaticClass(), nullptr, *MaterialInstanceNameString, nullptr, LOAD_NoWarn, nullptr));
-    // Trying to load the material instance from the package
     bool bNewMaterialCreated = false;
-    UMaterialInstanceConstant* NewMaterialInstance = LoadObject<UMaterialInstanceConstant>( MaterialInstancePackage, *MaterialInstanceName, nullptr, LOAD_None, nullptr );
     if ( !NewMaterialInstance )
     {
         // Factory to create materials.
@@ -2500,13 +2880,9 @@ FHoudiniEngineMaterialUtils::CreateMaterialInstances(
     // Update context for generated materials (will trigger when object goes out of scope).
     FMaterialUpdateContext MaterialUpdateContext;
 
+    // All the parameters are updated before the instance is edited once. A shared instance already
+    // holds these values, so only its first user modifies it.
     bool bModifiedMaterialParameters = false;
-    // See if we need to override some of the material instance's parameters
-    TArray< UGenericAttribute > AllMatParams;
-    // Get the detail material parameters
-    int ParamCount = FHoudiniEngineUtils::GetGenericAttributeList( HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_GENERIC_MAT_PARAM_PREFIX, AllMatParams, HAPI_ATTROWNER_DETAIL );
-    // Then the primitive material parameters
-    ParamCount += FHoudiniEngineUtils::GetGenericAttributeList( HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_GENERIC_MAT_PARAM_PREFIX, AllMatParams, HAPI_ATTROWNER_PRIM, MaterialIndexToAttributeIndex );
     for ( int32 ParamIdx = 0; ParamIdx < AllMatParams.Num(); ParamIdx++ )
     {
         // Try to update the material instance parameter corresponding to the attribute
@@ -2525,6 +2901,8 @@ FHoudiniEngineMaterialUtils::CreateMaterialInstances(
             MaterialInstancePackage, NewMaterialInstance, HAPI_UNREAL_PACKAGE_META_GENERATED_OBJECT, TEXT( "true" ) );
         FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
             MaterialInstancePackage, NewMaterialInstance, HAPI_UNREAL_PACKAGE_META_GENERATED_NAME, *MaterialInstanceName );
+        FHoudiniEngineBakeUtils::AddHoudiniMetaInformationToPackage(
+            MaterialInstancePackage, NewMaterialInstance, HAPI_UNREAL_PACKAGE_META_GENERATED_MATERIAL_INSTANCE_KEY, *MaterialInstanceKey );
 
         // Notify registry that we have created a new duplicate material.
         FAssetRegistryModule::AssetCreated( NewMaterialInstance );        
@@ -2557,6 +2935,24 @@ FHoudiniEngineMaterialUtils::CreateMaterialInstances(
 #endif
 }
 
+FString
+FHoudiniEngineMaterialUtils::GetMaterialInstanceKey( const UMaterial * ParentMaterial, const TArray< UGenericAttribute > & MaterialParameters )
+{
+    FString MaterialInstanceKey = ParentMaterial ? ParentMaterial->GetPathName() : FString();
+    for ( const UGenericAttribute & MatParam : MaterialParameters )
+    {
+        MaterialInstanceKey += FString::Printf( TEXT( ";%s:%d" ), *MatParam.AttributeName, (int32) MatParam.AttributeType );
+        for ( double DoubleValue : MatParam.DoubleValues )
+            MaterialInstanceKey += FString::Printf( TEXT( ",%.17g" ), DoubleValue );
+        for ( int64 IntValue : MatParam.IntValues )
+            MaterialInstanceKey += FString::Printf( TEXT( ",%lld" ), IntValue );
+        for ( const FString & StringValue : MatParam.StringValues )
+            MaterialInstanceKey += TEXT( "," ) + StringValue;
+    }
+
+    return MaterialInstanceKey;
+}
+
 bool
 FHoudiniEngineMaterialUtils::UpdateMaterialInstanceParameter( UGenericAttribute MaterialParameter, UMaterialInstanceConstant* MaterialInstance, FHoudiniCookParams& CookParams )
 {
@@ -2876,6 +3272,8 @@ FHoudiniEngineMaterialUtils::FindGeneratedTexture( const FString& TextureString,
             TextureTypeFriendlyString = TEXT( "metallic" );
         else if ( TextureTypeString.Compare( HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_OPACITY_MASK, ESearchCase::IgnoreCase) == 0 )
             TextureTypeFriendlyString = TEXT( "opacity" );
+        else if ( TextureTypeString.Compare( HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_VOLUME, ESearchCase::IgnoreCase) == 0 )
+            TextureTypeFriendlyString = TEXT( "volume" );
 
         // See if we have a match between the texture string and the friendly name
         if ( TextureTypeFriendlyString.Compare( TextureString, ESearchCase::IgnoreCase ) == 0 )
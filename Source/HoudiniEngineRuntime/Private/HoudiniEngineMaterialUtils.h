@@ -48,11 +48,11 @@ public:
         HAPI_ParmId NodeParmId, const HAPI_MaterialInfo & MaterialInfo,
         TArray< FString > & ImagePlanes );
 
-    /** HAPI : Extract image data. **/
+    /** HAPI : Extract image data. Images larger than MaxResolution are downsampled by Houdini, 0 keeps the full resolution. **/
     static bool HapiExtractImage(
         HAPI_ParmId NodeParmId, const HAPI_MaterialInfo & MaterialInfo,
         TArray< char > & ImageBuffer, const char * PlaneType, HAPI_ImageDataFormat ImageDataFormat,
-        HAPI_ImagePacking ImagePacking, bool bRenderToImage );
+        HAPI_ImagePacking ImagePacking, bool bRenderToImage, int32 MaxResolution = 0 );
         
     /** HAPI : Get unique material SHOP name. **/
     static bool GetUniqueMaterialShopName( HAPI_NodeId AssetId, HAPI_NodeId MaterialId, FString & Name );
@@ -60,18 +60,32 @@ public:
     /** Helper function to locate first Material expression of given class within given expression subgraph. **/
     static UMaterialExpression * MaterialLocateExpression( UMaterialExpression * Expression, UClass * ExpressionClass );
 
-    /** Creates Material Instance from attributes **/
+    /** Creates Material Instance from attributes. Instances are keyed by their parent material and a hash **/
+    /** of the material parameter attributes, so identical instances are shared and only edited once.     **/
     static bool CreateMaterialInstances( 
         const FHoudiniGeoPartObject& HoudiniGeoPartObject, FHoudiniCookParams& CookParams,
         UMaterialInstance *& CreatedMaterialInstance, UMaterialInterface*& OriginalMaterialInterface,
         std::string AttributeName, int32 MaterialIndex = 0 );
 
+    /** Returns the key identifying a material instance: its parent and all its parameters' names, types and values. **/
+    static FString GetMaterialInstanceKey( const UMaterial * ParentMaterial, const TArray< UGenericAttribute > & MaterialParameters );
+
     /** Updates the material instance parameter corresponding to the generic parameter found in the asset **/
     static bool UpdateMaterialInstanceParameter( UGenericAttribute MaterialParam, UMaterialInstanceConstant* MaterialInstance, FHoudiniCookParams& CookParams );
 
     /** Try to find a texture generated by HoudiniEngine that matches the texture string **/
     static UTexture* FindGeneratedTexture( const FString& TextureString, FHoudiniCookParams& CookParams );
 
+    /** Schedule a generated material to be compiled with the rest of the cook's materials. **/
+    static void AddPendingMaterialUpdate( UMaterial * Material );
+
+    /** Schedule a generated texture to be updated before the pending materials are compiled. **/
+    static void AddPendingTextureUpdate( UTexture * Texture );
+
+    /** Update all the pending textures, then compile all the pending materials in a single update context. **/
+    /** Shaders are compiled asynchronously, this does not wait for the compilation to finish.              **/
+    static void FinalizePendingMaterialUpdates();
+
 #if WITH_EDITOR
 
     /** Create a texture from given information. **/
@@ -81,6 +95,12 @@ public:
         const TArray< char > & ImageBuffer, const FString & TextureType,
         const FCreateTexture2DParameters & TextureParameters, TextureGroup LODGroup, const FString& NodePath );
 
+    /** HAPI : Create a 2D texture holding the Z slices of a non-heightfield volume laid out in a grid. **/
+    /** The volume is streamed tile by tile. Returns null for heightfields.                           **/
+    static UTexture2D * HapiCreateVolumeTexture(
+        FHoudiniCookParams& HoudiniCookParams, const FHoudiniGeoPartObject & HoudiniGeoPartObject,
+        int32 Downsampling, bool bUseHalfFloat );
+
     /** Create various material components. **/
     static bool CreateMaterialComponentDiffuse(
         FHoudiniCookParams& HoudiniCookParams, const HAPI_NodeId& AssetId,
@@ -130,4 +150,10 @@ public:
     static const int32 MaterialExpressionNodeStepX;
     static const int32 MaterialExpressionNodeStepY;
 
+protected:
+
+    /** Generated materials and textures waiting for FinalizePendingMaterialUpdates. **/
+    static TArray< TWeakObjectPtr< UMaterial > > PendingMaterialUpdates;
+    static TArray< TWeakObjectPtr< UTexture > > PendingTextureUpdates;
+
 };
\ No newline at end of file
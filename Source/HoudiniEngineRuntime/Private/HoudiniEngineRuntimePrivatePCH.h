@@ -83,10 +83,17 @@
 
 #include "HAPI.h"
 #include "HAPI_Version.h"
+#include "Runtime/Launch/Resources/Version.h"
 
 /** Whether to enable logging. **/
 #define HOUDINI_ENGINE_LOGGING 1
 
+/** Whether instanced static mesh components can update a range of instance transforms in one call. **/
+#define HOUDINI_ENGINE_BATCH_INSTANCE_UPDATE ( ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 22 )
+
+/** Whether instanced static mesh components support per-instance custom data floats. **/
+#define HOUDINI_ENGINE_INSTANCE_CUSTOM_DATA ( ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 25 )
+
 /** Define module names. **/
 #define HOUDINI_MODULE_EDITOR "HoudiniEngineEditor"
 #define HOUDINI_MODULE_RUNTIME "HoudiniEngine"
@@ -205,12 +212,15 @@
 //#define HAPI_UNREAL_ATTRIB_LANDSCAPE_NAME               "unreal_landscape"
 #define HAPI_UNREAL_ATTRIB_INPUT_MESH_NAME              "unreal_input_mesh_name"
 #define HAPI_UNREAL_ATTRIB_INPUT_SOURCE_FILE            "unreal_input_source_file"
+#define HAPI_UNREAL_ATTRIB_INPUT_SOURCE_INDEX           "unreal_input_source_index"
 #define HAPI_UNREAL_ATTRIB_MESH_SOCKET_NAME             "unreal_mesh_socket_name"
 #define HAPI_UNREAL_ATTRIB_MESH_SOCKET_ACTOR            "unreal_mesh_socket_actor"
 
 #define HAPI_UNREAL_ATTRIB_GENERIC_UPROP_PREFIX         "unreal_uproperty_"
 #define HAPI_UNREAL_ATTRIB_GENERIC_MAT_PARAM_PREFIX     "unreal_material_parameter_"
 #define HAPI_UNREAL_ATTRIB_INSTANCE_COLOR		"unreal_instance_color"
+#define HAPI_UNREAL_ATTRIB_INSTANCE_NUM_CUSTOM_FLOATS   "unreal_num_custom_floats"
+#define HAPI_UNREAL_ATTRIB_INSTANCE_CUSTOM_DATA_PREFIX  "unreal_per_instance_custom_data"
 
 /** Names of other Houdini Engine attributes and parameters. **/
 #define HAPI_UNREAL_ATTRIB_INSTANCE                     "instance"
@@ -355,6 +365,9 @@
 /** Group name used to mark everything that is not a member of collision or rendered collision group. **/
 #define HAPI_UNREAL_GROUP_GEOMETRY_NOT_COLLISION        "main_geo"
 
+/** Split name prefix used for the main geometry of each input source object, followed by its source index. **/
+#define HAPI_UNREAL_SPLIT_INPUT_SOURCE_PREFIX           "main_geo_source_"
+
 /** Group name prefix used to mark mesh sockets **/
 #define HAPI_UNREAL_GROUP_MESH_SOCKETS                  "socket"
 
@@ -369,6 +382,10 @@
 #define HAPI_UNREAL_PACKAGE_META_GENERATED_NAME                 TEXT( "HoudiniGeneratedName" )
 #define HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_TYPE         TEXT( "HoudiniGeneratedTextureType" )
 #define HAPI_UNREAL_PACKAGE_META_NODE_PATH                      TEXT( "HoudiniNodePath" )
+#define HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_HASH         TEXT( "HoudiniGeneratedTextureHash" )
+#define HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_RANGE         TEXT( "HoudiniGeneratedVolumeRange" )
+#define HAPI_UNREAL_PACKAGE_META_GENERATED_VOLUME_LAYOUT        TEXT( "HoudiniGeneratedVolumeLayout" )
+#define HAPI_UNREAL_PACKAGE_META_GENERATED_MATERIAL_INSTANCE_KEY TEXT( "HoudiniGeneratedMaterialInstanceKey" )
 
 #define HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_NORMAL       TEXT( "N" )
 #define HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_DIFFUSE      TEXT( "C_A" )
@@ -377,6 +394,7 @@
 #define HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_METALLIC     TEXT( "M" )
 #define HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_EMISSIVE     TEXT( "E" )
 #define HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_OPACITY_MASK TEXT( "O" )
+#define HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_VOLUME       TEXT( "V" )
 
 /** Various session related settings. **/
 #define HAPI_UNREAL_SESSION_SERVER_HOST                     TEXT( "localhost" )
@@ -36,17 +36,24 @@
 #include "HoudiniEngine.h"
 #include "HoudiniAsset.h"
 #include "HoudiniEngineString.h"
+#include "HoudiniApiRecorder.h"
+#include "HoudiniRuntimeSettings.h"
 #include "ScopeLock.h"
 
 const uint32
 FHoudiniEngineScheduler::InitialTaskSize = 256u;
 
-FHoudiniEngineScheduler::FHoudiniEngineScheduler()
+FHoudiniEngineScheduler::FHoudiniEngineScheduler( const HAPI_Session * InSession )
     : Tasks( nullptr )
     , PositionWrite( 0u )
     , PositionRead( 0u )
+    , bHasSession( InSession != nullptr )
     , bStopping( false )
 {
+    FMemory::Memzero< HAPI_Session >( Session );
+    if ( InSession )
+        Session = *InSession;
+
     //  Make sure size is power of two.
     TaskCount = FPlatformMath::RoundUpToPowerOfTwo( FHoudiniEngineScheduler::InitialTaskSize );
 
@@ -72,6 +79,12 @@ FHoudiniEngineScheduler::~FHoudiniEngineScheduler()
     }
 }
 
+const HAPI_Session *
+FHoudiniEngineScheduler::GetSession() const
+{
+    return bHasSession ? &Session : FHoudiniEngine::Get().GetSession();
+}
+
 void
 FHoudiniEngineScheduler::TaskDescription(
     FHoudiniEngineTaskInfo & TaskInfo,
@@ -105,7 +118,7 @@ FHoudiniEngineScheduler::TaskInstantiateAsset( const FHoudiniEngineTask & Task )
         TEXT( "HAPI Asynchronous Instantiation Started for %s: Asset=%s, HoudiniAsset = 0x%x" ),
         *Task.ActorName, *AssetN, Task.Asset.Get() );
 
-    if ( !FHoudiniEngineUtils::IsInitialized() )
+    if ( !FHoudiniEngineUtils::IsInitialized( GetSession() ) )
     {
         HOUDINI_LOG_ERROR(
             TEXT( "TaskInstantiateAsset failed for %s: %s" ),
@@ -160,7 +173,7 @@ FHoudiniEngineScheduler::TaskInstantiateAsset( const FHoudiniEngineTask & Task )
 
         // We instantiate without cooking.
         Result = FHoudiniApi::CreateNode(
-            FHoudiniEngine::Get().GetSession(), -1, &AssetNameString[ 0 ], nullptr, false, &AssetId );
+            GetSession(), -1, &AssetNameString[ 0 ], nullptr, false, &AssetId );
         if ( Result != HAPI_RESULT_SUCCESS )
         {
             AddResponseMessageTaskInfo(
@@ -185,7 +198,7 @@ FHoudiniEngineScheduler::TaskInstantiateAsset( const FHoudiniEngineTask & Task )
         {
             int Status = HAPI_STATE_STARTING_COOK;
             HOUDINI_CHECK_ERROR( &Result, FHoudiniApi::GetStatus(
-                FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_STATE, &Status ) );
+                GetSession(), HAPI_STATUS_COOK_STATE, &Status ) );
 
             if ( Status == HAPI_STATE_READY )
             {
@@ -200,9 +213,9 @@ FHoudiniEngineScheduler::TaskInstantiateAsset( const FHoudiniEngineTask & Task )
             else if ( Status == HAPI_STATE_READY_WITH_FATAL_ERRORS || Status == HAPI_STATE_READY_WITH_COOK_ERRORS )
             {
                 // There was an error while instantiating.
-                FString CookResultString = FHoudiniEngineUtils::GetCookResult();
+                FString CookResultString = FHoudiniEngineUtils::GetCookResult( GetSession() );
                 int32 CookResult = static_cast<int32>(HAPI_RESULT_SUCCESS);
-                FHoudiniApi::GetStatus( FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_RESULT, &CookResult );
+                FHoudiniApi::GetStatus( GetSession(), HAPI_STATUS_COOK_RESULT, &CookResult );
 
                 AddResponseMessageTaskInfo(
                     static_cast<HAPI_Result>(CookResult), EHoudiniEngineTaskType::AssetInstantiation,
@@ -218,7 +231,7 @@ FHoudiniEngineScheduler::TaskInstantiateAsset( const FHoudiniEngineTask & Task )
                 // Reset update time.
                 LastUpdateTime = FPlatformTime::Seconds();
 
-                const FString& CookStateMessage = FHoudiniEngineUtils::GetCookState();
+                const FString& CookStateMessage = FHoudiniEngineUtils::GetCookState( GetSession() );
 
                 AddResponseMessageTaskInfo(
                     HAPI_RESULT_SUCCESS, EHoudiniEngineTaskType::AssetInstantiation,
@@ -244,7 +257,7 @@ FHoudiniEngineScheduler::TaskInstantiateAsset( const FHoudiniEngineTask & Task )
 void
 FHoudiniEngineScheduler::TaskCookAsset( const FHoudiniEngineTask & Task )
 {
-    if ( !FHoudiniEngineUtils::IsInitialized() )
+    if ( !FHoudiniEngineUtils::IsInitialized( GetSession() ) )
     {
         HOUDINI_LOG_ERROR(
             TEXT( "TaskCookAsset failed for %s: %s"),
@@ -280,7 +293,7 @@ FHoudiniEngineScheduler::TaskCookAsset( const FHoudiniEngineTask & Task )
         return;
     }
 
-    Result = FHoudiniApi::CookNode( FHoudiniEngine::Get().GetSession(), AssetId, nullptr );
+    Result = FHoudiniApi::CookNode( GetSession(), AssetId, nullptr );
     if ( Result != HAPI_RESULT_SUCCESS )
     {
         AddResponseMessageTaskInfo(
@@ -304,15 +317,19 @@ FHoudiniEngineScheduler::TaskCookAsset( const FHoudiniEngineTask & Task )
     {
         int32 Status = HAPI_STATE_STARTING_COOK;
         HOUDINI_CHECK_ERROR( &Result, FHoudiniApi::GetStatus(
-            FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_STATE, &Status ) );
+            GetSession(), HAPI_STATUS_COOK_STATE, &Status ) );
 
         if ( Status == HAPI_STATE_READY )
         {
-            // Cooking has been successful.
+            // Cooking has been successful, fetch the output while the game thread is busy with other work.
+            TArray< FString > ReferencedObjectPaths;
+            TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > OutputSnapshot =
+                PrefetchCookOutput( AssetId, ReferencedObjectPaths );
+
             AddResponseMessageTaskInfo(
                 HAPI_RESULT_SUCCESS, EHoudiniEngineTaskType::AssetCooking,
                 EHoudiniEngineTaskState::FinishedCooking, AssetId, Task,
-                TEXT( "Finished Cooking" ) );
+                TEXT( "Finished Cooking" ), OutputSnapshot, ReferencedObjectPaths );
 
             break;
         }
@@ -334,7 +351,7 @@ FHoudiniEngineScheduler::TaskCookAsset( const FHoudiniEngineTask & Task )
             LastUpdateTime = FPlatformTime::Seconds();
 
             // Retrieve status string.
-            const FString & CookStateMessage = FHoudiniEngineUtils::GetCookState();
+            const FString & CookStateMessage = FHoudiniEngineUtils::GetCookState( GetSession() );
 
             AddResponseMessageTaskInfo(
                 HAPI_RESULT_SUCCESS, EHoudiniEngineTaskType::AssetCooking,
@@ -347,6 +364,36 @@ FHoudiniEngineScheduler::TaskCookAsset( const FHoudiniEngineTask & Task )
     }
 }
 
+TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe >
+FHoudiniEngineScheduler::PrefetchCookOutput( HAPI_NodeId AssetId, TArray< FString > & ReferencedObjectPaths )
+{
+    const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+    if ( !HoudiniRuntimeSettings || !HoudiniRuntimeSettings->bPrefetchCookOutput )
+        return nullptr;
+
+    // Recorder entries are installed by the game thread before we start, we only route our own calls to the snapshot.
+    // Output is always read from the engine session, there is nothing to prefetch on a dedicated one.
+    if ( !FHoudiniApiRecorder::AreSnapshotsEnabled() || bHasSession )
+        return nullptr;
+
+    double PrefetchStartTime = FPlatformTime::Seconds();
+
+    TSharedRef< FHoudiniApiSnapshot, ESPMode::ThreadSafe > Snapshot = MakeShareable( new FHoudiniApiSnapshot() );
+    bool bPrefetched = FHoudiniApiRecorder::CaptureSnapshot( *Snapshot, [ AssetId, &ReferencedObjectPaths ]()
+    {
+        return FHoudiniEngineUtils::HapiPrefetchCookOutput( AssetId, ReferencedObjectPaths );
+    } );
+
+    if ( !bPrefetched )
+        return nullptr;
+
+    HOUDINI_LOG_MESSAGE(
+        TEXT( "Prefetched %d HAPI calls (%d bytes) for AssetId %d in %.3f seconds." ),
+        Snapshot->Num(), Snapshot->GetPayloadSize(), AssetId, FPlatformTime::Seconds() - PrefetchStartTime );
+
+    return Snapshot;
+}
+
 void
 FHoudiniEngineScheduler::TaskDeleteAsset( const FHoudiniEngineTask & Task )
 {
@@ -355,8 +402,8 @@ FHoudiniEngineScheduler::TaskDeleteAsset( const FHoudiniEngineTask & Task )
         TEXT( "AssetId = %d" ),
         *Task.ActorName, Task.AssetId );
 
-    if ( FHoudiniEngineUtils::IsHoudiniAssetValid( Task.AssetId ) )
-        FHoudiniEngineUtils::DestroyHoudiniAsset( Task.AssetId );
+    if ( FHoudiniEngineUtils::IsHoudiniAssetValid( Task.AssetId, GetSession() ) )
+        FHoudiniEngineUtils::DestroyHoudiniAsset( Task.AssetId, GetSession() );
 
     // We do not insert task info as this is a fire and forget operation.
     // At this point component most likely does not exist.
@@ -368,7 +415,8 @@ FHoudiniEngineScheduler::AddResponseTaskInfo(
     HAPI_NodeId AssetId, const FHoudiniEngineTask & Task )
 {
     FHoudiniEngineTaskInfo TaskInfo( Result, AssetId, TaskType, TaskState );
-    FString StatusString = FHoudiniEngineUtils::GetErrorDescription();
+    FString StatusString = FHoudiniEngineUtils::GetStatusString(
+        HAPI_STATUS_CALL_RESULT, HAPI_STATUSVERBOSITY_ERRORS, GetSession() );
 
     TaskInfo.bLoadedComponent = Task.bLoadedComponent;
     TaskDescription( TaskInfo, Task.ActorName, StatusString );
@@ -378,11 +426,15 @@ FHoudiniEngineScheduler::AddResponseTaskInfo(
 void
 FHoudiniEngineScheduler::AddResponseMessageTaskInfo(
     HAPI_Result Result, EHoudiniEngineTaskType::Type TaskType, EHoudiniEngineTaskState::Type TaskState,
-    HAPI_NodeId AssetId, const FHoudiniEngineTask & Task, const FString & ErrorMessage )
+    HAPI_NodeId AssetId, const FHoudiniEngineTask & Task, const FString & ErrorMessage,
+    const TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > & OutputSnapshot,
+    const TArray< FString > & ReferencedObjectPaths )
 {
     FHoudiniEngineTaskInfo TaskInfo( Result, AssetId, TaskType, TaskState );
 
     TaskInfo.bLoadedComponent = Task.bLoadedComponent;
+    TaskInfo.OutputSnapshot = OutputSnapshot;
+    TaskInfo.ReferencedObjectPaths = ReferencedObjectPaths;
     TaskDescription( TaskInfo, Task.ActorName, ErrorMessage );
     FHoudiniEngine::Get().AddTaskInfo( Task.HapiGUID, TaskInfo );
 }
@@ -462,8 +514,8 @@ FHoudiniEngineScheduler::AddTask( const FHoudiniEngineTask & Task )
 {
     FScopeLock ScopeLock( &CriticalSection );
 
-    // Check if we need to grow our circular buffer.
-    if ( PositionWrite + 1 == PositionRead )
+    // Check if we need to grow our circular buffer, one slot is kept free to tell a full queue from an empty one.
+    if ( ( ( PositionWrite + 1 ) & ( TaskCount - 1 ) ) == PositionRead )
     {
         // Calculate next size (next power of two).
         uint32 NextTaskCount = FPlatformMath::RoundUpToPowerOfTwo( TaskCount + 1 );
@@ -478,25 +530,24 @@ FHoudiniEngineScheduler::AddTask( const FHoudiniEngineTask & Task )
         // Zero memory.
         FMemory::Memset( Buffer, 0x0, NextTaskCount * sizeof( FHoudiniEngineTask ) );
 
+        // Number of queued tasks.
+        uint32 QueuedTaskCount = ( PositionWrite - PositionRead ) & ( TaskCount - 1 );
+
         // Copy elements from old buffer to new one.
         if ( PositionRead < PositionWrite )
         {
-            FMemory::Memcpy( Buffer, Tasks + PositionRead, sizeof( FHoudiniEngineTask ) * ( PositionWrite - PositionRead ) );
-
-            // Update index positions.
-            PositionRead = 0;
-            PositionWrite = PositionWrite - PositionRead;
+            FMemory::Memcpy( Buffer, Tasks + PositionRead, sizeof( FHoudiniEngineTask ) * QueuedTaskCount );
         }
         else
         {
             FMemory::Memcpy( Buffer, Tasks + PositionRead, sizeof( FHoudiniEngineTask ) * ( TaskCount - PositionRead ) );
             FMemory::Memcpy( Buffer + TaskCount - PositionRead, Tasks, sizeof( FHoudiniEngineTask ) * PositionWrite );
-
-            // Update index positions.
-            PositionRead = 0;
-            PositionWrite = TaskCount - PositionRead + PositionWrite;
         }
 
+        // Update index positions.
+        PositionRead = 0;
+        PositionWrite = QueuedTaskCount;
+
         // Deallocate old buffer.
         FMemory::Free( Tasks );
 
@@ -526,6 +577,12 @@ FHoudiniEngineScheduler::Stop()
     bStopping = true;
 }
 
+void
+FHoudiniEngineScheduler::Resume()
+{
+    bStopping = false;
+}
+
 void
 FHoudiniEngineScheduler::Tick()
 {
@@ -42,7 +42,8 @@ class FHoudiniEngineScheduler : public FRunnable, FSingleThreadRunnable
 {
     public:
 
-        FHoudiniEngineScheduler();
+        /** Tasks are processed on the engine session, unless a dedicated session is given. **/
+        FHoudiniEngineScheduler( const HAPI_Session * InSession = nullptr );
         virtual ~FHoudiniEngineScheduler();
 
     /** FRunnable methods. **/
@@ -59,6 +60,9 @@ class FHoudiniEngineScheduler : public FRunnable, FSingleThreadRunnable
 
     public:
 
+        /** Clear the stopping flag, so that queued tasks are processed again once a new thread runs the scheduler. **/
+        void Resume();
+
         /** Add a task. **/
         void AddTask( const FHoudiniEngineTask & Task );
 
@@ -71,10 +75,15 @@ class FHoudiniEngineScheduler : public FRunnable, FSingleThreadRunnable
         void AddResponseMessageTaskInfo(
             HAPI_Result Result, EHoudiniEngineTaskType::Type TaskType,
             EHoudiniEngineTaskState::Type TaskState, HAPI_NodeId AssetId, const FHoudiniEngineTask & Task,
-            const FString & ErrorMessage );
+            const FString & ErrorMessage,
+            const TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > & OutputSnapshot = nullptr,
+            const TArray< FString > & ReferencedObjectPaths = TArray< FString >() );
 
     protected:
 
+        /** Return the session tasks are processed on. **/
+        const HAPI_Session * GetSession() const;
+
         /** Process queued tasks. **/
         void ProcessQueuedTasks();
 
@@ -84,6 +93,11 @@ class FHoudiniEngineScheduler : public FRunnable, FSingleThreadRunnable
         /** Task : cook an asset. **/
         void TaskCookAsset( const FHoudiniEngineTask & Task );
 
+        /** Fetch the output of a cooked asset and the objects it references, so that the game thread does not **/
+        /** have to wait on HAPI.                                                                               **/
+        TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > PrefetchCookOutput(
+            HAPI_NodeId AssetId, TArray< FString > & ReferencedObjectPaths );
+
         /** Create description of task's state. **/
         void TaskDescription( FHoudiniEngineTaskInfo & Task, const FString & ActorName, const FString & StatusString );
 
@@ -112,6 +126,10 @@ class FHoudiniEngineScheduler : public FRunnable, FSingleThreadRunnable
         /** Size of the circular queue. **/
         uint32 TaskCount;
 
+        /** Dedicated session, used instead of the engine one when bHasSession is set. **/
+        HAPI_Session Session;
+        bool bHasSession;
+
         /** Stopping flag. **/
         bool bStopping;
 };
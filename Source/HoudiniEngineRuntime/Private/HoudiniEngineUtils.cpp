@@ -34,6 +34,7 @@
 #include "HoudiniLandscapeUtils.h"
 #include "HoudiniEngineBakeUtils.h"
 #include "HoudiniEngineMaterialUtils.h"
+#include "HoudiniObjectLoader.h"
 #include "Components/SplineComponent.h"
 #include "LandscapeInfo.h"
 #include "LandscapeComponent.h"
@@ -61,6 +62,7 @@
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
 
 #include "Paths.h"
+#include "Misc/SecureHash.h"
 
 #if PLATFORM_WINDOWS
     #include "WindowsHWrapper.h"
@@ -171,22 +173,22 @@ FHoudiniEngineUtils::GetErrorDescription()
 }
 
 const FString
-FHoudiniEngineUtils::GetCookState()
+FHoudiniEngineUtils::GetCookState( const HAPI_Session * Session )
 {
-    return FHoudiniEngineUtils::GetStatusString( HAPI_STATUS_COOK_STATE, HAPI_STATUSVERBOSITY_ERRORS );
+    return FHoudiniEngineUtils::GetStatusString( HAPI_STATUS_COOK_STATE, HAPI_STATUSVERBOSITY_ERRORS, Session );
 }
 
 const FString
-FHoudiniEngineUtils::GetCookResult()
+FHoudiniEngineUtils::GetCookResult( const HAPI_Session * Session )
 {
-    return FHoudiniEngineUtils::GetStatusString( HAPI_STATUS_COOK_RESULT, HAPI_STATUSVERBOSITY_MESSAGES );
+    return FHoudiniEngineUtils::GetStatusString( HAPI_STATUS_COOK_RESULT, HAPI_STATUSVERBOSITY_MESSAGES, Session );
 }
 
 bool
-FHoudiniEngineUtils::IsInitialized()
+FHoudiniEngineUtils::IsInitialized( const HAPI_Session * Session )
 {
     return ( FHoudiniApi::IsHAPIInitialized() &&
-        FHoudiniApi::IsInitialized( FHoudiniEngine::Get().GetSession() ) == HAPI_RESULT_SUCCESS );
+        FHoudiniApi::IsInitialized( Session ? Session : FHoudiniEngine::Get().GetSession() ) == HAPI_RESULT_SUCCESS );
 }
 
 bool
@@ -323,27 +325,29 @@ FHoudiniEngineUtils::GetAssetPreset( HAPI_NodeId AssetId, TArray< char > & Prese
 }
 
 bool
-FHoudiniEngineUtils::IsHoudiniAssetValid( HAPI_NodeId AssetId )
+FHoudiniEngineUtils::IsHoudiniAssetValid( HAPI_NodeId AssetId, const HAPI_Session * Session )
 {
     if ( AssetId < 0 )
         return false;
 
+    if ( !Session )
+        Session = FHoudiniEngine::Get().GetSession();
+
     HAPI_NodeInfo NodeInfo;
     bool ValidationAnswer = 0;
 
-    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetNodeInfo(
-        FHoudiniEngine::Get().GetSession(), AssetId, &NodeInfo ), false );
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetNodeInfo( Session, AssetId, &NodeInfo ), false );
     HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::IsNodeValid(
-        FHoudiniEngine::Get().GetSession(), AssetId,
-        NodeInfo.uniqueHoudiniNodeId, &ValidationAnswer ), false );
+        Session, AssetId, NodeInfo.uniqueHoudiniNodeId, &ValidationAnswer ), false );
 
     return ValidationAnswer;
 }
 
 bool
-FHoudiniEngineUtils::DestroyHoudiniAsset( HAPI_NodeId AssetId )
+FHoudiniEngineUtils::DestroyHoudiniAsset( HAPI_NodeId AssetId, const HAPI_Session * Session )
 {
-    return FHoudiniApi::DeleteNode( FHoudiniEngine::Get().GetSession(), AssetId ) == HAPI_RESULT_SUCCESS;
+    return FHoudiniApi::DeleteNode(
+        Session ? Session : FHoudiniEngine::Get().GetSession(), AssetId ) == HAPI_RESULT_SUCCESS;
 }
 
 void
@@ -854,6 +858,116 @@ FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
         ResultAttributeInfo, Data, TupleSize );
 }
 
+bool
+FHoudiniEngineUtils::HapiGetCurvePoints(
+    const FHoudiniGeoPartObject & HoudiniGeoPartObject, TArray< FVector > & OutPositions,
+    TArray< int32 > & OutCurveCounts, bool & bOutPeriodic )
+{
+    OutPositions.Empty();
+    OutCurveCounts.Empty();
+    bOutPeriodic = false;
+
+    HAPI_CurveInfo CurveInfo;
+    FMemory::Memzero< HAPI_CurveInfo >( CurveInfo );
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetCurveInfo(
+        FHoudiniEngine::Get().GetSession(), HoudiniGeoPartObject.GeoId,
+        HoudiniGeoPartObject.PartId, &CurveInfo ), false );
+
+    if ( CurveInfo.curveCount <= 0 )
+        return false;
+
+    // Retrieve the number of points of every curve in the part at once.
+    OutCurveCounts.SetNumUninitialized( CurveInfo.curveCount );
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetCurveCounts(
+        FHoudiniEngine::Get().GetSession(), HoudiniGeoPartObject.GeoId,
+        HoudiniGeoPartObject.PartId, OutCurveCounts.GetData(), 0, CurveInfo.curveCount ), false );
+
+    // And all their positions.
+    HAPI_AttributeInfo AttributeInfoPosition;
+    FMemory::Memzero< HAPI_AttributeInfo >( AttributeInfoPosition );
+    TArray< float > Positions;
+    if ( !FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+        HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_POSITION, AttributeInfoPosition, Positions ) )
+        return false;
+
+    FHoudiniEngineUtils::ConvertScaleAndFlipVectorData( Positions, OutPositions );
+
+    // Make sure the counts match the retrieved positions.
+    int32 PointCount = 0;
+    for ( int32 CurveIdx = 0; CurveIdx < OutCurveCounts.Num(); ++CurveIdx )
+        PointCount += OutCurveCounts[ CurveIdx ];
+
+    if ( PointCount > OutPositions.Num() )
+        return false;
+
+    bOutPeriodic = CurveInfo.isPeriodic;
+    return true;
+}
+
+bool
+FHoudiniEngineUtils::HapiGetCurveParameters(
+    HAPI_NodeId NodeId, FString & OutCurveCoords, int32 & OutCurveType,
+    int32 & OutCurveMethod, int32 & OutCurveClosed )
+{
+    HAPI_NodeInfo NodeInfo;
+    FMemory::Memzero< HAPI_NodeInfo >( NodeInfo );
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetNodeInfo(
+        FHoudiniEngine::Get().GetSession(), NodeId, &NodeInfo ), false );
+
+    if ( NodeInfo.parmCount <= 0 )
+        return false;
+
+    TArray< HAPI_ParmInfo > ParmInfos;
+    ParmInfos.SetNumUninitialized( NodeInfo.parmCount );
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetParameters(
+        FHoudiniEngine::Get().GetSession(), NodeId, ParmInfos.GetData(), 0, NodeInfo.parmCount ), false );
+
+    // Locate the curve parameters by name or tag, their infos are taken from the listing.
+    auto FindParmInfoIndex = [ & ]( const std::string & ParmName )
+    {
+        const HAPI_ParmId ParmId = FHoudiniEngineUtils::HapiFindParameterByNameOrTag( NodeId, ParmName );
+        if ( ParmId < 0 )
+            return (int32) INDEX_NONE;
+
+        return ParmInfos.IndexOfByPredicate( [ ParmId ]( const HAPI_ParmInfo & ParmInfo ) { return ParmInfo.id == ParmId; } );
+    };
+
+    const int32 CoordsParmId = FindParmInfoIndex( HAPI_UNREAL_PARAM_CURVE_COORDS );
+    const int32 TypeParmId = FindParmInfoIndex( HAPI_UNREAL_PARAM_CURVE_TYPE );
+    const int32 MethodParmId = FindParmInfoIndex( HAPI_UNREAL_PARAM_CURVE_METHOD );
+    const int32 ClosedParmId = FindParmInfoIndex( HAPI_UNREAL_PARAM_CURVE_CLOSED );
+    if ( !ParmInfos.IsValidIndex( CoordsParmId ) || !ParmInfos.IsValidIndex( TypeParmId )
+        || !ParmInfos.IsValidIndex( MethodParmId ) || !ParmInfos.IsValidIndex( ClosedParmId ) )
+        return false;
+
+    // All the integer values of the node at once.
+    TArray< int32 > IntValues;
+    IntValues.SetNumZeroed( NodeInfo.parmIntValueCount );
+    if ( NodeInfo.parmIntValueCount > 0 )
+    {
+        HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetParmIntValues(
+            FHoudiniEngine::Get().GetSession(), NodeId, IntValues.GetData(), 0, NodeInfo.parmIntValueCount ), false );
+    }
+
+    const int32 TypeIndex = ParmInfos[ TypeParmId ].intValuesIndex;
+    const int32 MethodIndex = ParmInfos[ MethodParmId ].intValuesIndex;
+    const int32 ClosedIndex = ParmInfos[ ClosedParmId ].intValuesIndex;
+    if ( !IntValues.IsValidIndex( TypeIndex ) || !IntValues.IsValidIndex( MethodIndex ) || !IntValues.IsValidIndex( ClosedIndex ) )
+        return false;
+
+    OutCurveType = IntValues[ TypeIndex ];
+    OutCurveMethod = IntValues[ MethodIndex ];
+    OutCurveClosed = IntValues[ ClosedIndex ];
+
+    HAPI_StringHandle CoordsStringHandle;
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetParmStringValues(
+        FHoudiniEngine::Get().GetSession(), NodeId, false, &CoordsStringHandle,
+        ParmInfos[ CoordsParmId ].stringValuesIndex, 1 ), false );
+
+    FHoudiniEngineString HoudiniEngineString( CoordsStringHandle );
+    return HoudiniEngineString.ToFString( OutCurveCoords );
+}
+
 bool
 FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
     HAPI_NodeId AssetId, HAPI_NodeId ObjectId, HAPI_NodeId GeoId,
@@ -2564,7 +2678,8 @@ FHoudiniEngineUtils::HapiCreateInputNodeForData(
     UStaticMesh * StaticMesh,
     HAPI_NodeId & ConnectedAssetId,
     UStaticMeshComponent* StaticMeshComponent /* = nullptr */,
-    const bool& ExportAllLODs /* = false */ )
+    const bool& ExportAllLODs /* = false */,
+    const int32& InputSourceIndex /* = -1 */ )
 {
 #if WITH_EDITOR
 
@@ -2952,10 +3067,11 @@ FHoudiniEngineUtils::HapiCreateInputNodeForData(
         if ( RawMesh.FaceMaterialIndices.Num() > 0 )
         {
             // Create list of materials, one for each face.
-            TArray< char * > StaticMeshFaceMaterials;
+            TArray< std::string > MaterialSlotNames;
+            TArray< const char * > StaticMeshFaceMaterials;
             FHoudiniEngineUtils::CreateFaceMaterialArray(
                 StaticMesh->StaticMaterials, RawMesh.FaceMaterialIndices,
-                StaticMeshFaceMaterials );
+                MaterialSlotNames, StaticMeshFaceMaterials );
 
             // Get name of attribute used for marshalling materials.
             std::string MarshallingAttributeName = HAPI_UNREAL_ATTRIB_MATERIAL;
@@ -2984,15 +3100,12 @@ FHoudiniEngineUtils::HapiCreateInputNodeForData(
             if ( FHoudiniApi::SetAttributeStringData(
                 FHoudiniEngine::Get().GetSession(),
                 DisplayGeoInfo.nodeId, 0, MarshallingAttributeName.c_str(), &AttributeInfoMaterial,
-                (const char **) StaticMeshFaceMaterials.GetData(), 0,
+                StaticMeshFaceMaterials.GetData(), 0,
                 StaticMeshFaceMaterials.Num() ) != HAPI_RESULT_SUCCESS )
             {
                 bAttributeError = true;
             }
 
-            // Delete material names.
-            FHoudiniEngineUtils::DeleteFaceMaterialArray( StaticMeshFaceMaterials );
-
             if ( bAttributeError )
             {
                 check( 0 );
@@ -3097,6 +3210,31 @@ FHoudiniEngineUtils::HapiCreateInputNodeForData(
                 PrimitiveAttrs.GetData(), 0, PrimitiveAttrs.Num() ), false );
         }
 
+        if ( InputSourceIndex >= 0 )
+        {
+            // Create primitive attribute with the index of the source object, used to split the output per source
+            TArray< int32 > SourceIndices;
+            SourceIndices.Init( InputSourceIndex, Part.faceCount );
+
+            HAPI_AttributeInfo AttributeInfoSourceIndex;
+            FMemory::Memzero< HAPI_AttributeInfo >( AttributeInfoSourceIndex );
+            AttributeInfoSourceIndex.count = Part.faceCount;
+            AttributeInfoSourceIndex.tupleSize = 1;
+            AttributeInfoSourceIndex.exists = true;
+            AttributeInfoSourceIndex.owner = HAPI_ATTROWNER_PRIM;
+            AttributeInfoSourceIndex.storage = HAPI_STORAGETYPE_INT;
+            AttributeInfoSourceIndex.originalOwner = HAPI_ATTROWNER_INVALID;
+
+            HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::AddAttribute(
+                FHoudiniEngine::Get().GetSession(), DisplayGeoInfo.nodeId,
+                0, HAPI_UNREAL_ATTRIB_INPUT_SOURCE_INDEX, &AttributeInfoSourceIndex ), false );
+
+            HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::SetAttributeIntData(
+                FHoudiniEngine::Get().GetSession(),
+                DisplayGeoInfo.nodeId, 0, HAPI_UNREAL_ATTRIB_INPUT_SOURCE_INDEX, &AttributeInfoSourceIndex,
+                SourceIndices.GetData(), 0, SourceIndices.Num() ), false );
+        }
+
         if( !HoudiniRuntimeSettings->MarshallingAttributeInputSourceFile.IsEmpty() )
         {
             FString Filename;
@@ -3203,7 +3341,8 @@ FHoudiniEngineUtils::HapiCreateInputNodeForData(
     TArray< FHoudiniAssetInputOutlinerMesh > & OutlinerMeshArray,
     HAPI_NodeId & ConnectedAssetId,
     const float& SplineResolution,
-    const bool& ExportAllLODs /* = false */ )
+    const bool& ExportAllLODs /* = false */,
+    const bool& bTagInputSources /* = false */ )
 {
 #if WITH_EDITOR
     if ( OutlinerMeshArray.Num() <= 0 )
@@ -3228,7 +3367,8 @@ FHoudiniEngineUtils::HapiCreateInputNodeForData(
                 OutlinerMesh.StaticMesh,
                 OutlinerMesh.AssetId,
                 OutlinerMesh.StaticMeshComponent,
-                ExportAllLODs );
+                ExportAllLODs,
+                bTagInputSources ? InputIdx : -1 );
         }
         else if ( OutlinerMesh.SplineComponent != nullptr )
         {
@@ -3273,7 +3413,8 @@ FHoudiniEngineUtils::HapiCreateInputNodeForData(
 bool 
 FHoudiniEngineUtils::HapiCreateInputNodeForData( 
     HAPI_NodeId HostAssetId, TArray<UObject *>& InputObjects, const TArray< FTransform >& InputTransforms,
-    HAPI_NodeId & ConnectedAssetId, TArray< HAPI_NodeId >& OutCreatedNodeIds, const bool& bExportAllLODs /* = false */ )
+    HAPI_NodeId & ConnectedAssetId, TArray< HAPI_NodeId >& OutCreatedNodeIds, const bool& bExportAllLODs /* = false */,
+    const bool& bTagInputSources /* = false */ )
 {
 #if WITH_EDITOR
     if ( ensure( InputObjects.Num() ) )
@@ -3296,7 +3437,8 @@ FHoudiniEngineUtils::HapiCreateInputNodeForData(
                 HAPI_NodeId MeshAssetNodeId = -1;
                 // Creating an Input Node for Mesh Data
                 // Creating an Input Node for Static Mesh Data
-                if ( !HapiCreateInputNodeForData( ConnectedAssetId, InputStaticMesh, MeshAssetNodeId, nullptr, bExportAllLODs ) )
+                if ( !HapiCreateInputNodeForData(
+                    ConnectedAssetId, InputStaticMesh, MeshAssetNodeId, nullptr, bExportAllLODs, bTagInputSources ? InputIdx : -1 ) )
                 {
                     HOUDINI_LOG_WARNING( TEXT( "Error creating input index %d on %d" ), InputIdx, ConnectedAssetId );
                 }
@@ -3398,13 +3540,263 @@ FHoudiniEngineUtils::HapiSetAssetTransform( HAPI_NodeId AssetId, const FTransfor
     return true;
 }
 
+bool
+FHoudiniEngineUtils::HapiPrefetchCookOutput( HAPI_NodeId AssetId, TArray< FString > & ReferencedObjectPaths )
+{
+    ReferencedObjectPaths.Empty();
+
+    // Attribute marshalling names, these must match the ones used when creating static meshes.
+    std::string MarshallingAttributeNameLightmapResolution = HAPI_UNREAL_ATTRIB_LIGHTMAP_RESOLUTION;
+    std::string MarshallingAttributeNameMaterial = HAPI_UNREAL_ATTRIB_MATERIAL;
+    std::string MarshallingAttributeNameFaceSmoothingMask = HAPI_UNREAL_ATTRIB_FACE_SMOOTHING_MASK;
+    std::string MarshallingAttributeNameGeneratedMeshName = HAPI_UNREAL_ATTRIB_GENERATED_MESH_NAME;
+    std::string MarshallingAttributeNameInstanceOverride = HAPI_UNREAL_ATTRIB_INSTANCE_OVERRIDE;
+
+    const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+    if ( HoudiniRuntimeSettings )
+    {
+        if ( !HoudiniRuntimeSettings->MarshallingAttributeLightmapResolution.IsEmpty() )
+            FHoudiniEngineUtils::ConvertUnrealString(
+                HoudiniRuntimeSettings->MarshallingAttributeLightmapResolution, MarshallingAttributeNameLightmapResolution );
+
+        if ( !HoudiniRuntimeSettings->MarshallingAttributeMaterial.IsEmpty() )
+            FHoudiniEngineUtils::ConvertUnrealString(
+                HoudiniRuntimeSettings->MarshallingAttributeMaterial, MarshallingAttributeNameMaterial );
+
+        if ( !HoudiniRuntimeSettings->MarshallingAttributeFaceSmoothingMask.IsEmpty() )
+            FHoudiniEngineUtils::ConvertUnrealString(
+                HoudiniRuntimeSettings->MarshallingAttributeFaceSmoothingMask, MarshallingAttributeNameFaceSmoothingMask );
+
+        FHoudiniEngineUtils::ConvertUnrealString(
+            HoudiniRuntimeSettings->MarshallingAttributeGeneratedMeshName, MarshallingAttributeNameGeneratedMeshName );
+    }
+
+    UHoudiniRuntimeSettings::GetSettingsValue(
+        TEXT( "MarshallingAttributeInstanceOverride" ), MarshallingAttributeNameInstanceOverride );
+
+    // Attributes holding object paths: instance overrides, material overrides and material instance parents.
+    const char * ReferenceAttributeNames[] =
+    {
+        MarshallingAttributeNameInstanceOverride.c_str(),
+        MarshallingAttributeNameMaterial.c_str(),
+        HAPI_UNREAL_ATTRIB_MATERIAL_FALLBACK,
+        HAPI_UNREAL_ATTRIB_MATERIAL_INSTANCE
+    };
+
+    TSet< FString > UniqueObjectPaths;
+
+    HAPI_AssetInfo AssetInfo;
+    HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetAssetInfo(
+        FHoudiniEngine::Get().GetSession(), AssetId, &AssetInfo ), false );
+
+    FTransform AssetUnrealTransform;
+    if ( !FHoudiniEngineUtils::HapiGetAssetTransform( AssetId, AssetUnrealTransform ) )
+        return false;
+
+    TArray< HAPI_ObjectInfo > ObjectInfos;
+    if ( !FHoudiniEngineUtils::HapiGetObjectInfos( AssetId, ObjectInfos ) )
+        return false;
+
+    TArray< HAPI_Transform > ObjectTransforms;
+    if ( !FHoudiniEngineUtils::HapiGetObjectTransforms( AssetId, ObjectTransforms ) )
+        return false;
+
+    for ( int32 ObjectIdx = 0; ObjectIdx < ObjectInfos.Num(); ++ObjectIdx )
+    {
+        const HAPI_ObjectInfo & ObjectInfo = ObjectInfos[ ObjectIdx ];
+
+        HAPI_GeoInfo GeoInfo;
+        if ( HAPI_RESULT_SUCCESS != FHoudiniApi::GetDisplayGeoInfo(
+            FHoudiniEngine::Get().GetSession(), ObjectInfo.nodeId, &GeoInfo ) )
+            continue;
+
+        TArray< FString > ObjectGeoGroupNames;
+        FHoudiniEngineUtils::HapiGetGroupNames(
+            AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, 0, HAPI_GROUPTYPE_PRIM, ObjectGeoGroupNames, false );
+
+        for ( int32 PartIdx = 0; PartIdx < GeoInfo.partCount; ++PartIdx )
+        {
+            HAPI_PartInfo PartInfo;
+            if ( HAPI_RESULT_SUCCESS != FHoudiniApi::GetPartInfo(
+                FHoudiniEngine::Get().GetSession(), GeoInfo.nodeId, PartIdx, &PartInfo ) )
+                continue;
+
+            // Any part, instancers included, may reference objects the game thread streams in before applying the output.
+            for ( const char * ReferenceAttributeName : ReferenceAttributeNames )
+            {
+                HAPI_AttributeInfo ReferenceAttributeInfo;
+                FMemory::Memzero< HAPI_AttributeInfo >( ReferenceAttributeInfo );
+
+                TArray< FString > ReferenceData;
+                if ( !FHoudiniEngineUtils::HapiGetAttributeDataAsString(
+                    AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                    ReferenceAttributeName, ReferenceAttributeInfo, ReferenceData ) )
+                    continue;
+
+                for ( const FString & ObjectPath : ReferenceData )
+                {
+                    if ( !ObjectPath.IsEmpty() )
+                        UniqueObjectPaths.Add( ObjectPath );
+                }
+            }
+
+            // Only mesh parts carry bulk data, other parts are cheap to query from the game thread.
+            if ( PartInfo.type != HAPI_PARTTYPE_MESH || ObjectInfo.isInstancer || PartInfo.vertexCount <= 0 )
+                continue;
+
+            HAPI_AttributeInfo AttributeInfo;
+            FMemory::Memzero< HAPI_AttributeInfo >( AttributeInfo );
+
+            TArray< FString > StringData;
+            FHoudiniEngineUtils::HapiGetAttributeDataAsString(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                MarshallingAttributeNameGeneratedMeshName.c_str(), AttributeInfo, StringData );
+
+            if ( PartInfo.faceCount > 0 )
+            {
+                TArray< HAPI_NodeId > PartFaceMaterialIds;
+                PartFaceMaterialIds.SetNumUninitialized( PartInfo.faceCount );
+
+                HAPI_Bool bSingleFaceMaterial = false;
+                FHoudiniApi::GetMaterialNodeIdsOnFaces(
+                    FHoudiniEngine::Get().GetSession(), GeoInfo.nodeId, PartInfo.id,
+                    &bSingleFaceMaterial, &PartFaceMaterialIds[ 0 ], 0, PartInfo.faceCount );
+            }
+
+            TArray< int32 > PartVertexList;
+            PartVertexList.SetNumUninitialized( PartInfo.vertexCount );
+            FHoudiniApi::GetVertexList(
+                FHoudiniEngine::Get().GetSession(), GeoInfo.nodeId, PartInfo.id,
+                &PartVertexList[ 0 ], 0, PartInfo.vertexCount );
+
+            // Group memberships are used to split collision and LOD geometry.
+            TArray< FString > GroupNames = ObjectGeoGroupNames;
+            if ( PartInfo.isInstanced )
+            {
+                FHoudiniEngineUtils::HapiGetGroupNames(
+                    AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id, HAPI_GROUPTYPE_PRIM, GroupNames, true );
+            }
+
+            for ( int32 GroupIdx = 0; GroupIdx < GroupNames.Num(); ++GroupIdx )
+            {
+                TArray< int32 > GroupMembership;
+                FHoudiniEngineUtils::HapiGetGroupMembership(
+                    AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id, HAPI_GROUPTYPE_PRIM,
+                    GroupNames[ GroupIdx ], GroupMembership, PartInfo.isInstanced );
+            }
+
+            // Raw vertex data.
+            TArray< float > FloatData;
+            FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                HAPI_UNREAL_ATTRIB_POSITION, AttributeInfo, FloatData );
+
+            FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                HAPI_UNREAL_ATTRIB_NORMAL, AttributeInfo, FloatData );
+
+            FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                HAPI_UNREAL_ATTRIB_COLOR, AttributeInfo, FloatData );
+
+            FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                HAPI_UNREAL_ATTRIB_ALPHA, AttributeInfo, FloatData );
+
+            TArray< HAPI_AttributeInfo > AttribInfoUVs;
+            AttribInfoUVs.SetNumZeroed( MAX_STATIC_TEXCOORDS );
+            TArray< TArray< float > > PartUVs;
+            PartUVs.SetNumZeroed( MAX_STATIC_TEXCOORDS );
+            FHoudiniEngineUtils::GetAllUVAttributesInfoAndTexCoords(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id, AttribInfoUVs, PartUVs );
+
+            TArray< int32 > IntData;
+            FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                MarshallingAttributeNameFaceSmoothingMask.c_str(), AttributeInfo, IntData );
+
+            FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                MarshallingAttributeNameLightmapResolution.c_str(), AttributeInfo, IntData );
+
+            FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                HAPI_UNREAL_ATTRIB_INPUT_SOURCE_INDEX, AttributeInfo, IntData );
+
+            FHoudiniEngineUtils::HapiGetAttributeDataAsString(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                MarshallingAttributeNameMaterial.c_str(), AttributeInfo, StringData );
+        }
+    }
+
+    ReferencedObjectPaths = UniqueObjectPaths.Array();
+    return true;
+}
+
+FString
+FHoudiniEngineUtils::HapiGetPackedPartGeometryKey(
+    HAPI_NodeId AssetId, HAPI_NodeId ObjectId, HAPI_NodeId GeoId, const HAPI_PartInfo & PartInfo,
+    const TArray< int32 > & PartVertexList, const TArray< HAPI_NodeId > & PartFaceMaterialIds )
+{
+    FHoudiniGeoPartObject PackedPart( AssetId, ObjectId, GeoId, PartInfo.id );
+
+    FSHA1 Digest;
+    Digest.Update( (const uint8 *) PartVertexList.GetData(), PartVertexList.Num() * sizeof( int32 ) );
+    Digest.Update( (const uint8 *) PartFaceMaterialIds.GetData(), PartFaceMaterialIds.Num() * sizeof( HAPI_NodeId ) );
+
+    // All attributes contribute, as any of them (uvs, normals, materials, lightmap resolution..) can end up in the mesh.
+    for ( int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; ++OwnerIdx )
+    {
+        HAPI_AttributeOwner AttributeOwner = (HAPI_AttributeOwner) OwnerIdx;
+
+        TArray< FString > AttributeNames;
+        if ( !PackedPart.HapiGetAttributeNames( AttributeOwner, AttributeNames ) )
+            return FString();
+
+        // Attribute order is not significant.
+        AttributeNames.Sort();
+
+        for ( const FString & AttributeName : AttributeNames )
+        {
+            Digest.UpdateWithString( *AttributeName, AttributeName.Len() + 1 );
+
+            HAPI_AttributeInfo AttributeInfo;
+            FMemory::Memzero< HAPI_AttributeInfo >( AttributeInfo );
+
+            TArray< float > FloatData;
+            if ( PackedPart.HapiGetAttributeDataAsFloat( AttributeName, AttributeOwner, AttributeInfo, FloatData ) )
+            {
+                Digest.Update( (const uint8 *) &AttributeInfo.tupleSize, sizeof( AttributeInfo.tupleSize ) );
+                Digest.Update( (const uint8 *) FloatData.GetData(), FloatData.Num() * sizeof( float ) );
+                continue;
+            }
+
+            TArray< FString > StringData;
+            if ( PackedPart.HapiGetAttributeDataAsString( AttributeName, AttributeOwner, AttributeInfo, StringData ) )
+            {
+                for ( const FString & StringValue : StringData )
+                    Digest.UpdateWithString( *StringValue, StringValue.Len() + 1 );
+            }
+        }
+    }
+
+    Digest.Final();
+    FSHAHash DigestHash;
+    Digest.GetHash( DigestHash.Hash );
+
+    // The counts are kept readable in the key, the digest covers the topology, materials and attributes.
+    return FString::Printf(
+        TEXT( "%d_%d_%d_%s" ), PartInfo.pointCount, PartInfo.faceCount, PartInfo.vertexCount, *DigestHash.ToString() );
+}
+
 bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
     HAPI_NodeId AssetId,
     FHoudiniCookParams& HoudiniCookParams,
     bool ForceRebuildStaticMesh, bool ForceRecookAll,
     const TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshesIn,
     TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshesOut,
-    FTransform & ComponentTransform )
+    FTransform & ComponentTransform,
+    TArray< UStaticMesh * > * StaticMeshesToBuild )
 {
 #if WITH_EDITOR
 
@@ -3516,6 +3908,20 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
         AssetId, HoudiniCookParams, AssetInfo, UniqueMaterialIds,
         UniqueInstancerMaterialIds, Materials, ForceRecookAll );
 
+    // Meshes of instanced packed parts indexed by their geometry key, so identical packed geometry is converted
+    // once and shared by all the instancers using it, in this cook and the following ones. The key holds the
+    // full content digest and is compared as a whole, so only identical geometry ever shares a mesh.
+    TMap< FString, UStaticMesh * > PackedPartMeshes;
+    TMap< UStaticMesh *, FString > PackedPartMeshKeys;
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TConstIterator Iter( StaticMeshesIn ); Iter; ++Iter )
+    {
+        if ( Iter.Key().PackedGeometryKey.IsEmpty() || !Iter.Value() || Iter.Value()->IsPendingKill() )
+            continue;
+
+        PackedPartMeshes.Add( Iter.Key().PackedGeometryKey, Iter.Value() );
+        PackedPartMeshKeys.Add( Iter.Value(), Iter.Key().PackedGeometryKey );
+    }
+
     // Update all material assignments
     HoudiniCookParams.HoudiniCookManager->ClearAssignmentMaterials();
     for( const auto& AssPair : Materials )
@@ -3611,6 +4017,15 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
         TArray< FTransform > AllSockets;
         TArray< FString > AllSocketsNames;
         TArray< FString > AllSocketsActors;
+        TMultiMap< FIntVector, int32 > AllSocketsByCell;
+
+        // The socket groups are shared by all the parts of the geo, except for packed primitives.
+        TArray< FString > GeoSocketGroupNames;
+        if ( GeoInfo.pointGroupCount > 0 )
+        {
+            FHoudiniEngineUtils::HapiGetMeshSocketGroupNames(
+                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, 0, GeoSocketGroupNames, false );
+        }
 
         for ( int32 PartIdx = 0; PartIdx < GeoInfo.partCount; ++PartIdx )
         {
@@ -3675,7 +4090,16 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
             }
 
             // Extracting Sockets points on the current part and add them to the list
-            AddMeshSocketToList( AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id, AllSockets, AllSocketsNames, AllSocketsActors, PartInfo.isInstanced );
+            if ( PartInfo.isInstanced )
+            {
+                TArray< FString > PackedSocketGroupNames;
+                if ( HapiGetMeshSocketGroupNames( AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id, PackedSocketGroupNames, true ) )
+                    AddMeshSocketToList( AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id, PackedSocketGroupNames, AllSockets, AllSocketsNames, AllSocketsActors, AllSocketsByCell, true );
+            }
+            else if ( GeoSocketGroupNames.Num() > 0 )
+            {
+                AddMeshSocketToList( AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id, GeoSocketGroupNames, AllSockets, AllSocketsNames, AllSocketsActors, AllSocketsByCell, false );
+            }
 
             if ( PartInfo.type == HAPI_PARTTYPE_INSTANCER )
             {
@@ -3744,6 +4168,10 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
             bool bPartHasMaterials = false;
             bool bMaterialsChanged = false;
 
+            // Unique material ids of this part, and the index of each face's material id in that array.
+            TArray< HAPI_NodeId > PartUniqueMaterialIds;
+            TArray< int32 > PartFaceMaterialSlots;
+
             if ( PartInfo.faceCount > 0 )
             {
                 PartFaceMaterialIds.SetNumUninitialized( PartInfo.faceCount );
@@ -3760,19 +4188,36 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                     continue;
                 }
 
-                // Set flag if we have materials.
-                TArray< HAPI_NodeId > PartUniqueMaterialIds;
-                for ( int32 MaterialIdx = 0; MaterialIdx < PartFaceMaterialIds.Num(); ++MaterialIdx )
-                    PartUniqueMaterialIds.AddUnique( PartFaceMaterialIds[ MaterialIdx ] );
+                // Intern the face material ids once per part, so the split meshes only need a slot lookup per face.
+                // Consecutive faces usually share their material, so the last slot is checked before the map.
+                TMap< HAPI_NodeId, int32 > MaterialIdToSlot;
+                HAPI_NodeId LastMaterialId = -1;
+                int32 LastMaterialSlot = INDEX_NONE;
+                PartFaceMaterialSlots.SetNumUninitialized( PartFaceMaterialIds.Num() );
+                for ( int32 FaceIdx = 0; FaceIdx < PartFaceMaterialIds.Num(); ++FaceIdx )
+                {
+                    const HAPI_NodeId MaterialId = PartFaceMaterialIds[ FaceIdx ];
+                    if ( MaterialId != LastMaterialId || LastMaterialSlot == INDEX_NONE )
+                    {
+                        int32 const * FoundSlot = MaterialIdToSlot.Find( MaterialId );
+                        LastMaterialSlot = FoundSlot ? *FoundSlot : MaterialIdToSlot.Add( MaterialId, PartUniqueMaterialIds.Add( MaterialId ) );
+                        LastMaterialId = MaterialId;
+                    }
 
-                PartUniqueMaterialIds.RemoveSingle( -1 );
-                bPartHasMaterials = PartUniqueMaterialIds.Num() > 0;
+                    PartFaceMaterialSlots[ FaceIdx ] = LastMaterialSlot;
+                }
+
+                // Set flag if we have materials.
+                bPartHasMaterials = PartUniqueMaterialIds.Num() > ( MaterialIdToSlot.Contains( -1 ) ? 1 : 0 );
 
                 // Set flag if any of the materials have changed.
                 if ( bPartHasMaterials )
                 {
                     for ( int32 MaterialIdx = 0; MaterialIdx < PartUniqueMaterialIds.Num(); ++MaterialIdx )
                     {
+                        if ( PartUniqueMaterialIds[ MaterialIdx ] < 0 )
+                            continue;
+
                         HAPI_MaterialInfo MaterialInfo;
                         if ( HAPI_RESULT_SUCCESS != FHoudiniApi::GetMaterialInfo(
                             FHoudiniEngine::Get().GetSession(), PartUniqueMaterialIds[ MaterialIdx ], &MaterialInfo ) )
@@ -3864,6 +4309,9 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
             TArray< FString > PartFaceMaterialAttributeOverrides;
             HAPI_AttributeInfo AttribFaceMaterials;
             FMemory::Memzero< HAPI_AttributeInfo >( AttribFaceMaterials );
+            // Unique material override names, and the index of each face's override in that array.
+            TArray< FString > PartMaterialOverrideNames;
+            TArray< int32 > PartFaceMaterialOverrideSlots;
 
             // Face Smoothing masks
             TArray< int32 > PartFaceSmoothingMasks;
@@ -4077,14 +4525,176 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                 GroupSplitFaceIndices.Add( RemainingGroupName, AllFaces );
             }
 
+            // Inputs of merged batch tools tag each primitive with the index of the object it came from.
+            // The main geometry is split per source object, so each of them gets its own mesh and component.
+            if ( !PartInfo.isInstanced && NumberOfLODs <= 0 && GroupSplitFaceIndices.Contains( RemainingGroupName ) )
+            {
+                HAPI_AttributeInfo AttribInfoSourceIndices;
+                FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoSourceIndices );
+                TArray< int32 > PartSourceIndices;
+                FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
+                    AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                    HAPI_UNREAL_ATTRIB_INPUT_SOURCE_INDEX, AttribInfoSourceIndices, PartSourceIndices );
+
+                TMap< int32, TArray< int32 > > SourceFaceIndices;
+                if ( AttribInfoSourceIndices.exists && AttribInfoSourceIndices.owner == HAPI_ATTROWNER_PRIM
+                    && PartSourceIndices.Num() == PartInfo.faceCount )
+                {
+                    for ( int32 FaceIdx : GroupSplitFaceIndices[ RemainingGroupName ] )
+                        SourceFaceIndices.FindOrAdd( PartSourceIndices[ FaceIdx ] ).Add( FaceIdx );
+                }
+
+                if ( SourceFaceIndices.Num() > 1 )
+                {
+                    SourceFaceIndices.KeySort( TLess< int32 >() );
+
+                    // The source splits replace the main geometry, at the same place in the split order
+                    int32 SourceInsertPos = SplitGroupNames.Find( RemainingGroupName );
+                    SplitGroupNames.RemoveAt( SourceInsertPos );
+                    GroupSplitFaces.Remove( RemainingGroupName );
+                    GroupSplitFaceCounts.Remove( RemainingGroupName );
+                    GroupSplitFaceIndices.Remove( RemainingGroupName );
+
+                    for ( TPair< int32, TArray< int32 > > & SourceFaces : SourceFaceIndices )
+                    {
+                        const FString SourceSplitName = TEXT( HAPI_UNREAL_SPLIT_INPUT_SOURCE_PREFIX ) + FString::FromInt( SourceFaces.Key );
+
+                        TArray< int32 > SourceVertexList;
+                        SourceVertexList.Init( -1, PartVertexList.Num() );
+                        for ( int32 FaceIdx : SourceFaces.Value )
+                        {
+                            SourceVertexList[ FaceIdx * 3 + 0 ] = PartVertexList[ FaceIdx * 3 + 0 ];
+                            SourceVertexList[ FaceIdx * 3 + 1 ] = PartVertexList[ FaceIdx * 3 + 1 ];
+                            SourceVertexList[ FaceIdx * 3 + 2 ] = PartVertexList[ FaceIdx * 3 + 2 ];
+                        }
+
+                        SplitGroupNames.Insert( SourceSplitName, SourceInsertPos++ );
+                        GroupSplitFaces.Add( SourceSplitName, SourceVertexList );
+                        GroupSplitFaceCounts.Add( SourceSplitName, SourceFaces.Value.Num() * 3 );
+                        GroupSplitFaceIndices.Add( SourceSplitName, SourceFaces.Value );
+                    }
+                }
+            }
+
+            // Instanced packed parts which are not split can share their mesh with identical packed geometry.
+            FString PackedGeometryKey;
+            if ( PartInfo.isInstanced && SplitGroupNames.Num() == 1
+                && GeoInfo.hasGeoChanged && !ForceRebuildStaticMesh && !ForceRecookAll )
+            {
+                PackedGeometryKey = FHoudiniEngineUtils::HapiGetPackedPartGeometryKey(
+                    AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo, PartVertexList, PartFaceMaterialIds );
+            }
+
             // Keep track of the LOD Index
             int32 LodIndex = 0;
             int32 LodSplitId = -1;
 
-            // Map of Houdini Material IDs to Unreal Material Indices
-            TMap< HAPI_NodeId, int32 > MapHoudiniMatIdToUnrealIndex;
-            // Map of Houdini Material Attributes to Unreal Material Indices
-            TMap< FString, int32 > MapHoudiniMatAttributesToUnrealIndex;
+            // Screen sizes of the LOD levels, resolved once for the whole LOD chain of this part.
+            // The "lodX_screensize" attributes take precedence over the "lod_screensize" and
+            // "unreal_uproperty_screensize" fallbacks, which are only fetched once for all the LODs.
+            TMap< FString, float > LODScreenSizes;
+            if ( NumberOfLODs > 0 )
+            {
+                TArray< float > FallbackScreenSizes;
+                HAPI_AttributeInfo AttribInfoFallbackScreenSize;
+                FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoFallbackScreenSize );
+                bool bFallbackScreenSizeFetched = false;
+
+                // Returns the screen size of a LOD group from the attribute values, or -1 if there is none
+                auto GetLODScreenSize = [ & ]( const HAPI_AttributeInfo & AttribInfo, const TArray< float > & ScreenSizes, const FString & LODGroupName )
+                {
+                    if ( !AttribInfo.exists || ScreenSizes.Num() <= 0 )
+                        return -1.0f;
+
+                    if ( AttribInfo.owner != HAPI_ATTROWNER_PRIM )
+                        return ScreenSizes[ 0 ];
+
+                    // Use the value of the first face of the LOD group
+                    const TArray< int32 > & LODFaceIndices = GroupSplitFaceIndices[ LODGroupName ];
+                    if ( LODFaceIndices.Num() > 0 && ScreenSizes.IsValidIndex( LODFaceIndices[ 0 ] ) )
+                        return ScreenSizes[ LODFaceIndices[ 0 ] ];
+
+                    return -1.0f;
+                };
+
+                for ( const FString & LODGroupName : SplitGroupNames )
+                {
+                    if ( !LODGroupName.StartsWith( LodGroupNamePrefix, ESearchCase::IgnoreCase ) )
+                        continue;
+
+                    // Try to find the "lodX_screensize" attribute
+                    TArray< float > ScreenSizes;
+                    HAPI_AttributeInfo AttribInfoScreenSize;
+                    FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoScreenSize );
+
+                    FString LODAttributeName = LODGroupName + TEXT( "_screensize" );
+                    FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+                        AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                        TCHAR_TO_ANSI( *LODAttributeName ), AttribInfoScreenSize, ScreenSizes );
+
+                    if ( AttribInfoScreenSize.exists )
+                    {
+                        LODScreenSizes.Add( LODGroupName, GetLODScreenSize( AttribInfoScreenSize, ScreenSizes, LODGroupName ) );
+                        continue;
+                    }
+
+                    if ( !bFallbackScreenSizeFetched )
+                    {
+                        bFallbackScreenSizeFetched = true;
+
+                        // Fallback to the "lod_screensize" attribute
+                        FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+                            AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                            "lod_screensize", AttribInfoFallbackScreenSize, FallbackScreenSizes );
+
+                        // finally, look for a potential uproperty style attribute
+                        if ( !AttribInfoFallbackScreenSize.exists )
+                        {
+                            FallbackScreenSizes.Empty();
+                            FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+                                AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
+                                "unreal_uproperty_screensize", AttribInfoFallbackScreenSize, FallbackScreenSizes );
+                        }
+                    }
+
+                    LODScreenSizes.Add( LODGroupName, GetLODScreenSize( AttribInfoFallbackScreenSize, FallbackScreenSizes, LODGroupName ) );
+                }
+            }
+
+            // Unreal material index of each Houdini material slot, INDEX_NONE until the slot is used by the mesh.
+            TArray< int32 > MaterialSlotToUnrealIndex;
+            // Unreal material index of each material override slot, INDEX_NONE until the slot is used by the mesh.
+            // Overrides whose material could not be loaded are marked so they are only loaded once.
+            TArray< int32 > MaterialOverrideSlotToUnrealIndex;
+            const int32 MaterialOverrideNotFound = INDEX_NONE - 1;
+
+            // Returns the Unreal material index of a Houdini material slot, adding the material to the mesh if needed.
+            UStaticMesh * SlotStaticMesh = nullptr;
+            auto GetUnrealMaterialIndexForSlot = [ & ]( int32 MaterialSlot )
+            {
+                int32 & UnrealMatIndex = MaterialSlotToUnrealIndex[ MaterialSlot ];
+                if ( UnrealMatIndex != INDEX_NONE )
+                    return UnrealMatIndex;
+
+                UMaterialInterface * Material = FHoudiniEngine::Get().GetHoudiniDefaultMaterial().Get();
+
+                FString MaterialShopName = HAPI_UNREAL_DEFAULT_MATERIAL_NAME;
+                FHoudiniEngineMaterialUtils::GetUniqueMaterialShopName( AssetId, PartUniqueMaterialIds[ MaterialSlot ], MaterialShopName );
+                UMaterialInterface * const * FoundMaterial = Materials.Find( MaterialShopName );
+                if ( FoundMaterial )
+                    Material = *FoundMaterial;
+
+                // See if we have replacement material for this geo part object and this shop material name.
+                UMaterialInterface * ReplacementMaterial =
+                    HoudiniCookParams.HoudiniCookManager->GetReplacementMaterial( HoudiniGeoPartObject, MaterialShopName );
+
+                if ( ReplacementMaterial )
+                    Material = ReplacementMaterial;
+
+                // Add the material to the Static mesh
+                UnrealMatIndex = SlotStaticMesh->StaticMaterials.Add( FStaticMaterial( Material ) );
+                return UnrealMatIndex;
+            };
 
             // Iterate through all detected split groups we care about and split geometry.
             // The split are ordered in the following way:
@@ -4112,8 +4722,8 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                 // Only the first LOD resets those maps
                 if ( !IsLOD || ( IsLOD && LodIndex == 0 ) )
                 {
-                    MapHoudiniMatIdToUnrealIndex.Empty();
-                    MapHoudiniMatAttributesToUnrealIndex.Empty();
+                    MaterialSlotToUnrealIndex.Init( INDEX_NONE, PartUniqueMaterialIds.Num() );
+                    MaterialOverrideSlotToUnrealIndex.Init( INDEX_NONE, PartMaterialOverrideNames.Num() );
                 }
 
                 // Record split id in geo part.
@@ -4208,6 +4818,21 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                 // Attempt to locate static mesh from previous instantiation.
                 UStaticMesh * const * FoundStaticMesh = StaticMeshesIn.Find( HoudiniGeoPartObject );
 
+                // Identical packed geometry may already have been converted, for another instancer or a previous cook.
+                if ( !PackedGeometryKey.IsEmpty() && !IsLOD && !HoudiniGeoPartObject.bIsUCXCollisionGeo
+                    && !HoudiniGeoPartObject.bIsSimpleCollisionGeo && !HoudiniGeoPartObject.bIsCollidable
+                    && !HoudiniGeoPartObject.bIsRenderCollidable )
+                {
+                    HoudiniGeoPartObject.PackedGeometryKey = PackedGeometryKey;
+
+                    UStaticMesh * const * FoundPackedMesh = PackedPartMeshes.Find( PackedGeometryKey );
+                    if ( !bMaterialsChanged && FoundPackedMesh && *FoundPackedMesh )
+                    {
+                        StaticMeshesOut.Add( HoudiniGeoPartObject, *FoundPackedMesh );
+                        continue;
+                    }
+                }
+
                 // LODs levels other than the first one need to reuse StaticMesh from the output!
                 if ( IsLOD && LodIndex > 0 )
                     FoundStaticMesh = StaticMeshesOut.Find( HoudiniGeoPartObject );
@@ -4236,16 +4861,21 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                     // If any of the materials on corresponding geo part object have not changed.
                     if ( !bMaterialsChanged && FoundStaticMesh && *FoundStaticMesh )
                     {
-                        // We can reuse previously created geometry.
+                        // We can reuse previously created geometry, keeping track of its packed geometry.
+                        if ( const FString * FoundPackedGeometryKey = PackedPartMeshKeys.Find( *FoundStaticMesh ) )
+                            HoudiniGeoPartObject.PackedGeometryKey = *FoundPackedGeometryKey;
+
                         StaticMeshesOut.Add( HoudiniGeoPartObject, *FoundStaticMesh );
                         continue;
                     }
                 }
 
-                // If the static mesh was not located, we need to create a new one.
+                // If the static mesh was not located, we need to create a new one. Shared packed meshes are
+                // never modified in place, as other instancers may still be using them.
                 bool bStaticMeshCreated = false;
                 UStaticMesh * StaticMesh = nullptr;
-                if ( !FoundStaticMesh || *FoundStaticMesh == nullptr )
+                if ( !FoundStaticMesh || *FoundStaticMesh == nullptr
+                    || ( bRebuildStaticMesh && PackedPartMeshKeys.Contains( *FoundStaticMesh ) ) )
                 {
                     FGuid MeshGuid;
                     MeshGuid.Invalidate();
@@ -4280,13 +4910,9 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
 
                 if ( !IsLOD || LodIndex == 0 )
                 {
-                    // We need to initialize the LODs used by this mesh
+                    // The whole LOD chain is allocated at once, removing excessive LOD levels if needed
                     int32 NeededLODs = IsLOD ? NumberOfLODs : 1;
-                    while ( StaticMesh->SourceModels.Num() < NeededLODs )
-                        new (StaticMesh->SourceModels) FStaticMeshSourceModel();
-
-                    // We may have to remove excessive LOD levels
-                    if ( StaticMesh->SourceModels.Num() > NeededLODs )
+                    if ( StaticMesh->SourceModels.Num() != NeededLODs )
                         StaticMesh->SourceModels.SetNum( NeededLODs );
                 }
 
@@ -4769,8 +5395,29 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                         FString SingleFaceMaterial = PartFaceMaterialAttributeOverrides[ 0 ];
                         PartFaceMaterialAttributeOverrides.Init( SingleFaceMaterial, SplitGroupVertexList.Num() / 3 );
                     }
+
+                    // Intern the override names, faces then refer to their override by slot instead of by name.
+                    TMap< FString, int32 > MaterialOverrideToSlot;
+                    PartFaceMaterialOverrideSlots.SetNumUninitialized( PartFaceMaterialAttributeOverrides.Num() );
+                    for ( int32 FaceIdx = 0; FaceIdx < PartFaceMaterialAttributeOverrides.Num(); ++FaceIdx )
+                    {
+                        const FString & MaterialName = PartFaceMaterialAttributeOverrides[ FaceIdx ];
+                        if ( FaceIdx > 0 && MaterialName == PartFaceMaterialAttributeOverrides[ FaceIdx - 1 ] )
+                        {
+                            PartFaceMaterialOverrideSlots[ FaceIdx ] = PartFaceMaterialOverrideSlots[ FaceIdx - 1 ];
+                            continue;
+                        }
+
+                        int32 const * FoundSlot = MaterialOverrideToSlot.Find( MaterialName );
+                        PartFaceMaterialOverrideSlots[ FaceIdx ] = FoundSlot ? *FoundSlot
+                            : MaterialOverrideToSlot.Add( MaterialName, PartMaterialOverrideNames.Add( MaterialName ) );
+                    }
+
+                    MaterialOverrideSlotToUnrealIndex.Init( INDEX_NONE, PartMaterialOverrideNames.Num() );
                 }
 
+                SlotStaticMesh = StaticMesh;
+
                 //--------------------------------------------------------------------------------------------------------------------- 
                 // FACE MATERIALS
                 //---------------------------------------------------------------------------------------------------------------------
@@ -4787,21 +5434,16 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                     for ( int32 FaceIdx = 0; FaceIdx < SplitGroupFaceIndices.Num(); ++FaceIdx )
                     {
                         int32 SplitFaceIndex = SplitGroupFaceIndices[ FaceIdx ];
-                        if ( !PartFaceMaterialAttributeOverrides.IsValidIndex( SplitFaceIndex ) )
+                        if ( !PartFaceMaterialOverrideSlots.IsValidIndex( SplitFaceIndex ) )
                             continue;
 
-                        const FString & MaterialName = PartFaceMaterialAttributeOverrides[ SplitFaceIndex ];
-                        int32 const * FoundFaceMaterialIdx = MapHoudiniMatAttributesToUnrealIndex.Find( MaterialName );
-                        int32 CurrentFaceMaterialIdx = 0;
-                        if ( FoundFaceMaterialIdx )
-                        {
-                            CurrentFaceMaterialIdx = *FoundFaceMaterialIdx;
-                        }
-                        else
+                        const int32 OverrideSlot = PartFaceMaterialOverrideSlots[ SplitFaceIndex ];
+                        int32 & OverrideUnrealIndex = MaterialOverrideSlotToUnrealIndex[ OverrideSlot ];
+                        if ( OverrideUnrealIndex == INDEX_NONE )
                         {
+                            const FString & MaterialName = PartMaterialOverrideNames[ OverrideSlot ];
                             UMaterialInterface * MaterialInterface = Cast< UMaterialInterface >(
-                                StaticLoadObject( UMaterialInterface::StaticClass(),
-                                    nullptr, *MaterialName, nullptr, LOAD_NoWarn, nullptr ) );
+                                FHoudiniObjectLoader::LoadObject( MaterialName, UMaterialInterface::StaticClass(), LOAD_NoWarn ) );
 
                             if ( MaterialInterface )
                             {
@@ -4814,53 +5456,24 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                                 if( ReplacementMaterialInterface )
                                     MaterialInterface = ReplacementMaterialInterface;
 
-                                // Add this material to the map
-                                CurrentFaceMaterialIdx = StaticMesh->StaticMaterials.Add( FStaticMaterial( MaterialInterface ) );
-                                MapHoudiniMatAttributesToUnrealIndex.Add( MaterialName, CurrentFaceMaterialIdx );
+                                // Add this material to the mesh
+                                OverrideUnrealIndex = StaticMesh->StaticMaterials.Add( FStaticMaterial( MaterialInterface ) );
                             }
                             else
                             {
                                 // The Attribute Material and its replacement do not exist
-                                // See if we can fallback to the Houdini material assigned on the face
-
-                                // Get the unreal material corresponding to this houdini one
-                                HAPI_NodeId MaterialId = PartFaceMaterialIds[ SplitFaceIndex ];
-
-                                // See if we have already treated that material
-                                int32 const * FoundUnrealMatIndex = MapHoudiniMatIdToUnrealIndex.Find( MaterialId );
-                                if ( FoundUnrealMatIndex )
-                                {
-                                    // This material has been mapped already, just assign the mat index
-                                    CurrentFaceMaterialIdx = *FoundUnrealMatIndex;
-                                }
-                                else
-                                {
-                                    // If everything fails, we'll use the default material
-                                    MaterialInterface = FHoudiniEngine::Get().GetHoudiniDefaultMaterial().Get();
-
-                                    // We need to add this material to the map
-                                    FString MaterialShopName = HAPI_UNREAL_DEFAULT_MATERIAL_NAME;
-                                    FHoudiniEngineMaterialUtils::GetUniqueMaterialShopName( AssetId, MaterialId, MaterialShopName );
-                                    UMaterialInterface * const * FoundMaterial = Materials.Find( MaterialShopName );
-                                    if ( FoundMaterial )
-                                        MaterialInterface = *FoundMaterial;
-
-                                    // If we have a replacement material for this geo part object and this shop material name.
-                                    UMaterialInterface * ReplacementMaterial =
-                                        HoudiniCookParams.HoudiniCookManager->GetReplacementMaterial( HoudiniGeoPartObject, MaterialShopName );
-
-                                    if ( ReplacementMaterial )
-                                        MaterialInterface = ReplacementMaterial;
-
-                                    // Add the material to the Static mesh
-                                    CurrentFaceMaterialIdx = StaticMesh->StaticMaterials.Add( FStaticMaterial( MaterialInterface ) );
-
-                                    // Map the Houdini ID to the unreal one
-                                    MapHoudiniMatIdToUnrealIndex.Add( MaterialId, CurrentFaceMaterialIdx );
-                                }
+                                OverrideUnrealIndex = MaterialOverrideNotFound;
                             }
                         }
 
+                        // Fallback to the Houdini material assigned on the face if the override could not be loaded.
+                        int32 CurrentFaceMaterialIdx = OverrideUnrealIndex;
+                        if ( CurrentFaceMaterialIdx == MaterialOverrideNotFound )
+                        {
+                            CurrentFaceMaterialIdx = PartFaceMaterialSlots.IsValidIndex( SplitFaceIndex )
+                                ? GetUnrealMaterialIndexForSlot( PartFaceMaterialSlots[ SplitFaceIndex ] ) : 0;
+                        }
+
                         // Update the Face Material on the mesh
                         RawMesh.FaceMaterialIndices[ FaceIdx ] = CurrentFaceMaterialIdx;
                     }
@@ -4902,53 +5515,29 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                             if ( !IsLOD || ( IsLOD && LodIndex == 0 ) )
                                 StaticMesh->StaticMaterials.Empty();
 
-                            // Get default Houdini material.
-                            UMaterial * MaterialDefault = FHoudiniEngine::Get().GetHoudiniDefaultMaterial().Get();
-
                             // Reset Rawmesh material face assignments.
                             RawMesh.FaceMaterialIndices.SetNumZeroed( SplitGroupFaceCount );
 
+                            // Add the materials used by this split first, in the order they're encountered.
                             for ( int32 FaceIdx = 0; FaceIdx < SplitGroupFaceIndices.Num(); ++FaceIdx )
                             {
-                                int32 SplitFaceIndex = SplitGroupFaceIndices[ FaceIdx ];				                                
-                                if ( !PartFaceMaterialIds.IsValidIndex( SplitFaceIndex ) )
-                                    continue;
-
-                                // Get material id for this face.
-                                HAPI_NodeId MaterialId = PartFaceMaterialIds[ SplitFaceIndex ];
-
-                                // See if we have already treated that material
-                                int32 const * FoundUnrealMatIndex = MapHoudiniMatIdToUnrealIndex.Find( MaterialId );
-                                if ( FoundUnrealMatIndex )
-                                {
-                                    // This material has been mapped already, just assign the mat index
-                                    RawMesh.FaceMaterialIndices[ FaceIdx ] = *FoundUnrealMatIndex;
-                                    continue;
-                                }
-
-                                UMaterialInterface * Material = MaterialDefault;
-
-                                FString MaterialShopName = HAPI_UNREAL_DEFAULT_MATERIAL_NAME;
-                                FHoudiniEngineMaterialUtils::GetUniqueMaterialShopName( AssetId, MaterialId, MaterialShopName );
-                                UMaterialInterface * const * FoundMaterial = Materials.Find( MaterialShopName );
-                                if ( FoundMaterial )
-                                    Material = *FoundMaterial;
-
-                                // See if we have replacement material for this geo part object and this shop material name.
-                                UMaterialInterface * ReplacementMaterial = 
-                                    HoudiniCookParams.HoudiniCookManager->GetReplacementMaterial( HoudiniGeoPartObject, MaterialShopName );
-
-                                if ( ReplacementMaterial )
-                                    Material = ReplacementMaterial;
-
-                                // Add the material to the Static mesh
-                                int32 UnrealMatIndex = StaticMesh->StaticMaterials.Add( FStaticMaterial( Material ) );
-
-                                // Map the houdini ID to the unreal one
-                                MapHoudiniMatIdToUnrealIndex.Add( MaterialId, UnrealMatIndex );
+                                int32 SplitFaceIndex = SplitGroupFaceIndices[ FaceIdx ];
+                                if ( PartFaceMaterialSlots.IsValidIndex( SplitFaceIndex ) )
+                                    GetUnrealMaterialIndexForSlot( PartFaceMaterialSlots[ SplitFaceIndex ] );
+                            }
 
-                                // Update the face index
-                                RawMesh.FaceMaterialIndices[ FaceIdx ] = UnrealMatIndex;
+                            // Every slot is resolved, so the face material indices are a plain gather through the slot table.
+                            const int32 * FaceSlots = PartFaceMaterialSlots.GetData();
+                            const int32 * SlotUnrealIndices = MaterialSlotToUnrealIndex.GetData();
+                            const int32 * SplitFaceIndices = SplitGroupFaceIndices.GetData();
+                            int32 * FaceMaterialIndices = RawMesh.FaceMaterialIndices.GetData();
+                            const int32 NumFaceMaterialSlots = PartFaceMaterialSlots.Num();
+                            const int32 NumSplitFaces = FMath::Min( SplitGroupFaceIndices.Num(), RawMesh.FaceMaterialIndices.Num() );
+                            for ( int32 FaceIdx = 0; FaceIdx < NumSplitFaces; ++FaceIdx )
+                            {
+                                const int32 SplitFaceIndex = SplitFaceIndices[ FaceIdx ];
+                                if ( SplitFaceIndex >= 0 && SplitFaceIndex < NumFaceMaterialSlots )
+                                    FaceMaterialIndices[ FaceIdx ] = SlotUnrealIndices[ FaceSlots[ SplitFaceIndex ] ];
                             }
                         }
                     }
@@ -5036,57 +5625,12 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                     // Init the current LOD level
                     InitLODLevel( LodIndex );
 
-                    // Look for LOD Specific attributes
-                    TArray< float > LODScreenSizes;
-                    HAPI_AttributeInfo AttribInfoScreenSize;
-                    FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoScreenSize );
-
-                    // Try to find the "lodX_screensize" detail attribute
-                    FString LODAttributeName = SplitGroupName + TEXT("_screensize");
-                    FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
-                        AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
-                        TCHAR_TO_ANSI( *LODAttributeName ), AttribInfoScreenSize, LODScreenSizes);
-
-                    // If the attribute was not found, fallback to the "lod_screensize" attribute
-                    if ( !AttribInfoScreenSize.exists )
-                    {
-                        LODScreenSizes.Empty();
-                        FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
-                            AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
-                            "lod_screensize", AttribInfoScreenSize, LODScreenSizes);
-                    }
-
-                    // finally, look for a potential uproperty style attribute
-                    if ( !AttribInfoScreenSize.exists )
-                    {
-                        LODScreenSizes.Empty();
-                        FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
-                            AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id,
-                            "unreal_uproperty_screensize", AttribInfoScreenSize, LODScreenSizes);
-                    }
-
-                    if ( AttribInfoScreenSize.exists )
+                    // Apply the screen size resolved for this LOD level
+                    const float * LODScreenSize = LODScreenSizes.Find( SplitGroupName );
+                    if ( LODScreenSize && *LODScreenSize >= 0.0f )
                     {
-                        float screensize = -1.0;
-                        if ( AttribInfoScreenSize.owner == HAPI_ATTROWNER_PRIM )
-                        {
-                            int32 n = 0;
-                            for( ; n <  SplitGroupVertexList.Num(); n++ )
-                            {
-                                if ( SplitGroupVertexList[ n ] > 0 )
-                                    break;
-                            }
-
-                            screensize = LODScreenSizes[ n / 3 ];
-                        }
-                        else
-                            screensize = LODScreenSizes[ 0 ];
-
-                        if ( screensize >= 0.0f )
-                        {
-                            StaticMesh->SourceModels[ LodIndex ].ScreenSize = screensize;
-                            StaticMesh->bAutoComputeLODScreenSize = false;
-                        }
+                        StaticMesh->SourceModels[ LodIndex ].ScreenSize = *LODScreenSize;
+                        StaticMesh->bAutoComputeLODScreenSize = false;
                     }
 
                     // Increment the LODIndex
@@ -5126,15 +5670,13 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
                 // Try to update the uproperties of the StaticMesh
                 UpdateUPropertyAttributesOnObject( StaticMesh, HoudiniGeoPartObject);
 
-                // Free any RHI resources.
-                StaticMesh->PreEditChange( nullptr );
-
                 FHoudiniScopedGlobalSilence ScopedGlobalSilence;
                 TArray< FText > BuildErrors;
-                {
-                    SCOPE_CYCLE_COUNTER( STAT_BuildStaticMesh );
-                    StaticMesh->Build( true, &BuildErrors );
-                }
+                if ( StaticMeshesToBuild )
+                    StaticMeshesToBuild->AddUnique( StaticMesh );
+                else
+                    BuildStaticMesh( StaticMesh, BuildErrors );
+
                 for ( int32 BuildErrorIdx = 0; BuildErrorIdx < BuildErrors.Num(); ++BuildErrorIdx )
                 {
                     const FText & TextError = BuildErrors[ BuildErrorIdx ];
@@ -5181,6 +5723,12 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
 
                 StaticMeshesOut.Add( HoudiniGeoPartObject, StaticMesh );
 
+                if ( !HoudiniGeoPartObject.PackedGeometryKey.IsEmpty() )
+                {
+                    PackedPartMeshes.Add( HoudiniGeoPartObject.PackedGeometryKey, StaticMesh );
+                    PackedPartMeshKeys.Add( StaticMesh, HoudiniGeoPartObject.PackedGeometryKey );
+                }
+
             } // end for SplitId
 
         } // end for PartId
@@ -5207,12 +5755,44 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
         AllSockets.Empty();
         AllSocketsNames.Empty();
         AllSocketsActors.Empty();
+        AllSocketsByCell.Empty();
 
     } // end for ObjectId
 
+    if ( !StaticMeshesToBuild )
+        UpdateStaticMeshNavigationCollision( StaticMeshesOut );
+
+#endif
+
+    return true;
+}
+
+void
+FHoudiniEngineUtils::BuildStaticMesh( UStaticMesh * StaticMesh, TArray< FText > & BuildErrors )
+{
+#if WITH_EDITOR
+
+    if ( !StaticMesh )
+        return;
+
+    // Free any RHI resources.
+    StaticMesh->PreEditChange( nullptr );
+
+    FHoudiniScopedGlobalSilence ScopedGlobalSilence;
+    SCOPE_CYCLE_COUNTER( STAT_BuildStaticMesh );
+    StaticMesh->Build( true, &BuildErrors );
+
+#endif
+}
+
+void
+FHoudiniEngineUtils::UpdateStaticMeshNavigationCollision( const TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshes )
+{
+#if WITH_EDITOR
+
     // Now that all the meshes are built and their collisions meshes and primitives updated,
     // we need to update their pre-built navigation collision used by the navmesh
-    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TIterator Iter( StaticMeshesOut ); Iter; ++Iter )
+    for ( TMap< FHoudiniGeoPartObject, UStaticMesh * >::TConstIterator Iter( StaticMeshes ); Iter; ++Iter )
     {
         FHoudiniGeoPartObject HoudiniGeoPartObject = Iter.Key();
 
@@ -5238,8 +5818,6 @@ bool FHoudiniEngineUtils::CreateStaticMeshesFromHoudiniAsset(
     }
 
 #endif
-
-    return true;
 }
 
 #if WITH_EDITOR
@@ -5401,61 +5979,46 @@ FHoudiniEngineUtils::ExtractRawName( const FString & Name )
 void
 FHoudiniEngineUtils::CreateFaceMaterialArray(
     const TArray< FStaticMaterial > & Materials, const TArray< int32 > & FaceMaterialIndices,
-    TArray< char * > & OutStaticMeshFaceMaterials )
+    TArray< std::string > & OutMaterialSlotNames, TArray< const char * > & OutStaticMeshFaceMaterials )
 {
-    // We need to create list of unique materials.
-    TArray< char * > UniqueMaterialList;
-    UMaterialInterface * MaterialInterface;
-    char * UniqueName = nullptr;
-
-    if ( Materials.Num() )
+    // We need to create list of unique materials, one name per material slot.
+    OutMaterialSlotNames.Empty( FMath::Max( Materials.Num(), 1 ) );
+    for ( int32 MaterialIdx = 0; MaterialIdx < Materials.Num(); ++MaterialIdx )
     {
-        // We have materials.
-        for ( int32 MaterialIdx = 0; MaterialIdx < Materials.Num(); ++MaterialIdx )
+        UMaterialInterface * MaterialInterface = Materials[ MaterialIdx ].MaterialInterface;
+        if ( !MaterialInterface )
         {
-            UniqueName = nullptr;
-            MaterialInterface = Materials[ MaterialIdx ].MaterialInterface;
-
-            if ( !MaterialInterface )
-            {
-                // Null material interface found, add default instead.
-                MaterialInterface = FHoudiniEngine::Get().GetHoudiniDefaultMaterial().Get();
-            }
-
-            FString FullMaterialName = MaterialInterface->GetPathName();
-            UniqueName = FHoudiniEngineUtils::ExtractRawName( FullMaterialName );
-            UniqueMaterialList.Add( UniqueName );
+            // Null material interface found, add default instead.
+            MaterialInterface = FHoudiniEngine::Get().GetHoudiniDefaultMaterial().Get();
         }
+
+        std::string & SlotName = OutMaterialSlotNames[ OutMaterialSlotNames.AddDefaulted() ];
+        FHoudiniEngineUtils::ConvertUnrealString( MaterialInterface->GetPathName(), SlotName );
     }
-    else
+
+    if ( OutMaterialSlotNames.Num() <= 0 )
     {
         // We do not have any materials, add default.
-        MaterialInterface = FHoudiniEngine::Get().GetHoudiniDefaultMaterial().Get();
-        FString FullMaterialName = MaterialInterface->GetPathName();
-        UniqueName = FHoudiniEngineUtils::ExtractRawName( FullMaterialName );
-        UniqueMaterialList.Add( UniqueName );
+        UMaterialInterface * MaterialInterface = FHoudiniEngine::Get().GetHoudiniDefaultMaterial().Get();
+        std::string & SlotName = OutMaterialSlotNames[ OutMaterialSlotNames.AddDefaulted() ];
+        FHoudiniEngineUtils::ConvertUnrealString( MaterialInterface->GetPathName(), SlotName );
     }
 
-    for ( int32 FaceIdx = 0; FaceIdx < FaceMaterialIndices.Num(); ++FaceIdx )
-    {
-        int32 FaceMaterialIdx = FaceMaterialIndices[ FaceIdx ];
-        check( FaceMaterialIdx < UniqueMaterialList.Num() );
+    // Gather the slot name of each face.
+    TArray< const char * > SlotNamePointers;
+    SlotNamePointers.SetNumUninitialized( OutMaterialSlotNames.Num() );
+    for ( int32 SlotIdx = 0; SlotIdx < OutMaterialSlotNames.Num(); ++SlotIdx )
+        SlotNamePointers[ SlotIdx ] = OutMaterialSlotNames[ SlotIdx ].c_str();
 
-        OutStaticMeshFaceMaterials.Add( UniqueMaterialList[ FaceMaterialIdx ] );
-    }
-}
-
-void
-FHoudiniEngineUtils::DeleteFaceMaterialArray( TArray< char * > & OutStaticMeshFaceMaterials )
-{
-    TSet< char * > UniqueMaterials( OutStaticMeshFaceMaterials );
-    for ( TSet< char * >::TIterator Iter = UniqueMaterials.CreateIterator(); Iter; ++Iter )
+    OutStaticMeshFaceMaterials.SetNumUninitialized( FaceMaterialIndices.Num() );
+    const char * const * SlotNames = SlotNamePointers.GetData();
+    const int32 * FaceSlots = FaceMaterialIndices.GetData();
+    const char ** FaceNames = OutStaticMeshFaceMaterials.GetData();
+    for ( int32 FaceIdx = 0; FaceIdx < FaceMaterialIndices.Num(); ++FaceIdx )
     {
-        char* MaterialName = *Iter;
-        FMemory::Free( MaterialName );
+        check( FaceSlots[ FaceIdx ] < SlotNamePointers.Num() );
+        FaceNames[ FaceIdx ] = SlotNames[ FaceSlots[ FaceIdx ] ];
     }
-
-    OutStaticMeshFaceMaterials.Empty();
 }
 
 #endif // WITH_EDITOR
@@ -5949,16 +6512,19 @@ FHoudiniEngineUtils::CountUVSets( const FRawMesh & RawMesh )
 }
 
 const FString
-FHoudiniEngineUtils::GetStatusString( HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity )
+FHoudiniEngineUtils::GetStatusString( HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity, const HAPI_Session * Session )
 {
+    if ( !Session )
+        Session = FHoudiniEngine::Get().GetSession();
+
     int32 StatusBufferLength = 0;
-    FHoudiniApi::GetStatusStringBufLength( FHoudiniEngine::Get().GetSession(), status_type, verbosity, &StatusBufferLength );
+    FHoudiniApi::GetStatusStringBufLength( Session, status_type, verbosity, &StatusBufferLength );
 
     if ( StatusBufferLength > 0 )
     {
         TArray< char > StatusStringBuffer;
         StatusStringBuffer.SetNumZeroed( StatusBufferLength );
-        FHoudiniApi::GetStatusString( FHoudiniEngine::Get().GetSession(), status_type, &StatusStringBuffer[ 0 ], StatusBufferLength );
+        FHoudiniApi::GetStatusString( Session, status_type, &StatusStringBuffer[ 0 ], StatusBufferLength );
 
         return FString( UTF8_TO_TCHAR( &StatusStringBuffer[ 0 ] ) );
     }
@@ -6216,16 +6782,23 @@ FHoudiniEngineUtils::GetAssetNames(
 }
 
 
-int32
-FHoudiniEngineUtils::AddMeshSocketToList(
+/** Returns the one unit cell of the spatial index used to find duplicated mesh sockets. **/
+static FIntVector
+GetMeshSocketCell( const FVector & Position )
+{
+    return FIntVector( FMath::FloorToInt( Position.X ), FMath::FloorToInt( Position.Y ), FMath::FloorToInt( Position.Z ) );
+}
+
+bool
+FHoudiniEngineUtils::HapiGetMeshSocketGroupNames(
     HAPI_NodeId AssetId, HAPI_NodeId ObjectId,
     HAPI_NodeId GeoId, HAPI_PartId PartId,
-    TArray< FTransform >& AllSockets,
-    TArray< FString >& AllSocketsNames,
-    TArray< FString >& AllSocketsActors,
+    TArray< FString >& SocketGroupNames,
     const bool& isPackedPrim )
 {
-    // Get object / geo group memberships for primitives.
+    SocketGroupNames.Empty();
+
+    // Get object / geo group memberships for points.
     TArray< FString > GroupNames;
     if ( !FHoudiniEngineUtils::HapiGetGroupNames(
         AssetId, ObjectId, GeoId, PartId, HAPI_GROUPTYPE_POINT, GroupNames, isPackedPrim ) )
@@ -6233,20 +6806,47 @@ FHoudiniEngineUtils::AddMeshSocketToList(
         HOUDINI_LOG_MESSAGE( TEXT( "GetMeshSocketList: Object [%d] non-fatal error reading group names" ), ObjectId );
     }
 
-    // First, we want to make sure we have at least one socket group before continuing
-    bool bHasSocketGroup = false;
     for ( int32 GeoGroupNameIdx = 0; GeoGroupNameIdx < GroupNames.Num(); ++GeoGroupNameIdx )
     {
         const FString & GroupName = GroupNames[ GeoGroupNameIdx ];
         if ( GroupName.StartsWith( TEXT( HAPI_UNREAL_GROUP_MESH_SOCKETS ), ESearchCase::IgnoreCase ) )
-        {
-            bHasSocketGroup = true;
-            break;
-        }
+            SocketGroupNames.Add( GroupName );
     }
 
-    if ( !bHasSocketGroup )
-        return 0;
+    return SocketGroupNames.Num() > 0;
+}
+
+int32
+FHoudiniEngineUtils::AddMeshSocketToList(
+    HAPI_NodeId AssetId, HAPI_NodeId ObjectId,
+    HAPI_NodeId GeoId, HAPI_PartId PartId,
+    const TArray< FString >& SocketGroupNames,
+    TArray< FTransform >& AllSockets,
+    TArray< FString >& AllSocketsNames,
+    TArray< FString >& AllSocketsActors,
+    TMultiMap< FIntVector, int32 >& AllSocketsByCell,
+    const bool& isPackedPrim )
+{
+    // Merge the membership of all the socket groups, so the points are only processed once
+    TArray< int32 > SocketPointMembership;
+    for ( int32 GroupIdx = 0; GroupIdx < SocketGroupNames.Num(); ++GroupIdx )
+    {
+        TArray< int32 > PointGroupMembership;
+        if ( !FHoudiniEngineUtils::HapiGetGroupMembership(
+            AssetId, ObjectId, GeoId, PartId,
+            HAPI_GROUPTYPE_POINT, SocketGroupNames[ GroupIdx ], PointGroupMembership, isPackedPrim ) )
+            continue;
+
+        if ( SocketPointMembership.Num() < PointGroupMembership.Num() )
+            SocketPointMembership.SetNumZeroed( PointGroupMembership.Num() );
+
+        for ( int32 PointIdx = 0; PointIdx < PointGroupMembership.Num(); ++PointIdx )
+            SocketPointMembership[ PointIdx ] |= PointGroupMembership[ PointIdx ];
+    }
+
+    // Don't fetch any attribute if none of this part's points are sockets
+    if ( !SocketPointMembership.Contains( 1 ) )
+        return AllSockets.Num();
 
     //
     // Get runtime settings.
@@ -6329,131 +6929,139 @@ FHoudiniEngineUtils::AddMeshSocketToList(
         bHasActors = true;
 
     // Extracting Sockets vertices
-    for ( int32 GeoGroupNameIdx = 0; GeoGroupNameIdx < GroupNames.Num(); ++GeoGroupNameIdx )
+    for ( int32 PointIdx = 0; PointIdx < SocketPointMembership.Num(); ++PointIdx )
     {
-        const FString & GroupName = GroupNames[ GeoGroupNameIdx ];
-        if ( !GroupName.StartsWith ( TEXT ( HAPI_UNREAL_GROUP_MESH_SOCKETS ) , ESearchCase::IgnoreCase ) )
+        if ( SocketPointMembership[ PointIdx ] == 0 )
             continue;
 
-        TArray< int32 > PointGroupMembership;
-        FHoudiniEngineUtils::HapiGetGroupMembership(
-            AssetId, ObjectId, GeoId, PartId, 
-            HAPI_GROUPTYPE_POINT, GroupName, PointGroupMembership, isPackedPrim );
+        FTransform currentSocketTransform;
+        FVector currentPosition = FVector::ZeroVector;
+        FVector currentScale = FVector( 1.0f, 1.0f, 1.0f );
+        FQuat currentRotation = FQuat::Identity;
 
-        // Go through all primitives.
-        for ( int32 PointIdx = 0; PointIdx < PointGroupMembership.Num(); ++PointIdx )
+        if ( ImportAxis == HRSAI_Unreal )
         {
-            if ( PointGroupMembership[ PointIdx ] == 0 )
-                continue;
-
-            FTransform currentSocketTransform;
-            FVector currentPosition = FVector::ZeroVector;
-            FVector currentScale = FVector( 1.0f, 1.0f, 1.0f );
-            FQuat currentRotation = FQuat::Identity;
-
-            if ( ImportAxis == HRSAI_Unreal )
+            if ( Positions.IsValidIndex( PointIdx * 3 + 2 ) )
             {
-                if ( Positions.IsValidIndex( PointIdx * 3 + 2 ) )
-                {
-                    currentPosition.X = Positions[ PointIdx * 3 ] * GeneratedGeometryScaleFactor;
-                    currentPosition.Y = Positions[ PointIdx * 3 + 2 ] * GeneratedGeometryScaleFactor;
-                    currentPosition.Z = Positions[ PointIdx * 3 + 1 ] * GeneratedGeometryScaleFactor;
-                }
+                currentPosition.X = Positions[ PointIdx * 3 ] * GeneratedGeometryScaleFactor;
+                currentPosition.Y = Positions[ PointIdx * 3 + 2 ] * GeneratedGeometryScaleFactor;
+                currentPosition.Z = Positions[ PointIdx * 3 + 1 ] * GeneratedGeometryScaleFactor;
+            }
 
-                if ( bHasScale && Scales.IsValidIndex( PointIdx * 3 + 2 ) )
-                {
-                    currentScale.X = Scales[ PointIdx * 3 ];
-                    currentScale.Y = Scales[ PointIdx * 3 + 2 ];
-                    currentScale.Z = Scales[ PointIdx * 3 + 1 ];
-                }
+            if ( bHasScale && Scales.IsValidIndex( PointIdx * 3 + 2 ) )
+            {
+                currentScale.X = Scales[ PointIdx * 3 ];
+                currentScale.Y = Scales[ PointIdx * 3 + 2 ];
+                currentScale.Z = Scales[ PointIdx * 3 + 1 ];
+            }
 
-                if ( bHasRotation && Rotations.IsValidIndex( PointIdx * 4 + 3 ) )
-                {
-                    currentRotation.X = Rotations[ PointIdx * 4 ];
-                    currentRotation.Y = Rotations[ PointIdx * 4 + 2 ];
-                    currentRotation.Z = Rotations[ PointIdx * 4 + 1 ];
-                    currentRotation.W = -Rotations[ PointIdx * 4 + 3 ];
-                }
-                else if ( bHasNormals && Normals.IsValidIndex( PointIdx * 3 + 2 ) )
-                {
-                    FVector vNormal;
-                    vNormal.X = Normals[ PointIdx * 3 ];
-                    vNormal.Y = Normals[ PointIdx * 3 + 2 ];
-                    vNormal.Z = Normals[ PointIdx * 3 + 1 ];
+            if ( bHasRotation && Rotations.IsValidIndex( PointIdx * 4 + 3 ) )
+            {
+                currentRotation.X = Rotations[ PointIdx * 4 ];
+                currentRotation.Y = Rotations[ PointIdx * 4 + 2 ];
+                currentRotation.Z = Rotations[ PointIdx * 4 + 1 ];
+                currentRotation.W = -Rotations[ PointIdx * 4 + 3 ];
+            }
+            else if ( bHasNormals && Normals.IsValidIndex( PointIdx * 3 + 2 ) )
+            {
+                FVector vNormal;
+                vNormal.X = Normals[ PointIdx * 3 ];
+                vNormal.Y = Normals[ PointIdx * 3 + 2 ];
+                vNormal.Z = Normals[ PointIdx * 3 + 1 ];
 
-                    if ( vNormal != FVector::ZeroVector )
-                        currentRotation = FQuat::FindBetween( FVector::UpVector, vNormal );
-                }
+                if ( vNormal != FVector::ZeroVector )
+                    currentRotation = FQuat::FindBetween( FVector::UpVector, vNormal );
             }
-            else
+        }
+        else
+        {
+            if ( Positions.IsValidIndex( PointIdx * 3 + 2 ) )
             {
-                if ( Positions.IsValidIndex( PointIdx * 3 + 2 ) )
-                {
-                    currentPosition.X = Positions[ PointIdx * 3 ] * GeneratedGeometryScaleFactor;
-                    currentPosition.Y = Positions[ PointIdx * 3 + 1 ] * GeneratedGeometryScaleFactor;
-                    currentPosition.Z = Positions[ PointIdx * 3 + 2 ] * GeneratedGeometryScaleFactor;
-                }
+                currentPosition.X = Positions[ PointIdx * 3 ] * GeneratedGeometryScaleFactor;
+                currentPosition.Y = Positions[ PointIdx * 3 + 1 ] * GeneratedGeometryScaleFactor;
+                currentPosition.Z = Positions[ PointIdx * 3 + 2 ] * GeneratedGeometryScaleFactor;
+            }
 
-                if ( bHasScale && Scales.IsValidIndex( PointIdx * 3 + 2 ) )
-                {
-                    currentScale.X = Scales[ PointIdx * 3 ];
-                    currentScale.Y = Scales[ PointIdx * 3 + 1 ];
-                    currentScale.Z = Scales[ PointIdx * 3 + 2 ];
-                }
+            if ( bHasScale && Scales.IsValidIndex( PointIdx * 3 + 2 ) )
+            {
+                currentScale.X = Scales[ PointIdx * 3 ];
+                currentScale.Y = Scales[ PointIdx * 3 + 1 ];
+                currentScale.Z = Scales[ PointIdx * 3 + 2 ];
+            }
 
-                if ( bHasRotation && Rotations.IsValidIndex( PointIdx * 4 + 3 ) )
-                {
-                    currentRotation.X = Rotations[ PointIdx * 4 ];
-                    currentRotation.Y = Rotations[ PointIdx * 4 + 1 ];
-                    currentRotation.Z = Rotations[ PointIdx * 4 + 2 ];
-                    currentRotation.W = Rotations[ PointIdx * 4 + 3 ];
-                }
-                else if ( bHasNormals && Normals.IsValidIndex( PointIdx * 3 + 2 ) )
-                {
-                    FVector vNormal;
-                    vNormal.X = Normals[ PointIdx * 3 ];
-                    vNormal.Y = Normals[ PointIdx * 3 + 1 ];
-                    vNormal.Z = Normals[ PointIdx * 3 + 2 ];
+            if ( bHasRotation && Rotations.IsValidIndex( PointIdx * 4 + 3 ) )
+            {
+                currentRotation.X = Rotations[ PointIdx * 4 ];
+                currentRotation.Y = Rotations[ PointIdx * 4 + 1 ];
+                currentRotation.Z = Rotations[ PointIdx * 4 + 2 ];
+                currentRotation.W = Rotations[ PointIdx * 4 + 3 ];
+            }
+            else if ( bHasNormals && Normals.IsValidIndex( PointIdx * 3 + 2 ) )
+            {
+                FVector vNormal;
+                vNormal.X = Normals[ PointIdx * 3 ];
+                vNormal.Y = Normals[ PointIdx * 3 + 1 ];
+                vNormal.Z = Normals[ PointIdx * 3 + 2 ];
 
-                    if ( vNormal != FVector::ZeroVector )
-                        currentRotation = FQuat::FindBetween( FVector::UpVector, vNormal );
-                }
+                if ( vNormal != FVector::ZeroVector )
+                    currentRotation = FQuat::FindBetween( FVector::UpVector, vNormal );
             }
+        }
 
-            FString currentName;
-            if ( bHasNames && Names.IsValidIndex( PointIdx ) )
-                currentName = Names[ PointIdx ];
+        FString currentName;
+        if ( bHasNames && Names.IsValidIndex( PointIdx ) )
+            currentName = Names[ PointIdx ];
 
-            FString currentActors;
-            if ( bHasActors && Actors.IsValidIndex( PointIdx ) )
-                currentActors = Actors[ PointIdx ];
+        FString currentActors;
+        if ( bHasActors && Actors.IsValidIndex( PointIdx ) )
+            currentActors = Actors[ PointIdx ];
 
-            // If the scale attribute wasn't set on all socket, we might end up
-            // with a zero scale socket, avoid that.
-            if ( currentScale == FVector::ZeroVector )
-                currentScale = FVector( 1.0f, 1.0f, 1.0f );
+        // If the scale attribute wasn't set on all socket, we might end up
+        // with a zero scale socket, avoid that.
+        if ( currentScale == FVector::ZeroVector )
+            currentScale = FVector( 1.0f, 1.0f, 1.0f );
 
-            currentSocketTransform.SetLocation( currentPosition );
-            currentSocketTransform.SetRotation( currentRotation );
-            currentSocketTransform.SetScale3D( currentScale );
+        currentSocketTransform.SetLocation( currentPosition );
+        currentSocketTransform.SetRotation( currentRotation );
+        currentSocketTransform.SetScale3D( currentScale );
 
-            // We want to make sure we're not adding the same socket multiple times
-            int32 FoundIx = AllSockets.IndexOfByPredicate(
-                [ currentSocketTransform ]( const FTransform InTransform ){ return InTransform.Equals( currentSocketTransform); } );
+        // We want to make sure we're not adding the same socket multiple times,
+        // only the sockets in the cells overlapping the equality tolerance are compared.
+        const FIntVector CellMin = GetMeshSocketCell( currentPosition - FVector( KINDA_SMALL_NUMBER ) );
+        const FIntVector CellMax = GetMeshSocketCell( currentPosition + FVector( KINDA_SMALL_NUMBER ) );
 
-            //int32 FoundIx = AllSockets.Find( currentSocketTransform );
-            if ( FoundIx >= 0 )
+        bool bIsDuplicate = false;
+        TArray< int32 > CellSockets;
+        for ( int32 CellX = CellMin.X; CellX <= CellMax.X && !bIsDuplicate; CellX++ )
+        {
+            for ( int32 CellY = CellMin.Y; CellY <= CellMax.Y && !bIsDuplicate; CellY++ )
             {
-                // If the transform, names and actors are identical, skip this duplicate
-                if ( ( AllSocketsNames[ FoundIx ] == currentName )
-                    && ( AllSocketsActors[ FoundIx ] == currentActors ) )
-                    continue;
+                for ( int32 CellZ = CellMin.Z; CellZ <= CellMax.Z && !bIsDuplicate; CellZ++ )
+                {
+                    CellSockets.Reset();
+                    AllSocketsByCell.MultiFind( FIntVector( CellX, CellY, CellZ ), CellSockets );
+                    for ( int32 FoundIx : CellSockets )
+                    {
+                        // If the transform, names and actors are identical, skip this duplicate
+                        if ( AllSockets[ FoundIx ].Equals( currentSocketTransform )
+                            && ( AllSocketsNames[ FoundIx ] == currentName )
+                            && ( AllSocketsActors[ FoundIx ] == currentActors ) )
+                        {
+                            bIsDuplicate = true;
+                            break;
+                        }
+                    }
+                }
             }
-
-            AllSockets.Add( currentSocketTransform );
-            AllSocketsNames.Add( currentName );
-            AllSocketsActors.Add( currentActors );
         }
+
+        if ( bIsDuplicate )
+            continue;
+
+        int32 SocketIx = AllSockets.Add( currentSocketTransform );
+        AllSocketsNames.Add( currentName );
+        AllSocketsActors.Add( currentActors );
+        AllSocketsByCell.Add( GetMeshSocketCell( currentPosition ), SocketIx );
     }
 
     return AllSockets.Num();
@@ -6657,6 +7265,22 @@ FHoudiniEngineUtils::GetGenericAttributeList(
             HandleSplit = true;
             PrimIndexForSplit = PrimitiveIndex;
         }
+        else if ( GeoPartObject.SplitName.StartsWith( TEXT( HAPI_UNREAL_SPLIT_INPUT_SOURCE_PREFIX ) ) )
+        {
+            HandleSplit = true;
+
+            // Source splits are not groups, we need to find a primitive coming from the split's source object
+            const FString SourcePrefix = TEXT( HAPI_UNREAL_SPLIT_INPUT_SOURCE_PREFIX );
+            int32 SourceIndex = FCString::Atoi( *GeoPartObject.SplitName.RightChop( SourcePrefix.Len() ) );
+
+            HAPI_AttributeInfo AttribInfoSourceIndices;
+            FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoSourceIndices );
+            TArray< int32 > PartSourceIndices;
+            FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
+                GeoPartObject, HAPI_UNREAL_ATTRIB_INPUT_SOURCE_INDEX, AttribInfoSourceIndices, PartSourceIndices );
+
+            PrimIndexForSplit = PartSourceIndices.Find( SourceIndex );
+        }
         else if ( !GeoPartObject.SplitName.IsEmpty() && ( GeoPartObject.SplitName != TEXT("main_geo") ) )
         {
             HandleSplit = true;
@@ -200,17 +200,17 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
         /** Return a string error description. **/
         static const FString GetErrorDescription();
 
-        /** Return a string indicating cook state. **/
-        static const FString GetCookState();
+        /** Return a string indicating cook state, of the engine session if none is given. **/
+        static const FString GetCookState( const HAPI_Session * Session = nullptr );
 
-        /** Return a string representing cooking result. **/
-        static const FString GetCookResult();
+        /** Return a string representing cooking result, of the engine session if none is given. **/
+        static const FString GetCookResult( const HAPI_Session * Session = nullptr );
 
         /** Helper function for creating a temporary Slate notification. **/
         static void CreateSlateNotification( const FString& NotificationString );
 
-        /** Return true if module has been properly initialized. **/
-        static bool IsInitialized();
+        /** Return true if module has been properly initialized, checking the engine session if none is given. **/
+        static bool IsInitialized( const HAPI_Session * Session = nullptr );
 
         /** Return type of license used. **/
         static bool GetLicenseType( FString & LicenseType );
@@ -227,11 +227,11 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
         /** Gets preset data for a given asset. **/
         static bool GetAssetPreset( HAPI_NodeId AssetId, TArray< char > & PresetBuffer );
 
-        /** Return true if asset is valid. **/
-        static bool IsHoudiniAssetValid( HAPI_NodeId AssetId );
+        /** Return true if asset is valid. Uses the engine session if none is given. **/
+        static bool IsHoudiniAssetValid( HAPI_NodeId AssetId, const HAPI_Session * Session = nullptr );
 
-        /** Destroy asset, returns the status. **/
-        static bool DestroyHoudiniAsset( HAPI_NodeId AssetId );
+        /** Destroy asset, returns the status. Uses the engine session if none is given. **/
+        static bool DestroyHoudiniAsset( HAPI_NodeId AssetId, const HAPI_Session * Session = nullptr );
 
         /** HAPI : Convert Unreal string to ascii one. **/
         static void ConvertUnrealString( const FString & UnrealString, std::string & String );
@@ -259,7 +259,15 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
             HAPI_NodeId AssetId, FHoudiniCookParams& HoudiniCookParams,
             bool ForceRebuildStaticMesh, bool ForceRecookAll,
             const TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshesIn,
-            TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshesOut, FTransform & ComponentTransform );
+            TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshesOut, FTransform & ComponentTransform,
+            TArray< UStaticMesh * > * StaticMeshesToBuild = nullptr );
+
+        /** Build a static mesh constructed from a Houdini asset. When CreateStaticMeshesFromHoudiniAsset is given a **/
+        /** list of meshes to build, this and UpdateStaticMeshNavigationCollision are left to the caller.            **/
+        static void BuildStaticMesh( UStaticMesh * StaticMesh, TArray< FText > & BuildErrors );
+
+        /** Update the navigation collision of built collidable static meshes. **/
+        static void UpdateStaticMeshNavigationCollision( const TMap< FHoudiniGeoPartObject, UStaticMesh * > & StaticMeshes );
 
         /** Extract position information from coords string. **/
         static void ExtractStringPositions( const FString & Positions, TArray< FVector > & OutPositions );
@@ -309,6 +317,19 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
         /** HAPI : Retrieve object transforms from given asset node id. **/
         static bool HapiGetObjectTransforms( HAPI_NodeId AssetId, TArray< HAPI_Transform > & ObjectTransforms );
 
+        /** HAPI : Issue the read-only queries static mesh creation makes on a cooked asset. Only talks to HAPI, it is **/
+        /** used by the scheduler thread to capture the cook output before the game thread processes it. Also     **/
+        /** returns the unique object paths referenced by the instance and material override attributes, so that  **/
+        /** they can be loaded before the cook output is applied.                                                 **/
+        static bool HapiPrefetchCookOutput( HAPI_NodeId AssetId, TArray< FString > & ReferencedObjectPaths );
+
+        /** HAPI : Compute the content key of an instanced packed part: its counts and a SHA1 digest of its topology, **/
+        /** attributes and materials. Identical packed geometry yields the same key, whatever its part id. Returns an  **/
+        /** empty key if the part cannot be read.                                                                       **/
+        static FString HapiGetPackedPartGeometryKey(
+            HAPI_NodeId AssetId, HAPI_NodeId ObjectId, HAPI_NodeId GeoId, const HAPI_PartInfo & PartInfo,
+            const TArray< int32 > & PartVertexList, const TArray< HAPI_NodeId > & PartFaceMaterialIds );
+
         /** HAPI : Marshalling, extract landscape geometry and upload it. Return true on success. **/
         static bool HapiCreateInputNodeForData(
             const HAPI_NodeId& HostAssetId, ALandscapeProxy * LandscapeProxy,
@@ -324,7 +345,8 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
             UStaticMesh * Mesh,
             HAPI_NodeId & ConnectedAssetId,
             class UStaticMeshComponent* StaticMeshComponent = nullptr,
-            const bool& ExportAllLODs = false );
+            const bool& ExportAllLODs = false,
+            const int32& InputSourceIndex = -1 );
 
         /** HAPI : Marshaling, extract geometry and create input asset for it - return true on success **/
         static bool HapiCreateInputNodeForData(
@@ -333,7 +355,8 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
             const TArray< FTransform >& InputTransforms,
             HAPI_NodeId & ConnectedAssetId, 
             TArray< HAPI_NodeId >& OutCreatedNodeIds,
-            const bool& ExportAllLODs = false );
+            const bool& ExportAllLODs = false,
+            const bool& bTagInputSources = false );
 
         /** HAPI : Marshaling, extract geometry and create input asset for it - return true on success **/
         static bool HapiCreateInputNodeForData(
@@ -341,7 +364,8 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
             TArray< FHoudiniAssetInputOutlinerMesh > & OutlinerMeshArray,
             HAPI_NodeId & ConnectedAssetId,
             const float& SplineResolution = -1.0f,
-            const bool& ExportAllLODs = false );
+            const bool& ExportAllLODs = false,
+            const bool& bTagInputSources = false );
 
         /** HAPI : Marshaling, extract points from the Unreal Spline and create an input curve for it - return true on success **/
         static bool HapiCreateInputNodeForData(
@@ -419,6 +443,18 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
             const FHoudiniGeoPartObject & HoudiniGeoPartObject, const char * Name,
             HAPI_AttributeInfo & ResultAttributeInfo, TArray< float > & Data, int32 TupleSize = 0 );
 
+        /** HAPI : Get the points of all the curves of a curve part, the counts and positions are each retrieved in one call. **/
+        static bool HapiGetCurvePoints(
+            const FHoudiniGeoPartObject & HoudiniGeoPartObject, TArray< FVector > & OutPositions,
+            TArray< int32 > & OutCurveCounts, bool & bOutPeriodic );
+
+        /** HAPI : Get the coords, type, method and closed parameters of a curve node. Each parameter is looked   **/
+        /** up by name or tag, the node's parameter infos are listed once and all its integer values are read in **/
+        /** a single call. Return false if one is missing.                                                       **/
+        static bool HapiGetCurveParameters(
+            HAPI_NodeId NodeId, FString & OutCurveCoords, int32 & OutCurveType,
+            int32 & OutCurveMethod, int32 & OutCurveClosed );
+
         /** HAPI : Get attribute data as integer. **/
         static bool HapiGetAttributeDataAsInteger(
             HAPI_NodeId AssetId, HAPI_NodeId ObjectId, HAPI_NodeId GeoId,
@@ -487,13 +523,22 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
             TArray< int32 > & NewVertexList, TArray< int32 > & AllVertexList, TArray< int32 > & AllFaceList,
             TArray< int32 > & AllCollisionFaceIndices, const bool& isPackedPrim );
 
+        /** HAPI : Retrieves the names of the socket point groups, returns false if there are none			**/
+        static bool HapiGetMeshSocketGroupNames(
+            HAPI_NodeId AssetId, HAPI_NodeId ObjectId,
+            HAPI_NodeId GeoId, HAPI_PartId PartId,
+            TArray< FString >& SocketGroupNames,
+            const bool& isPackedPrim );
+
         /** HAPI : Retrieves the mesh sockets list for the current part							**/
         static int32 AddMeshSocketToList(
             HAPI_NodeId AssetId, HAPI_NodeId ObjectId,
             HAPI_NodeId GeoId, HAPI_PartId PartId,
+            const TArray< FString >& SocketGroupNames,
             TArray< FTransform >& AllSockets,
             TArray< FString >& AllSocketsName,
             TArray< FString >& AllSocketsActors,
+            TMultiMap< FIntVector, int32 >& AllSocketsByCell,
             const bool& isPackedPrim );
 
         /** Add the mesh sockets in the list to the specified StaticMesh						**/
@@ -585,19 +630,19 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineUtils
         /** Helper routine to count number of degenerate triangles. **/
         static int32 CountDegenerateTriangles( const FRawMesh & RawMesh );
 
-        /** Create helper array of material names, we use it for marshalling. **/
+        /** Create helper array of material names, we use it for marshalling. Names are converted once per **/
+        /** material slot, the per face array points into OutMaterialSlotNames and is valid as long as it is. **/
         static void CreateFaceMaterialArray(
             const TArray< FStaticMaterial > & Materials,
             const TArray< int32 > & FaceMaterialIndices,
-            TArray< char * > & OutStaticMeshFaceMaterials );
-
-        /** Delete helper array of material names. **/
-        static void DeleteFaceMaterialArray( TArray< char * > & OutStaticMeshFaceMaterials );
+            TArray< std::string > & OutMaterialSlotNames,
+            TArray< const char * > & OutStaticMeshFaceMaterials );
 
 #endif // WITH_EDITOR
 
-        /** Return a specified HAPI status string. **/
-        static const FString GetStatusString( HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity );
+        /** Return a specified HAPI status string, of the engine session if none is given. **/
+        static const FString GetStatusString(
+            HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity, const HAPI_Session * Session = nullptr );
 
         /** Extract all unique material ids for all geo object parts. **/
         static bool ExtractUniqueMaterialIds(
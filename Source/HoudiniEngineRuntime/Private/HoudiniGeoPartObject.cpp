@@ -260,6 +260,7 @@ FHoudiniGeoPartObject::FHoudiniGeoPartObject( const FHoudiniGeoPartObject & GeoP
     , bHasSocketBeenAdded( GeoPartObject.bHasSocketBeenAdded )
     , UnusedFlagsSpace( 0u )
     , HoudiniGeoPartObjectVersion( VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_BASE )
+    , PackedGeometryKey( GeoPartObject.PackedGeometryKey )
 {
     if ( bCopyLoaded )
         bIsLoaded = true;
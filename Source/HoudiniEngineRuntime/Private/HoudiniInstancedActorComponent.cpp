@@ -23,25 +23,35 @@
 
 #include "HoudiniApi.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "HoudiniInstancedActorComponent.h"
 #include "HoudiniMeshSplitInstancerComponent.h"
 #include "HoudiniEngineRuntimePrivatePCH.h"
+#include "HoudiniAssetComponent.h"
+#include "HoudiniEngineUtils.h"
+#include "Engine/Blueprint.h"
 #if WITH_EDITOR
-#include "LevelEditorViewport.h"
+#include "AssetSelection.h"
+#include "ActorFactories/ActorFactory.h"
 #endif
 
 #include "Internationalization.h"
 #define LOCTEXT_NAMESPACE HOUDINI_LOCTEXT_NAMESPACE 
 
+/** Number of instanced actors spawned by each work item of a batch. **/
+static const int32 InstancedActorSpawnChunkSize = 64;
+
 UHoudiniInstancedActorComponent::UHoudiniInstancedActorComponent( const FObjectInitializer& ObjectInitializer )
 : Super( ObjectInitializer )
 , InstancedAsset( nullptr )
+, NextPendingInstance( 0 )
 {
 }
 
 
 void UHoudiniInstancedActorComponent::OnComponentDestroyed( bool bDestroyingHierarchy )
 {
+    CancelPendingInstances();
     ClearInstances();
     Super::OnComponentDestroyed( bDestroyingHierarchy );
 }
@@ -70,18 +80,31 @@ void
 UHoudiniInstancedActorComponent::SetInstances( const TArray<FTransform>& InstanceTransforms )
 {
 #if WITH_EDITOR
-    if ( Instances.Num() || InstanceTransforms.Num() )
+    if ( Instances.Num() || InstanceTransforms.Num() || GetPendingInstanceCount() > 0 )
     {
-        const FScopedTransaction Transaction( LOCTEXT( "UpdateInstances", "Update Instances" ) );
-        GetOwner()->Modify();
-        ClearInstances();
+        // A batch which is still spawning is superseded by this one.
+        CancelPendingInstances();
+
+        {
+            const FScopedTransaction Transaction( LOCTEXT( "UpdateInstances", "Update Instances" ) );
+            GetOwner()->Modify();
+            Modify();
+            ClearInstances();
+        }
 
         if( InstancedAsset )
         {
-            for( const FTransform& InstanceTransform : InstanceTransforms )
+            PendingInstanceTransforms = InstanceTransforms;
+            NextPendingInstance = 0;
+            Instances.Reserve( InstanceTransforms.Num() );
+
+            if ( InstanceTransforms.Num() > InstancedActorSpawnChunkSize )
             {
-                AddInstance( InstanceTransform );
+                FHoudiniEngineUtils::CreateSlateNotification( FString::Printf(
+                    TEXT( "Spawning %d instances of %s" ), InstanceTransforms.Num(), *InstancedAsset->GetName() ) );
             }
+
+            QueueInstanceSpawnChunk();
         }
         else
         {
@@ -91,13 +114,101 @@ UHoudiniInstancedActorComponent::SetInstances( const TArray<FTransform>& Instanc
 #endif
 }
 
+int32
+UHoudiniInstancedActorComponent::GetPendingInstanceCount() const
+{
+    return PendingInstanceTransforms.Num() - NextPendingInstance;
+}
+
+void
+UHoudiniInstancedActorComponent::FinishPendingInstances()
+{
+    if ( GetPendingInstanceCount() > 0 )
+        SpawnPendingInstances( GetPendingInstanceCount() );
+}
+
+void
+UHoudiniInstancedActorComponent::QueueInstanceSpawnChunk()
+{
+    TWeakObjectPtr< UHoudiniInstancedActorComponent > WeakThis( this );
+    auto SpawnChunk = [ WeakThis ]()
+    {
+        UHoudiniInstancedActorComponent * This = WeakThis.Get();
+        if ( !This || This->GetPendingInstanceCount() <= 0 )
+            return;
+
+        This->SpawnPendingInstances( InstancedActorSpawnChunkSize );
+        if ( This->GetPendingInstanceCount() > 0 )
+            This->QueueInstanceSpawnChunk();
+    };
+
+    // Chunks are spawned with the rest of the cook output of the owning asset, within its frame budget,
+    // so baking or recooking the asset finishes them first.
+    if ( UHoudiniAssetComponent * HoudiniAssetComponent = Cast< UHoudiniAssetComponent >( GetAttachParent() ) )
+        HoudiniAssetComponent->AddPostCookWorkItem( SpawnChunk );
+    else
+        FinishPendingInstances();
+}
+
+void
+UHoudiniInstancedActorComponent::SpawnPendingInstances( int32 MaxInstances )
+{
+#if WITH_EDITOR
+    const int32 SpawnCount = FMath::Min( MaxInstances, GetPendingInstanceCount() );
+    if ( SpawnCount <= 0 )
+        return;
+
+    const int32 StartIdx = NextPendingInstance;
+    NextPendingInstance += SpawnCount;
+
+    // Each chunk is its own transaction, opened and closed within the frame it is spawned in.
+    {
+        const FScopedTransaction Transaction( LOCTEXT( "SpawnInstances", "Spawn Instances" ) );
+        Modify();
+
+        // The whole chunk is spawned at its final world transforms first, then attached in a single pass.
+        const FTransform & ComponentTransform = GetComponentTransform();
+        TArray< AActor * > NewActors;
+        NewActors.Reserve( SpawnCount );
+        for ( int32 InstanceIdx = StartIdx; InstanceIdx < StartIdx + SpawnCount; ++InstanceIdx )
+        {
+            if ( AActor * NewActor = SpawnInstancedActor( PendingInstanceTransforms[ InstanceIdx ] * ComponentTransform ) )
+                NewActors.Add( NewActor );
+        }
+
+        for ( AActor * NewActor : NewActors )
+        {
+            NewActor->AttachToComponent( this, FAttachmentTransformRules::KeepWorldTransform );
+            Instances.Add( NewActor );
+        }
+    }
+
+    if ( GetPendingInstanceCount() <= 0 )
+    {
+        if ( PendingInstanceTransforms.Num() > InstancedActorSpawnChunkSize )
+        {
+            FHoudiniEngineUtils::CreateSlateNotification( FString::Printf(
+                TEXT( "Spawned %d instances of %s" ), Instances.Num(), *GetNameSafe( InstancedAsset ) ) );
+        }
+
+        CancelPendingInstances();
+    }
+#endif
+}
+
+void
+UHoudiniInstancedActorComponent::CancelPendingInstances()
+{
+    PendingInstanceTransforms.Empty();
+    NextPendingInstance = 0;
+}
+
 int32 
 UHoudiniInstancedActorComponent::AddInstance( const FTransform& InstanceTransform )
 {
-    if ( AActor * NewActor = SpawnInstancedActor( InstanceTransform ) )
+    if ( AActor * NewActor = SpawnInstancedActor( InstanceTransform * GetComponentTransform() ) )
     {
-        NewActor->AttachToComponent( this, FAttachmentTransformRules::KeepRelativeTransform );
-        NewActor->SetActorRelativeTransform( InstanceTransform );
+        NewActor->AttachToComponent( this, FAttachmentTransformRules::KeepWorldTransform );
         return Instances.Add( NewActor );
     }
     return -1;
@@ -107,11 +218,34 @@ AActor*
 UHoudiniInstancedActorComponent::SpawnInstancedActor( const FTransform& InstancedTransform ) const
 {
 #if WITH_EDITOR
-    GEditor->ClickLocation = InstancedTransform.GetTranslation();
-    GEditor->ClickPlane = FPlane( GEditor->ClickLocation, FVector::UpVector );
-    TArray<AActor*> NewActors = FLevelEditorViewportClient::TryPlacingActorFromObject( GetOwner()->GetLevel(), InstancedAsset, false, RF_Transactional, nullptr );
-    if ( NewActors.Num() > 0 )
-        return NewActors[ 0 ];
+    ULevel * Level = GetOwner() ? GetOwner()->GetLevel() : nullptr;
+    UWorld * World = Level ? Level->OwningWorld : nullptr;
+    if ( !World || !InstancedAsset )
+        return nullptr;
+
+    // Actor classes and blueprints are spawned directly, their construction deferred until the transform is set.
+    UClass * ActorClass = Cast< UClass >( InstancedAsset );
+    if ( UBlueprint * Blueprint = Cast< UBlueprint >( InstancedAsset ) )
+        ActorClass = Blueprint->GeneratedClass;
+
+    if ( ActorClass && ActorClass->IsChildOf( AActor::StaticClass() ) )
+    {
+        // Same as SpawnActorDeferred, but spawning in the level of the owning actor.
+        FActorSpawnParameters SpawnParameters;
+        SpawnParameters.OverrideLevel = Level;
+        SpawnParameters.bDeferConstruction = true;
+        SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        SpawnParameters.ObjectFlags = RF_Transactional;
+
+        AActor * NewActor = World->SpawnActor( ActorClass, &InstancedTransform, SpawnParameters );
+        if ( NewActor )
+            NewActor->FinishSpawning( InstancedTransform );
+        return NewActor;
+    }
+
+    // Other assets (meshes, particle systems, sounds..) go through their actor factory, placed at the transform.
+    if ( UActorFactory * ActorFactory = FActorFactoryAssetProxy::GetFactoryForAssetObject( InstancedAsset ) )
+        return ActorFactory->CreateActor( InstancedAsset, Level, InstancedTransform, RF_Transactional );
 #endif
     return nullptr;
 }
@@ -150,9 +284,77 @@ UHoudiniInstancedActorComponent::OnComponentCreated()
     }
 }
 
+/** Update the instances of an instanced static mesh component in place: only the changed ranges are sent, and   **/
+/** instances are only added or removed at the tail. Returns true if any instance changed.                        **/
+static bool
+UpdateInstancedStaticMeshTransforms( UInstancedStaticMeshComponent * ISMC, const TArray< FTransform > & Transforms )
+{
+    bool bChanged = false;
+
+    int32 NumExistingInstances = ISMC->GetInstanceCount();
+    if ( NumExistingInstances > Transforms.Num() )
+    {
+        if ( Transforms.Num() == 0 )
+        {
+            ISMC->ClearInstances();
+        }
+        else
+        {
+            for ( int32 InstanceIdx = NumExistingInstances - 1; InstanceIdx >= Transforms.Num(); --InstanceIdx )
+                ISMC->RemoveInstance( InstanceIdx );
+        }
+
+        NumExistingInstances = Transforms.Num();
+        bChanged = true;
+    }
+
+    auto UpdateRange = [&]( int32 StartIdx, int32 EndIdx )
+    {
+#if HOUDINI_ENGINE_BATCH_INSTANCE_UPDATE
+        TArray< FTransform > RangeTransforms( &Transforms[ StartIdx ], EndIdx - StartIdx );
+        ISMC->BatchUpdateInstancesTransforms( StartIdx, RangeTransforms, false, false );
+#else
+        for ( int32 InstanceIdx = StartIdx; InstanceIdx < EndIdx; ++InstanceIdx )
+            ISMC->UpdateInstanceTransform( InstanceIdx, Transforms[ InstanceIdx ], false, false );
+#endif
+        bChanged = true;
+    };
+
+    // Diff existing instances against the new transforms, and send contiguous changed ranges.
+    int32 RangeStartIdx = INDEX_NONE;
+    for ( int32 InstanceIdx = 0; InstanceIdx < NumExistingInstances; ++InstanceIdx )
+    {
+        const bool bInstanceChanged = !ISMC->PerInstanceSMData[ InstanceIdx ].Transform.Equals(
+            Transforms[ InstanceIdx ].ToMatrixWithScale() );
+
+        if ( bInstanceChanged && RangeStartIdx == INDEX_NONE )
+        {
+            RangeStartIdx = InstanceIdx;
+        }
+        else if ( !bInstanceChanged && RangeStartIdx != INDEX_NONE )
+        {
+            UpdateRange( RangeStartIdx, InstanceIdx );
+            RangeStartIdx = INDEX_NONE;
+        }
+    }
+
+    if ( RangeStartIdx != INDEX_NONE )
+        UpdateRange( RangeStartIdx, NumExistingInstances );
+
+    // Append new instances at the tail.
+    for ( int32 InstanceIdx = NumExistingInstances; InstanceIdx < Transforms.Num(); ++InstanceIdx )
+    {
+        ISMC->AddInstance( Transforms[ InstanceIdx ] );
+        bChanged = true;
+    }
+
+    return bChanged;
+}
+
 void UHoudiniInstancedActorComponent::UpdateInstancerComponentInstances(
     USceneComponent * Component,
     const TArray< FTransform > & InstancedTransforms, const TArray<FLinearColor> & InstancedColors,
+    const TArray< float > & InstancedCustomData, int32 NumCustomDataFloats,
     const FRotator & RotationOffset, const FVector & ScaleOffset)
 {
     UInstancedStaticMeshComponent* ISMC = Cast<UInstancedStaticMeshComponent>( Component );
@@ -195,11 +397,35 @@ void UHoudiniInstancedActorComponent::UpdateInstancerComponentInstances(
 
     if( ISMC )
     {
-        ISMC->ClearInstances();
-        for( const auto& Transform : ProcessOffsets() )
+        bool bChanged = UpdateInstancedStaticMeshTransforms( ISMC, ProcessOffsets() );
+
+#if HOUDINI_ENGINE_INSTANCE_CUSTOM_DATA
+        // Custom data of all instances is assigned in bulk, and only when it differs from the component's.
+        const bool bHasCustomData = NumCustomDataFloats > 0
+            && InstancedCustomData.Num() == InstancedTransforms.Num() * NumCustomDataFloats;
+        const int32 NewNumCustomDataFloats = bHasCustomData ? NumCustomDataFloats : 0;
+
+        if( ISMC->NumCustomDataFloats != NewNumCustomDataFloats )
+        {
+            ISMC->SetNumCustomDataFloats( NewNumCustomDataFloats );
+            bChanged = true;
+        }
+
+        if( bHasCustomData && ISMC->PerInstanceSMCustomData != InstancedCustomData )
         {
-            ISMC->AddInstance( Transform );
+            ISMC->PerInstanceSMCustomData = InstancedCustomData;
+            bChanged = true;
         }
+
+        if( bChanged )
+        {
+            if( UHierarchicalInstancedStaticMeshComponent * HISMC = Cast< UHierarchicalInstancedStaticMeshComponent >( ISMC ) )
+                HISMC->BuildTreeIfOutdated( false, true );
+        }
+#endif
+
+        if( bChanged )
+            ISMC->MarkRenderStateDirty();
     }
     else if( IAC )
     {
@@ -47,23 +47,33 @@ public:
 
     static void AddReferencedObjects( UObject * InThis, FReferenceCollector & Collector );
     
-    /** Set the instances. Transforms are given in local space of this component. */
+    /** Set the instances. Transforms are given in local space of this component. Instances are spawned in chunks */
+    /** along with the rest of the cook output of the owning asset, each chunk being its own transaction.        */
     void SetInstances( const TArray<FTransform>& InstanceTransforms );
 
+    /** Return the number of instances which have been queued by SetInstances but not spawned yet. */
+    int32 GetPendingInstanceCount() const;
+
+    /** Spawn all queued instances now. */
+    void FinishPendingInstances();
+
     /** Add an instance to this component. Transform is given in local space of this component. */
     int32 AddInstance( const FTransform& InstanceTransform );
     
     /** Destroy all extant instances */
     void ClearInstances();
 
-    /** Spawn a single instance */
+    /** Spawn a single instance at the given world transform, without attaching it. */
     AActor* SpawnInstancedActor( const FTransform& InstancedTransform ) const;
 
     /** Update instances of a given instancer component. (could be ISMC, IAC or MSIC) **/
+    /** ISMC instances are updated in place, only changed instances are sent to the component. **/
     static void UpdateInstancerComponentInstances(
         USceneComponent * Component,
         const TArray< FTransform > & InstancedTransforms,
         const TArray<FLinearColor> & InstancedColors ,
+        const TArray< float > & InstancedCustomData,
+        int32 NumCustomDataFloats,
         const FRotator & RotationOffset,
         const FVector & ScaleOffset );
 
@@ -73,4 +83,21 @@ public:
     UPROPERTY( SkipSerialization, VisibleInstanceOnly, Category = Instances )
     TArray< AActor* > Instances;
 
+protected:
+
+    /** Queue the spawning of the next chunk of pending instances. */
+    void QueueInstanceSpawnChunk();
+
+    /** Spawn up to MaxInstances pending instances, then attach them to this component in one pass. */
+    void SpawnPendingInstances( int32 MaxInstances );
+
+    /** Drop the pending instances. */
+    void CancelPendingInstances();
+
+    /** Transforms of the instances waiting to be spawned. */
+    TArray< FTransform > PendingInstanceTransforms;
+
+    /** Index of the next pending instance to spawn. */
+    int32 NextPendingInstance;
+
 };
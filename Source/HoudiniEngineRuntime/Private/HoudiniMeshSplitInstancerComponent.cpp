@@ -77,55 +77,83 @@ UHoudiniMeshSplitInstancerComponent::SetInstances( const TArray<FTransform>& Ins
     {
         const FScopedTransaction Transaction( LOCTEXT( "UpdateInstances", "Update Instances" ) );
         GetOwner()->Modify();
-        ClearInstances();
 
-        if( InstancedMesh )
+        if( !InstancedMesh )
         {
-	    TArray<FColor> InstanceColorOverride;
-	    InstanceColorOverride.SetNumUninitialized(InstancedColors.Num());
-	    for( int32 ix = 0; ix < InstancedColors.Num(); ++ix )
-	    {
-		InstanceColorOverride[ix] = InstancedColors[ix].GetClamped().ToFColor(false);
-	    }
-
-            for( const FTransform& InstanceTransform : InstanceTransforms )
-            {
-		UStaticMeshComponent* SMC = NewObject< UStaticMeshComponent >(
-		    GetOwner(), UStaticMeshComponent::StaticClass(),
-		    NAME_None, RF_Transactional);
-
-		SMC->SetRelativeTransform(InstanceTransform);
-		// Attach created static mesh component to this thing
-		SMC->AttachToComponent(this, FAttachmentTransformRules::KeepRelativeTransform);
-
-		SMC->SetStaticMesh(InstancedMesh);
-		SMC->SetVisibility(IsVisible());
-		SMC->SetMobility(Mobility);
-		if( OverrideMaterial )
-		{
-		    int32 MeshMaterialCount = InstancedMesh->StaticMaterials.Num();
-		    for( int32 Idx = 0; Idx < MeshMaterialCount; ++Idx )
-			SMC->SetMaterial(Idx, OverrideMaterial);
-		}
-
-		// If we have override colors, apply them
-		int32 InstIndex = Instances.Num();
-		if( InstanceColorOverride.IsValidIndex(InstIndex) )
-		{
-		    MeshPaintHelpers::FillVertexColors(SMC, InstanceColorOverride[InstIndex], true);
-		    //FIXME: How to get rid of the warning about fixup vertex colors on load?
-		    //SMC->FixupOverrideColorsIfNecessary();
-		}
-
-		SMC->RegisterComponent();
-
-		Instances.Add(SMC);
-            }
+            ClearInstances();
+            HOUDINI_LOG_ERROR( TEXT( "%s: Null InstancedMesh for split instanced mesh override" ), *GetOwner()->GetName() );
+            return;
         }
-        else
+
+        TArray<FColor> InstanceColorOverride;
+        InstanceColorOverride.SetNumUninitialized( InstancedColors.Num() );
+        for( int32 ix = 0; ix < InstancedColors.Num(); ++ix )
+            InstanceColorOverride[ ix ] = InstancedColors[ ix ].GetClamped().ToFColor( false );
+
+        // Components of instances which no longer exist are destroyed, the others are reused.
+        while( Instances.Num() > InstanceTransforms.Num() )
         {
-            HOUDINI_LOG_ERROR( TEXT( "%s: Null InstancedMesh for split instanced mesh override" ), *GetOwner()->GetName() );
+            if( UStaticMeshComponent* SMC = Instances.Pop( false ) )
+                SMC->ConditionalBeginDestroy();
+        }
+
+        Instances.SetNum( InstanceTransforms.Num() );
+        for( int32 InstIndex = 0; InstIndex < InstanceTransforms.Num(); ++InstIndex )
+        {
+            UStaticMeshComponent* SMC = Instances[ InstIndex ];
+            const bool bNewComponent = SMC == nullptr;
+            if( bNewComponent )
+            {
+                SMC = NewObject< UStaticMeshComponent >(
+                    GetOwner(), UStaticMeshComponent::StaticClass(),
+                    NAME_None, RF_Transactional );
+
+                // Attach created static mesh component to this thing
+                SMC->AttachToComponent( this, FAttachmentTransformRules::KeepRelativeTransform );
+                Instances[ InstIndex ] = SMC;
+            }
+            else
+            {
+                SMC->Modify();
+            }
+
+            SMC->SetRelativeTransform( InstanceTransforms[ InstIndex ] );
+
+            // Painted colors depend on the mesh vertices, so they are reapplied when it changes.
+            const bool bMeshChanged = SMC->GetStaticMesh() != InstancedMesh;
+            if( bMeshChanged )
+                SMC->SetStaticMesh( InstancedMesh );
+
+            SMC->SetVisibility( IsVisible() );
+            SMC->SetMobility( Mobility );
+            if( OverrideMaterial )
+            {
+                int32 MeshMaterialCount = InstancedMesh->StaticMaterials.Num();
+                for( int32 Idx = 0; Idx < MeshMaterialCount; ++Idx )
+                    SMC->SetMaterial( Idx, OverrideMaterial );
+            }
+
+            // Only instances whose color changed are painted again, this is by far the most expensive step.
+            const bool bHasColor = InstanceColorOverride.IsValidIndex( InstIndex );
+            const bool bHadColor = !bNewComponent && !bMeshChanged && PaintedColors.IsValidIndex( InstIndex );
+            if( bHasColor && ( !bHadColor || PaintedColors[ InstIndex ] != InstanceColorOverride[ InstIndex ] ) )
+            {
+                MeshPaintHelpers::FillVertexColors( SMC, InstanceColorOverride[ InstIndex ], true );
+                //FIXME: How to get rid of the warning about fixup vertex colors on load?
+                //SMC->FixupOverrideColorsIfNecessary();
+            }
+            else if( !bHasColor && !bNewComponent && SMC->LODData.Num() > 0 && SMC->LODData[ 0 ].OverrideVertexColors )
+            {
+                SMC->RemoveInstanceVertexColors();
+            }
+
+            if( bNewComponent )
+                SMC->RegisterComponent();
+            else
+                SMC->MarkRenderStateDirty();
         }
+
+        PaintedColors = MoveTemp( InstanceColorOverride );
     }
 #endif
 }
@@ -141,6 +169,7 @@ UHoudiniMeshSplitInstancerComponent::ClearInstances()
         }
     }
     Instances.Empty();
+    PaintedColors.Empty();
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -47,7 +47,8 @@ public:
 
     void SetOverrideMaterial(class UMaterialInterface* MI) { OverrideMaterial = MI; }
     
-    /** Set the instances. Transforms are given in local space of this component. */
+    /** Set the instances. Transforms are given in local space of this component. Existing instance components */
+    /** are reused, and only the instances whose color changed are painted again.                                */
     void SetInstances( const TArray<FTransform>& InstanceTransforms, const TArray<FLinearColor> & InstancedColors );
     
     /** Destroy all extant instances */
@@ -64,4 +65,8 @@ private:
 
     UPROPERTY(SkipSerialization, VisibleAnywhere, Category = Instances )
     class UStaticMesh* InstancedMesh;
+
+    /** Colors painted on each instance by the last update, instances are only painted again when theirs changes. */
+    UPROPERTY( Transient )
+    TArray< FColor > PaintedColors;
 };
@@ -0,0 +1,139 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+#include "HoudiniApi.h"
+#include "HoudiniObjectLoader.h"
+#include "HoudiniEngineRuntimePrivatePCH.h"
+
+TMap< FString, TWeakObjectPtr< UObject > >
+FHoudiniObjectLoader::ResolvedObjects;
+
+FStreamableManager *
+FHoudiniObjectLoader::StreamableManager = nullptr;
+
+UObject *
+FHoudiniObjectLoader::LoadObject( const FString & ObjectPath, UClass * ObjectClass, uint32 LoadFlags )
+{
+    if ( ObjectPath.IsEmpty() )
+        return nullptr;
+
+    UObject * Object = FindResolvedObject( ObjectPath );
+    if ( !Object )
+    {
+        Object = StaticLoadObject( UObject::StaticClass(), nullptr, *ObjectPath, nullptr, LoadFlags, nullptr );
+        if ( Object )
+            ResolvedObjects.Add( ObjectPath, Object );
+    }
+
+    if ( Object && ObjectClass && !Object->IsA( ObjectClass ) )
+        return nullptr;
+
+    return Object;
+}
+
+TSharedPtr< FStreamableHandle >
+FHoudiniObjectLoader::RequestAsyncLoad( const TArray< FString > & ObjectPaths )
+{
+    TArray< FString > ObjectPathsToLoad;
+    TArray< FSoftObjectPath > PathsToLoad;
+    for ( const FString & ObjectPath : ObjectPaths )
+    {
+        if ( ObjectPath.IsEmpty() || FindResolvedObject( ObjectPath ) )
+            continue;
+
+        // Objects which are already in memory only need to be recorded.
+        FSoftObjectPath SoftObjectPath( ObjectPath );
+        if ( UObject * Object = SoftObjectPath.ResolveObject() )
+        {
+            ResolvedObjects.Add( ObjectPath, Object );
+            continue;
+        }
+
+        if ( SoftObjectPath.IsValid() && !ObjectPathsToLoad.Contains( ObjectPath ) )
+        {
+            ObjectPathsToLoad.Add( ObjectPath );
+            PathsToLoad.Add( SoftObjectPath );
+        }
+    }
+
+    if ( PathsToLoad.Num() == 0 )
+        return nullptr;
+
+    if ( !StreamableManager )
+        StreamableManager = new FStreamableManager();
+
+    HOUDINI_LOG_MESSAGE( TEXT( "Streaming in %d objects referenced by cook output." ), PathsToLoad.Num() );
+
+    return StreamableManager->RequestAsyncLoad(
+        PathsToLoad, FStreamableDelegate::CreateStatic( &FHoudiniObjectLoader::OnAsyncLoadCompleted, ObjectPathsToLoad, PathsToLoad ) );
+}
+
+void
+FHoudiniObjectLoader::Reset()
+{
+    ResolvedObjects.Empty();
+
+    if ( StreamableManager )
+    {
+        delete StreamableManager;
+        StreamableManager = nullptr;
+    }
+}
+
+UObject *
+FHoudiniObjectLoader::FindResolvedObject( const FString & ObjectPath )
+{
+    TWeakObjectPtr< UObject > * FoundObject = ResolvedObjects.Find( ObjectPath );
+    if ( !FoundObject )
+        return nullptr;
+
+    if ( !FoundObject->IsValid() )
+    {
+        // The object has been unloaded since it was resolved.
+        ResolvedObjects.Remove( ObjectPath );
+        return nullptr;
+    }
+
+    return FoundObject->Get();
+}
+
+void
+FHoudiniObjectLoader::OnAsyncLoadCompleted( TArray< FString > ObjectPaths, TArray< FSoftObjectPath > SoftObjectPaths )
+{
+    for ( int32 PathIdx = 0; PathIdx < SoftObjectPaths.Num(); ++PathIdx )
+    {
+        // Paths are recorded as they were referenced, which may differ from their soft object path form.
+        if ( UObject * Object = SoftObjectPaths[ PathIdx ].ResolveObject() )
+            ResolvedObjects.Add( ObjectPaths[ PathIdx ], Object );
+        else
+            HOUDINI_LOG_WARNING( TEXT( "Could not load %s referenced by cook output." ), *ObjectPaths[ PathIdx ] );
+    }
+}
@@ -0,0 +1,71 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+#pragma once
+
+#include "Engine/StreamableManager.h"
+
+class UClass;
+class UObject;
+
+/** Resolves the objects referenced by paths in cook output, such as instance and material overrides. Resolved **/
+/** paths are cached across cooks, and paths which are not loaded yet can be streamed in asynchronously so    **/
+/** that applying the output does not block on disk. All functions must be called from the game thread.       **/
+struct HOUDINIENGINERUNTIME_API FHoudiniObjectLoader
+{
+    public:
+
+        /** Return the object for a path, loading it synchronously if it has not been resolved yet. **/
+        static UObject * LoadObject( const FString & ObjectPath, UClass * ObjectClass, uint32 LoadFlags = LOAD_None );
+
+        /** Stream in all paths which have not been resolved yet. Returns null if every path is already loaded, **/
+        /** otherwise the returned handle keeps the loaded objects alive until it is released.                 **/
+        static TSharedPtr< FStreamableHandle > RequestAsyncLoad( const TArray< FString > & ObjectPaths );
+
+        /** Forget all resolved paths and cancel pending loads. **/
+        static void Reset();
+
+    protected:
+
+        /** Return the cached object for a path, or null if it has not been resolved or has been unloaded. **/
+        static UObject * FindResolvedObject( const FString & ObjectPath );
+
+        /** Record the objects of a completed load. **/
+        static void OnAsyncLoadCompleted( TArray< FString > ObjectPaths, TArray< FSoftObjectPath > SoftObjectPaths );
+
+    protected:
+
+        /** Objects indexed by the path used to reference them. **/
+        static TMap< FString, TWeakObjectPtr< UObject > > ResolvedObjects;
+
+        /** Streamable manager used for asynchronous loads, created on first use. **/
+        static FStreamableManager * StreamableManager;
+};
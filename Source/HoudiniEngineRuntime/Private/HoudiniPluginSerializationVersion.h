@@ -67,6 +67,9 @@ enum EHoudiniPluginSerializationVersion
     VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_GEOMETRY_INPUT_TRANSFORMS = 20,
     VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_ADDED_PARAM_HELP = 21,
     VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_INSTANCE_COLORS = 22,
+    VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_VOLUME_TEXTURES = 23,
+    VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_INSTANCE_CUSTOM_DATA = 24,
+    VER_HOUDINI_PLUGIN_SERIALIZATION_VERSION_OUTPUT_CURVE_LINES = 25,
 
     // -----<new versions can be added before this line>-------------------------------------------------
     // - this needs to be the last line (see note below)
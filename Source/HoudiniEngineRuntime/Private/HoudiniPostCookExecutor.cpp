@@ -0,0 +1,218 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+#include "HoudiniApi.h"
+#include "HoudiniPostCookExecutor.h"
+#include "HoudiniEngineRuntimePrivatePCH.h"
+#include "HoudiniRuntimeSettings.h"
+
+FHoudiniPostCookExecutor::FHoudiniPostCookExecutor()
+    : NextWorkItem( 0 )
+    , PendingWorkItemCount( 0 )
+{}
+
+void
+FHoudiniPostCookExecutor::AddWorkItem( UObject * Owner, TFunction< void() > Work )
+{
+    check( IsInGameThread() );
+
+    if ( !Work )
+        return;
+
+    int32 ItemIdx = INDEX_NONE;
+    if ( ContinuationIndices.Num() > 0 )
+    {
+        // Items queued by an executing item continue it, they are executed before the items queued after it.
+        ItemIdx = ContinuationIndices.Last();
+        WorkItems.InsertDefaulted( ItemIdx );
+
+        for ( int32 & ContinuationIdx : ContinuationIndices )
+        {
+            if ( ContinuationIdx >= ItemIdx )
+                ContinuationIdx++;
+        }
+    }
+    else
+    {
+        ItemIdx = WorkItems.AddDefaulted();
+    }
+
+    FHoudiniPostCookWorkItem & WorkItem = WorkItems[ ItemIdx ];
+    WorkItem.Owner = Owner;
+    WorkItem.Work = MoveTemp( Work );
+
+    PendingWorkItemCount++;
+}
+
+void
+FHoudiniPostCookExecutor::FinishWorkItems( const UObject * Owner )
+{
+    check( IsInGameThread() );
+
+    // Items may queue further items while executing, so the array size is re-read each iteration.
+    for ( int32 ItemIdx = NextWorkItem; ItemIdx < WorkItems.Num(); ++ItemIdx )
+    {
+        if ( !Owner || WorkItems[ ItemIdx ].Owner.Get() == Owner )
+            ExecuteWorkItem( ItemIdx );
+    }
+
+    CompactWorkItems();
+}
+
+void
+FHoudiniPostCookExecutor::CancelWorkItems( const UObject * Owner )
+{
+    for ( int32 ItemIdx = NextWorkItem; ItemIdx < WorkItems.Num(); ++ItemIdx )
+    {
+        FHoudiniPostCookWorkItem & WorkItem = WorkItems[ ItemIdx ];
+        if ( WorkItem.Work && WorkItem.Owner.Get() == Owner )
+        {
+            WorkItem.Work = nullptr;
+            PendingWorkItemCount--;
+        }
+    }
+
+    CompactWorkItems();
+}
+
+bool
+FHoudiniPostCookExecutor::HasWorkItems( const UObject * Owner ) const
+{
+    if ( PendingWorkItemCount == 0 )
+        return false;
+
+    for ( int32 ItemIdx = NextWorkItem; ItemIdx < WorkItems.Num(); ++ItemIdx )
+    {
+        const FHoudiniPostCookWorkItem & WorkItem = WorkItems[ ItemIdx ];
+        if ( WorkItem.Work && WorkItem.Owner.Get() == Owner )
+            return true;
+    }
+
+    return false;
+}
+
+bool
+FHoudiniPostCookExecutor::IsExecutingWorkItem() const
+{
+    return ContinuationIndices.Num() > 0;
+}
+
+int32
+FHoudiniPostCookExecutor::ProcessWorkItems( double BudgetSeconds )
+{
+    check( IsInGameThread() );
+
+    const double StartTime = FPlatformTime::Seconds();
+    int32 ExecutedCount = 0;
+
+    while ( NextWorkItem < WorkItems.Num() )
+    {
+        if ( ExecuteWorkItem( NextWorkItem++ ) )
+            ExecutedCount++;
+
+        if ( ExecutedCount > 0 && ( FPlatformTime::Seconds() - StartTime ) >= BudgetSeconds )
+            break;
+    }
+
+    CompactWorkItems();
+
+    return ExecutedCount;
+}
+
+bool
+FHoudiniPostCookExecutor::ExecuteWorkItem( int32 ItemIdx )
+{
+    // Move the work out, the array may be reallocated if the item queues new items.
+    TFunction< void() > Work = MoveTemp( WorkItems[ ItemIdx ].Work );
+    WorkItems[ ItemIdx ].Work = nullptr;
+    if ( !Work )
+        return false;
+
+    PendingWorkItemCount--;
+
+    if ( !WorkItems[ ItemIdx ].Owner.IsValid() )
+        return false;
+
+    ContinuationIndices.Push( ItemIdx + 1 );
+    Work();
+    ContinuationIndices.Pop( false );
+
+    return true;
+}
+
+void
+FHoudiniPostCookExecutor::CompactWorkItems()
+{
+    // Indices of the executing items must stay valid.
+    if ( PendingWorkItemCount == 0 && ContinuationIndices.Num() == 0 )
+    {
+        WorkItems.Reset();
+        NextWorkItem = 0;
+    }
+}
+
+bool
+FHoudiniPostCookExecutor::IsTickableInEditor() const
+{
+    return true;
+}
+
+bool
+FHoudiniPostCookExecutor::IsTickableWhenPaused() const
+{
+    return true;
+}
+
+void
+FHoudiniPostCookExecutor::Tick( float DeltaTime )
+{
+    double BudgetSeconds = 0.0;
+
+    const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+    if ( HoudiniRuntimeSettings && HoudiniRuntimeSettings->PostCookFrameBudget > 0.0f )
+        BudgetSeconds = HoudiniRuntimeSettings->PostCookFrameBudget / 1000.0;
+    else
+        BudgetSeconds = TNumericLimits< double >::Max();
+
+    ProcessWorkItems( BudgetSeconds );
+}
+
+TStatId
+FHoudiniPostCookExecutor::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT( FHoudiniPostCookExecutor, STATGROUP_Tickables );
+}
+
+bool
+FHoudiniPostCookExecutor::IsTickable() const
+{
+    return PendingWorkItemCount > 0;
+}
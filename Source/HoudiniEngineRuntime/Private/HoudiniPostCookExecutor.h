@@ -0,0 +1,107 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+#pragma once
+
+#include "Tickable.h"
+
+/** A unit of output application work queued after a cook, executed on the game thread. **/
+struct FHoudiniPostCookWorkItem
+{
+    /** Object which queued this item, items of destroyed owners are dropped. **/
+    TWeakObjectPtr< UObject > Owner;
+
+    /** Work to perform, unbound once the item has been executed or cancelled. **/
+    TFunction< void() > Work;
+};
+
+/** Executes the output application work of finished cooks (component creation, instancers, material instances) **/
+/** over several frames. Each frame, items are processed in submission order until the configured time budget  **/
+/** is used. Items queued by an executing item continue it and are executed right after it. Owners can request **/
+/** their pending items to be finished immediately, for instance for batch cooks.                               **/
+class HOUDINIENGINERUNTIME_API FHoudiniPostCookExecutor : public FTickableGameObject
+{
+    public:
+
+        FHoudiniPostCookExecutor();
+
+    public:
+
+        /** Queue a work item for the given owner. **/
+        void AddWorkItem( UObject * Owner, TFunction< void() > Work );
+
+        /** Execute all pending work items of the given owner now, or of all owners if none is given. **/
+        void FinishWorkItems( const UObject * Owner = nullptr );
+
+        /** Drop all pending work items of the given owner without executing them. **/
+        void CancelWorkItems( const UObject * Owner );
+
+        /** Return true if the given owner has pending work items. **/
+        bool HasWorkItems( const UObject * Owner ) const;
+
+        /** Return true while a work item is being executed. **/
+        bool IsExecutingWorkItem() const;
+
+        /** Execute pending work items until the budget (in seconds) is used, at least one item is always executed. **/
+        /** Returns the number of executed items.                                                                    **/
+        int32 ProcessWorkItems( double BudgetSeconds );
+
+    /** FTickableGameObject methods. **/
+    public:
+
+        virtual bool IsTickableInEditor() const override;
+        virtual bool IsTickableWhenPaused() const override;
+        virtual void Tick( float DeltaTime ) override;
+        virtual TStatId GetStatId() const override;
+        virtual bool IsTickable() const override;
+
+    protected:
+
+        /** Execute the item at the given index, if it is still bound and its owner is alive. **/
+        bool ExecuteWorkItem( int32 ItemIdx );
+
+        /** Release executed items once the queue has been drained. **/
+        void CompactWorkItems();
+
+    protected:
+
+        /** Pending work items, in submission order. **/
+        TArray< FHoudiniPostCookWorkItem > WorkItems;
+
+        /** Index of the next item to execute. **/
+        int32 NextWorkItem;
+
+        /** Number of items which are still bound. **/
+        int32 PendingWorkItemCount;
+
+        /** Index at which items queued by each executing item are inserted, innermost item last. **/
+        TArray< int32 > ContinuationIndices;
+};
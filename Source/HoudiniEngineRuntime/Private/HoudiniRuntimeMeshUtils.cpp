@@ -0,0 +1,519 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+
+#include "HoudiniApi.h"
+#include "HoudiniRuntimeMeshUtils.h"
+#include "HoudiniEngineRuntimePrivatePCH.h"
+#include "HoudiniRuntimeSettings.h"
+#include "HoudiniEngineUtils.h"
+#include "HoudiniEngine.h"
+
+#include "Async/TaskGraphInterfaces.h"
+
+FHoudiniRuntimeMeshSection::FHoudiniRuntimeMeshSection()
+    : MaterialId( -1 )
+{}
+
+FHoudiniRuntimeMeshPartData::FHoudiniRuntimeMeshPartData()
+    : PointCount( 0 )
+    , FaceCount( 0 )
+    , ObjectTransform( FTransform::Identity )
+    , GeneratedGeometryScaleFactor( HAPI_UNREAL_SCALE_FACTOR_POSITION )
+    , bSwapYZ( true )
+{
+    FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoNormals );
+    FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoColors );
+    FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoAlpha );
+    FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoUVs );
+    FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoMaterials );
+}
+
+/** Return the value of an attribute for the given wedge, whatever the attribute's owner is. **/
+static float
+GetRuntimeMeshAttributeValue(
+    const HAPI_AttributeInfo & AttribInfo, const TArray< float > & Data,
+    int32 WedgeIdx, int32 PointIdx, int32 TupleIdx, float DefaultValue )
+{
+    if ( !AttribInfo.exists || TupleIdx >= AttribInfo.tupleSize )
+        return DefaultValue;
+
+    int32 ElementIdx = 0;
+    switch ( AttribInfo.owner )
+    {
+        case HAPI_ATTROWNER_VERTEX:
+            ElementIdx = WedgeIdx;
+            break;
+
+        case HAPI_ATTROWNER_POINT:
+            ElementIdx = PointIdx;
+            break;
+
+        case HAPI_ATTROWNER_PRIM:
+            ElementIdx = WedgeIdx / 3;
+            break;
+
+        case HAPI_ATTROWNER_DETAIL:
+            ElementIdx = 0;
+            break;
+
+        default:
+            return DefaultValue;
+    }
+
+    const int32 DataIdx = ElementIdx * AttribInfo.tupleSize + TupleIdx;
+    return Data.IsValidIndex( DataIdx ) ? Data[ DataIdx ] : DefaultValue;
+}
+
+/** Return true if the attribute has the same value for all the wedges of a point. **/
+static bool
+IsRuntimeMeshAttributeSharedByPoints( const HAPI_AttributeInfo & AttribInfo )
+{
+    return !AttribInfo.exists || AttribInfo.owner == HAPI_ATTROWNER_POINT || AttribInfo.owner == HAPI_ATTROWNER_DETAIL;
+}
+
+bool
+FHoudiniRuntimeMeshUtils::HapiGetRuntimeMeshPartData(
+    const FHoudiniGeoPartObject & HoudiniGeoPartObject,
+    FHoudiniRuntimeMeshPartData & OutPartData )
+{
+    check( IsInGameThread() );
+
+    HAPI_PartInfo PartInfo;
+    FMemory::Memzero< HAPI_PartInfo >( PartInfo );
+    if ( !HoudiniGeoPartObject.HapiPartGetInfo( PartInfo ) )
+        return false;
+
+    if ( PartInfo.type != HAPI_PARTTYPE_MESH || PartInfo.faceCount <= 0 )
+        return false;
+
+    // Meshes are triangulated by the cook, every face is expected to have three vertices.
+    if ( PartInfo.vertexCount != PartInfo.faceCount * 3 )
+    {
+        HOUDINI_LOG_MESSAGE(
+            TEXT( "Creating Runtime Mesh: Geo [%d], Part [%d] is not triangulated - skipping." ),
+            HoudiniGeoPartObject.GeoId, HoudiniGeoPartObject.PartId );
+        return false;
+    }
+
+    OutPartData.PointCount = PartInfo.pointCount;
+    OutPartData.FaceCount = PartInfo.faceCount;
+
+    if ( !HoudiniGeoPartObject.HapiGetVertices( OutPartData.VertexList ) )
+        return false;
+
+    // Positions are mandatory.
+    HAPI_AttributeInfo AttribInfoPositions;
+    FMemory::Memzero< HAPI_AttributeInfo >( AttribInfoPositions );
+    if ( !FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+        HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_POSITION, AttribInfoPositions, OutPartData.Positions, 3 ) )
+    {
+        HOUDINI_LOG_MESSAGE(
+            TEXT( "Creating Runtime Mesh: Geo [%d], Part [%d] unable to retrieve position data - skipping." ),
+            HoudiniGeoPartObject.GeoId, HoudiniGeoPartObject.PartId );
+        return false;
+    }
+
+    // The other attributes are optional, their infos are left zeroed when they are missing.
+    FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+        HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_NORMAL, OutPartData.AttribInfoNormals, OutPartData.Normals, 3 );
+    FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+        HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_COLOR, OutPartData.AttribInfoColors, OutPartData.Colors );
+    FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+        HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_ALPHA, OutPartData.AttribInfoAlpha, OutPartData.Alphas, 1 );
+    FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+        HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_UV, OutPartData.AttribInfoUVs, OutPartData.UVs, 2 );
+    FHoudiniEngineUtils::HapiGetAttributeDataAsString(
+        HoudiniGeoPartObject, HAPI_UNREAL_ATTRIB_MATERIAL, OutPartData.AttribInfoMaterials, OutPartData.MaterialPaths, 1 );
+
+    // Houdini materials assigned to the faces.
+    HAPI_Bool bSingleFaceMaterial = false;
+    OutPartData.FaceMaterialIds.SetNumUninitialized( PartInfo.faceCount );
+    if ( FHoudiniApi::GetMaterialNodeIdsOnFaces(
+        FHoudiniEngine::Get().GetSession(), HoudiniGeoPartObject.GeoId, HoudiniGeoPartObject.PartId,
+        &bSingleFaceMaterial, OutPartData.FaceMaterialIds.GetData(), 0, PartInfo.faceCount ) != HAPI_RESULT_SUCCESS )
+    {
+        OutPartData.FaceMaterialIds.Init( -1, 1 );
+    }
+    else if ( bSingleFaceMaterial )
+    {
+        OutPartData.FaceMaterialIds.SetNum( 1 );
+    }
+
+    // Read the settings here, the sections are built on a worker thread.
+    const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+    if ( HoudiniRuntimeSettings )
+    {
+        OutPartData.GeneratedGeometryScaleFactor = HoudiniRuntimeSettings->GeneratedGeometryScaleFactor;
+        OutPartData.bSwapYZ = ( HoudiniRuntimeSettings->ImportAxis == HRSAI_Unreal );
+    }
+
+    return true;
+}
+
+bool
+FHoudiniRuntimeMeshUtils::HapiGetRuntimeMeshPartData(
+    HAPI_NodeId AssetId, TArray< FHoudiniRuntimeMeshPartData > & OutPartData )
+{
+    check( IsInGameThread() );
+
+    TArray< HAPI_ObjectInfo > ObjectInfos;
+    if ( !FHoudiniEngineUtils::HapiGetObjectInfos( AssetId, ObjectInfos ) )
+        return false;
+
+    TArray< HAPI_Transform > ObjectTransforms;
+    if ( !FHoudiniEngineUtils::HapiGetObjectTransforms( AssetId, ObjectTransforms ) )
+        return false;
+
+    for ( int32 ObjectIdx = 0; ObjectIdx < ObjectInfos.Num(); ++ObjectIdx )
+    {
+        const HAPI_ObjectInfo & ObjectInfo = ObjectInfos[ ObjectIdx ];
+
+        // Instancers are not supported by the runtime backend.
+        if ( !ObjectInfo.isVisible || ObjectInfo.isInstancer )
+            continue;
+
+        HAPI_GeoInfo GeoInfo;
+        FMemory::Memzero< HAPI_GeoInfo >( GeoInfo );
+        if ( FHoudiniApi::GetDisplayGeoInfo(
+            FHoudiniEngine::Get().GetSession(), ObjectInfo.nodeId, &GeoInfo ) != HAPI_RESULT_SUCCESS )
+            continue;
+
+        FTransform ObjectTransform = FTransform::Identity;
+        if ( ObjectTransforms.IsValidIndex( ObjectIdx ) )
+            FHoudiniEngineUtils::TranslateHapiTransform( ObjectTransforms[ ObjectIdx ], ObjectTransform );
+
+        for ( int32 PartIdx = 0; PartIdx < GeoInfo.partCount; ++PartIdx )
+        {
+            HAPI_PartInfo PartInfo;
+            FMemory::Memzero< HAPI_PartInfo >( PartInfo );
+            if ( FHoudiniApi::GetPartInfo(
+                FHoudiniEngine::Get().GetSession(), GeoInfo.nodeId, PartIdx, &PartInfo ) != HAPI_RESULT_SUCCESS )
+                continue;
+
+            if ( PartInfo.type != HAPI_PARTTYPE_MESH || PartInfo.isInstanced )
+                continue;
+
+            FHoudiniGeoPartObject HoudiniGeoPartObject( AssetId, ObjectInfo.nodeId, GeoInfo.nodeId, PartInfo.id );
+
+            FHoudiniRuntimeMeshPartData PartData;
+            if ( !HapiGetRuntimeMeshPartData( HoudiniGeoPartObject, PartData ) )
+                continue;
+
+            PartData.ObjectTransform = ObjectTransform;
+            OutPartData.Add( MoveTemp( PartData ) );
+        }
+    }
+
+    return true;
+}
+
+void
+FHoudiniRuntimeMeshUtils::BuildRuntimeMeshSections(
+    const FHoudiniRuntimeMeshPartData & PartData,
+    TArray< FHoudiniRuntimeMeshSection > & OutSections )
+{
+    const int32 FaceCount = PartData.FaceCount;
+    const int32 PointCount = PartData.PointCount;
+    if ( FaceCount <= 0 || PartData.VertexList.Num() < FaceCount * 3 || PartData.Positions.Num() < PointCount * 3 )
+        return;
+
+    // Only primitive and detail material attributes can be used to split the part.
+    const HAPI_AttributeInfo & AttribInfoMaterials = PartData.AttribInfoMaterials;
+    const bool bHasMaterialPaths = AttribInfoMaterials.exists && PartData.MaterialPaths.Num() > 0
+        && ( AttribInfoMaterials.owner == HAPI_ATTROWNER_PRIM || AttribInfoMaterials.owner == HAPI_ATTROWNER_DETAIL );
+    const bool bSingleFaceMaterial = PartData.FaceMaterialIds.Num() < FaceCount;
+
+    // Assign each face to a section, there is one section per material of this part.
+    const int32 FirstSectionIdx = OutSections.Num();
+    TArray< int32 > FaceSections;
+    TArray< int32 > SectionFaceCounts;
+    FaceSections.SetNumUninitialized( FaceCount );
+
+    static const FString NoMaterialPath;
+    int32 LastSectionIdx = INDEX_NONE;
+    for ( int32 FaceIdx = 0; FaceIdx < FaceCount; ++FaceIdx )
+    {
+        HAPI_NodeId MaterialId = -1;
+        if ( PartData.FaceMaterialIds.Num() > 0 )
+            MaterialId = PartData.FaceMaterialIds[ bSingleFaceMaterial ? 0 : FaceIdx ];
+
+        const int32 MaterialPathIdx = AttribInfoMaterials.owner == HAPI_ATTROWNER_PRIM ? FaceIdx : 0;
+        const FString & MaterialPath = ( bHasMaterialPaths && PartData.MaterialPaths.IsValidIndex( MaterialPathIdx ) )
+            ? PartData.MaterialPaths[ MaterialPathIdx ] : NoMaterialPath;
+
+        // Consecutive faces usually share their material.
+        int32 SectionIdx = LastSectionIdx;
+        if ( SectionIdx == INDEX_NONE || OutSections[ SectionIdx ].MaterialId != MaterialId
+            || OutSections[ SectionIdx ].MaterialPath != MaterialPath )
+        {
+            SectionIdx = INDEX_NONE;
+            for ( int32 Idx = FirstSectionIdx; Idx < OutSections.Num(); ++Idx )
+            {
+                if ( OutSections[ Idx ].MaterialId == MaterialId && OutSections[ Idx ].MaterialPath == MaterialPath )
+                {
+                    SectionIdx = Idx;
+                    break;
+                }
+            }
+
+            if ( SectionIdx == INDEX_NONE )
+            {
+                SectionIdx = OutSections.AddDefaulted();
+                OutSections[ SectionIdx ].MaterialId = MaterialId;
+                OutSections[ SectionIdx ].MaterialPath = MaterialPath;
+                SectionFaceCounts.Add( 0 );
+            }
+        }
+
+        FaceSections[ FaceIdx ] = SectionIdx;
+        SectionFaceCounts[ SectionIdx - FirstSectionIdx ]++;
+        LastSectionIdx = SectionIdx;
+    }
+
+    // When no attribute varies per vertex or per primitive, wedges of the same point can share their vertex.
+    const bool bSharePointVertices =
+        IsRuntimeMeshAttributeSharedByPoints( PartData.AttribInfoNormals )
+        && IsRuntimeMeshAttributeSharedByPoints( PartData.AttribInfoColors )
+        && IsRuntimeMeshAttributeSharedByPoints( PartData.AttribInfoAlpha )
+        && IsRuntimeMeshAttributeSharedByPoints( PartData.AttribInfoUVs );
+
+    // Size the buffers once.
+    const int32 PartSectionCount = OutSections.Num() - FirstSectionIdx;
+    TArray< TArray< int32 > > SectionPointVertices;
+    SectionPointVertices.SetNum( bSharePointVertices ? PartSectionCount : 0 );
+    for ( int32 Idx = 0; Idx < PartSectionCount; ++Idx )
+    {
+        const int32 SectionWedgeCount = SectionFaceCounts[ Idx ] * 3;
+
+        FProcMeshSection & Section = OutSections[ FirstSectionIdx + Idx ].Section;
+        Section.ProcIndexBuffer.Reserve( SectionWedgeCount );
+        Section.ProcVertexBuffer.Reserve( bSharePointVertices ? FMath::Min( SectionWedgeCount, PointCount ) : SectionWedgeCount );
+
+        if ( bSharePointVertices )
+            SectionPointVertices[ Idx ].Init( INDEX_NONE, PointCount );
+    }
+
+    // Positions and tangents use the object's transform, normals its inverse transpose so they stay
+    // perpendicular to the surface under non uniform scales.
+    const bool bHasObjectTransform = !PartData.ObjectTransform.Equals( FTransform::Identity );
+    const FMatrix ObjectMatrix = PartData.ObjectTransform.ToMatrixWithScale();
+    const FMatrix NormalMatrix = ObjectMatrix.Inverse().GetTransposed();
+
+    // Swapping Y and Z, or a mirroring transform, requires flipping the winding order as well.
+    const bool bMirrored = bHasObjectTransform && ObjectMatrix.Determinant() < 0.0f;
+    static const int32 FlippedWinding[ 3 ] = { 0, 2, 1 };
+    static const int32 HoudiniWinding[ 3 ] = { 0, 1, 2 };
+    const int32 * Winding = ( PartData.bSwapYZ != bMirrored ) ? FlippedWinding : HoudiniWinding;
+
+    const HAPI_AttributeInfo & AttribInfoNormals = PartData.AttribInfoNormals;
+    const HAPI_AttributeInfo & AttribInfoColors = PartData.AttribInfoColors;
+    const HAPI_AttributeInfo & AttribInfoAlpha = PartData.AttribInfoAlpha;
+    const HAPI_AttributeInfo & AttribInfoUVs = PartData.AttribInfoUVs;
+    const bool bHasAlpha = AttribInfoAlpha.exists || ( AttribInfoColors.exists && AttribInfoColors.tupleSize >= 4 );
+
+    for ( int32 FaceIdx = 0; FaceIdx < FaceCount; ++FaceIdx )
+    {
+        const int32 SectionIdx = FaceSections[ FaceIdx ];
+        FProcMeshSection & Section = OutSections[ SectionIdx ].Section;
+
+        for ( int32 Corner = 0; Corner < 3; ++Corner )
+        {
+            const int32 WedgeIdx = FaceIdx * 3 + Winding[ Corner ];
+            const int32 PointIdx = PartData.VertexList[ WedgeIdx ];
+            if ( PointIdx < 0 || PointIdx >= PointCount )
+                continue;
+
+            if ( bSharePointVertices )
+            {
+                int32 & SharedVertexIdx = SectionPointVertices[ SectionIdx - FirstSectionIdx ][ PointIdx ];
+                if ( SharedVertexIdx != INDEX_NONE )
+                {
+                    Section.ProcIndexBuffer.Add( SharedVertexIdx );
+                    continue;
+                }
+
+                SharedVertexIdx = Section.ProcVertexBuffer.Num();
+            }
+
+            Section.ProcIndexBuffer.Add( Section.ProcVertexBuffer.Num() );
+            FProcMeshVertex & Vertex = Section.ProcVertexBuffer[ Section.ProcVertexBuffer.AddDefaulted() ];
+
+            FVector Position(
+                PartData.Positions[ PointIdx * 3 + 0 ], PartData.Positions[ PointIdx * 3 + 1 ], PartData.Positions[ PointIdx * 3 + 2 ] );
+            if ( PartData.bSwapYZ )
+                Swap( Position.Y, Position.Z );
+            Position *= PartData.GeneratedGeometryScaleFactor;
+            Vertex.Position = bHasObjectTransform ? ObjectMatrix.TransformPosition( Position ) : Position;
+            Section.SectionLocalBox += Vertex.Position;
+
+            if ( AttribInfoNormals.exists )
+            {
+                FVector Normal(
+                    GetRuntimeMeshAttributeValue( AttribInfoNormals, PartData.Normals, WedgeIdx, PointIdx, 0, 0.0f ),
+                    GetRuntimeMeshAttributeValue( AttribInfoNormals, PartData.Normals, WedgeIdx, PointIdx, 1, 0.0f ),
+                    GetRuntimeMeshAttributeValue( AttribInfoNormals, PartData.Normals, WedgeIdx, PointIdx, 2, 1.0f ) );
+                if ( PartData.bSwapYZ )
+                    Swap( Normal.Y, Normal.Z );
+                if ( bHasObjectTransform )
+                    Normal = NormalMatrix.TransformVector( Normal );
+                Normal = Normal.GetSafeNormal( SMALL_NUMBER, FVector::UpVector );
+
+                FVector TangentX, TangentY;
+                Normal.FindBestAxisVectors( TangentX, TangentY );
+                Vertex.Normal = Normal;
+                Vertex.Tangent = FProcMeshTangent( TangentX, false );
+            }
+
+            if ( AttribInfoColors.exists || bHasAlpha )
+            {
+                FLinearColor Color(
+                    FMath::Clamp( GetRuntimeMeshAttributeValue( AttribInfoColors, PartData.Colors, WedgeIdx, PointIdx, 0, 1.0f ), 0.0f, 1.0f ),
+                    FMath::Clamp( GetRuntimeMeshAttributeValue( AttribInfoColors, PartData.Colors, WedgeIdx, PointIdx, 1, 1.0f ), 0.0f, 1.0f ),
+                    FMath::Clamp( GetRuntimeMeshAttributeValue( AttribInfoColors, PartData.Colors, WedgeIdx, PointIdx, 2, 1.0f ), 0.0f, 1.0f ),
+                    1.0f );
+
+                if ( AttribInfoAlpha.exists )
+                    Color.A = FMath::Clamp( GetRuntimeMeshAttributeValue( AttribInfoAlpha, PartData.Alphas, WedgeIdx, PointIdx, 0, 1.0f ), 0.0f, 1.0f );
+                else if ( bHasAlpha )
+                    Color.A = FMath::Clamp( GetRuntimeMeshAttributeValue( AttribInfoColors, PartData.Colors, WedgeIdx, PointIdx, 3, 1.0f ), 0.0f, 1.0f );
+
+                Vertex.Color = Color.ToFColor( false );
+            }
+
+            if ( AttribInfoUVs.exists )
+            {
+                // We need to flip V coordinate when it's coming from HAPI.
+                Vertex.UV0.X = GetRuntimeMeshAttributeValue( AttribInfoUVs, PartData.UVs, WedgeIdx, PointIdx, 0, 0.0f );
+                Vertex.UV0.Y = 1.0f - GetRuntimeMeshAttributeValue( AttribInfoUVs, PartData.UVs, WedgeIdx, PointIdx, 1, 0.0f );
+            }
+        }
+    }
+
+    // Without normals, use the area weighted normals of the faces, positions are already in the asset's space.
+    if ( !AttribInfoNormals.exists )
+    {
+        for ( int32 SectionIdx = FirstSectionIdx; SectionIdx < OutSections.Num(); ++SectionIdx )
+        {
+            FProcMeshSection & Section = OutSections[ SectionIdx ].Section;
+            for ( FProcMeshVertex & Vertex : Section.ProcVertexBuffer )
+                Vertex.Normal = FVector::ZeroVector;
+
+            for ( int32 Idx = 0; Idx + 2 < Section.ProcIndexBuffer.Num(); Idx += 3 )
+            {
+                FProcMeshVertex & Vertex0 = Section.ProcVertexBuffer[ Section.ProcIndexBuffer[ Idx + 0 ] ];
+                FProcMeshVertex & Vertex1 = Section.ProcVertexBuffer[ Section.ProcIndexBuffer[ Idx + 1 ] ];
+                FProcMeshVertex & Vertex2 = Section.ProcVertexBuffer[ Section.ProcIndexBuffer[ Idx + 2 ] ];
+
+                const FVector FaceNormal =
+                    ( Vertex2.Position - Vertex0.Position ) ^ ( Vertex1.Position - Vertex0.Position );
+                Vertex0.Normal += FaceNormal;
+                Vertex1.Normal += FaceNormal;
+                Vertex2.Normal += FaceNormal;
+            }
+
+            for ( FProcMeshVertex & Vertex : Section.ProcVertexBuffer )
+            {
+                Vertex.Normal = Vertex.Normal.GetSafeNormal( SMALL_NUMBER, FVector::UpVector );
+
+                FVector TangentX, TangentY;
+                Vertex.Normal.FindBestAxisVectors( TangentX, TangentY );
+                Vertex.Tangent = FProcMeshTangent( TangentX, false );
+            }
+        }
+    }
+}
+
+void
+FHoudiniRuntimeMeshUtils::ApplyRuntimeMeshSections(
+    UProceduralMeshComponent * ProceduralMeshComponent,
+    const TArray< FHoudiniRuntimeMeshSection > & Sections, bool bCreateCollision )
+{
+    check( IsInGameThread() );
+
+    if ( !ProceduralMeshComponent || ProceduralMeshComponent->IsPendingKill() )
+        return;
+
+    // Collision is cooked on a worker thread and swapped in once ready.
+    ProceduralMeshComponent->bUseAsyncCooking = true;
+    ProceduralMeshComponent->ClearAllMeshSections();
+
+    UMaterialInterface * DefaultMaterial = FHoudiniEngine::Get().GetHoudiniDefaultMaterial().Get();
+    for ( int32 SectionIdx = 0; SectionIdx < Sections.Num(); ++SectionIdx )
+    {
+        const FHoudiniRuntimeMeshSection & RuntimeMeshSection = Sections[ SectionIdx ];
+
+        FProcMeshSection Section = RuntimeMeshSection.Section;
+        Section.bEnableCollision = bCreateCollision;
+        ProceduralMeshComponent->SetProcMeshSection( SectionIdx, Section );
+
+        // Houdini materials are generated by the editor only, use the default material for those.
+        UMaterialInterface * Material = nullptr;
+        if ( !RuntimeMeshSection.MaterialPath.IsEmpty() )
+        {
+            Material = Cast< UMaterialInterface >( StaticLoadObject(
+                UMaterialInterface::StaticClass(), nullptr, *RuntimeMeshSection.MaterialPath, nullptr, LOAD_NoWarn, nullptr ) );
+        }
+
+        ProceduralMeshComponent->SetMaterial( SectionIdx, Material ? Material : DefaultMaterial );
+    }
+}
+
+void
+FHoudiniRuntimeMeshUtils::CreateRuntimeMeshAsync(
+    HAPI_NodeId AssetId, UProceduralMeshComponent * ProceduralMeshComponent, bool bCreateCollision )
+{
+    check( IsInGameThread() );
+
+    // HAPI is only called here, on the game thread.
+    TSharedRef< TArray< FHoudiniRuntimeMeshPartData >, ESPMode::ThreadSafe > PartData =
+        MakeShareable( new TArray< FHoudiniRuntimeMeshPartData >() );
+    if ( !FHoudiniRuntimeMeshUtils::HapiGetRuntimeMeshPartData( AssetId, PartData.Get() ) )
+        return;
+
+    TWeakObjectPtr< UProceduralMeshComponent > WeakComponent( ProceduralMeshComponent );
+    FFunctionGraphTask::CreateAndDispatchWhenReady( [ = ]()
+    {
+        TSharedRef< TArray< FHoudiniRuntimeMeshSection >, ESPMode::ThreadSafe > Sections =
+            MakeShareable( new TArray< FHoudiniRuntimeMeshSection >() );
+
+        for ( const FHoudiniRuntimeMeshPartData & Part : PartData.Get() )
+            FHoudiniRuntimeMeshUtils::BuildRuntimeMeshSections( Part, Sections.Get() );
+
+        FFunctionGraphTask::CreateAndDispatchWhenReady( [ = ]()
+        {
+            if ( WeakComponent.IsValid() )
+                FHoudiniRuntimeMeshUtils::ApplyRuntimeMeshSections( WeakComponent.Get(), Sections.Get(), bCreateCollision );
+        }
+        , TStatId(), nullptr, ENamedThreads::GameThread );
+    }
+    , TStatId(), nullptr, ENamedThreads::AnyThread );
+}
@@ -0,0 +1,118 @@
+/*
+* Copyright (c) <2017> Side Effects Software Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Produced by:
+*      Mykola Konyk
+*      Side Effects Software Inc
+*      123 Front Street West, Suite 1401
+*      Toronto, Ontario
+*      Canada   M5J 2M2
+*      416-504-9876
+*
+*/
+
+
+#pragma once
+
+#include "HoudiniApi.h"
+#include "HoudiniGeoPartObject.h"
+#include "ProceduralMeshComponent.h"
+
+/** Render ready geometry of a mesh part, extracted without any editor only data. **/
+struct HOUDINIENGINERUNTIME_API FHoudiniRuntimeMeshSection
+{
+    FHoudiniRuntimeMeshSection();
+
+    /** Interleaved vertex and index buffers, in the layout used by procedural mesh components. **/
+    FProcMeshSection Section;
+
+    /** Material assigned with the unreal_material attribute, empty if there is none. **/
+    FString MaterialPath;
+
+    /** Houdini material assigned to the faces of this section, -1 if there is none. **/
+    HAPI_NodeId MaterialId;
+};
+
+/** Geometry of a mesh part as returned by HAPI, converted to sections without any further HAPI call. **/
+struct HOUDINIENGINERUNTIME_API FHoudiniRuntimeMeshPartData
+{
+    FHoudiniRuntimeMeshPartData();
+
+    int32 PointCount;
+    int32 FaceCount;
+
+    /** Point index of each vertex, three per face. **/
+    TArray< int32 > VertexList;
+
+    /** Attribute values, with their zeroed infos when the attribute is missing. **/
+    TArray< float > Positions;
+    TArray< float > Normals;
+    TArray< float > Colors;
+    TArray< float > Alphas;
+    TArray< float > UVs;
+    TArray< FString > MaterialPaths;
+    HAPI_AttributeInfo AttribInfoNormals;
+    HAPI_AttributeInfo AttribInfoColors;
+    HAPI_AttributeInfo AttribInfoAlpha;
+    HAPI_AttributeInfo AttribInfoUVs;
+    HAPI_AttributeInfo AttribInfoMaterials;
+
+    /** Houdini material of each face, a single entry if the part has only one material. **/
+    TArray< HAPI_NodeId > FaceMaterialIds;
+
+    /** Transform of the part's object, in the asset's space. **/
+    FTransform ObjectTransform;
+
+    /** Runtime settings, read on the game thread along with the geometry. **/
+    float GeneratedGeometryScaleFactor;
+    bool bSwapYZ;
+};
+
+struct HOUDINIENGINERUNTIME_API FHoudiniRuntimeMeshUtils
+{
+    public:
+
+        // Reads the geometry of a mesh part. HAPI sessions are not thread safe, this must be called on the game thread.
+        static bool HapiGetRuntimeMeshPartData(
+            const FHoudiniGeoPartObject & HoudiniGeoPartObject,
+            FHoudiniRuntimeMeshPartData & OutPartData );
+
+        // Reads the geometry of all the visible mesh parts of an asset. This must be called on the game thread.
+        static bool HapiGetRuntimeMeshPartData(
+            HAPI_NodeId AssetId, TArray< FHoudiniRuntimeMeshPartData > & OutPartData );
+
+        // Converts the geometry of a part to sections, one per material, in the asset's space.
+        // This only uses plain data, so it can be called from a worker thread.
+        static void BuildRuntimeMeshSections(
+            const FHoudiniRuntimeMeshPartData & PartData,
+            TArray< FHoudiniRuntimeMeshSection > & OutSections );
+
+        // Replaces the sections of a procedural mesh component, this must be called on the game thread.
+        // Collision is cooked asynchronously when requested.
+        static void ApplyRuntimeMeshSections(
+            UProceduralMeshComponent * ProceduralMeshComponent,
+            const TArray< FHoudiniRuntimeMeshSection > & Sections, bool bCreateCollision );
+
+        // Reads the geometry of an asset on the game thread, builds the sections on a worker thread,
+        // then applies them to the component back on the game thread.
+        static void CreateRuntimeMeshAsync(
+            HAPI_NodeId AssetId, UProceduralMeshComponent * ProceduralMeshComponent, bool bCreateCollision );
+};
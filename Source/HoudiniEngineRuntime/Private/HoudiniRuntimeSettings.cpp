@@ -57,6 +57,12 @@ UHoudiniRuntimeSettings::UHoudiniRuntimeSettings( const FObjectInitializer & Obj
     bTransformChangeTriggersCooks = false;
     bDisplaySlateCookingNotifications = true;
     bCookCurvesOnMouseRelease = false;
+    bShareIdenticalCooks = false;
+    bPrefetchCookOutput = true;
+    PostCookFrameBudget = 5.0f;
+    bAsyncLoadReferencedObjects = true;
+    MaxCookedTextureResolution = 0;
+    CurveLineBatchThreshold = 100;
 
     TemporaryCookFolder = LOCTEXT("Temp", "/Game/HoudiniEngine/Temp");
 
@@ -85,6 +91,9 @@ UHoudiniRuntimeSettings::UHoudiniRuntimeSettings( const FObjectInitializer & Obj
     MarshallingLandscapesForceMinMaxValues = false;
     MarshallingLandscapesForcedMinValue = -2000.0f;
     MarshallingLandscapesForcedMaxValue = 4553.0f;
+    MarshallingVolumesAsTextures = true;
+    MarshallingVolumeTexturesDownsampling = 1;
+    MarshallingVolumeTexturesUseHalfFloat = true;
 
     /** Geometry scaling. **/
     GeneratedGeometryScaleFactor = HAPI_UNREAL_SCALE_FACTOR_POSITION;
@@ -90,7 +90,11 @@ enum class EHoudiniToolType : uint8
     HTOOLTYPE_OPERATOR_MULTI UMETA( DisplayName = "Operator (multiple)" ),
 
     // For tools that needs to be applied each time for each single selected
-    HTOOLTYPE_OPERATOR_BATCH UMETA( DisplayName = "Batch Operator" )
+    HTOOLTYPE_OPERATOR_BATCH UMETA( DisplayName = "Batch Operator" ),
+
+    // For batch tools that can process all the selected objects in a single cook,
+    // each selected object is packed in the first input and its output is split back into its own mesh component
+    HTOOLTYPE_OPERATOR_BATCH_MERGED UMETA( DisplayName = "Batch Operator (merged)" )
 };
 
 USTRUCT( BlueprintType )
@@ -231,6 +235,32 @@ class HOUDINIENGINERUNTIME_API UHoudiniRuntimeSettings : public UObject
         UPROPERTY(GlobalConfig, EditAnywhere, Category = Cooking)
         bool bCookCurvesOnMouseRelease;
 
+        // Houdini Assets with identical asset, parameters and inputs will share a single cook and its output.
+        // Off by default: a shared asset gets its own node again, and cooks, once it is edited.
+        UPROPERTY( GlobalConfig, EditAnywhere, Category = Cooking )
+        bool bShareIdenticalCooks;
+
+        // Cook output is fetched from Houdini Engine on the background thread as soon as a cook finishes.
+        UPROPERTY( GlobalConfig, EditAnywhere, Category = Cooking )
+        bool bPrefetchCookOutput;
+
+        // Time in milliseconds spent each frame applying cook output (components, instancers, material instances). Zero applies it all at once.
+        UPROPERTY( GlobalConfig, EditAnywhere, Category = Cooking, meta = ( ClampMin = "0.0", UIMin = "0.0", UIMax = "33.0" ) )
+        float PostCookFrameBudget;
+
+        // Objects referenced by instance and material override attributes are streamed in before the cook output is applied.
+        // Requires cook output prefetching, the referenced paths are gathered on the background thread.
+        UPROPERTY( GlobalConfig, EditAnywhere, Category = Cooking )
+        bool bAsyncLoadReferencedObjects;
+
+        // Maximum resolution of the textures extracted from Houdini while cooking, larger images are downsampled by Houdini. Baking uses the full resolution. Zero disables the limit.
+        UPROPERTY( GlobalConfig, EditAnywhere, Category = Cooking, meta = ( ClampMin = "0", UIMin = "0", UIMax = "8192" ) )
+        int32 MaxCookedTextureResolution;
+
+        // Assets outputting more non-editable curves than this draw them with a single line batch component, instead of a spline component per curve. Zero always uses spline components.
+        UPROPERTY( GlobalConfig, EditAnywhere, Category = Cooking, meta = ( ClampMin = "0", UIMin = "0", UIMax = "10000" ) )
+        int32 CurveLineBatchThreshold;
+
         // Content folder storing all the temporary cook data
         UPROPERTY(GlobalConfig, EditAnywhere, Category = Cooking)
         FText TemporaryCookFolder;
@@ -326,6 +356,16 @@ class HOUDINIENGINERUNTIME_API UHoudiniRuntimeSettings : public UObject
         UPROPERTY(GlobalConfig, EditAnywhere, Category = GeometryMarshalling)
         float MarshallingLandscapesForcedMaxValue;
 
+        // If true, volumes that are not heightfields (fog, SDFs, velocity fields) are imported as 2D textures laying out their slices in a grid.
+        UPROPERTY( GlobalConfig, EditAnywhere, Category = GeometryMarshalling )
+        bool MarshallingVolumesAsTextures;
+        // Only one voxel out of this number is kept along each axis when creating volume textures.
+        UPROPERTY( GlobalConfig, EditAnywhere, Category = GeometryMarshalling, meta = ( ClampMin = "1", UIMin = "1", UIMax = "8" ) )
+        int32 MarshallingVolumeTexturesDownsampling;
+        // If true, volume textures store their voxels as half floats, otherwise they are normalized to 8 bits.
+        UPROPERTY( GlobalConfig, EditAnywhere, Category = GeometryMarshalling )
+        bool MarshallingVolumeTexturesUseHalfFloat;
+
     /** Geometry scaling. **/
     public:
 
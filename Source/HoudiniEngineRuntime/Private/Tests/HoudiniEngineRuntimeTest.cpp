@@ -21,6 +21,11 @@
 #include "HoudiniAssetComponent.h"
 #include "HoudiniEngineRuntimeTest.h"
 #include "HoudiniAssetParameterInt.h"
+#include "HoudiniEngineScheduler.h"
+#include "HoudiniAssetInstanceInput.h"
+#include "HoudiniApiRecorder.h"
+#include "HoudiniRuntimeMeshUtils.h"
+#include "HoudiniCookCache.h"
 
 
 DEFINE_LOG_CATEGORY_STATIC( LogHoudiniTests, Log, All );
@@ -32,6 +37,14 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeUploadStaticMeshTest, "Ho
 IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeActorTest, "Houdini.Runtime.ActorTest", kTestFlags )
 IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeParamTest, "Houdini.Runtime.ParamTest", kTestFlags )
 IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeBatchTest, "Houdini.Runtime.BatchTest", kTestFlags )
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeApiReplayTest, "Houdini.Runtime.ApiReplayTest", kTestFlags )
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeMeshSectionsTest, "Houdini.Runtime.RuntimeMeshSectionsTest", kTestFlags )
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeCookCacheTest, "Houdini.Runtime.CookCacheTest", kTestFlags )
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeSchedulerStressTest, "Houdini.Runtime.SchedulerStressTest", kTestFlags )
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeSchedulerBenchmark, "Houdini.Runtime.SchedulerBenchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter )
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FHoudiniEngineRuntimeInstancePartitionBenchmark, "Houdini.Runtime.InstancePartitionBenchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter )
 
 static float TestTickDelay = 1.0f;
 
@@ -759,4 +772,821 @@ bool FHoudiniEngineRuntimeMeshMarshalTest::RunTest( const FString& Parameters )
     return true;
 }
 
-#endif // WITH_EDITOR
\ No newline at end of file
+bool FHoudiniEngineRuntimeApiReplayTest::RunTest( const FString& Parameters )
+{
+    // Calls on this session are replayed, the editor session keeps talking to libHAPI.
+    HAPI_Session ReplaySession;
+    ReplaySession.type = HAPI_SESSION_INPROCESS;
+    ReplaySession.id = 0x7e57;
+
+    static const HAPI_NodeId NodeId = 7;
+    static const HAPI_PartId PartId = 0;
+    const char * AttribName = HAPI_UNREAL_ATTRIB_COLOR;
+
+    // Point and primitive attributes share the name, they must be replayed separately.
+    HAPI_AttributeInfo PointAttribInfo;
+    FMemory::Memzero< HAPI_AttributeInfo >( PointAttribInfo );
+    PointAttribInfo.exists = true;
+    PointAttribInfo.owner = HAPI_ATTROWNER_POINT;
+    PointAttribInfo.storage = HAPI_STORAGETYPE_FLOAT;
+    PointAttribInfo.count = 2;
+    PointAttribInfo.tupleSize = 3;
+
+    HAPI_AttributeInfo PrimAttribInfo = PointAttribInfo;
+    PrimAttribInfo.owner = HAPI_ATTROWNER_PRIM;
+    PrimAttribInfo.count = 1;
+
+    const float PointColors[] = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    const float PrimColors[] = { 0.0f, 0.0f, 1.0f };
+    const int ParmValues[] = { 5, 9 };
+
+    TArray< FHoudiniApiCallRecord > Records;
+
+    auto AddAttributeRecord = [ & ]( const HAPI_AttributeInfo & AttribInfo, const float * Data )
+    {
+        FHoudiniApiCallRecord & Record = Records[ Records.AddDefaulted() ];
+        Record.Function = EHoudiniApiRecordedFunction::GetAttributeFloatData;
+        Record.AddArgument( NodeId );
+        Record.AddArgument( PartId );
+        Record.AddArgument( AttribName );
+        Record.AddArgument( -1 );
+        Record.AddArgument( 0 );
+        Record.AddArgument( AttribInfo.count );
+        Record.AddArgument( AttribInfo.owner );
+        Record.AddArgument( AttribInfo.tupleSize );
+        Record.Result = HAPI_RESULT_SUCCESS;
+        Record.AddOutput( &AttribInfo, 1 );
+        Record.AddOutput( Data, AttribInfo.count * AttribInfo.tupleSize );
+    };
+
+    AddAttributeRecord( PointAttribInfo, PointColors );
+    AddAttributeRecord( PrimAttribInfo, PrimColors );
+
+    {
+        FHoudiniApiCallRecord & Record = Records[ Records.AddDefaulted() ];
+        Record.Function = EHoudiniApiRecordedFunction::GetParmIntValues;
+        Record.AddArgument( NodeId );
+        Record.AddArgument( 0 );
+        Record.AddArgument( 2 );
+        Record.Result = HAPI_RESULT_SUCCESS;
+        Record.AddOutput( ParmValues, 2 );
+    }
+
+    const FString RecordingPath = FPaths::AutomationTransientDir() / TEXT( "HoudiniApiReplayTest.hapirec" );
+    TestTrue( TEXT( "Recording saved" ), FHoudiniApiRecorder::SaveRecording( RecordingPath, Records ) );
+
+    FHoudiniApi::GetStatusFuncPtr GetStatusOld = FHoudiniApi::GetStatus;
+
+    if ( !TestTrue( TEXT( "Replay started" ), FHoudiniApiRecorder::StartReplay( RecordingPath, &ReplaySession ) ) )
+        return false;
+
+    // Session entries are answered without libHAPI.
+    TestTrue( TEXT( "HAPI reported as initialized" ), FHoudiniApi::IsHAPIInitialized() );
+    TestEqual( TEXT( "Replayed session is initialized" ), (int32) FHoudiniApi::IsInitialized( &ReplaySession ), (int32) HAPI_RESULT_SUCCESS );
+    TestEqual( TEXT( "Replayed session is valid" ), (int32) FHoudiniApi::IsSessionValid( &ReplaySession ), (int32) HAPI_RESULT_SUCCESS );
+    TestEqual( TEXT( "Replayed session cleans up" ), (int32) FHoudiniApi::Cleanup( &ReplaySession ), (int32) HAPI_RESULT_SUCCESS );
+
+    // Attributes are matched by owner.
+    float ReplayedPointColors[ 6 ] = { 0.0f };
+    float ReplayedPrimColors[ 3 ] = { 0.0f };
+
+    HAPI_AttributeInfo QueryInfo = PointAttribInfo;
+    QueryInfo.exists = false;
+    TestEqual( TEXT( "Point colors replayed" ), (int32) FHoudiniApi::GetAttributeFloatData(
+        &ReplaySession, NodeId, PartId, AttribName, &QueryInfo, -1, ReplayedPointColors, 0, PointAttribInfo.count ),
+        (int32) HAPI_RESULT_SUCCESS );
+    TestTrue( TEXT( "Point attribute info replayed" ), QueryInfo.exists && QueryInfo.owner == HAPI_ATTROWNER_POINT );
+
+    QueryInfo = PrimAttribInfo;
+    QueryInfo.exists = false;
+    TestEqual( TEXT( "Primitive colors replayed" ), (int32) FHoudiniApi::GetAttributeFloatData(
+        &ReplaySession, NodeId, PartId, AttribName, &QueryInfo, -1, ReplayedPrimColors, 0, PrimAttribInfo.count ),
+        (int32) HAPI_RESULT_SUCCESS );
+
+    TestTrue( TEXT( "Point colors match" ), FMemory::Memcmp( ReplayedPointColors, PointColors, sizeof( PointColors ) ) == 0 );
+    TestTrue( TEXT( "Primitive colors match" ), FMemory::Memcmp( ReplayedPrimColors, PrimColors, sizeof( PrimColors ) ) == 0 );
+
+    // Parameters are replayed.
+    int ReplayedParmValues[ 2 ] = { 0, 0 };
+    TestEqual( TEXT( "Parameter values replayed" ),
+        (int32) FHoudiniApi::GetParmIntValues( &ReplaySession, NodeId, ReplayedParmValues, 0, 2 ), (int32) HAPI_RESULT_SUCCESS );
+    TestTrue( TEXT( "Parameter values match" ), ReplayedParmValues[ 0 ] == ParmValues[ 0 ] && ReplayedParmValues[ 1 ] == ParmValues[ 1 ] );
+
+    // Calls which were not recorded fail instead of reaching libHAPI.
+    HAPI_PartInfo PartInfo;
+    TestEqual( TEXT( "Unrecorded call fails" ),
+        (int32) FHoudiniApi::GetPartInfo( &ReplaySession, NodeId, PartId, &PartInfo ), (int32) HAPI_RESULT_FAILURE );
+    TestEqual( TEXT( "Replay misses" ), FHoudiniApiRecorder::GetReplayMissCount(), 1 );
+
+    FHoudiniApiRecorder::StopReplay();
+
+    TestTrue( TEXT( "HAPI table restored" ), FHoudiniApi::GetStatus == GetStatusOld );
+    IFileManager::Get().Delete( *RecordingPath );
+
+    return true;
+}
+
+/** Fake HAPI backend for scheduler tests. Cooks take a configurable time to complete and every cook and delete  **/
+/** request reaching HAPI is logged, so that the order in which the scheduler processed tasks can be verified.   **/
+/** Only calls made on the fake session are served, others are forwarded. The engine scheduler thread is        **/
+/** suspended while the fake is installed, so that no other thread reads the HAPI table while it is patched.    **/
+struct FFakeHapiBackend
+{
+    struct FCall
+    {
+        HAPI_NodeId NodeId;
+        EHoudiniEngineTaskType::Type TaskType;
+        double Time;
+    };
+
+    FFakeHapiBackend( double InCookLatency )
+    {
+        FScopeLock ScopeLock( &CriticalSection );
+        CookLatency = InCookLatency;
+        CookStartTime = 0.0;
+        Calls.Empty();
+        DeletedNodes.Empty();
+
+        if ( FHoudiniEngine::IsInitialized() )
+            FHoudiniEngine::Get().SuspendScheduler();
+
+        IsInitializedOld = FHoudiniApi::IsInitialized;
+        CookNodeOld = FHoudiniApi::CookNode;
+        GetStatusOld = FHoudiniApi::GetStatus;
+        GetStatusStringBufLengthOld = FHoudiniApi::GetStatusStringBufLength;
+        GetStatusStringOld = FHoudiniApi::GetStatusString;
+        GetNodeInfoOld = FHoudiniApi::GetNodeInfo;
+        IsNodeValidOld = FHoudiniApi::IsNodeValid;
+        DeleteNodeOld = FHoudiniApi::DeleteNode;
+
+        FHoudiniApi::IsInitialized = &IsInitialized;
+        FHoudiniApi::CookNode = &CookNode;
+        FHoudiniApi::GetStatus = &GetStatus;
+        FHoudiniApi::GetStatusStringBufLength = &GetStatusStringBufLength;
+        FHoudiniApi::GetStatusString = &GetStatusString;
+        FHoudiniApi::GetNodeInfo = &GetNodeInfo;
+        FHoudiniApi::IsNodeValid = &IsNodeValid;
+        FHoudiniApi::DeleteNode = &DeleteNode;
+    }
+
+    ~FFakeHapiBackend()
+    {
+        FHoudiniApi::IsInitialized = IsInitializedOld;
+        FHoudiniApi::CookNode = CookNodeOld;
+        FHoudiniApi::GetStatus = GetStatusOld;
+        FHoudiniApi::GetStatusStringBufLength = GetStatusStringBufLengthOld;
+        FHoudiniApi::GetStatusString = GetStatusStringOld;
+        FHoudiniApi::GetNodeInfo = GetNodeInfoOld;
+        FHoudiniApi::IsNodeValid = IsNodeValidOld;
+        FHoudiniApi::DeleteNode = DeleteNodeOld;
+
+        if ( FHoudiniEngine::IsInitialized() )
+            FHoudiniEngine::Get().ResumeScheduler();
+    }
+
+    int32 GetCallCount() const
+    {
+        FScopeLock ScopeLock( &CriticalSection );
+        return Calls.Num();
+    }
+
+    TArray< FCall > GetCalls() const
+    {
+        FScopeLock ScopeLock( &CriticalSection );
+        return Calls;
+    }
+
+    static bool IsFakeSession( const HAPI_Session * session )
+    {
+        return session && session->type == Session.type && session->id == Session.id;
+    }
+
+    static HAPI_Result IsInitialized( const HAPI_Session * session )
+    {
+        if ( !IsFakeSession( session ) )
+            return IsInitializedOld( session );
+
+        return HAPI_RESULT_SUCCESS;
+    }
+
+    static HAPI_Result CookNode( const HAPI_Session * session, HAPI_NodeId node_id, const HAPI_CookOptions * cook_options )
+    {
+        if ( !IsFakeSession( session ) )
+            return CookNodeOld( session, node_id, cook_options );
+
+        FScopeLock ScopeLock( &CriticalSection );
+        Calls.Add( { node_id, EHoudiniEngineTaskType::AssetCooking, FPlatformTime::Seconds() } );
+
+        if ( DeletedNodes.Contains( node_id ) )
+            return HAPI_RESULT_INVALID_ARGUMENT;
+
+        CookStartTime = FPlatformTime::Seconds();
+        return HAPI_RESULT_SUCCESS;
+    }
+
+    static HAPI_Result GetStatus( const HAPI_Session * session, HAPI_StatusType status_type, int * status )
+    {
+        if ( !IsFakeSession( session ) )
+            return GetStatusOld( session, status_type, status );
+
+        FScopeLock ScopeLock( &CriticalSection );
+        if ( status_type != HAPI_STATUS_COOK_STATE )
+            *status = HAPI_RESULT_SUCCESS;
+        else if ( FPlatformTime::Seconds() - CookStartTime >= CookLatency )
+            *status = HAPI_STATE_READY;
+        else
+            *status = HAPI_STATE_COOKING;
+
+        return HAPI_RESULT_SUCCESS;
+    }
+
+    static HAPI_Result GetStatusStringBufLength(
+        const HAPI_Session * session, HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity, int * buffer_length )
+    {
+        if ( !IsFakeSession( session ) )
+            return GetStatusStringBufLengthOld( session, status_type, verbosity, buffer_length );
+
+        *buffer_length = 0;
+        return HAPI_RESULT_SUCCESS;
+    }
+
+    static HAPI_Result GetStatusString( const HAPI_Session * session, HAPI_StatusType status_type, char * string_value, int length )
+    {
+        if ( !IsFakeSession( session ) )
+            return GetStatusStringOld( session, status_type, string_value, length );
+
+        return HAPI_RESULT_SUCCESS;
+    }
+
+    static HAPI_Result GetNodeInfo( const HAPI_Session * session, HAPI_NodeId node_id, HAPI_NodeInfo * node_info )
+    {
+        if ( !IsFakeSession( session ) )
+            return GetNodeInfoOld( session, node_id, node_info );
+
+        FScopeLock ScopeLock( &CriticalSection );
+        if ( DeletedNodes.Contains( node_id ) )
+            return HAPI_RESULT_INVALID_ARGUMENT;
+
+        FMemory::Memzero( *node_info );
+        node_info->id = node_id;
+        node_info->uniqueHoudiniNodeId = node_id;
+        return HAPI_RESULT_SUCCESS;
+    }
+
+    static HAPI_Result IsNodeValid( const HAPI_Session * session, HAPI_NodeId node_id, int unique_node_id, HAPI_Bool * answer )
+    {
+        if ( !IsFakeSession( session ) )
+            return IsNodeValidOld( session, node_id, unique_node_id, answer );
+
+        FScopeLock ScopeLock( &CriticalSection );
+        *answer = !DeletedNodes.Contains( node_id );
+        return HAPI_RESULT_SUCCESS;
+    }
+
+    static HAPI_Result DeleteNode( const HAPI_Session * session, HAPI_NodeId node_id )
+    {
+        if ( !IsFakeSession( session ) )
+            return DeleteNodeOld( session, node_id );
+
+        FScopeLock ScopeLock( &CriticalSection );
+        Calls.Add( { node_id, EHoudiniEngineTaskType::AssetDeletion, FPlatformTime::Seconds() } );
+
+        DeletedNodes.Add( node_id );
+        return HAPI_RESULT_SUCCESS;
+    }
+
+    static const HAPI_Session Session;
+    static FCriticalSection CriticalSection;
+    static double CookLatency;
+    static double CookStartTime;
+    static TArray< FCall > Calls;
+    static TSet< HAPI_NodeId > DeletedNodes;
+
+    static FHoudiniApi::IsInitializedFuncPtr IsInitializedOld;
+    static FHoudiniApi::CookNodeFuncPtr CookNodeOld;
+    static FHoudiniApi::GetStatusFuncPtr GetStatusOld;
+    static FHoudiniApi::GetStatusStringBufLengthFuncPtr GetStatusStringBufLengthOld;
+    static FHoudiniApi::GetStatusStringFuncPtr GetStatusStringOld;
+    static FHoudiniApi::GetNodeInfoFuncPtr GetNodeInfoOld;
+    static FHoudiniApi::IsNodeValidFuncPtr IsNodeValidOld;
+    static FHoudiniApi::DeleteNodeFuncPtr DeleteNodeOld;
+};
+
+const HAPI_Session FFakeHapiBackend::Session = { HAPI_SESSION_INPROCESS, 0x5c4ed };
+FCriticalSection FFakeHapiBackend::CriticalSection;
+double FFakeHapiBackend::CookLatency = 0.0;
+double FFakeHapiBackend::CookStartTime = 0.0;
+TArray< FFakeHapiBackend::FCall > FFakeHapiBackend::Calls;
+TSet< HAPI_NodeId > FFakeHapiBackend::DeletedNodes;
+FHoudiniApi::IsInitializedFuncPtr FFakeHapiBackend::IsInitializedOld = nullptr;
+FHoudiniApi::CookNodeFuncPtr FFakeHapiBackend::CookNodeOld = nullptr;
+FHoudiniApi::GetStatusFuncPtr FFakeHapiBackend::GetStatusOld = nullptr;
+FHoudiniApi::GetStatusStringBufLengthFuncPtr FFakeHapiBackend::GetStatusStringBufLengthOld = nullptr;
+FHoudiniApi::GetStatusStringFuncPtr FFakeHapiBackend::GetStatusStringOld = nullptr;
+FHoudiniApi::GetNodeInfoFuncPtr FFakeHapiBackend::GetNodeInfoOld = nullptr;
+FHoudiniApi::IsNodeValidFuncPtr FFakeHapiBackend::IsNodeValidOld = nullptr;
+FHoudiniApi::DeleteNodeFuncPtr FFakeHapiBackend::DeleteNodeOld = nullptr;
+
+/** Drives a private scheduler instance and its thread against the fake backend, on the fake session. **/
+struct FSchedulerTestHarness
+{
+    struct FSubmittedTask
+    {
+        FGuid HapiGUID;
+        HAPI_NodeId NodeId;
+        EHoudiniEngineTaskType::Type TaskType;
+        double Time;
+    };
+
+    FSchedulerTestHarness( double CookLatency, bool bStartThread = true )
+        : Backend( CookLatency )
+        , Scheduler( &FFakeHapiBackend::Session )
+        , Thread( nullptr )
+    {
+        if ( bStartThread )
+            StartThread();
+    }
+
+    ~FSchedulerTestHarness()
+    {
+        Scheduler.Stop();
+        if ( Thread )
+        {
+            Thread->WaitForCompletion();
+            delete Thread;
+        }
+
+        for ( const FSubmittedTask & SubmittedTask : Submitted )
+            FHoudiniEngine::Get().RemoveTaskInfo( SubmittedTask.HapiGUID );
+    }
+
+    void StartThread()
+    {
+        Thread = FRunnableThread::Create( &Scheduler, TEXT( "HoudiniTestScheduler" ), 0, TPri_Normal );
+    }
+
+    void Submit( EHoudiniEngineTaskType::Type TaskType, HAPI_NodeId NodeId )
+    {
+        FHoudiniEngineTask Task( TaskType, FGuid::NewGuid() );
+        Task.AssetId = NodeId;
+        Task.ActorName = TEXT( "SchedulerTest" );
+
+        Submitted.Add( { Task.HapiGUID, NodeId, TaskType, FPlatformTime::Seconds() } );
+        Scheduler.AddTask( Task );
+    }
+
+    /** Wait for all submitted tasks to reach the backend. Returns false on timeout. **/
+    bool WaitForCompletion( double Timeout = 120.0 )
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        while ( Backend.GetCallCount() < Submitted.Num() )
+        {
+            if ( FPlatformTime::Seconds() - StartTime > Timeout )
+                return false;
+
+            FPlatformProcess::Sleep( 0.001f );
+        }
+
+        // Let the last response be posted, and any duplicated task reach the backend.
+        FPlatformProcess::Sleep( 0.1f );
+        return true;
+    }
+
+    /** Check every task reached the backend exactly once and in submission order. **/
+    void TestNoLostOrDuplicatedTasks( FAutomationTestBase * Test ) const
+    {
+        TArray< FFakeHapiBackend::FCall > Calls = Backend.GetCalls();
+        Test->TestEqual( TEXT( "Processed task count" ), Calls.Num(), Submitted.Num() );
+
+        int32 Mismatches = 0;
+        for ( int32 Idx = 0; Idx < FMath::Min( Calls.Num(), Submitted.Num() ); ++Idx )
+        {
+            if ( Calls[ Idx ].NodeId != Submitted[ Idx ].NodeId || Calls[ Idx ].TaskType != Submitted[ Idx ].TaskType )
+                Mismatches++;
+        }
+
+        Test->TestEqual( TEXT( "Tasks processed in submission order" ), Mismatches, 0 );
+    }
+
+    /** Return true if task info has been posted for a task, which is what components poll for. **/
+    bool HasTaskInfo( int32 SubmittedIdx ) const
+    {
+        FHoudiniEngineTaskInfo TaskInfo;
+        return FHoudiniEngine::Get().RetrieveTaskInfo( Submitted[ SubmittedIdx ].HapiGUID, TaskInfo );
+    }
+
+    /** Return the final state reported for a cook task. **/
+    EHoudiniEngineTaskState::Type GetTaskState( int32 SubmittedIdx ) const
+    {
+        FHoudiniEngineTaskInfo TaskInfo;
+        if ( !FHoudiniEngine::Get().RetrieveTaskInfo( Submitted[ SubmittedIdx ].HapiGUID, TaskInfo ) )
+            return EHoudiniEngineTaskState::None;
+
+        return TaskInfo.TaskState;
+    }
+
+    /** Log throughput and queue latency percentiles. **/
+    void LogStatistics( const TCHAR * Label, double ElapsedTime ) const
+    {
+        TArray< FFakeHapiBackend::FCall > Calls = Backend.GetCalls();
+
+        TArray< double > Latencies;
+        for ( int32 Idx = 0; Idx < FMath::Min( Calls.Num(), Submitted.Num() ); ++Idx )
+            Latencies.Add( ( Calls[ Idx ].Time - Submitted[ Idx ].Time ) * 1000.0 );
+
+        if ( Latencies.Num() == 0 )
+            return;
+
+        Latencies.Sort();
+        auto Percentile = [ &Latencies ]( double P )
+        {
+            return Latencies[ FMath::Clamp( (int32) ( P * ( Latencies.Num() - 1 ) ), 0, Latencies.Num() - 1 ) ];
+        };
+
+        UE_LOG( LogHoudiniTests, Log,
+            TEXT( "%s: %d tasks in %.3f s (%.1f tasks/s), queue latency ms p50 %.3f p90 %.3f p99 %.3f max %.3f" ),
+            Label, Calls.Num(), ElapsedTime, Calls.Num() / FMath::Max( ElapsedTime, 1e-6 ),
+            Percentile( 0.5 ), Percentile( 0.9 ), Percentile( 0.99 ), Latencies.Last() );
+    }
+
+    FFakeHapiBackend Backend;
+    FHoudiniEngineScheduler Scheduler;
+    FRunnableThread * Thread;
+    TArray< FSubmittedTask > Submitted;
+};
+
+bool FHoudiniEngineRuntimeSchedulerStressTest::RunTest( const FString& Parameters )
+{
+    // Queue is filled before the scheduler starts, growing the ring buffer well past its initial size.
+    {
+        FSchedulerTestHarness Harness( 0.0, false );
+        for ( int32 Idx = 0; Idx < 10000; ++Idx )
+            Harness.Submit( EHoudiniEngineTaskType::AssetCooking, Idx % 500 );
+
+        Harness.StartThread();
+        TestTrue( TEXT( "Prefilled queue drained" ), Harness.WaitForCompletion() );
+        Harness.TestNoLostOrDuplicatedTasks( this );
+    }
+
+    // Bursts submitted while the scheduler is consuming, so the ring buffer grows after its write position wrapped.
+    {
+        FSchedulerTestHarness Harness( 0.0002 );
+        for ( int32 Burst = 0; Burst < 20; ++Burst )
+        {
+            for ( int32 Idx = 0; Idx < 100 + Burst * 50; ++Idx )
+                Harness.Submit( EHoudiniEngineTaskType::AssetCooking, Idx );
+
+            FPlatformProcess::Sleep( 0.005f );
+        }
+
+        TestTrue( TEXT( "Burst queue drained" ), Harness.WaitForCompletion() );
+        Harness.TestNoLostOrDuplicatedTasks( this );
+    }
+
+    // Rapid parameter changes on many components, with components deleted while their cooks are in flight.
+    {
+        static const int32 ComponentCount = 200;
+        static const int32 ChangesPerComponent = 20;
+
+        FSchedulerTestHarness Harness( 0.0001 );
+        TArray< int32 > LastCookBeforeDelete;
+        TArray< int32 > Deletes;
+        TArray< int32 > CooksAfterDelete;
+
+        for ( int32 Change = 0; Change < ChangesPerComponent; ++Change )
+        {
+            for ( HAPI_NodeId NodeId = 0; NodeId < ComponentCount; ++NodeId )
+            {
+                Harness.Submit( EHoudiniEngineTaskType::AssetCooking, NodeId );
+
+                // Every fourth component is deleted halfway through, right after requesting a cook.
+                if ( NodeId % 4 == 0 && Change == ChangesPerComponent / 2 )
+                {
+                    LastCookBeforeDelete.Add( Harness.Submitted.Num() - 1 );
+                    Harness.Submit( EHoudiniEngineTaskType::AssetDeletion, NodeId );
+                    Deletes.Add( Harness.Submitted.Num() - 1 );
+                }
+                else if ( NodeId % 4 == 0 && Change > ChangesPerComponent / 2 )
+                {
+                    CooksAfterDelete.Add( Harness.Submitted.Num() - 1 );
+                }
+            }
+        }
+
+        TestTrue( TEXT( "Parameter change queue drained" ), Harness.WaitForCompletion() );
+        Harness.TestNoLostOrDuplicatedTasks( this );
+
+        int32 FinishedCooks = 0;
+        int32 ExpectedFinishedCooks = 0;
+        for ( int32 Idx = 0; Idx < Harness.Submitted.Num(); ++Idx )
+        {
+            if ( Harness.Submitted[ Idx ].TaskType != EHoudiniEngineTaskType::AssetCooking )
+                continue;
+
+            ExpectedFinishedCooks++;
+            EHoudiniEngineTaskState::Type TaskState = Harness.GetTaskState( Idx );
+            if ( TaskState == EHoudiniEngineTaskState::FinishedCooking || TaskState == EHoudiniEngineTaskState::FinishedCookingWithErrors )
+                FinishedCooks++;
+        }
+
+        TestEqual( TEXT( "All cooks reported" ), FinishedCooks, ExpectedFinishedCooks );
+
+        for ( int32 Idx : LastCookBeforeDelete )
+        {
+            TestEqual( TEXT( "Cook in flight before delete succeeds" ),
+                (int32) Harness.GetTaskState( Idx ), (int32) EHoudiniEngineTaskState::FinishedCooking );
+        }
+
+        for ( int32 Idx : Deletes )
+        {
+            // The node is gone from the session, and the destroyed component is never notified of the deletion.
+            TestFalse( TEXT( "Deleted node is invalid" ),
+                FHoudiniEngineUtils::IsHoudiniAssetValid( Harness.Submitted[ Idx ].NodeId, &FFakeHapiBackend::Session ) );
+            TestFalse( TEXT( "No response for deletion" ), Harness.HasTaskInfo( Idx ) );
+        }
+
+        for ( int32 Idx : CooksAfterDelete )
+        {
+            // A cook queued for a destroyed component must never report output to apply.
+            TestEqual( TEXT( "Cook after delete fails" ),
+                (int32) Harness.GetTaskState( Idx ), (int32) EHoudiniEngineTaskState::FinishedCookingWithErrors );
+        }
+    }
+
+    return true;
+}
+
+bool FHoudiniEngineRuntimeSchedulerBenchmark::RunTest( const FString& Parameters )
+{
+    static const int32 TaskCounts[] = { 100, 1000, 10000 };
+    static const double CookLatencies[] = { 0.0, 0.0001, 0.001 };
+
+    for ( double CookLatency : CookLatencies )
+    {
+        for ( int32 TaskCount : TaskCounts )
+        {
+            // Keep the slowest configurations within a reasonable run time.
+            if ( TaskCount * CookLatency > 2.0 )
+                continue;
+
+            FSchedulerTestHarness Harness( CookLatency );
+
+            const double StartTime = FPlatformTime::Seconds();
+            for ( int32 Idx = 0; Idx < TaskCount; ++Idx )
+                Harness.Submit( EHoudiniEngineTaskType::AssetCooking, Idx % 64 );
+
+            const bool bCompleted = Harness.WaitForCompletion();
+            TestTrue( TEXT( "Benchmark queue drained" ), bCompleted );
+
+            // Do not count the settling time of WaitForCompletion.
+            TArray< FFakeHapiBackend::FCall > Calls = Harness.Backend.GetCalls();
+            const double ElapsedTime = Calls.Num() > 0 ? Calls.Last().Time - StartTime : 0.0;
+
+            FString Label = FString::Printf( TEXT( "Scheduler %d tasks, %.1f ms cook" ), TaskCount, CookLatency * 1000.0 );
+            Harness.LogStatistics( *Label, ElapsedTime );
+            Harness.TestNoLostOrDuplicatedTasks( this );
+        }
+    }
+
+    return true;
+}
+
+bool FHoudiniEngineRuntimeInstancePartitionBenchmark::RunTest( const FString& Parameters )
+{
+    static const int32 PointCounts[] = { 1000, 100000, 1000000 };
+    static const int32 VariantCounts[] = { 1, 10, 50 };
+
+    FRandomStream RandomStream( 1234 );
+
+    for ( int32 PointCount : PointCounts )
+    {
+        TArray< FTransform > Transforms;
+        Transforms.SetNumUninitialized( PointCount );
+        for ( int32 PointIdx = 0; PointIdx < PointCount; ++PointIdx )
+            Transforms[ PointIdx ] = FTransform( FVector( PointIdx, 0.0f, 0.0f ) );
+
+        for ( int32 VariantCount : VariantCounts )
+        {
+            TArray< HAPI_NodeId > PointIds;
+            TArray< FString > PointPaths;
+            PointIds.SetNumUninitialized( PointCount );
+            PointPaths.SetNum( PointCount );
+            for ( int32 PointIdx = 0; PointIdx < PointCount; ++PointIdx )
+            {
+                PointIds[ PointIdx ] = RandomStream.RandHelper( VariantCount );
+                PointPaths[ PointIdx ] = FString::Printf(
+                    TEXT( "StaticMesh'/Game/Instances/SM_Variant_%d.SM_Variant_%d'" ), PointIds[ PointIdx ], PointIds[ PointIdx ] );
+            }
+
+            TArray< HAPI_NodeId > Ids;
+            TArray< FString > Paths;
+            TArray< TArray< FTransform > > IdTransforms;
+            TArray< TArray< FTransform > > PathTransforms;
+
+            double StartTime = FPlatformTime::Seconds();
+            UHoudiniAssetInstanceInput::PartitionInstanceTransforms( PointIds, Transforms, Ids, IdTransforms );
+            const double IdTime = FPlatformTime::Seconds() - StartTime;
+
+            StartTime = FPlatformTime::Seconds();
+            UHoudiniAssetInstanceInput::PartitionInstanceTransforms( PointPaths, Transforms, Paths, PathTransforms );
+            const double PathTime = FPlatformTime::Seconds() - StartTime;
+
+            UE_LOG( LogHoudiniTests, Log, TEXT( "Instance partition %d points, %d variants: ids %.3f ms, paths %.3f ms" ),
+                PointCount, VariantCount, IdTime * 1000.0, PathTime * 1000.0 );
+
+            // Every point lands in the bucket of its key, in point order.
+            TestEqual( TEXT( "Id bucket count" ), Ids.Num(), Paths.Num() );
+            int32 Mismatches = 0;
+            TArray< int32 > BucketCursors;
+            BucketCursors.SetNumZeroed( Ids.Num() );
+            for ( int32 PointIdx = 0; PointIdx < PointCount; ++PointIdx )
+            {
+                const int32 BucketIdx = Ids.IndexOfByKey( PointIds[ PointIdx ] );
+                if ( BucketIdx == INDEX_NONE || Paths[ BucketIdx ] != PointPaths[ PointIdx ] )
+                {
+                    Mismatches++;
+                    continue;
+                }
+
+                const int32 Cursor = BucketCursors[ BucketIdx ]++;
+                if ( !IdTransforms[ BucketIdx ].IsValidIndex( Cursor )
+                    || !IdTransforms[ BucketIdx ][ Cursor ].Equals( Transforms[ PointIdx ] )
+                    || !PathTransforms[ BucketIdx ][ Cursor ].Equals( Transforms[ PointIdx ] ) )
+                {
+                    Mismatches++;
+                }
+            }
+
+            TestEqual( TEXT( "Partitioned transforms" ), Mismatches, 0 );
+        }
+    }
+
+    return true;
+}
+
+bool FHoudiniEngineRuntimeMeshSectionsTest::RunTest( const FString& Parameters )
+{
+    // A single sloped triangle, its point normal follows Houdini's clockwise winding.
+    FHoudiniRuntimeMeshPartData PartData;
+    PartData.PointCount = 3;
+    PartData.FaceCount = 1;
+    PartData.VertexList = { 0, 1, 2 };
+    PartData.Positions = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f };
+    PartData.Normals = { 0.0f, 1.0f, -1.0f, 0.0f, 1.0f, -1.0f, 0.0f, 1.0f, -1.0f };
+    PartData.AttribInfoNormals.exists = true;
+    PartData.AttribInfoNormals.owner = HAPI_ATTROWNER_POINT;
+    PartData.AttribInfoNormals.count = 3;
+    PartData.AttribInfoNormals.tupleSize = 3;
+    PartData.GeneratedGeometryScaleFactor = 1.0f;
+
+    struct FCase
+    {
+        const TCHAR * Name;
+        FVector Scale;
+        bool bSwapYZ;
+    };
+
+    static const FCase Cases[] =
+    {
+        { TEXT( "Identity" ), FVector( 1.0f, 1.0f, 1.0f ), false },
+        { TEXT( "Swapped axis" ), FVector( 1.0f, 1.0f, 1.0f ), true },
+        { TEXT( "Non uniform scale" ), FVector( 1.0f, 1.0f, 4.0f ), false },
+        { TEXT( "Mirrored" ), FVector( -1.0f, 1.0f, 1.0f ), true },
+    };
+
+    for ( const FCase & Case : Cases )
+    {
+        PartData.ObjectTransform = FTransform( FQuat::Identity, FVector::ZeroVector, Case.Scale );
+        PartData.bSwapYZ = Case.bSwapYZ;
+
+        TArray< FHoudiniRuntimeMeshSection > Sections;
+        FHoudiniRuntimeMeshUtils::BuildRuntimeMeshSections( PartData, Sections );
+        if ( !TestEqual( Case.Name, Sections.Num(), 1 ) || !TestEqual( Case.Name, Sections[ 0 ].Section.ProcIndexBuffer.Num(), 3 ) )
+            continue;
+
+        const FProcMeshSection & Section = Sections[ 0 ].Section;
+        const FVector P0 = Section.ProcVertexBuffer[ Section.ProcIndexBuffer[ 0 ] ].Position;
+        const FVector P1 = Section.ProcVertexBuffer[ Section.ProcIndexBuffer[ 1 ] ].Position;
+        const FVector P2 = Section.ProcVertexBuffer[ Section.ProcIndexBuffer[ 2 ] ].Position;
+        const FVector Normal = Section.ProcVertexBuffer[ 0 ].Normal;
+
+        // Normals stay perpendicular to the transformed surface.
+        TestTrue( FString::Printf( TEXT( "%s: normal perpendicular" ), Case.Name ),
+            FMath::IsNearlyZero( Normal | ( P1 - P0 ).GetSafeNormal(), KINDA_SMALL_NUMBER )
+            && FMath::IsNearlyZero( Normal | ( P2 - P0 ).GetSafeNormal(), KINDA_SMALL_NUMBER ) );
+
+        // And on the side the winding faces.
+        const FVector FaceNormal = ( ( P2 - P0 ) ^ ( P1 - P0 ) ).GetSafeNormal();
+        TestTrue( FString::Printf( TEXT( "%s: winding matches normal" ), Case.Name ), ( FaceNormal | Normal ) > 0.99f );
+    }
+
+    return true;
+}
+
+/** Build a valid cook key for the cook cache test. **/
+static FHoudiniCookKey
+MakeTestCookKey( char PresetValue, const FString & Input )
+{
+    FHoudiniCookKey CookKey;
+    CookKey.AssetPath = TEXT( "/Temp/HoudiniCookCacheTest.HoudiniCookCacheTest" );
+    CookKey.AssetName = TEXT( "Sop/cookcachetest" );
+    CookKey.Preset = { 'P', PresetValue };
+    CookKey.Inputs.Add( Input );
+    CookKey.UpdateHash();
+    return CookKey;
+}
+
+bool FHoudiniEngineRuntimeCookCacheTest::RunTest( const FString& Parameters )
+{
+    // Cook keys are equal only if all their fields are.
+    {
+        const FHoudiniCookKey CookKey = MakeTestCookKey( 1, TEXT( "Input" ) );
+        const FHoudiniCookKey SameCookKey = MakeTestCookKey( 1, TEXT( "Input" ) );
+        TestTrue( TEXT( "Identical keys are equal" ), CookKey == SameCookKey );
+        TestEqual( TEXT( "Identical keys hash the same" ), GetTypeHash( CookKey ), GetTypeHash( SameCookKey ) );
+
+        TestFalse( TEXT( "Keys with different presets differ" ), CookKey == MakeTestCookKey( 2, TEXT( "Input" ) ) );
+        TestFalse( TEXT( "Keys with different inputs differ" ), CookKey == MakeTestCookKey( 1, TEXT( "Other input" ) ) );
+
+        FHoudiniCookKey TransformCookKey = CookKey;
+        TransformCookKey.Transform = FTransform::Identity.ToString();
+        TransformCookKey.UpdateHash();
+        TestFalse( TEXT( "Keys with different transforms differ" ), CookKey == TransformCookKey );
+
+        // A hash collision must not make two keys equal.
+        FHoudiniCookKey CollidingCookKey = MakeTestCookKey( 2, TEXT( "Input" ) );
+        CollidingCookKey.Hash = CookKey.Hash;
+        TestFalse( TEXT( "Keys with colliding hashes differ" ), CookKey == CollidingCookKey );
+
+        FHoudiniCookKey EmptyPresetCookKey = CookKey;
+        EmptyPresetCookKey.Preset.Empty();
+        TestFalse( TEXT( "Keys without preset cannot be shared" ), EmptyPresetCookKey.IsValid() );
+    }
+
+    // Node ids are far above the ones of the running session, so the cache entries of open levels are untouched.
+    static const HAPI_NodeId SharedNodeId = 0x7ff00000;
+    static const HAPI_NodeId ForkedNodeId = 0x7ff00001;
+
+    UHoudiniAssetComponent * CookingComponent = NewObject< UHoudiniAssetComponent >( GetTransientPackage(), NAME_None, RF_Transient );
+    UHoudiniAssetComponent * WaitingComponent = NewObject< UHoudiniAssetComponent >( GetTransientPackage(), NAME_None, RF_Transient );
+    UHoudiniAssetComponent * ForkWaitingComponent = NewObject< UHoudiniAssetComponent >( GetTransientPackage(), NAME_None, RF_Transient );
+
+    const FHoudiniCookKey CookKey = MakeTestCookKey( 1, TEXT( "Input" ) );
+    const FHoudiniCookKey DivergedCookKey = MakeTestCookKey( 2, TEXT( "Input" ) );
+    HAPI_NodeId FoundNodeId = -1;
+    TMap< FHoudiniGeoPartObject, UStaticMesh * > FoundStaticMeshes;
+
+    // A component waiting on an identical cook is notified once its output is published.
+    FHoudiniCookCache::RegisterCook( SharedNodeId, CookKey, CookingComponent );
+    TestEqual( TEXT( "Registered cook is cooking" ),
+        (int32) FHoudiniCookCache::FindNode( CookKey, -1, FoundNodeId, FoundStaticMeshes ), (int32) EHoudiniCookCacheResult::Cooking );
+    TestTrue( TEXT( "Waiting on a cooking node" ), FHoudiniCookCache::WaitForCook( CookKey, WaitingComponent ) );
+    TestFalse( TEXT( "Cannot wait on an unknown key" ), FHoudiniCookCache::WaitForCook( DivergedCookKey, WaitingComponent ) );
+    TestEqual( TEXT( "Cooking node has a waiter" ), FHoudiniCookCache::GetNodeWaiterCount( SharedNodeId ), 1 );
+
+    FHoudiniCookCache::PublishCook( SharedNodeId, TMap< FHoudiniGeoPartObject, UStaticMesh * >() );
+    TestEqual( TEXT( "Waiters notified on publish" ), FHoudiniCookCache::GetNodeWaiterCount( SharedNodeId ), 0 );
+    TestEqual( TEXT( "Published cook is found" ),
+        (int32) FHoudiniCookCache::FindNode( CookKey, -1, FoundNodeId, FoundStaticMeshes ), (int32) EHoudiniCookCacheResult::Cooked );
+    TestEqual( TEXT( "Published cook is found on its node" ), FoundNodeId, SharedNodeId );
+    TestFalse( TEXT( "Cannot wait on a cooked node" ), FHoudiniCookCache::WaitForCook( CookKey, ForkWaitingComponent ) );
+
+    // Sharing the node, then forking it once the parameters diverge.
+    FHoudiniCookCache::AcquireNode( SharedNodeId, WaitingComponent );
+    TestEqual( TEXT( "Shared node has two users" ), FHoudiniCookCache::GetNodeUserCount( SharedNodeId ), 2 );
+    TestFalse( TEXT( "Forked node is kept for its other user" ), FHoudiniCookCache::ReleaseNode( SharedNodeId, WaitingComponent ) );
+    TestEqual( TEXT( "Shared node has one user left" ), FHoudiniCookCache::GetNodeUserCount( SharedNodeId ), 1 );
+
+    FHoudiniCookCache::RegisterCook( ForkedNodeId, DivergedCookKey, WaitingComponent );
+    TestEqual( TEXT( "Original output is still shared after a fork" ),
+        (int32) FHoudiniCookCache::FindNode( CookKey, -1, FoundNodeId, FoundStaticMeshes ), (int32) EHoudiniCookCacheResult::Cooked );
+    TestEqual( TEXT( "Original output stays on its node" ), FoundNodeId, SharedNodeId );
+    TestEqual( TEXT( "Forked node cooks its diverged key" ),
+        (int32) FHoudiniCookCache::FindNode( DivergedCookKey, -1, FoundNodeId, FoundStaticMeshes ), (int32) EHoudiniCookCacheResult::Cooking );
+    TestEqual( TEXT( "Forked node is not found by itself" ),
+        (int32) FHoudiniCookCache::FindNode( DivergedCookKey, ForkedNodeId, FoundNodeId, FoundStaticMeshes ), (int32) EHoudiniCookCacheResult::NotFound );
+
+    // A node reverting to a key held by another node does not take it over.
+    FHoudiniCookCache::RegisterCook( ForkedNodeId, CookKey, WaitingComponent );
+    FHoudiniCookCache::FindNode( CookKey, -1, FoundNodeId, FoundStaticMeshes );
+    TestEqual( TEXT( "Key stays with the node holding it" ), FoundNodeId, SharedNodeId );
+
+    // Waiting components are notified when the cook they wait on can no longer be shared.
+    FHoudiniCookCache::RegisterCook( ForkedNodeId, DivergedCookKey, WaitingComponent );
+    TestTrue( TEXT( "Waiting on the forked node" ), FHoudiniCookCache::WaitForCook( DivergedCookKey, ForkWaitingComponent ) );
+    FHoudiniCookCache::InvalidateNode( ForkedNodeId );
+    TestEqual( TEXT( "Waiters notified on invalidation" ), FHoudiniCookCache::GetNodeWaiterCount( ForkedNodeId ), 0 );
+    TestEqual( TEXT( "Invalidated cook is not found" ),
+        (int32) FHoudiniCookCache::FindNode( DivergedCookKey, -1, FoundNodeId, FoundStaticMeshes ), (int32) EHoudiniCookCacheResult::NotFound );
+
+    TestTrue( TEXT( "Last users release their nodes" ),
+        FHoudiniCookCache::ReleaseNode( SharedNodeId, CookingComponent ) && FHoudiniCookCache::ReleaseNode( ForkedNodeId, WaitingComponent ) );
+
+    CookingComponent->MarkPendingKill();
+    WaitingComponent->MarkPendingKill();
+    ForkWaitingComponent->MarkPendingKill();
+
+    return true;
+}
+
+#endif // WITH_EDITOR
@@ -91,4 +91,7 @@ struct HOUDINIENGINERUNTIME_API FHoudiniCookParams
     class UObject* IntermediateOuter = nullptr;
 
     int32 GeneratedDistanceFieldResolutionScale = 0;
+
+    // Textures larger than this are downsampled when extracted from Houdini, 0 extracts them at full resolution
+    int32 MaxTextureResolution = 0;
 };
@@ -41,6 +41,8 @@ namespace EHoudiniEngineTaskState
     };
 }
 
+struct FHoudiniApiSnapshot;
+
 struct HOUDINIENGINERUNTIME_API FHoudiniEngineTaskInfo
 {
     /** Constructors. **/
@@ -67,4 +69,10 @@ struct HOUDINIENGINERUNTIME_API FHoudiniEngineTaskInfo
 
     /** Is set to true if corresponding task was issued for loaded component. **/
     bool bLoadedComponent;
+
+    /** Cook output prefetched by the scheduler thread once cooking has finished. **/
+    TSharedPtr< const FHoudiniApiSnapshot, ESPMode::ThreadSafe > OutputSnapshot;
+
+    /** Objects referenced by the prefetched cook output. **/
+    TArray< FString > ReferencedObjectPaths;
 };
@@ -640,6 +640,9 @@ struct HOUDINIENGINERUNTIME_API FHoudiniGeoPartObject
 
         /** Temporary variable holding serialization version. **/
         uint32 HoudiniGeoPartObjectVersion;
+
+        /** Content key of the geometry of an instanced packed part, empty if unknown. Not serialized. **/
+        FString PackedGeometryKey;
 };
 
 /** Function used by hashing containers to create a unique hash for this type of object. **/